@@ -5,15 +5,144 @@
 #include <sstream>
 #include <locale>
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <system_error>
 
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
+
+namespace {
+
+//Accepts a leading '+' and ignores trailing characters, like the std::sto* family.
+template<typename T>
+bool ParseConfigInteger(const std::string& raw, T& value) {
+    const char* first = raw.data();
+    const char* last = first + raw.size();
+    while(first != last && std::isspace(static_cast<unsigned char>(*first))) {
+        ++first;
+    }
+    if(first != last && *first == '+') {
+        ++first;
+    }
+    T parsed{};
+    auto result = std::from_chars(first, last, parsed);
+    if(result.ec != std::errc{}) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+template<typename T, typename F>
+bool ParseConfigFloat(const std::string& raw, T& value, F&& strto) {
+    const char* first = raw.c_str();
+    char* end = nullptr;
+    T parsed = strto(first, &end);
+    if(end == first) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+}
+
+bool ParseConfigValue(const std::string& raw, char& value) {
+    if(raw.empty()) {
+        return false;
+    }
+    value = raw.front();
+    return true;
+}
+
+bool ParseConfigValue(const std::string& raw, unsigned char& value) {
+    return ParseConfigInteger(raw, value);
+}
+
+bool ParseConfigValue(const std::string& raw, signed char& value) {
+    return ParseConfigInteger(raw, value);
+}
+
+bool ParseConfigValue(const std::string& raw, bool& value) {
+    if(raw == "true") {
+        value = true;
+        return true;
+    }
+    if(raw == "false") {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+bool ParseConfigValue(const std::string& raw, unsigned int& value) {
+    return ParseConfigInteger(raw, value);
+}
+
+bool ParseConfigValue(const std::string& raw, int& value) {
+    return ParseConfigInteger(raw, value);
+}
+
+bool ParseConfigValue(const std::string& raw, long& value) {
+    return ParseConfigInteger(raw, value);
+}
+
+bool ParseConfigValue(const std::string& raw, unsigned long& value) {
+    return ParseConfigInteger(raw, value);
+}
+
+bool ParseConfigValue(const std::string& raw, long long& value) {
+    return ParseConfigInteger(raw, value);
+}
+
+bool ParseConfigValue(const std::string& raw, unsigned long long& value) {
+    return ParseConfigInteger(raw, value);
+}
+
+bool ParseConfigValue(const std::string& raw, float& value) {
+    return ParseConfigFloat(raw, value, [](const char* str, char** end) { return std::strtof(str, end); });
+}
+
+bool ParseConfigValue(const std::string& raw, double& value) {
+    return ParseConfigFloat(raw, value, [](const char* str, char** end) { return std::strtod(str, end); });
+}
+
+bool ParseConfigValue(const std::string& raw, long double& value) {
+    return ParseConfigFloat(raw, value, [](const char* str, char** end) { return std::strtold(str, end); });
+}
+
+bool ParseConfigValue(const std::string& raw, std::string& value) {
+    value = raw;
+    return true;
+}
+
+Config::Config()
+: _config()
+, _handles()
+, _watched_files()
+, _reload_state(nullptr)
+, _hot_reload_seconds(0.0f)
+, _hot_reload_elapsed(0.0f)
+, _configFilePath()
+, _configCmdParams()
+{
+    /* DO NOTHING */
+}
 
 Config::Config(const std::string& configFilePath, const std::string& cmdLineParams)
 : _config()
+, _handles()
+, _watched_files()
+, _reload_state(std::make_shared<reload_state_t>())
+, _hot_reload_seconds(0.0f)
+, _hot_reload_elapsed(0.0f)
 , _configFilePath(configFilePath)
 , _configCmdParams(cmdLineParams)
 
 {
+    _reload_state->config = this;
 
     if (_configFilePath.empty()) {
         if (!CreateDefaultConfig()) {
@@ -30,6 +159,8 @@ Config::Config(const std::string& configFilePath, const std::string& cmdLinePara
             if(!CreateDefaultConfig()) {
                 DebuggerPrintf("\nWARNING: Default Config file failed to parse correctly.");
             }
+        } else {
+            WatchFile(_configFilePath, _config);
         }
     }
     if(!cmdLineParams.empty()) {
@@ -42,7 +173,9 @@ Config::Config(const std::string& configFilePath, const std::string& cmdLinePara
 }
 
 Config::~Config() {
-    /* DO NOTHING */
+    if(_reload_state) {
+        _reload_state->config = nullptr;
+    }
 }
 
 bool Config::CreateDefaultConfig() {
@@ -106,6 +239,115 @@ void Config::PrintConfigs(std::ostream& output /*= std::cout*/) const {
     }
 }
 
+void Config::Update(float deltaSeconds) {
+    if(_hot_reload_seconds <= 0.0f || _watched_files.empty()) {
+        return;
+    }
+    _hot_reload_elapsed += deltaSeconds;
+    if(_hot_reload_elapsed < _hot_reload_seconds || _reload_state->in_flight) {
+        return;
+    }
+    _hot_reload_elapsed = 0.0f;
+    _reload_state->in_flight = true;
+
+    std::vector<std::pair<std::string, std::filesystem::file_time_type>> files{};
+    files.reserve(_watched_files.size());
+    for(const auto& file : _watched_files) {
+        files.emplace_back(file.path, file.last_write);
+    }
+    auto state = _reload_state;
+    JobSystem::Run(JobType::JOBTYPE_IO, [state, files](void* /*user_data*/) {
+        namespace FS = std::filesystem;
+        auto reloaded = std::make_shared<std::vector<watched_file_t>>();
+        for(const auto& file : files) {
+            std::error_code ec;
+            auto last_write = FS::last_write_time(file.first, ec);
+            if(ec || last_write == file.second) {
+                continue;
+            }
+            Config parsed{};
+            std::ifstream input;
+            input.open(file.first);
+            bool successful = parsed.Parse(input);
+            input.close();
+            if(!successful) {
+                DebuggerPrintf("\nWARNING: Changed config file failed to parse correctly. Keeping previous values.");
+                continue;
+            }
+            reloaded->push_back(watched_file_t{ file.first, last_write, std::move(parsed._config) });
+        }
+        if(reloaded->empty()) {
+            state->in_flight = false;
+            return;
+        }
+        JobSystem::Run(JobType::JOBTYPE_MAIN, [state, reloaded](void* /*user_data*/) {
+            state->in_flight = false;
+            if(state->config) {
+                state->config->ApplyReload(*reloaded);
+            }
+        }, nullptr);
+    }, nullptr);
+}
+
+void Config::EnableHotReload(float poll_seconds /*= 1.0f*/) {
+    _hot_reload_seconds = (std::max)(poll_seconds, 0.001f);
+    _hot_reload_elapsed = 0.0f;
+}
+
+void Config::DisableHotReload() {
+    _hot_reload_seconds = 0.0f;
+}
+
+void Config::WatchFile(const std::string& filepath, const std::map<std::string, std::string>& values) {
+    if(!_reload_state) {
+        return;
+    }
+    namespace FS = std::filesystem;
+    std::error_code ec;
+    auto last_write = FS::last_write_time(filepath, ec);
+    if(ec) {
+        return;
+    }
+    auto found = std::find_if(_watched_files.begin(), _watched_files.end(), [&filepath](const watched_file_t& file) { return file.path == filepath; });
+    if(found == _watched_files.end()) {
+        _watched_files.push_back(watched_file_t{ filepath, last_write, values });
+        return;
+    }
+    found->last_write = last_write;
+    for(const auto& kvp : values) {
+        found->values[kvp.first] = kvp.second;
+    }
+}
+
+//Sets only the keys whose value in the file changed, so values set since
+//(command line, SetValue) survive edits to unrelated keys.
+void Config::ApplyReload(const std::vector<watched_file_t>& reloaded) {
+    for(const auto& file : reloaded) {
+        auto watched = std::find_if(_watched_files.begin(), _watched_files.end(), [&file](const watched_file_t& w) { return w.path == file.path; });
+        if(watched == _watched_files.end()) {
+            continue;
+        }
+        for(const auto& kvp : file.values) {
+            auto previous = watched->values.find(kvp.first);
+            if(previous == watched->values.end() || previous->second != kvp.second) {
+                SetValue(kvp.first, kvp.second);
+            }
+        }
+        watched->last_write = file.last_write;
+        watched->values = file.values;
+    }
+}
+
+void Config::RefreshHandles(const std::string& key, const std::string& raw) {
+    auto found = _handles.find(key);
+    if(found == _handles.end()) {
+        return;
+    }
+    for(auto& slot : found->second) {
+        slot->Refresh(raw);
+    }
+}
+
 bool Config::ProcessSystemMessage(const SystemMessage& /*msg*/) {
     return false;
 }
@@ -170,70 +412,71 @@ void Config::GetValue(const std::string& key, std::string& value) {
 }
 
 void Config::SetValue(const std::string& key, const char& value) {
-    _config[key] = value;
+    SetValue(key, std::string(1, value));
 }
 
 void Config::SetValue(const std::string& key, const unsigned char& value) {
-    _config[key] = value;
+    SetValue(key, std::string(1, static_cast<char>(value)));
 }
 
 void Config::SetValue(const std::string& key, const signed char& value) {
-    _config[key] = value;
+    SetValue(key, std::string(1, static_cast<char>(value)));
 }
 
 void Config::SetValue(const std::string& key, const bool& value) {
     if(value) {
-        _config[key] = "true";
+        SetValue(key, std::string("true"));
     } else {
-        _config[key] = "false";
+        SetValue(key, std::string("false"));
     }
 }
 
 void Config::SetValue(const std::string& key, const unsigned int& value) {
-    _config[key] = std::to_string(value);
+    SetValue(key, std::to_string(value));
 }
 
 void Config::SetValue(const std::string& key, const int& value) {
-    _config[key] = std::to_string(value);
+    SetValue(key, std::to_string(value));
 }
 
 void Config::SetValue(const std::string& key, const long& value) {
-    _config[key] = std::to_string(value);
+    SetValue(key, std::to_string(value));
 }
 
 void Config::SetValue(const std::string& key, const unsigned long& value) {
-    _config[key] = std::to_string(value);
+    SetValue(key, std::to_string(value));
 }
 
 void Config::SetValue(const std::string& key, const long long& value) {
-    _config[key] = std::to_string(value);
+    SetValue(key, std::to_string(value));
 }
 
 void Config::SetValue(const std::string& key, const unsigned long long& value) {
-    _config[key] = std::to_string(value);
+    SetValue(key, std::to_string(value));
 }
 
 void Config::SetValue(const std::string& key, const float& value) {
-    _config[key] = std::to_string(value);
+    SetValue(key, std::to_string(value));
 }
 
 void Config::SetValue(const std::string& key, const double& value) {
-    _config[key] = std::to_string(value);
+    SetValue(key, std::to_string(value));
 }
 
 void Config::SetValue(const std::string& key, const long double& value) {
-    _config[key] = std::to_string(value);
+    SetValue(key, std::to_string(value));
 }
 
 void Config::SetValue(const std::string& key, const std::string& value) {
     _config[key] = value;
+    RefreshHandles(key, value);
 }
 
 void Config::SetValue(const std::string& key, const char* value) {
     SetValue(key, std::string(value));
 }
 bool Config::LoadFromFile(const std::string& filepath) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(filepath);
     if(p.has_extension() == false) {
         std::ostringstream ss;
@@ -253,7 +496,17 @@ bool Config::LoadFromFile(const std::string& filepath) {
     
     std::string buffer(GetFileContents(p.string()));
 
-    return Parse(buffer);
+    //Parsed on the side first so the file's own values are known for hot reload.
+    Config parsed{};
+    std::istringstream ss(buffer);
+    if(!parsed.Parse(ss)) {
+        return false;
+    }
+    for(const auto& kvp : parsed._config) {
+        SetValue(kvp.first, kvp.second);
+    }
+    WatchFile(p.string(), parsed._config);
+    return true;
 }
 
 std::string Config::GetFileContents(const std::string& filepath) {
@@ -317,13 +570,13 @@ bool Config::Parse(const std::string& input) {
     if(*key_iter == '-') {
         ++key_iter;
         std::string key = cur_line.substr(std::distance(key_iter, key_iter + 1));
-        _config[key] = "false";
+        SetValue(key, std::string("false"));
         return true;
     }
     if(*key_iter == '+') {
         ++key_iter;
         std::string key = cur_line.substr(std::distance(key_iter, key_iter + 1));
-        _config[key] = "true";
+        SetValue(key, std::string("true"));
         return true;
     }
     //Get raw key-value pairs split on equals.
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <filesystem>
+#include <functional>
 #include <map>
 #include <string>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <typeindex>
+#include <utility>
 #include <vector>
 
 #include "Engine/Core/EngineSubsystem.hpp"
@@ -15,6 +20,96 @@ constexpr const int DEFAULT_CLIENT_HEIGHT = 600;
 constexpr const int DEFAULT_WINDOW_WIDTH = 800;
 constexpr const int DEFAULT_WINDOW_HEIGHT = 600;
 
+//Parses a raw config value. Returns false and leaves value untouched if raw is not a valid T.
+bool ParseConfigValue(const std::string& raw, char& value);
+bool ParseConfigValue(const std::string& raw, unsigned char& value);
+bool ParseConfigValue(const std::string& raw, signed char& value);
+bool ParseConfigValue(const std::string& raw, bool& value);
+bool ParseConfigValue(const std::string& raw, unsigned int& value);
+bool ParseConfigValue(const std::string& raw, int& value);
+bool ParseConfigValue(const std::string& raw, long& value);
+bool ParseConfigValue(const std::string& raw, unsigned long& value);
+bool ParseConfigValue(const std::string& raw, long long& value);
+bool ParseConfigValue(const std::string& raw, unsigned long long& value);
+bool ParseConfigValue(const std::string& raw, float& value);
+bool ParseConfigValue(const std::string& raw, double& value);
+bool ParseConfigValue(const std::string& raw, long double& value);
+bool ParseConfigValue(const std::string& raw, std::string& value);
+
+struct config_slot_base_t {
+    explicit config_slot_base_t(const std::type_index& slot_type) : type(slot_type) {}
+    virtual ~config_slot_base_t() = default;
+    virtual void Refresh(const std::string& raw) = 0;
+    std::type_index type;
+};
+
+//Parsed value of one key as one type, shared by every handle to it.
+template<typename T>
+struct config_slot_t : public config_slot_base_t {
+    config_slot_t() : config_slot_base_t(typeid(T)) {}
+
+    //Re-parses raw and notifies subscribers if the value changed.
+    virtual void Refresh(const std::string& raw) override {
+        T parsed = value;
+        if(!ParseConfigValue(raw, parsed) || parsed == value) {
+            return;
+        }
+        value = std::move(parsed);
+        //Indexed so callbacks may subscribe more.
+        for(std::size_t i = 0; i < subscribers.size(); ++i) {
+            subscribers[i].second(value);
+        }
+    }
+
+    T value{};
+    std::vector<std::pair<unsigned int, std::function<void(const T&)>>> subscribers{};
+    unsigned int next_subscriber_id = 1;
+};
+
+//Typed view of a config key, made by Config::GetHandle. Reading it is a plain load of the
+//cached value; parsing only happens when the key changes. Cheap to copy.
+template<typename T>
+class ConfigHandle {
+public:
+    using change_cb = std::function<void(const T& value)>;
+
+    ConfigHandle() = default;
+
+    const T& Get() const {
+        return _slot->value;
+    }
+    operator const T&() const {
+        return _slot->value;
+    }
+    bool IsValid() const {
+        return _slot != nullptr;
+    }
+
+    //cb runs on the main thread after the value changes. Returns an id for Unsubscribe.
+    unsigned int Subscribe(const change_cb& cb) const {
+        unsigned int id = _slot->next_subscriber_id++;
+        _slot->subscribers.emplace_back(id, cb);
+        return id;
+    }
+    void Unsubscribe(unsigned int id) const {
+        auto& subscribers = _slot->subscribers;
+        for(auto iter = subscribers.begin(); iter != subscribers.end(); ++iter) {
+            if(iter->first == id) {
+                subscribers.erase(iter);
+                return;
+            }
+        }
+    }
+
+protected:
+private:
+    explicit ConfigHandle(config_slot_t<T>* slot) : _slot(slot) {}
+
+    config_slot_t<T>* _slot = nullptr;
+
+    friend class Config;
+};
+
 class Config : public EngineSubsystem {
 public:
 	Config(const std::string& configFilePath, const std::string& cmdLineParams = std::string(""));
@@ -51,6 +146,18 @@ public:
     void SetValue(const std::string& key, const std::string& value);
     void SetValue(const std::string& key, const char* value);
 
+    //Resolves key once. The handle's cached value is refreshed whenever the key is set or
+    //hot reloaded. Keys that are missing or do not parse as T keep default_value; every
+    //handle to the same key and type shares the first default given.
+    //Main thread only. Handles are valid for the lifetime of the Config.
+    template<typename T>
+    ConfigHandle<T> GetHandle(const std::string& key, const T& default_value = T{});
+
+    //Checks the loaded config files every poll_seconds and re-parses changed ones on a
+    //JOBTYPE_IO job. Changed keys are set, and their handles notified, on the main thread.
+    void EnableHotReload(float poll_seconds = 1.0f);
+    void DisableHotReload();
+
     bool LoadFromFile(const std::string& filepath);
     void PrintConfigs(std::ostream& output = std::cout) const;
 
@@ -58,6 +165,7 @@ public:
     friend std::istream& operator>>(std::istream& input, Config& config);
 
 
+    virtual void Update(float deltaSeconds) override;
     virtual bool ProcessSystemMessage(const SystemMessage& msg) override;
 protected:
     bool Parse(std::ifstream& input);
@@ -67,9 +175,51 @@ protected:
     std::string GetFileContents(const std::string& filepath);
     bool CreateDefaultConfig();
 private:
+    struct watched_file_t {
+        std::string path;
+        std::filesystem::file_time_type last_write;
+        //Values as last read from this file, so a reload only sets keys the file changed.
+        std::map<std::string, std::string> values;
+    };
+    //Shared with in-flight reload jobs, which may outlive the Config.
+    struct reload_state_t {
+        Config* config = nullptr;
+        std::atomic_bool in_flight{ false };
+    };
+
+    //Parse target for files read off the main thread. Does not touch the file system.
+    Config();
+
+    void WatchFile(const std::string& filepath, const std::map<std::string, std::string>& values);
+    void ApplyReload(const std::vector<watched_file_t>& reloaded);
+    void RefreshHandles(const std::string& key, const std::string& raw);
 
 	std::map<std::string, std::string> _config;
+    std::map<std::string, std::vector<std::unique_ptr<config_slot_base_t>>> _handles;
+    std::vector<watched_file_t> _watched_files;
+    std::shared_ptr<reload_state_t> _reload_state;
+    float _hot_reload_seconds;
+    float _hot_reload_elapsed;
     std::string _configFilePath;
     std::string _configCmdParams;
 
-};
\ No newline at end of file
+};
+
+template<typename T>
+ConfigHandle<T> Config::GetHandle(const std::string& key, const T& default_value /*= T{}*/) {
+    auto& slots = _handles[key];
+    for(auto& slot : slots) {
+        if(slot->type == typeid(T)) {
+            return ConfigHandle<T>(static_cast<config_slot_t<T>*>(slot.get()));
+        }
+    }
+    auto slot = std::make_unique<config_slot_t<T>>();
+    slot->value = default_value;
+    auto found = _config.find(key);
+    if(found != _config.end()) {
+        ParseConfigValue(found->second, slot->value);
+    }
+    ConfigHandle<T> handle(slot.get());
+    slots.push_back(std::move(slot));
+    return handle;
+}
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include "Engine/Core/AsyncFileService.hpp"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+
+#include "Engine/Core/CriticalSection.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/PackFile.hpp"
+
+namespace {
+
+struct file_request_t {
+    file_request_id id = AsyncFileService::INVALID_REQUEST_ID;
+    std::string filepath{};
+    std::string key{};
+    file_request_cb cb{};
+};
+
+struct file_delivery_t {
+    file_request_id id = AsyncFileService::INVALID_REQUEST_ID;
+    std::string filepath{};
+    file_request_cb cb{};
+    std::vector<unsigned char> buffer{};
+    bool succeeded = false;
+};
+
+constexpr std::size_t PRIORITY_COUNT = static_cast<std::size_t>(FileRequestPriority::MAX);
+
+CriticalSection s_cs;
+std::array<std::deque<file_request_t>, PRIORITY_COUNT> s_pending{};
+std::set<file_request_id> s_in_flight{};
+std::set<file_request_id> s_awaiting_delivery{};
+std::set<file_request_id> s_cancelled{};
+std::map<std::string, std::vector<unsigned char>> s_read_ahead_cache{};
+//Keys of read-aheads being read, and the Request waiting on each, if any.
+std::set<std::string> s_read_aheads_in_flight{};
+std::map<std::string, file_request_t> s_read_ahead_claims{};
+std::size_t s_read_ahead_bytes = 0;
+std::size_t s_read_ahead_budget = 32u * 1024u * 1024u;
+file_request_id s_next_id = 1;
+
+file_request_id NextRequestId() {
+    file_request_id id = s_next_id++;
+    if(s_next_id == AsyncFileService::INVALID_REQUEST_ID) {
+        ++s_next_id;
+    }
+    return id;
+}
+
+std::deque<file_request_t>& GetPendingQueue(const FileRequestPriority& priority) {
+    return s_pending[static_cast<std::size_t>(priority)];
+}
+
+//Must be called while NOT holding s_cs. The delivery is marked awaiting by the caller.
+void Deliver(const std::shared_ptr<file_delivery_t>& delivery) {
+    JobSystem::Run(JobType::JOBTYPE_MAIN, [delivery](void* /*user_data*/) {
+        s_cs.enter();
+        bool was_cancelled = s_cancelled.erase(delivery->id) != 0;
+        s_awaiting_delivery.erase(delivery->id);
+        s_cs.leave();
+        if(!was_cancelled && delivery->cb) {
+            delivery->cb(delivery->filepath, delivery->succeeded, delivery->buffer);
+        }
+    }, nullptr);
+}
+
+}
+
+file_request_id AsyncFileService::Request(const std::string& filepath, const file_request_cb& cb, const FileRequestPriority& priority /*= FileRequestPriority::NORMAL*/) {
+    file_request_t request{};
+    request.filepath = filepath;
+    request.key = FileUtils::PackFile::NormalizePath(filepath);
+    request.cb = cb;
+
+    s_cs.enter();
+    request.id = NextRequestId();
+    file_request_id id = request.id;
+
+    //Claim a finished read-ahead.
+    auto cached = s_read_ahead_cache.find(request.key);
+    if(cached != s_read_ahead_cache.end()) {
+        auto delivery = std::make_shared<file_delivery_t>();
+        delivery->id = id;
+        delivery->filepath = filepath;
+        delivery->cb = cb;
+        delivery->buffer = std::move(cached->second);
+        delivery->succeeded = true;
+        s_read_ahead_bytes -= delivery->buffer.size();
+        s_read_ahead_cache.erase(cached);
+        s_awaiting_delivery.insert(id);
+        s_cs.leave();
+        Deliver(delivery);
+        return id;
+    }
+
+    //Wait for a read-ahead that is already being read instead of reading the file again.
+    if(s_read_aheads_in_flight.count(request.key) && !s_read_ahead_claims.count(request.key)) {
+        s_in_flight.insert(id);
+        s_read_ahead_claims.emplace(request.key, std::move(request));
+        s_cs.leave();
+        return id;
+    }
+
+    //Promote a queued read-ahead. Its IO job was already dispatched.
+    auto& read_ahead_queue = GetPendingQueue(FileRequestPriority::READ_AHEAD);
+    auto queued = std::find_if(read_ahead_queue.begin(), read_ahead_queue.end(), [&request](const file_request_t& r) { return r.key == request.key; });
+    bool promoted = queued != read_ahead_queue.end();
+    if(promoted) {
+        read_ahead_queue.erase(queued);
+    }
+    GetPendingQueue(priority == FileRequestPriority::MAX ? FileRequestPriority::NORMAL : priority).push_back(std::move(request));
+    s_cs.leave();
+
+    if(!promoted) {
+        DispatchServiceJob();
+    }
+    return id;
+}
+
+void AsyncFileService::ReadAhead(const std::string& filepath) {
+    file_request_t request{};
+    request.filepath = filepath;
+    request.key = FileUtils::PackFile::NormalizePath(filepath);
+
+    s_cs.enter();
+    bool already_known = s_read_ahead_cache.find(request.key) != s_read_ahead_cache.end() || s_read_aheads_in_flight.count(request.key) != 0;
+    for(auto iter = s_pending.begin(); !already_known && iter != s_pending.end(); ++iter) {
+        already_known = std::any_of(iter->begin(), iter->end(), [&request](const file_request_t& r) { return r.key == request.key; });
+    }
+    if(already_known) {
+        s_cs.leave();
+        return;
+    }
+    request.id = NextRequestId();
+    GetPendingQueue(FileRequestPriority::READ_AHEAD).push_back(std::move(request));
+    s_cs.leave();
+
+    DispatchServiceJob();
+}
+
+void AsyncFileService::DispatchServiceJob() {
+    JobSystem::Run(JobType::JOBTYPE_IO, [](void* /*user_data*/) { AsyncFileService::ServiceNextRequest(); }, nullptr);
+}
+
+bool AsyncFileService::Cancel(file_request_id id) {
+    bool result = false;
+    s_cs.enter();
+    for(auto& queue : s_pending) {
+        auto found = std::find_if(queue.begin(), queue.end(), [id](const file_request_t& r) { return r.id == id; });
+        if(found != queue.end()) {
+            queue.erase(found);
+            result = true;
+            break;
+        }
+    }
+    if(!result && (s_in_flight.count(id) || s_awaiting_delivery.count(id))) {
+        s_cancelled.insert(id);
+        result = true;
+    }
+    s_cs.leave();
+    return result;
+}
+
+void AsyncFileService::CancelAll() {
+    s_cs.enter();
+    for(auto& queue : s_pending) {
+        queue.clear();
+    }
+    s_cancelled.insert(s_in_flight.begin(), s_in_flight.end());
+    s_cancelled.insert(s_awaiting_delivery.begin(), s_awaiting_delivery.end());
+    s_read_ahead_cache.clear();
+    s_read_ahead_bytes = 0;
+    s_cs.leave();
+}
+
+void AsyncFileService::SetReadAheadBudget(std::size_t max_bytes) {
+    s_cs.enter();
+    s_read_ahead_budget = max_bytes;
+    s_cs.leave();
+}
+
+std::size_t AsyncFileService::GetPendingCount() {
+    std::size_t count = 0;
+    s_cs.enter();
+    for(auto& queue : s_pending) {
+        count += queue.size();
+    }
+    s_cs.leave();
+    return count;
+}
+
+std::size_t AsyncFileService::GetInFlightCount() {
+    s_cs.enter();
+    std::size_t count = s_in_flight.size();
+    s_cs.leave();
+    return count;
+}
+
+void AsyncFileService::ServiceNextRequest() {
+    file_request_t request{};
+    s_cs.enter();
+    auto queue = std::find_if(s_pending.begin(), s_pending.end(), [](const std::deque<file_request_t>& q) { return !q.empty(); });
+    if(queue == s_pending.end()) {
+        s_cs.leave();
+        return;
+    }
+    request = std::move(queue->front());
+    queue->pop_front();
+    s_in_flight.insert(request.id);
+    if(!request.cb) {
+        s_read_aheads_in_flight.insert(request.key);
+    }
+    s_cs.leave();
+
+    auto delivery = std::make_shared<file_delivery_t>();
+    delivery->succeeded = FileUtils::ReadBufferFromFile(delivery->buffer, request.filepath);
+
+    s_cs.enter();
+    s_in_flight.erase(request.id);
+    bool cancelled = s_cancelled.erase(request.id) != 0;
+    if(!request.cb) {
+        s_read_aheads_in_flight.erase(request.key);
+        //Hand the buffer to a Request that arrived during the read, unless it was cancelled.
+        auto claim = s_read_ahead_claims.find(request.key);
+        if(claim != s_read_ahead_claims.end()) {
+            file_request_t claimant = std::move(claim->second);
+            s_read_ahead_claims.erase(claim);
+            s_in_flight.erase(claimant.id);
+            if(s_cancelled.erase(claimant.id) == 0) {
+                request = std::move(claimant);
+                cancelled = false;
+            }
+        }
+    }
+    if(cancelled) {
+        s_cs.leave();
+        return;
+    }
+    if(!request.cb) {
+        const bool fits = s_read_ahead_bytes + delivery->buffer.size() <= s_read_ahead_budget;
+        if(delivery->succeeded && fits && s_read_ahead_cache.find(request.key) == s_read_ahead_cache.end()) {
+            s_read_ahead_bytes += delivery->buffer.size();
+            s_read_ahead_cache.emplace(request.key, std::move(delivery->buffer));
+        }
+        s_cs.leave();
+        return;
+    }
+    s_awaiting_delivery.insert(request.id);
+    s_cs.leave();
+
+    delivery->id = request.id;
+    delivery->filepath = std::move(request.filepath);
+    delivery->cb = std::move(request.cb);
+    Deliver(delivery);
+}
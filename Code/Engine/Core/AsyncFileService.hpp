@@ -0,0 +1,48 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+enum class FileRequestPriority : unsigned int {
+    CRITICAL,
+    HIGH,
+    NORMAL,
+    LOW,
+    READ_AHEAD,
+    MAX,
+};
+
+//Called on the main thread (JOBTYPE_MAIN) once the read finishes.
+//The buffer may be moved out of by the callback.
+typedef std::function<void(const std::string& filepath, bool succeeded, std::vector<unsigned char>& buffer)> file_request_cb;
+
+typedef unsigned int file_request_id;
+
+//Reads files on the JOBTYPE_IO threads in priority order.
+//The number of reads in flight is bounded by the number of IO threads given to JobSystem::Startup.
+class AsyncFileService {
+public:
+    static constexpr file_request_id INVALID_REQUEST_ID = 0;
+
+    static file_request_id Request(const std::string& filepath, const file_request_cb& cb, const FileRequestPriority& priority = FileRequestPriority::NORMAL);
+
+    //Reads filepath at the lowest priority and keeps the result until a later Request for the same file claims it.
+    //A Request made while the read-ahead is reading waits for it rather than reading the file again.
+    static void ReadAhead(const std::string& filepath);
+
+    //Returns false if the request already completed or does not exist.
+    //A cancelled request never calls its callback.
+    static bool Cancel(file_request_id id);
+    static void CancelAll();
+
+    static void SetReadAheadBudget(std::size_t max_bytes);
+
+    static std::size_t GetPendingCount();
+    static std::size_t GetInFlightCount();
+
+protected:
+private:
+    static void DispatchServiceJob();
+    static void ServiceNextRequest();
+};
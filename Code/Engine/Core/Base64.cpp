@@ -1,358 +1,597 @@
 #include "Engine/Core/Base64.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <intrin.h>
+
+#include "Engine/EngineConfig.hpp"
+
+#include "Engine/Core/CpuUtils.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
 
 namespace DataUtils {
 
-const std::vector<char> Base64Encoder::EncodingTable = { 'A','B','C','D','E','F','G','H','I','J','K','L','M','N','O','P','Q','R','S','T','U','V','W','X','Y','Z', //0-25
-'a','b','c','d','e','f','g','h','i','j','k','l','m','n','o','p','q','r','s','t','u','v','w','x','y','z', //26-51
-'0','1','2','3','4','5','6','7','8','9',                                                                 //52-61
-'+','/' };
+namespace {
 
-const char Base64Encoder::PADDING_CHAR = '=';
+constexpr char ENCODING_TABLE[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char PADDING_CHAR = '=';
 
-/************************************************************************/
-/* ENCODER                                                              */
-/************************************************************************/
+//Both markers have the top two bits set so one test rejects either.
+constexpr unsigned char INVALID_SYMBOL = 0xFF;
+constexpr unsigned char WHITESPACE_SYMBOL = 0xFE;
 
-int Base64Encoder::GetFirstSymbolIndex(const std::vector<unsigned char>& encoding_buffer) const noexcept {
-    return ((encoding_buffer[0] & 0xFC) >> 2);
-}
+//Multiples of the group sizes so chunk boundaries rarely split a group.
+constexpr std::size_t ENCODE_CHUNK_SIZE = 3 * 16384;
+constexpr std::size_t DECODE_CHUNK_SIZE = 4 * 16384;
 
-int Base64Encoder::GetSecondSymbolIndex(const std::vector<unsigned char>& encoding_buffer) const noexcept {
-    return (((encoding_buffer[0] & 0x03) << 4) | ((encoding_buffer[1] & 0xF0) >> 4));
-}
+struct decoding_table_t {
+    unsigned char values[256];
+};
 
-int Base64Encoder::GetThirdSymbolIndex(const std::vector<unsigned char>& encoding_buffer) const noexcept {
-    return (((encoding_buffer[1] & 0x0F) << 2) | ((encoding_buffer[2] & 0xC0) >> 6));
+constexpr decoding_table_t MakeDecodingTable() {
+    decoding_table_t table{};
+    for(int i = 0; i < 256; ++i) {
+        table.values[i] = INVALID_SYMBOL;
+    }
+    for(int i = 0; i < 64; ++i) {
+        table.values[static_cast<unsigned char>(ENCODING_TABLE[i])] = static_cast<unsigned char>(i);
+    }
+    table.values[static_cast<unsigned char>(' ')] = WHITESPACE_SYMBOL;
+    table.values[static_cast<unsigned char>('\t')] = WHITESPACE_SYMBOL;
+    table.values[static_cast<unsigned char>('\r')] = WHITESPACE_SYMBOL;
+    table.values[static_cast<unsigned char>('\n')] = WHITESPACE_SYMBOL;
+    return table;
 }
 
-int Base64Encoder::GetFourthSymbolIndex(const std::vector<unsigned char>& encoding_buffer) const noexcept {
-    return (encoding_buffer[2] & 0x3F);
-}
+constexpr decoding_table_t DECODING_TABLE = MakeDecodingTable();
 
-//Gets the 6 most significant digits of the first byte.
-unsigned char Base64Encoder::GetFirstSymbol(const std::vector<unsigned char>& encoding_buffer) const noexcept {
-    return Base64Encoder::EncodingTable[Base64Encoder::GetFirstSymbolIndex(encoding_buffer)];
+Base64InstructionSet GetBestInstructionSet() {
+    if(CpuUtils::HasAVX2()) {
+        return Base64InstructionSet::AVX2;
+    }
+    if(CpuUtils::HasSSSE3()) {
+        return Base64InstructionSet::SSSE3;
+    }
+    return Base64InstructionSet::SCALAR;
 }
 
-//Gets the 2 least significant digits from previous (first) byte and 4 most significant from the second byte.
-unsigned char Base64Encoder::GetSecondSymbol(const std::vector<unsigned char>& encoding_buffer) const noexcept {
-    return Base64Encoder::EncodingTable[Base64Encoder::GetSecondSymbolIndex(encoding_buffer)];
+std::atomic<Base64InstructionSet>& GetInstructionSetStorage() {
+    static std::atomic<Base64InstructionSet> instruction_set(GetBestInstructionSet());
+    return instruction_set;
 }
 
-//Gets the 4 least significant digits from previous (second) byte and 2 least significant from the third byte.
-unsigned char Base64Encoder::GetThirdSymbol(const std::vector<unsigned char>& encoding_buffer) const noexcept {
-    return Base64Encoder::EncodingTable[Base64Encoder::GetThirdSymbolIndex(encoding_buffer)];
-}
+/************************************************************************/
+/* SCALAR                                                               */
+/************************************************************************/
 
-//Gets the 6 least significant digits from the third byte.
-unsigned char Base64Encoder::GetFourthSymbol(const std::vector<unsigned char>& encoding_buffer) const noexcept {
-    return Base64Encoder::EncodingTable[Base64Encoder::GetFourthSymbolIndex(encoding_buffer)];
+void EncodeTriple(const unsigned char* src, char* dst) {
+    uint32_t v = (uint32_t{ src[0] } << 16) | (uint32_t{ src[1] } << 8) | uint32_t{ src[2] };
+    dst[0] = ENCODING_TABLE[(v >> 18) & 0x3F];
+    dst[1] = ENCODING_TABLE[(v >> 12) & 0x3F];
+    dst[2] = ENCODING_TABLE[(v >> 6) & 0x3F];
+    dst[3] = ENCODING_TABLE[v & 0x3F];
 }
 
-std::string Base64Encoder::Encode(std::ifstream& file_input_stream) const noexcept {
-    if(!file_input_stream.is_open() || file_input_stream.fail()) {
-        return std::string{};
+//Encodes one or two trailing bytes with padding.
+void EncodeTail(const unsigned char* src, std::size_t size, char* dst) {
+    unsigned char group[3] = { src[0], size > 1 ? src[1] : static_cast<unsigned char>(0), 0 };
+    EncodeTriple(group, dst);
+    dst[3] = PADDING_CHAR;
+    if(size == 1) {
+        dst[2] = PADDING_CHAR;
     }
-    return Encode(static_cast<std::istream&>(file_input_stream));
 }
 
-std::string Base64Encoder::Encode(std::istream& input_stream) const noexcept {
+bool DecodeQuad(const char* src, unsigned char* dst) {
+    uint32_t a = DECODING_TABLE.values[static_cast<unsigned char>(src[0])];
+    uint32_t b = DECODING_TABLE.values[static_cast<unsigned char>(src[1])];
+    uint32_t c = DECODING_TABLE.values[static_cast<unsigned char>(src[2])];
+    uint32_t d = DECODING_TABLE.values[static_cast<unsigned char>(src[3])];
+    if(((a | b | c | d) & 0xC0) != 0) {
+        return false;
+    }
+    uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+    dst[0] = static_cast<unsigned char>(v >> 16);
+    dst[1] = static_cast<unsigned char>(v >> 8);
+    dst[2] = static_cast<unsigned char>(v);
+    return true;
+}
 
-    if(input_stream.fail()) {
-        return std::string{};
+//Decodes a final group of two or three symbols, optionally padded to four characters.
+bool DecodeTail(const char* src, std::size_t size, unsigned char* dst, std::size_t& out_size) {
+    std::size_t symbol_count = size;
+    if(size == 4) {
+        symbol_count = src[2] == PADDING_CHAR ? 2 : (src[3] == PADDING_CHAR ? 3 : 4);
+        if(symbol_count == 2 && src[3] != PADDING_CHAR) {
+            return false;
+        }
+    }
+    if(symbol_count < 2 || symbol_count > 3) {
+        return false;
+    }
+    uint32_t v = 0;
+    for(std::size_t i = 0; i < symbol_count; ++i) {
+        uint32_t symbol = DECODING_TABLE.values[static_cast<unsigned char>(src[i])];
+        if((symbol & 0xC0) != 0) {
+            return false;
+        }
+        v |= symbol << (18 - 6 * i);
+    }
+    dst[0] = static_cast<unsigned char>(v >> 16);
+    if(symbol_count == 3) {
+        dst[1] = static_cast<unsigned char>(v >> 8);
     }
+    out_size = symbol_count - 1;
+    return true;
+}
 
-    unsigned long file_size = 0;
-    std::vector<unsigned char> encoding_buffer = { '\0', '\0', '\0' };
+/************************************************************************/
+/* SSSE3                                                                */
+/************************************************************************/
 
-    input_stream.seekg(0, std::ios::end);
-    file_size = static_cast<unsigned long>(input_stream.tellg());
-    input_stream.seekg(0);
+//Maps 6-bit values to ASCII by adding a per-range offset chosen with pshufb.
+__m128i TranslateToAsciiSSSE3(const __m128i indices) {
+    const __m128i shift_lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52
+                                          , '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62
+                                          , '/' - 63, 'A', 0, 0);
+    __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+    result = _mm_shuffle_epi8(shift_lut, result);
+    return _mm_add_epi8(result, indices);
+}
 
-    std::string output(static_cast<unsigned long>(4 * std::ceil(file_size / 3.0)), '\0');
+//Spreads 12 bytes into 16 6-bit values.
+__m128i UnpackSSSE3(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
 
-    if(file_size == 0) {
-        output.clear();
-        input_stream.clear();
-        return output;
+//Reads 16 bytes per 12 encoded, so stops while at least 16 bytes remain.
+std::size_t EncodeSSSE3(const unsigned char* src, std::size_t size, char* dst) {
+    std::size_t consumed = 0;
+    while(size - consumed >= 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + consumed));
+        __m128i out = TranslateToAsciiSSSE3(UnpackSSSE3(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), out);
+        consumed += 12;
+        dst += 16;
     }
+    return consumed;
+}
 
-    while(input_stream.read(reinterpret_cast<char*>(encoding_buffer.data()), encoding_buffer.size())) {
-
-        char firstsymbol = GetFirstSymbol(encoding_buffer);
-        char secondsymbol = GetSecondSymbol(encoding_buffer);
-        char thirdsymbol = GetThirdSymbol(encoding_buffer);
-        char fourthsymbol = GetFourthSymbol(encoding_buffer);
+//Returns false without writing if any of the 16 characters is not in the alphabet.
+bool DecodeBlockSSSE3(const char* src, unsigned char* dst) {
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_2f = _mm_set1_epi8(0x2F);
+
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask_2f);
+    const __m128i lo_nibbles = _mm_and_si128(in, mask_2f);
+    const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+    const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+    if(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) {
+        return false;
+    }
+    const __m128i eq_2f = _mm_cmpeq_epi8(in, mask_2f);
+    const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+    in = _mm_add_epi8(in, roll);
+
+    //Pack the 16 6-bit values into 12 bytes.
+    in = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+    in = _mm_madd_epi16(in, _mm_set1_epi32(0x00011000));
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), in);
+    return true;
+}
 
-        unsigned long s = 4 * static_cast<unsigned long>(input_stream.tellg()) / 3;
+/************************************************************************/
+/* AVX2                                                                 */
+/************************************************************************/
 
-        output[s - 4] = firstsymbol;
-        output[s - 3] = secondsymbol;
-        output[s - 2] = thirdsymbol;
-        output[s - 1] = fourthsymbol;
+__m256i TranslateToAsciiAVX2(const __m256i indices) {
+    const __m256i shift_lut = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52
+                                             , '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62
+                                             , '/' - 63, 'A', 0, 0
+                                             , 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52
+                                             , '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62
+                                             , '/' - 63, 'A', 0, 0);
+    __m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    result = _mm256_shuffle_epi8(shift_lut, result);
+    return _mm256_add_epi8(result, indices);
+}
 
+//Each 128-bit lane takes 12 bytes so the SSSE3 unpacking applies per lane.
+std::size_t EncodeAVX2(const unsigned char* src, std::size_t size, char* dst) {
+    std::size_t consumed = 0;
+    while(size - consumed >= 28) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + consumed));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + consumed + 12));
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        in = _mm256_shuffle_epi8(in, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+                                                    , 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+        const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        __m256i out = TranslateToAsciiAVX2(_mm256_or_si256(t1, t3));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), out);
+        consumed += 24;
+        dst += 32;
     }
+    return consumed;
+}
 
-    output.erase(output.find_first_of('\0'));
+bool DecodeBlockAVX2(const char* src, unsigned char* dst) {
+    const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+                                          , 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+                                          , 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+                                            , 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+
+    __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask_2f);
+    const __m256i lo_nibbles = _mm256_and_si256(in, mask_2f);
+    const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+    const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+    if(!_mm256_testz_si256(lo, hi)) {
+        return false;
+    }
+    const __m256i eq_2f = _mm256_cmpeq_epi8(in, mask_2f);
+    const __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+    in = _mm256_add_epi8(in, roll);
+
+    in = _mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140));
+    in = _mm256_madd_epi16(in, _mm256_set1_epi32(0x00011000));
+    in = _mm256_shuffle_epi8(in, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+                                                , 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    //Close the gap between the two 12 byte lanes.
+    in = _mm256_permutevar8x32_epi32(in, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), in);
+    return true;
+}
 
-    if(input_stream.fail()) {
-        switch(input_stream.gcount()) {
-            case 0:
-                /* DO NOTHING. Evenly divisible by 4. */
-                break;
-            case 1:
-            {
-                /* Only one byte read */
-                encoding_buffer[2] = 0;
-                encoding_buffer[1] = 0;
-
-                char firstsymbol = GetFirstSymbol(encoding_buffer);
-                char secondsymbol = GetSecondSymbol(encoding_buffer);
-                char thirdsymbol = GetThirdSymbol(encoding_buffer);
-                char fourthsymbol = GetFourthSymbol(encoding_buffer);
-                (void)(thirdsymbol);
-                (void)(fourthsymbol);
-
-                output.push_back(firstsymbol);
-                output.push_back(secondsymbol);
-                output.push_back(Base64Encoder::PADDING_CHAR);
-                output.push_back(Base64Encoder::PADDING_CHAR);
+/************************************************************************/
+/* DISPATCH                                                             */
+/************************************************************************/
 
-                break;
-            } case 2:
-            {
-                /* Only two bytes read */
-                encoding_buffer[2] = 0;
-
-                char firstsymbol = GetFirstSymbol(encoding_buffer);
-                char secondsymbol = GetSecondSymbol(encoding_buffer);
-                char thirdsymbol = GetThirdSymbol(encoding_buffer);
-                char fourthsymbol = GetFourthSymbol(encoding_buffer);
-                (void)(fourthsymbol);
-
-                output.push_back(firstsymbol);
-                output.push_back(secondsymbol);
-                output.push_back(thirdsymbol);
-                output.push_back(Base64Encoder::PADDING_CHAR);
+//Encodes every whole group of size. Returns the bytes consumed.
+std::size_t EncodeGroups(const unsigned char* src, std::size_t size, char* dst) {
+    std::size_t consumed = 0;
+    auto instruction_set = GetInstructionSetStorage().load(std::memory_order_relaxed);
+    if(instruction_set == Base64InstructionSet::AVX2) {
+        consumed += EncodeAVX2(src, size, dst);
+    }
+    if(instruction_set != Base64InstructionSet::SCALAR) {
+        consumed += EncodeSSSE3(src + consumed, size - consumed, dst + consumed / 3 * 4);
+    }
+    for(; size - consumed >= 3; consumed += 3) {
+        EncodeTriple(src + consumed, dst + consumed / 3 * 4);
+    }
+    return consumed;
+}
 
-                break;
-            } case 3:
-                /* DO NOTHING All three bytes read. */
-                break;
-            default:
-                /* DO NOTHING */;
+//Decodes whole groups until the first one holding whitespace, padding or an invalid character.
+//Returns the characters consumed. The SIMD blocks store a few bytes past their output, so they
+//only run while enough input remains for dst (sized by GetMaxDecodedSize) to absorb the overrun.
+std::size_t DecodeGroups(const char* src, std::size_t size, unsigned char* dst) {
+    std::size_t consumed = 0;
+    auto instruction_set = GetInstructionSetStorage().load(std::memory_order_relaxed);
+    if(instruction_set == Base64InstructionSet::AVX2) {
+        while(size - consumed >= 44 && DecodeBlockAVX2(src + consumed, dst + consumed / 4 * 3)) {
+            consumed += 32;
         }
     }
-
-    input_stream.clear();
-
-    return output;
+    if(instruction_set != Base64InstructionSet::SCALAR) {
+        while(size - consumed >= 24 && DecodeBlockSSSE3(src + consumed, dst + consumed / 4 * 3)) {
+            consumed += 16;
+        }
+    }
+    while(size - consumed >= 4 && DecodeQuad(src + consumed, dst + consumed / 4 * 3)) {
+        consumed += 4;
+    }
+    return consumed;
 }
 
-std::string Base64Encoder::Encode(const std::string& str) const noexcept {
-    (void)str;
-    return std::string{};
+//The lookup the previous decoder performed per character. Kept for the benchmark comparison.
+bool DecodeWithMap(const std::string& encoded, std::string& output) {
+    static const std::map<char, int> decoding_map = []() {
+        std::map<char, int> m;
+        for(int i = 0; i < 64; ++i) {
+            m.emplace(ENCODING_TABLE[i], i);
+        }
+        return m;
+    }();
+    output.clear();
+    output.reserve(encoded.size() / 4 * 3);
+    for(std::size_t i = 0; i + 4 <= encoded.size(); i += 4) {
+        uint32_t v = 0;
+        std::size_t symbol_count = 0;
+        for(std::size_t j = 0; j < 4; ++j) {
+            auto found = decoding_map.find(encoded[i + j]);
+            if(found == decoding_map.end()) {
+                break;
+            }
+            v |= static_cast<uint32_t>(found->second) << (18 - 6 * j);
+            ++symbol_count;
+        }
+        for(std::size_t j = 0; j + 1 < symbol_count; ++j) {
+            output.push_back(static_cast<char>(v >> (16 - 8 * j)));
+        }
+    }
+    return true;
 }
 
-std::string Base64Encoder::Execute(std::ifstream& file_input_stream) const noexcept {
-    return Encode(file_input_stream);
 }
 
-std::string Base64Encoder::Execute(std::istream& input_stream) const noexcept {
-    return Encode(input_stream);
+void SetBase64InstructionSet(const Base64InstructionSet& instruction_set) {
+    auto best = GetBestInstructionSet();
+    GetInstructionSetStorage().store(instruction_set > best ? best : instruction_set);
 }
 
-std::string Base64Encoder::Execute(const std::string& str) const noexcept {
-    return Encode(str);
+Base64InstructionSet GetBase64InstructionSet() {
+    return GetInstructionSetStorage().load();
 }
 
 /************************************************************************/
-/* DECODER                                                              */
+/* ENCODER                                                              */
 /************************************************************************/
 
-const Base64Decoder::DecodingMap Base64Decoder::DecodingTable =
-{
-    { 'A', 0 },{ 'Q', 16 },{ 'g', 32 },{ 'w', 48 }
-    ,{ 'B', 1 },{ 'R', 17 },{ 'h', 33 },{ 'x', 49 }
-    ,{ 'C', 2 },{ 'S', 18 },{ 'i', 34 },{ 'y', 50 }
-    ,{ 'D', 3 },{ 'T', 19 },{ 'j', 35 },{ 'z', 51 }
-    ,{ 'E', 4 },{ 'U', 20 },{ 'k', 36 },{ '0', 52 }
-    ,{ 'F', 5 },{ 'V', 21 },{ 'l', 37 },{ '1', 53 }
-    ,{ 'G', 6 },{ 'W', 22 },{ 'm', 38 },{ '2', 54 }
-    ,{ 'H', 7 },{ 'X', 23 },{ 'n', 39 },{ '3', 55 }
-    ,{ 'I', 8 },{ 'Y', 24 },{ 'o', 40 },{ '4', 56 }
-    ,{ 'J', 9 },{ 'Z', 25 },{ 'p', 41 },{ '5', 57 }
-    ,{ 'K', 10 },{ 'a', 26 },{ 'q', 42 },{ '6', 58 }
-    ,{ 'L', 11 },{ 'b', 27 },{ 'r', 43 },{ '7', 59 }
-    ,{ 'M', 12 },{ 'c', 28 },{ 's', 44 },{ '8', 60 }
-    ,{ 'N', 13 },{ 'd', 29 },{ 't', 45 },{ '0', 61 }
-    ,{ 'O', 14 },{ 'e', 30 },{ 'u', 46 },{ '+', 62 }
-    ,{ 'P', 15 },{ 'f', 31 },{ 'v', 47 },{ '/', 63 }
-};
-
-const char Base64Decoder::PADDING_CHAR = '=';
-
-//First Byte is all 6 of first symbol and 2 most significant bits of second symbol.
-unsigned char Base64Decoder::GetFirstByte(const std::vector<unsigned char>& decoding_buffer) const noexcept {
-    auto first_iter = DecodingTable.find(decoding_buffer[0]);
-    auto second_iter = DecodingTable.find(decoding_buffer[1]);
-
-    int first_index;
-    if(first_iter == DecodingTable.end()) {
-        first_index = decoding_buffer[0];
-    } else {
-        first_index = (*first_iter).second;
-    }
+std::size_t Base64Encoder::GetEncodedSize(std::size_t byte_count) noexcept {
+    return (byte_count + 2) / 3 * 4;
+}
 
-    int second_index;
-    if(second_iter == DecodingTable.end()) {
-        second_index = decoding_buffer[1];
-    } else {
-        second_index = (*second_iter).second;
+std::size_t Base64Encoder::Encode(const unsigned char* src, std::size_t size, char* dst) noexcept {
+    std::size_t consumed = EncodeGroups(src, size, dst);
+    if(consumed < size) {
+        EncodeTail(src + consumed, size - consumed, dst + consumed / 3 * 4);
     }
-
-    first_index = (first_index & 0x3F) << 2;
-    second_index = (second_index & 0x30) >> 4;
-    auto result = static_cast<unsigned char>(first_index | second_index);
-    return result;
+    return GetEncodedSize(size);
 }
 
-//Second Byte is 4 least significant bits of second symbol and 4 most significant bits of third symbol.
-unsigned char Base64Decoder::GetSecondByte(const std::vector<unsigned char>& decoding_buffer) const noexcept {
-    auto second_iter = DecodingTable.find(decoding_buffer[1]);
-    auto third_iter = DecodingTable.find(decoding_buffer[2]);
-
-    int second_index;
-    if(second_iter == DecodingTable.end()) {
-        second_index = decoding_buffer[1];
-    } else {
-        second_index = (*second_iter).second;
+void Base64Encoder::Update(const void* data, std::size_t size, std::string& output) noexcept {
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+    if(_pending_count > 0) {
+        while(_pending_count < _pending.size() && size > 0) {
+            _pending[_pending_count++] = *bytes++;
+            --size;
+        }
+        if(_pending_count < _pending.size()) {
+            return;
+        }
+        char group[4];
+        EncodeTriple(_pending.data(), group);
+        output.append(group, sizeof(group));
+        _pending_count = 0;
     }
-
-    int third_index;
-    if(third_iter == DecodingTable.end()) {
-        third_index = decoding_buffer[2];
-    } else {
-        third_index = (*third_iter).second;
+    std::size_t whole_size = size / 3 * 3;
+    if(whole_size > 0) {
+        std::size_t offset = output.size();
+        output.resize(offset + whole_size / 3 * 4);
+        EncodeGroups(bytes, whole_size, &output[offset]);
+    }
+    for(std::size_t i = whole_size; i < size; ++i) {
+        _pending[_pending_count++] = bytes[i];
     }
-    second_index = (second_index & 0x0F) << 4;
-    third_index = (third_index & 0x3C) >> 2;
-    auto result = static_cast<unsigned char>(second_index | third_index);
-    return result;
 }
 
-//Third Byte is 2 least significant bits of third symbol and all of fourth symbol.
-unsigned char Base64Decoder::GetThirdByte(const std::vector<unsigned char>& decoding_buffer) const noexcept {
-    auto third_iter = DecodingTable.find(decoding_buffer[2]);
-    auto fourth_iter = DecodingTable.find(decoding_buffer[3]);
-
-    int third_index;
-    if(third_iter == DecodingTable.end()) {
-        third_index = decoding_buffer[2];
-    } else {
-        third_index = (*third_iter).second;
+void Base64Encoder::Finish(std::string& output) noexcept {
+    if(_pending_count > 0) {
+        char group[4];
+        EncodeTail(_pending.data(), _pending_count, group);
+        output.append(group, sizeof(group));
     }
+    Reset();
+}
 
-    int fourth_index;
-    if(fourth_iter == DecodingTable.end()) {
-        fourth_index = decoding_buffer[3];
-    } else {
-        fourth_index = (*fourth_iter).second;
-    }
+void Base64Encoder::Reset() noexcept {
+    _pending_count = 0;
+}
 
-    third_index = (third_index & 0x03) << 6;
-    fourth_index = fourth_index & 0x3F;
-    auto result = static_cast<unsigned char>(third_index | fourth_index);
-    return result;
+std::string Base64Encoder::Execute(std::ifstream& file_input_stream) const noexcept {
+    if(!file_input_stream.is_open()) {
+        return std::string{};
+    }
+    return Execute(static_cast<std::istream&>(file_input_stream));
 }
 
-std::string Base64Decoder::Decode(const std::string& file_path) const noexcept {
+std::string Base64Encoder::Execute(std::istream& input_stream) const noexcept {
+    if(input_stream.fail()) {
+        return std::string{};
+    }
+    Base64Encoder encoder;
     std::string output;
-    std::ifstream ifs;
-    ifs.open(file_path.c_str(), std::ios_base::binary);
-    try {
-        output = Decode(ifs);
-        ifs.close();
-    } catch(...) {
-        ifs.close();
+    std::vector<char> chunk(ENCODE_CHUNK_SIZE);
+    while(input_stream.read(chunk.data(), chunk.size()) || input_stream.gcount() > 0) {
+        encoder.Update(chunk.data(), static_cast<std::size_t>(input_stream.gcount()), output);
+        if(input_stream.eof()) {
+            break;
+        }
     }
+    encoder.Finish(output);
+    input_stream.clear();
     return output;
 }
 
-std::string Base64Decoder::Decode(std::istream& input_stream) const noexcept {
-
-    if(input_stream.fail()) return "";
-
-    unsigned long file_size = 0;
-    std::vector<unsigned char> decoding_buffer{ '\0', '\0', '\0', '\0' };
+std::string Base64Encoder::Execute(const std::string& str) const noexcept {
+    std::string output(GetEncodedSize(str.size()), '\0');
+    Encode(reinterpret_cast<const unsigned char*>(str.data()), str.size(), &output[0]);
+    return output;
+}
 
-    input_stream.seekg(0, std::ios::end);
-    file_size = static_cast<unsigned long>(input_stream.tellg());
-    input_stream.seekg(0);
+/************************************************************************/
+/* DECODER                                                              */
+/************************************************************************/
 
-    std::string output(static_cast<unsigned long>(3 * std::ceil(file_size / 4.0)) + (file_size % 3), '\0');
+std::size_t Base64Decoder::GetMaxDecodedSize(std::size_t char_count) noexcept {
+    return (char_count + 3) / 4 * 3;
+}
 
-    if(file_size == 0) {
-        output.clear();
-        input_stream.clear();
-        return "";
+bool Base64Decoder::Decode(const char* src, std::size_t size, unsigned char* dst, std::size_t& out_size) noexcept {
+    std::size_t consumed = DecodeGroups(src, size, dst);
+    out_size = consumed / 4 * 3;
+    if(consumed == size) {
+        return true;
     }
+    std::size_t tail_size = 0;
+    if(size - consumed > 4 || !DecodeTail(src + consumed, size - consumed, dst + out_size, tail_size)) {
+        return false;
+    }
+    out_size += tail_size;
+    return true;
+}
 
-    while(input_stream.read(reinterpret_cast<char*>(decoding_buffer.data()), decoding_buffer.size())) {
-
-        char firstbyte = GetFirstByte(decoding_buffer);
-        char secondbyte = GetSecondByte(decoding_buffer);
-        char thirdbyte = GetThirdByte(decoding_buffer);
-
-        unsigned long s = static_cast<unsigned long>(3 * std::ceil(static_cast<unsigned long>(input_stream.tellg()) / 4.0));
+bool Base64Decoder::Update(const char* data, std::size_t size, std::string& output) noexcept {
+    while(size > 0 && !_failed) {
+        if(_pending_count == 0 && !_padded) {
+            std::size_t offset = output.size();
+            output.resize(offset + GetMaxDecodedSize(size));
+            std::size_t consumed = DecodeGroups(data, size, reinterpret_cast<unsigned char*>(&output[offset]));
+            output.resize(offset + consumed / 4 * 3);
+            data += consumed;
+            size -= consumed;
+            if(size == 0) {
+                break;
+            }
+        }
+        //Slow path: one character at a time until the group in progress completes.
+        char c = *data++;
+        --size;
+        if(DECODING_TABLE.values[static_cast<unsigned char>(c)] == WHITESPACE_SYMBOL) {
+            continue;
+        }
+        if(_padded) {
+            _failed = true;
+            break;
+        }
+        _pending[_pending_count++] = c;
+        if(_pending_count == _pending.size() && !DecodePending(output)) {
+            _failed = true;
+        }
+    }
+    return !_failed;
+}
 
-        if(firstbyte != PADDING_CHAR) output[s - 3] = firstbyte;
-        if(secondbyte != PADDING_CHAR) output[s - 2] = secondbyte;
-        if(thirdbyte != PADDING_CHAR) output[s - 1] = thirdbyte;
+bool Base64Decoder::DecodePending(std::string& output) noexcept {
+    unsigned char bytes[3];
+    std::size_t byte_count = 3;
+    bool has_padding = std::find(_pending.begin(), _pending.begin() + _pending_count, PADDING_CHAR) != _pending.begin() + _pending_count;
+    if(_pending_count == 4 && !has_padding) {
+        if(!DecodeQuad(_pending.data(), bytes)) {
+            return false;
+        }
+    } else if(!DecodeTail(_pending.data(), _pending_count, bytes, byte_count)) {
+        return false;
+    }
+    output.append(reinterpret_cast<const char*>(bytes), byte_count);
+    _padded = has_padding;
+    _pending_count = 0;
+    return true;
+}
 
-        decoding_buffer[0] = '\0';
-        decoding_buffer[1] = '\0';
-        decoding_buffer[2] = '\0';
-        decoding_buffer[3] = '\0';
+bool Base64Decoder::Finish(std::string& output) noexcept {
+    bool succeeded = !_failed;
+    if(succeeded && _pending_count > 0) {
+        succeeded = DecodePending(output);
     }
+    Reset();
+    return succeeded;
+}
 
-    //Erase extraneous null chars.
-    output.erase(output.find_first_of('\0'));
+void Base64Decoder::Reset() noexcept {
+    _pending_count = 0;
+    _padded = false;
+    _failed = false;
+}
 
+std::string Base64Decoder::Execute(std::istream& input_stream) const noexcept {
     if(input_stream.fail()) {
-        if(decoding_buffer[2] == PADDING_CHAR) {
-            //Third character is PADDING_CHAR. Only one in decoding_buffer.
-            char firstbyte = GetFirstByte(decoding_buffer);
-            char secondbyte = GetSecondByte(decoding_buffer);
-            char thirdbyte = GetThirdByte(decoding_buffer);
-            output.push_back(firstbyte);
-            (void)(secondbyte);
-            (void)(thirdbyte);
-        } else if(decoding_buffer[3] == PADDING_CHAR) {
-            //Fourth character is PADDING_CHAR. Only two in decoding_buffer.
-            char firstbyte = GetFirstByte(decoding_buffer);
-            char secondbyte = GetSecondByte(decoding_buffer);
-            char thirdbyte = GetThirdByte(decoding_buffer);
-            output.push_back(firstbyte);
-            output.push_back(secondbyte);
-            (void)(thirdbyte);
-        } else {
-            /* DO NOTHING */
+        return std::string{};
+    }
+    Base64Decoder decoder;
+    std::string output;
+    std::vector<char> chunk(DECODE_CHUNK_SIZE);
+    bool succeeded = true;
+    while(succeeded && (input_stream.read(chunk.data(), chunk.size()) || input_stream.gcount() > 0)) {
+        succeeded = decoder.Update(chunk.data(), static_cast<std::size_t>(input_stream.gcount()), output);
+        if(input_stream.eof()) {
+            break;
         }
     }
+    succeeded = decoder.Finish(output) && succeeded;
     input_stream.clear();
-
-    return output;
+    return succeeded ? output : std::string{};
 }
 
-std::string Base64Decoder::Execute(std::istream& input_stream) const noexcept {
-    return Decode(input_stream);
+std::string Base64Decoder::Execute(const std::string& file_path) const noexcept {
+    std::ifstream ifs(file_path, std::ios_base::binary);
+    if(!ifs.is_open()) {
+        return std::string{};
+    }
+    return Execute(static_cast<std::istream&>(ifs));
 }
 
-std::string Base64Decoder::Execute(const std::string& file_path) const noexcept {
-    return Decode(file_path);
+/************************************************************************/
+/* BENCHMARK                                                            */
+/************************************************************************/
+
+void Base64Benchmark(std::size_t byte_count) {
+    std::vector<unsigned char> source(byte_count);
+    std::mt19937 rng(1729);
+    for(auto& b : source) {
+        b = static_cast<unsigned char>(rng());
+    }
+    auto megabytes_per_second = [byte_count](double seconds) { return seconds > 0.0 ? (byte_count / (1024.0 * 1024.0)) / seconds : 0.0; };
+
+    auto previous_instruction_set = GetBase64InstructionSet();
+    std::string encoded(Base64Encoder::GetEncodedSize(byte_count), '\0');
+    std::vector<unsigned char> decoded(Base64Decoder::GetMaxDecodedSize(encoded.size()));
+
+    const Base64InstructionSet instruction_sets[] = { Base64InstructionSet::SCALAR, Base64InstructionSet::SSSE3, Base64InstructionSet::AVX2 };
+    const char* instruction_set_names[] = { "Table", "SSSE3", "AVX2" };
+    for(std::size_t i = 0; i < 3; ++i) {
+        SetBase64InstructionSet(instruction_sets[i]);
+        if(GetBase64InstructionSet() != instruction_sets[i]) {
+            g_theFileLogger->LogTagf("test", "Base64 %s: not supported by this CPU.\n", instruction_set_names[i]);
+            continue;
+        }
+        double start = GetCurrentTimeSeconds();
+        Base64Encoder::Encode(source.data(), source.size(), &encoded[0]);
+        double encode_seconds = GetCurrentTimeSeconds() - start;
+
+        std::size_t decoded_size = 0;
+        start = GetCurrentTimeSeconds();
+        bool decoded_ok = Base64Decoder::Decode(encoded.data(), encoded.size(), decoded.data(), decoded_size);
+        double decode_seconds = GetCurrentTimeSeconds() - start;
+
+        bool matches = decoded_ok && decoded_size == source.size() && std::equal(source.begin(), source.end(), decoded.begin());
+        g_theFileLogger->LogTagf("test", "Base64 %s: encode %.1f MB/s, decode %.1f MB/s.%s\n"
+                                 , instruction_set_names[i], megabytes_per_second(encode_seconds), megabytes_per_second(decode_seconds)
+                                 , matches ? "" : " ROUND TRIP MISMATCH.");
+    }
+    SetBase64InstructionSet(previous_instruction_set);
+
+    std::string map_decoded;
+    double start = GetCurrentTimeSeconds();
+    DecodeWithMap(encoded, map_decoded);
+    double map_seconds = GetCurrentTimeSeconds() - start;
+    g_theFileLogger->LogTagf("test", "Base64 std::map lookup: decode %.1f MB/s.\n", megabytes_per_second(map_seconds));
 }
 
-}
\ No newline at end of file
+}
@@ -1,57 +1,86 @@
 #pragma once
 
+#include <array>
 #include <fstream>
 #include <istream>
-#include <map>
 #include <string>
-#include <vector>
 
 namespace DataUtils {
 
+//Code paths the codec dispatches between. The best one the CPU supports is used by default.
+enum class Base64InstructionSet {
+    SCALAR,
+    SSSE3,
+    AVX2,
+};
+
+//Requests above what the CPU supports are clamped. Used to compare code paths.
+void SetBase64InstructionSet(const Base64InstructionSet& instruction_set);
+Base64InstructionSet GetBase64InstructionSet();
+
 class Base64Encoder {
 public:
     Base64Encoder() = default;
     ~Base64Encoder() = default;
 
+    //Streams are read in fixed size chunks and never seeked, so pipes and sockets work.
     std::string Execute(std::ifstream& file_input_stream) const noexcept;
     std::string Execute(std::istream& input_stream) const noexcept;
     std::string Execute(const std::string& str) const noexcept;
 
+    //Streaming interface. Each Update appends every complete group to output;
+    //Finish appends the padded final group and resets the encoder.
+    void Update(const void* data, std::size_t size, std::string& output) noexcept;
+    void Finish(std::string& output) noexcept;
+    void Reset() noexcept;
+
+    static std::size_t GetEncodedSize(std::size_t byte_count) noexcept;
+
+    //dst must hold GetEncodedSize(size) characters. Returns the number of characters written.
+    static std::size_t Encode(const unsigned char* src, std::size_t size, char* dst) noexcept;
+
 protected:
 private:
-    static const std::vector<char> EncodingTable;
-    static const char PADDING_CHAR;
-
-    int GetFirstSymbolIndex(const std::vector<unsigned char>& encoding_buffer) const noexcept;
-    int GetSecondSymbolIndex(const std::vector<unsigned char>& encoding_buffer) const noexcept;
-    int GetThirdSymbolIndex(const std::vector<unsigned char>& encoding_buffer) const noexcept;
-    int GetFourthSymbolIndex(const std::vector<unsigned char>& encoding_buffer) const noexcept;
-    unsigned char GetFirstSymbol(const std::vector<unsigned char>& encoding_buffer) const noexcept;
-    unsigned char GetSecondSymbol(const std::vector<unsigned char>& encoding_buffer) const noexcept;
-    unsigned char GetThirdSymbol(const std::vector<unsigned char>& encoding_buffer) const noexcept;
-    unsigned char GetFourthSymbol(const std::vector<unsigned char>& encoding_buffer) const noexcept;
-    std::string Encode(std::ifstream& file_path) const noexcept;
-    std::string Encode(std::istream& input_stream) const noexcept;
-    std::string Encode(const std::string& str) const noexcept;
+    std::array<unsigned char, 3> _pending{};
+    std::size_t _pending_count = 0;
 };
 
 class Base64Decoder {
 public:
     Base64Decoder() = default;
     ~Base64Decoder() = default;
-    unsigned char GetFirstByte(const std::vector<unsigned char>& decoding_buffer) const noexcept;
-    unsigned char GetSecondByte(const std::vector<unsigned char>& decoding_buffer) const noexcept;
-    unsigned char GetThirdByte(const std::vector<unsigned char>& decoding_buffer) const noexcept;
-    std::string Decode(const std::string& file_path) const noexcept;
-    std::string Decode(std::istream& input_stream) const noexcept;
+
+    //Decodes the contents of the stream. Returns an empty string on ill-formed input.
     std::string Execute(std::istream& input_stream) const noexcept;
+
+    //Decodes the contents of the file at file_path.
     std::string Execute(const std::string& file_path) const noexcept;
+
+    //Streaming interface. Whitespace between characters is skipped.
+    //Returns false once an invalid character or data after the padding is seen.
+    bool Update(const char* data, std::size_t size, std::string& output) noexcept;
+
+    //Decodes an unpadded final group and resets the decoder. Returns false if the input was ill-formed.
+    bool Finish(std::string& output) noexcept;
+    void Reset() noexcept;
+
+    static std::size_t GetMaxDecodedSize(std::size_t char_count) noexcept;
+
+    //Decodes Base64 without whitespace. dst must hold GetMaxDecodedSize(size) bytes.
+    static bool Decode(const char* src, std::size_t size, unsigned char* dst, std::size_t& out_size) noexcept;
+
 protected:
 private:
-    using DecodingMap = std::map<char, int>;
-    static const char Base64Decoder::PADDING_CHAR;
-    static const Base64Decoder::DecodingMap Base64Decoder::DecodingTable;
+    bool DecodePending(std::string& output) noexcept;
 
+    std::array<char, 4> _pending{};
+    std::size_t _pending_count = 0;
+    bool _padded = false;
+    bool _failed = false;
 };
 
-}
\ No newline at end of file
+//Times the table driven and SIMD paths against per-character std::map lookups on byte_count random bytes.
+//Results are logged with the "test" tag.
+void Base64Benchmark(std::size_t byte_count);
+
+}
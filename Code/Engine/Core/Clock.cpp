@@ -0,0 +1,173 @@
+#include "Engine/Core/Clock.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Engine/Core/Time.hpp"
+
+namespace {
+
+int64_t s_max_frame_ticks = Clock::TICKS_PER_SECOND / 4;
+int64_t s_last_master_ticks = -1;
+
+}
+
+Clock::Clock(Clock* parent /*= nullptr*/)
+    : _parent(nullptr)
+    , _children{}
+    , _frame_ticks(0)
+    , _total_ticks(0)
+    , _frame_count(0)
+    , _scale(1.0)
+    , _scale_remainder(0.0)
+    , _paused(false)
+    , _step_requested(false)
+{
+    SetParent(parent);
+}
+
+Clock::~Clock() {
+    //Children keep running off this clock's parent.
+    for(auto child : _children) {
+        child->_parent = nullptr;
+        if(_parent) {
+            child->SetParent(_parent);
+        }
+    }
+    _children.clear();
+    SetParent(nullptr);
+}
+
+void Clock::AdvanceMasterClock() {
+    int64_t now = GetCurrentTimeNanoseconds();
+    if(s_last_master_ticks < 0) {
+        s_last_master_ticks = now;
+    }
+    int64_t elapsed = (std::min)(now - s_last_master_ticks, s_max_frame_ticks);
+    s_last_master_ticks = now;
+    GetMasterClock().Advance(elapsed);
+}
+
+void Clock::SetMaxFrameSeconds(double seconds) {
+    s_max_frame_ticks = (std::max)(SecondsToTicks(seconds), int64_t{ 0 });
+}
+
+Clock& Clock::GetMasterClock() {
+    static Clock master;
+    return master;
+}
+
+Clock& Clock::GetGameClock() {
+    static Clock game(&GetMasterClock());
+    return game;
+}
+
+Clock& Clock::GetUIClock() {
+    static Clock ui(&GetMasterClock());
+    return ui;
+}
+
+Clock& Clock::GetNetworkClock() {
+    static Clock network(&GetMasterClock());
+    return network;
+}
+
+void Clock::Advance(int64_t parent_ticks) {
+    int64_t ticks = 0;
+    if(!_paused || _step_requested) {
+        if(_scale == 1.0) {
+            ticks = parent_ticks;
+        } else {
+            double scaled = static_cast<double>(parent_ticks) * _scale + _scale_remainder;
+            double whole = std::floor(scaled);
+            _scale_remainder = scaled - whole;
+            ticks = static_cast<int64_t>(whole);
+        }
+        _step_requested = false;
+    }
+    _frame_ticks = ticks;
+    _total_ticks += ticks;
+    ++_frame_count;
+    for(auto child : _children) {
+        child->Advance(ticks);
+    }
+}
+
+void Clock::SetParent(Clock* parent) {
+    if(_parent) {
+        _parent->RemoveChild(this);
+    }
+    _parent = parent;
+    if(_parent) {
+        _parent->AddChild(this);
+    }
+}
+
+Clock* Clock::GetParent() const {
+    return _parent;
+}
+
+void Clock::Pause() {
+    _paused = true;
+}
+
+void Clock::Unpause() {
+    _paused = false;
+}
+
+void Clock::SetPaused(bool paused) {
+    _paused = paused;
+}
+
+bool Clock::IsPaused() const {
+    return _paused;
+}
+
+void Clock::StepSingleFrame() {
+    _step_requested = true;
+}
+
+void Clock::SetScale(double scale) {
+    _scale = (std::max)(scale, 0.0);
+    _scale_remainder = 0.0;
+}
+
+double Clock::GetScale() const {
+    return _scale;
+}
+
+int64_t Clock::GetFrameTicks() const {
+    return _frame_ticks;
+}
+
+int64_t Clock::GetTotalTicks() const {
+    return _total_ticks;
+}
+
+float Clock::GetFrameSeconds() const {
+    return static_cast<float>(TicksToSeconds(_frame_ticks));
+}
+
+double Clock::GetTotalSeconds() const {
+    return TicksToSeconds(_total_ticks);
+}
+
+uint64_t Clock::GetFrameCount() const {
+    return _frame_count;
+}
+
+double Clock::TicksToSeconds(int64_t ticks) {
+    return static_cast<double>(ticks) / static_cast<double>(TICKS_PER_SECOND);
+}
+
+int64_t Clock::SecondsToTicks(double seconds) {
+    return static_cast<int64_t>(std::llround(seconds * static_cast<double>(TICKS_PER_SECOND)));
+}
+
+void Clock::AddChild(Clock* child) {
+    _children.push_back(child);
+}
+
+void Clock::RemoveChild(Clock* child) {
+    _children.erase(std::remove(_children.begin(), _children.end(), child), _children.end());
+}
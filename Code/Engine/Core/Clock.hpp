@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//Game time in integer nanosecond ticks, so totals never drift or lose precision with uptime.
+//Clocks form a tree: each frame a clock receives its parent's scaled delta, applies its own
+//pause and time scale, and passes the result on to its children.
+//The master clock is driven by real time through AdvanceMasterClock; the game, UI and network
+//clocks are its children. Main thread only.
+class Clock {
+public:
+    static constexpr int64_t TICKS_PER_SECOND = 1000000000;
+
+    explicit Clock(Clock* parent = nullptr);
+    ~Clock();
+
+    Clock(const Clock& other) = delete;
+    Clock& operator=(const Clock& other) = delete;
+
+    //Advances the master clock, and every clock under it, by the real time since the last call.
+    //Call once at the start of each frame.
+    static void AdvanceMasterClock();
+    //Longest real frame the master clock accepts, so a breakpoint or hitch does not turn into
+    //a huge delta. Defaults to 0.25 seconds.
+    static void SetMaxFrameSeconds(double seconds);
+
+    static Clock& GetMasterClock();
+    static Clock& GetGameClock();
+    static Clock& GetUIClock();
+    static Clock& GetNetworkClock();
+
+    //Advances this clock and its children by parent_ticks of parent time.
+    void Advance(int64_t parent_ticks);
+
+    void SetParent(Clock* parent);
+    Clock* GetParent() const;
+
+    void Pause();
+    void Unpause();
+    void SetPaused(bool paused);
+    bool IsPaused() const;
+    //While paused, lets the next Advance through as a normal frame.
+    void StepSingleFrame();
+
+    //Negative scales are clamped to zero. Fractions of a tick are carried between frames.
+    void SetScale(double scale);
+    double GetScale() const;
+
+    int64_t GetFrameTicks() const;
+    int64_t GetTotalTicks() const;
+    float GetFrameSeconds() const;
+    double GetTotalSeconds() const;
+    uint64_t GetFrameCount() const;
+
+    static double TicksToSeconds(int64_t ticks);
+    static int64_t SecondsToTicks(double seconds);
+
+protected:
+private:
+    void AddChild(Clock* child);
+    void RemoveChild(Clock* child);
+
+    Clock* _parent;
+    std::vector<Clock*> _children;
+    int64_t _frame_ticks;
+    int64_t _total_ticks;
+    uint64_t _frame_count;
+    double _scale;
+    double _scale_remainder;
+    bool _paused;
+    bool _step_requested;
+};
@@ -0,0 +1,353 @@
+#include "Engine/Core/CompressedBinaryStream.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "Engine/EngineConfig.hpp"
+
+#include "Engine/Core/Compression.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
+
+namespace FileUtils {
+
+namespace {
+
+//Set in a block's stored size when the block did not compress and is stored as-is.
+constexpr uint32_t BLOCK_STORED_FLAG = 0x80000000u;
+constexpr std::size_t BLOCK_HEADER_SIZE = 2 * sizeof(uint32_t);
+constexpr std::size_t STREAM_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+}
+
+CompressedBinaryStream::CompressedBinaryStream(BinaryStream& inner, std::size_t block_size /*= DEFAULT_BLOCK_SIZE*/)
+    : BinaryStream()
+    , _inner(inner)
+    , _block_size((std::min)((std::max)(block_size, std::size_t{ 1 }), MAX_BLOCK_SIZE))
+{
+    stream_order = _inner.stream_order;
+}
+
+CompressedBinaryStream::~CompressedBinaryStream() {
+    if(_mode == Mode::WRITE) {
+        finish();
+    }
+}
+
+std::size_t CompressedBinaryStream::write_bytes(const void* buffer, const std::size_t size) const {
+    if(_mode == Mode::NONE) {
+        _mode = Mode::WRITE;
+        if(!WriteHeader()) {
+            _mode = Mode::FINISHED;
+        }
+    }
+    if(_mode != Mode::WRITE) {
+        return 0;
+    }
+    auto bytes = reinterpret_cast<const unsigned char*>(buffer);
+    std::size_t bytes_written = 0;
+    while(bytes_written < size) {
+        std::size_t count = (std::min)(size - bytes_written, _block_size - _block.size());
+        _block.insert(_block.end(), bytes + bytes_written, bytes + bytes_written + count);
+        bytes_written += count;
+        if(_block.size() == _block_size && !WriteBlock()) {
+            break;
+        }
+    }
+    _uncompressed_bytes += bytes_written;
+    return bytes_written;
+}
+
+std::size_t CompressedBinaryStream::read_bytes(void* out_buffer, const std::size_t count) {
+    if(_mode == Mode::NONE && !ReadHeader()) {
+        _mode = Mode::FINISHED;
+    }
+    if(_mode != Mode::READ) {
+        return 0;
+    }
+    auto bytes = reinterpret_cast<unsigned char*>(out_buffer);
+    std::size_t bytes_read = 0;
+    while(bytes_read < count) {
+        if(_block_read_position == _block.size()) {
+            if(_end_of_stream || !ReadBlock()) {
+                break;
+            }
+        }
+        std::size_t available = (std::min)(count - bytes_read, _block.size() - _block_read_position);
+        std::memcpy(bytes + bytes_read, _block.data() + _block_read_position, available);
+        _block_read_position += available;
+        bytes_read += available;
+    }
+    return bytes_read;
+}
+
+bool CompressedBinaryStream::is_seekable() const {
+    return _inner.is_seekable();
+}
+
+bool CompressedBinaryStream::seek_read(std::size_t position) {
+    if(_mode == Mode::NONE && !ReadHeader()) {
+        _mode = Mode::FINISHED;
+    }
+    if(_mode != Mode::READ || !_inner.is_seekable()) {
+        return false;
+    }
+    if(_block_uncompressed_offset <= position && position < _block_uncompressed_offset + _block.size()) {
+        _block_read_position = position - _block_uncompressed_offset;
+        return true;
+    }
+    if(!_index_built && !BuildIndex()) {
+        return false;
+    }
+    std::size_t stream_size = _index.empty() ? 0 : _index.back().uncompressed_offset + _index.back().uncompressed_size;
+    if(position >= stream_size) {
+        if(position > stream_size) {
+            return false;
+        }
+        _block.clear();
+        _block_read_position = 0;
+        _block_uncompressed_offset = stream_size;
+        _end_of_stream = true;
+        return true;
+    }
+    auto found = std::upper_bound(_index.begin(), _index.end(), position, [](std::size_t p, const block_index_t& b) { return p < b.uncompressed_offset; });
+    --found;
+    if(!_inner.seek_read(found->stream_offset)) {
+        return false;
+    }
+    _block.clear();
+    _block_read_position = 0;
+    _block_uncompressed_offset = found->uncompressed_offset;
+    _end_of_stream = false;
+    if(!ReadBlock()) {
+        return false;
+    }
+    _block_read_position = position - _block_uncompressed_offset;
+    return true;
+}
+
+std::size_t CompressedBinaryStream::tell_read() const {
+    return _block_uncompressed_offset + _block_read_position;
+}
+
+void CompressedBinaryStream::flush() const {
+    if(_mode == Mode::WRITE) {
+        WriteBlock();
+    }
+}
+
+void CompressedBinaryStream::finish() const {
+    if(_mode == Mode::NONE) {
+        _mode = Mode::WRITE;
+        if(!WriteHeader()) {
+            _mode = Mode::FINISHED;
+            return;
+        }
+    }
+    if(_mode != Mode::WRITE) {
+        return;
+    }
+    WriteBlock();
+    if(_inner.write(uint32_t{ 0 }) && _inner.write(uint32_t{ 0 })) {
+        _compressed_bytes += BLOCK_HEADER_SIZE;
+    }
+    _mode = Mode::FINISHED;
+}
+
+std::size_t CompressedBinaryStream::get_block_size() const {
+    return _block_size;
+}
+
+std::size_t CompressedBinaryStream::get_block_count() const {
+    return _block_count;
+}
+
+std::size_t CompressedBinaryStream::get_compressed_bytes() const {
+    return _compressed_bytes;
+}
+
+std::size_t CompressedBinaryStream::get_uncompressed_bytes() const {
+    return _uncompressed_bytes;
+}
+
+bool CompressedBinaryStream::WriteHeader() const {
+    if(!_inner.write(STREAM_MAGIC) || !_inner.write(static_cast<uint32_t>(_block_size))) {
+        return false;
+    }
+    _compressed_bytes += STREAM_HEADER_SIZE;
+    _block.reserve(_block_size);
+    return true;
+}
+
+bool CompressedBinaryStream::WriteBlock() const {
+    if(_block.empty()) {
+        return true;
+    }
+    _compressed.resize(Compression::CompressBound(_block.size()));
+    std::size_t compressed_size = Compression::CompressBlock(_block.data(), _block.size(), _compressed.data(), _compressed.size());
+    bool stored = compressed_size == 0 || compressed_size >= _block.size();
+    const unsigned char* payload = stored ? _block.data() : _compressed.data();
+    std::size_t payload_size = stored ? _block.size() : compressed_size;
+    uint32_t stored_size = static_cast<uint32_t>(payload_size) | (stored ? BLOCK_STORED_FLAG : 0u);
+    bool succeeded = _inner.write(static_cast<uint32_t>(_block.size()))
+                  && _inner.write(stored_size)
+                  && _inner.write_bytes(payload, payload_size) == payload_size;
+    _block.clear();
+    if(!succeeded) {
+        _mode = Mode::FINISHED;
+        return false;
+    }
+    ++_block_count;
+    _compressed_bytes += BLOCK_HEADER_SIZE + payload_size;
+    return true;
+}
+
+bool CompressedBinaryStream::ReadHeader() {
+    uint32_t magic = 0;
+    uint32_t block_size = 0;
+    if(!_inner.read(magic) || !_inner.read(block_size)) {
+        return false;
+    }
+    if(magic != STREAM_MAGIC || block_size == 0 || block_size > MAX_BLOCK_SIZE) {
+        return false;
+    }
+    _block_size = block_size;
+    _blocks_stream_offset = _inner.is_seekable() ? _inner.tell_read() : 0;
+    _compressed_bytes += STREAM_HEADER_SIZE;
+    _mode = Mode::READ;
+    return true;
+}
+
+bool CompressedBinaryStream::ReadBlock() {
+    std::size_t next_offset = _block_uncompressed_offset + _block.size();
+    uint32_t uncompressed_size = 0;
+    uint32_t stored_size = 0;
+    if(!_inner.read(uncompressed_size) || !_inner.read(stored_size) || uncompressed_size == 0) {
+        _end_of_stream = true;
+        return false;
+    }
+    bool stored = (stored_size & BLOCK_STORED_FLAG) != 0;
+    std::size_t payload_size = stored_size & ~BLOCK_STORED_FLAG;
+    if(uncompressed_size > _block_size || payload_size > Compression::CompressBound(uncompressed_size) || (stored && payload_size != uncompressed_size)) {
+        _end_of_stream = true;
+        return false;
+    }
+    _block.resize(uncompressed_size);
+    _block_read_position = 0;
+    _block_uncompressed_offset = next_offset;
+    bool succeeded = false;
+    if(stored) {
+        succeeded = _inner.read_bytes(_block.data(), payload_size) == payload_size;
+    } else {
+        _compressed.resize(payload_size);
+        succeeded = _inner.read_bytes(_compressed.data(), payload_size) == payload_size
+                 && Compression::DecompressBlock(_compressed.data(), payload_size, _block.data(), _block.size());
+    }
+    if(!succeeded) {
+        _block.clear();
+        _end_of_stream = true;
+        return false;
+    }
+    _compressed_bytes += BLOCK_HEADER_SIZE + payload_size;
+    _uncompressed_bytes += uncompressed_size;
+    return true;
+}
+
+bool CompressedBinaryStream::BuildIndex() {
+    std::size_t resume_position = _inner.tell_read();
+    if(!_inner.seek_read(_blocks_stream_offset)) {
+        return false;
+    }
+    _index.clear();
+    std::size_t uncompressed_offset = 0;
+    std::size_t stream_offset = _blocks_stream_offset;
+    bool succeeded = true;
+    for(;;) {
+        uint32_t uncompressed_size = 0;
+        uint32_t stored_size = 0;
+        if(!_inner.read(uncompressed_size) || !_inner.read(stored_size)) {
+            succeeded = false;
+            break;
+        }
+        if(uncompressed_size == 0) {
+            break;
+        }
+        block_index_t entry{};
+        entry.uncompressed_offset = uncompressed_offset;
+        entry.uncompressed_size = uncompressed_size;
+        entry.stream_offset = stream_offset;
+        _index.push_back(entry);
+        uncompressed_offset += uncompressed_size;
+        stream_offset += BLOCK_HEADER_SIZE + (stored_size & ~BLOCK_STORED_FLAG);
+        if(!_inner.seek_read(stream_offset)) {
+            succeeded = false;
+            break;
+        }
+    }
+    _inner.seek_read(resume_position);
+    _index_built = succeeded;
+    if(succeeded) {
+        _block_count = _index.size();
+    }
+    return succeeded;
+}
+
+void CompressedBinaryStreamBenchmark(const std::string& filepath, std::size_t block_size /*= CompressedBinaryStream::DEFAULT_BLOCK_SIZE*/) {
+    std::vector<unsigned char> source;
+    if(!ReadBufferFromDisk(source, filepath) || source.empty()) {
+        g_theFileLogger->LogTagf("test", "Compression benchmark: could not read %s.\n", filepath.c_str());
+        return;
+    }
+    std::string compressed_filepath = filepath + ".lzbs";
+
+    double encode_seconds = 0.0;
+    std::size_t compressed_size = 0;
+    {
+        FileBinaryStream file;
+        if(!file.open_for_write(compressed_filepath)) {
+            g_theFileLogger->LogTagf("test", "Compression benchmark: could not create %s.\n", compressed_filepath.c_str());
+            return;
+        }
+        CompressedBinaryStream stream(file, block_size);
+        double start = GetCurrentTimeSeconds();
+        stream.write_bytes(source.data(), source.size());
+        stream.finish();
+        encode_seconds = GetCurrentTimeSeconds() - start;
+        compressed_size = stream.get_compressed_bytes();
+    }
+
+    std::vector<unsigned char> decoded(source.size());
+    double raw_seconds = 0.0;
+    {
+        FileBinaryStream file;
+        if(file.open_for_read(filepath)) {
+            double start = GetCurrentTimeSeconds();
+            file.read_bytes(decoded.data(), decoded.size());
+            raw_seconds = GetCurrentTimeSeconds() - start;
+        }
+    }
+
+    std::fill(decoded.begin(), decoded.end(), static_cast<unsigned char>(0));
+    double decode_seconds = 0.0;
+    {
+        FileBinaryStream file;
+        if(file.open_for_read(compressed_filepath)) {
+            CompressedBinaryStream stream(file);
+            double start = GetCurrentTimeSeconds();
+            stream.read_bytes(decoded.data(), decoded.size());
+            decode_seconds = GetCurrentTimeSeconds() - start;
+        }
+    }
+    std::remove(compressed_filepath.c_str());
+
+    bool matches = decoded == source;
+    auto megabytes_per_second = [&source](double seconds) { return seconds > 0.0 ? (source.size() / (1024.0 * 1024.0)) / seconds : 0.0; };
+    g_theFileLogger->LogTagf("test", "Compression benchmark: %s %zu -> %zu bytes (%.1f%%) with %zu byte blocks.\n"
+                             , filepath.c_str(), source.size(), compressed_size, 100.0 * compressed_size / source.size(), block_size);
+    g_theFileLogger->LogTagf("test", "Encode %.1f MB/s. Raw read %.1f MB/s. Compressed read %.1f MB/s.%s\n"
+                             , megabytes_per_second(encode_seconds), megabytes_per_second(raw_seconds), megabytes_per_second(decode_seconds)
+                             , matches ? "" : " DECODED DATA MISMATCH.");
+}
+
+}
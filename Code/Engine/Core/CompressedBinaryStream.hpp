@@ -0,0 +1,89 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Engine/Core/FileUtils.hpp"
+
+namespace FileUtils {
+
+//Block-compresses everything written through it into an inner stream and
+//decompresses on read. Each block is compressed independently so a seekable
+//inner stream allows random access without decoding earlier blocks.
+//A stream is used for either reading or writing, decided by the first call.
+class CompressedBinaryStream : public BinaryStream {
+public:
+    static constexpr uint32_t STREAM_MAGIC = 0x53425A4C; //'LZBS'
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64u * 1024u;
+    static constexpr std::size_t MAX_BLOCK_SIZE = 4u * 1024u * 1024u;
+
+    //block_size is ignored when reading; the writer's block size is stored in the stream header.
+    explicit CompressedBinaryStream(BinaryStream& inner, std::size_t block_size = DEFAULT_BLOCK_SIZE);
+
+    //Calls finish() on write streams.
+    virtual ~CompressedBinaryStream();
+
+    virtual std::size_t read_bytes(void* out_buffer, const std::size_t count) override;
+    virtual std::size_t write_bytes(const void* buffer, const std::size_t size) const override;
+
+    //Seeks by uncompressed position. Requires a seekable inner stream.
+    virtual bool is_seekable() const override;
+    virtual bool seek_read(std::size_t position) override;
+    virtual std::size_t tell_read() const override;
+
+    //Emits the partially filled block. Frequent flushes hurt the compression ratio.
+    void flush() const;
+
+    //Flushes and writes the end of stream marker. Further writes are ignored.
+    void finish() const;
+
+    std::size_t get_block_size() const;
+
+    //Blocks written so far. Read streams know their block count once a seek has indexed them.
+    std::size_t get_block_count() const;
+
+    std::size_t get_compressed_bytes() const;
+    std::size_t get_uncompressed_bytes() const;
+
+protected:
+private:
+    enum class Mode {
+        NONE,
+        READ,
+        WRITE,
+        FINISHED,
+    };
+
+    struct block_index_t {
+        std::size_t uncompressed_offset = 0;
+        std::size_t uncompressed_size = 0;
+        std::size_t stream_offset = 0;
+    };
+
+    bool WriteHeader() const;
+    bool WriteBlock() const;
+    bool ReadHeader();
+    bool ReadBlock();
+    bool BuildIndex();
+
+    BinaryStream& _inner;
+    mutable Mode _mode = Mode::NONE;
+    mutable std::size_t _block_size = DEFAULT_BLOCK_SIZE;
+    mutable std::vector<unsigned char> _block{};
+    mutable std::vector<unsigned char> _compressed{};
+    mutable std::size_t _block_count = 0;
+    mutable std::size_t _compressed_bytes = 0;
+    mutable std::size_t _uncompressed_bytes = 0;
+    std::size_t _block_read_position = 0;
+    std::size_t _block_uncompressed_offset = 0;
+    std::size_t _blocks_stream_offset = 0;
+    std::vector<block_index_t> _index{};
+    bool _index_built = false;
+    bool _end_of_stream = false;
+};
+
+//Compresses filepath to a temporary file then times decoding it against reading the raw file.
+//Results are logged with the "test" tag.
+void CompressedBinaryStreamBenchmark(const std::string& filepath, std::size_t block_size = CompressedBinaryStream::DEFAULT_BLOCK_SIZE);
+
+}
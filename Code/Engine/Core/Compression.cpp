@@ -0,0 +1,179 @@
+#include "Engine/Core/Compression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace Compression {
+
+namespace {
+
+constexpr std::size_t MIN_MATCH = 4;
+constexpr std::size_t LAST_LITERALS = 5;
+constexpr std::size_t MATCH_FIND_LIMIT = 12;
+constexpr std::size_t MAX_OFFSET = 65535;
+constexpr unsigned int HASH_LOG = 12;
+constexpr unsigned int SKIP_TRIGGER = 6;
+
+uint32_t Read32(const unsigned char* p) {
+    uint32_t v = 0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_LOG);
+}
+
+unsigned char* WriteLength(unsigned char* op, std::size_t length) {
+    length -= 15;
+    while(length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<unsigned char>(length);
+    return op;
+}
+
+bool ReadLength(const unsigned char*& ip, const unsigned char* iend, std::size_t& length) {
+    unsigned char b = 0;
+    do {
+        if(ip >= iend) {
+            return false;
+        }
+        b = *ip++;
+        length += b;
+    } while(b == 255);
+    return true;
+}
+
+unsigned char* WriteSequence(unsigned char* op, const unsigned char* anchor, std::size_t literal_length, std::size_t offset, std::size_t match_length) {
+    unsigned char* token = op++;
+    *token = static_cast<unsigned char>((std::min)(literal_length, std::size_t{ 15 }) << 4);
+    if(literal_length >= 15) {
+        op = WriteLength(op, literal_length);
+    }
+    std::memcpy(op, anchor, literal_length);
+    op += literal_length;
+    if(offset == 0) {
+        return op;
+    }
+    *op++ = static_cast<unsigned char>(offset & 0xFF);
+    *op++ = static_cast<unsigned char>((offset >> 8) & 0xFF);
+    *token |= static_cast<unsigned char>((std::min)(match_length, std::size_t{ 15 }));
+    if(match_length >= 15) {
+        op = WriteLength(op, match_length);
+    }
+    return op;
+}
+
+}
+
+std::size_t CompressBound(std::size_t src_size) {
+    return src_size + (src_size / 255) + 16;
+}
+
+std::size_t CompressBlock(const unsigned char* src, std::size_t src_size, unsigned char* dst, std::size_t dst_capacity) {
+    if(dst_capacity < CompressBound(src_size)) {
+        return 0;
+    }
+    const unsigned char* ip = src;
+    const unsigned char* anchor = src;
+    const unsigned char* const iend = src + src_size;
+    unsigned char* op = dst;
+
+    if(src_size > MATCH_FIND_LIMIT) {
+        std::array<uint32_t, 1u << HASH_LOG> table{};
+        const unsigned char* const match_limit = iend - MATCH_FIND_LIMIT;
+        const unsigned char* const match_end_limit = iend - LAST_LITERALS;
+        unsigned int misses = 0;
+        while(ip < match_limit) {
+            uint32_t sequence = Read32(ip);
+            uint32_t h = Hash(sequence);
+            const unsigned char* candidate = src + table[h];
+            table[h] = static_cast<uint32_t>(ip - src);
+            if(candidate >= ip || static_cast<std::size_t>(ip - candidate) > MAX_OFFSET || Read32(candidate) != sequence) {
+                //Step faster through data that refuses to compress.
+                ip += 1 + (misses++ >> SKIP_TRIGGER);
+                continue;
+            }
+            misses = 0;
+            while(ip > anchor && candidate > src && ip[-1] == candidate[-1]) {
+                --ip;
+                --candidate;
+            }
+            const unsigned char* match_end = ip + MIN_MATCH;
+            const unsigned char* candidate_end = candidate + MIN_MATCH;
+            while(match_end < match_end_limit && *match_end == *candidate_end) {
+                ++match_end;
+                ++candidate_end;
+            }
+            std::size_t literal_length = static_cast<std::size_t>(ip - anchor);
+            std::size_t match_length = static_cast<std::size_t>(match_end - ip) - MIN_MATCH;
+            op = WriteSequence(op, anchor, literal_length, static_cast<std::size_t>(ip - candidate), match_length);
+            ip = match_end;
+            anchor = ip;
+            if(ip - 2 > src && ip < match_limit) {
+                table[Hash(Read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - src);
+            }
+        }
+    }
+
+    op = WriteSequence(op, anchor, static_cast<std::size_t>(iend - anchor), 0, 0);
+    return static_cast<std::size_t>(op - dst);
+}
+
+bool DecompressBlock(const unsigned char* src, std::size_t src_size, unsigned char* dst, std::size_t dst_size) {
+    const unsigned char* ip = src;
+    const unsigned char* const iend = src + src_size;
+    unsigned char* op = dst;
+    unsigned char* const oend = dst + dst_size;
+
+    while(ip < iend) {
+        unsigned char token = *ip++;
+        std::size_t literal_length = token >> 4;
+        if(literal_length == 15 && !ReadLength(ip, iend, literal_length)) {
+            return false;
+        }
+        if(literal_length > static_cast<std::size_t>(iend - ip) || literal_length > static_cast<std::size_t>(oend - op)) {
+            return false;
+        }
+        std::memcpy(op, ip, literal_length);
+        op += literal_length;
+        ip += literal_length;
+        if(ip == iend) {
+            break;
+        }
+
+        if(iend - ip < 2) {
+            return false;
+        }
+        std::size_t offset = static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+        if(offset == 0 || offset > static_cast<std::size_t>(op - dst)) {
+            return false;
+        }
+        std::size_t match_length = token & 0x0F;
+        if(match_length == 15 && !ReadLength(ip, iend, match_length)) {
+            return false;
+        }
+        match_length += MIN_MATCH;
+        if(match_length > static_cast<std::size_t>(oend - op)) {
+            return false;
+        }
+        const unsigned char* match = op - offset;
+        if(offset >= match_length) {
+            std::memcpy(op, match, match_length);
+            op += match_length;
+        } else {
+            //Overlapping copy repeats the last 'offset' bytes.
+            for(std::size_t i = 0; i < match_length; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+    return op == oend;
+}
+
+}
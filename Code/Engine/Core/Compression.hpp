@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+//LZ4 block format compatible compressor and decompressor.
+//Blocks carry no framing; the caller stores the raw size alongside the compressed bytes.
+namespace Compression {
+
+//Worst case compressed size of src_size bytes.
+std::size_t CompressBound(std::size_t src_size);
+
+//Returns the number of bytes written to dst or 0 if dst_capacity is smaller than CompressBound(src_size).
+std::size_t CompressBlock(const unsigned char* src, std::size_t src_size, unsigned char* dst, std::size_t dst_capacity);
+
+//Returns false on malformed input or if the decompressed size is not exactly dst_size.
+bool DecompressBlock(const unsigned char* src, std::size_t src_size, unsigned char* dst, std::size_t dst_size);
+
+}
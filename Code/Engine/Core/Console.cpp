@@ -2,43 +2,80 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <iterator>
 #include <filesystem>
 #include <locale>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <thread>
 
 #include "Engine/BuildConfig.cpp"
 
+#include "Engine/Core/Base64.hpp"
+#include "Engine/Core/CompressedBinaryStream.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
 #include "Engine/Core/KerningFont.hpp"
 #include "Engine/Core/Memory.hpp"
+#include "Engine/Core/PackFile.hpp"
+#include "Engine/Core/StringUtils.hpp"
 
 #include "Engine/EngineConfig.hpp"
 
 #include "Engine/Input/InputSystem.hpp"
 
+#include "Engine/RHI/RHIDevice.hpp"
+
+#include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/SimpleRenderer.hpp"
 #include "Engine/Renderer/Texture2D.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
 
 #include "Engine/Math/Vector3.hpp"
 #include "Engine/Math/Vector4.hpp"
 #include "Engine/Math/IntVector2.hpp"
 #include "Engine/Math/IntVector3.hpp"
 #include "Engine/Math/IntVector4.hpp"
+#include "Engine/Math/DynamicAABB3Tree.hpp"
+#include "Engine/Math/FrustumCuller.hpp"
 #include "Engine/Math/Matrix4.hpp"
+#include "Engine/Math/Noise.hpp"
+#include "Engine/Math/Quaternion.hpp"
+#include "Engine/Math/RandomEngine.hpp"
+#include "Engine/Math/SpatialHashGrid2.hpp"
 
 #include "Engine/Networking/Address.hpp"
 
 Event<const std::string&> Console::OnMessagePrint;
 
+//Output lines kept for display. Older lines are overwritten.
+const std::size_t MAX_OUTPUT_LINES = 1024;
+
 Console::Console(SimpleRenderer* renderer, KerningFont* font, const Vector2& topleft)
-    : output_buffer{}
+    : _output_lines(MAX_OUTPUT_LINES)
+    , _output_head(0)
+    , _output_count(0)
+    , _output_vbo_data{}
+    , _output_ibo_data{}
+    , _output_vbo(nullptr)
+    , _output_ibo(nullptr)
+    , _output_vbo_capacity(0)
+    , _output_ibo_capacity(0)
+    , _output_index_count(0)
+    , _output_dirty(false)
     , entryline_buffer{}
     , entryline()
     , caretPos()
     , selectPos()
+    , _commands()
+    , _autocomplete_candidates{}
+    , _autocomplete_prefix()
+    , _autocomplete_index(std::string::npos)
+    , _autocomplete_fuzzy(false)
+    , _autocomplete_valid(false)
     , _renderer(renderer)
     , _font(font)
     , _topleft(topleft)
@@ -52,6 +89,10 @@ Console::Console(SimpleRenderer* renderer, KerningFont* font, const Vector2& top
 { /* DO NOTHING */ }
 
 Console::~Console() {
+    delete _output_vbo;
+    _output_vbo = nullptr;
+    delete _output_ibo;
+    _output_ibo = nullptr;
     _font = nullptr; //Observing pointer
 }
 
@@ -325,18 +366,196 @@ void Console::SaveEntrylineToBuffer() {
     }
 }
 
+namespace {
+
+//Scores pattern as an in-order subsequence of candidate, or returns -1 if it is not one.
+//Runs of consecutive characters and characters starting a word score higher; skipped characters cost.
+int FuzzyMatchScore(std::string_view pattern, std::string_view candidate) {
+    int score = 0;
+    std::size_t last = std::string_view::npos;
+    std::size_t c = 0;
+    for(char p : pattern) {
+        const auto lower_p = std::tolower(static_cast<unsigned char>(p));
+        while(c < candidate.size() && std::tolower(static_cast<unsigned char>(candidate[c])) != lower_p) {
+            ++c;
+        }
+        if(c == candidate.size()) {
+            return -1;
+        }
+        if(last != std::string_view::npos && c == last + 1) {
+            score += 5;
+        }
+        if(c == 0 || candidate[c - 1] == '_') {
+            score += 3;
+        }
+        score -= static_cast<int>(last == std::string_view::npos ? c : c - last - 1);
+        last = c++;
+    }
+    return score;
+}
+
+}
+
 void Console::AutoCompleteEntryLine() {
-    for(auto& cmd_string : _commands) {
-        if(cmd_string.first.find(entryline) == 0) {
-            SetEntryline(cmd_string.first);
-            break;
+    const bool cycling = _autocomplete_index < _autocomplete_candidates.size()
+                         && entryline == _autocomplete_candidates[_autocomplete_index];
+    if(cycling) {
+        const std::size_t count = _autocomplete_candidates.size();
+        _autocomplete_index = (_autocomplete_index + (_shiftModifier ? count - 1 : 1)) % count;
+    } else {
+        UpdateAutoCompleteCandidates();
+        if(_autocomplete_candidates.empty()) {
+            return;
+        }
+        _autocomplete_index = 0;
+    }
+    SetEntryline(_autocomplete_candidates[_autocomplete_index]);
+}
+
+void Console::UpdateAutoCompleteCandidates() {
+    //Only the command name completes; once arguments are being typed there is nothing to offer.
+    std::string_view prefix = entryline;
+    if(prefix.find(' ') != std::string_view::npos) {
+        prefix = std::string_view{};
+    }
+    if(_autocomplete_valid && prefix == _autocomplete_prefix) {
+        return;
+    }
+    const bool extends_previous = _autocomplete_valid
+                                  && !_autocomplete_fuzzy
+                                  && !_autocomplete_candidates.empty()
+                                  && prefix.size() > _autocomplete_prefix.size()
+                                  && prefix.substr(0, _autocomplete_prefix.size()) == _autocomplete_prefix;
+    _autocomplete_prefix = prefix;
+    _autocomplete_index = std::string::npos;
+    _autocomplete_valid = true;
+    if(prefix.empty()) {
+        _autocomplete_candidates.clear();
+        return;
+    }
+    //Typing more of a prefix only narrows the ranked list, so filter it instead of searching again.
+    if(extends_previous) {
+        auto not_prefixed = [prefix](const std::string& name) { return name.compare(0, prefix.size(), prefix) != 0; };
+        _autocomplete_candidates.erase(std::remove_if(_autocomplete_candidates.begin(), _autocomplete_candidates.end(), not_prefixed), _autocomplete_candidates.end());
+        if(!_autocomplete_candidates.empty()) {
+            return;
+        }
+    }
+    _autocomplete_candidates.clear();
+    _autocomplete_fuzzy = false;
+    _commands.ForEachWithPrefix(prefix, [this](std::string_view name, const command_t& /*command*/) {
+        _autocomplete_candidates.emplace_back(name);
+    });
+    if(!_autocomplete_candidates.empty()) {
+        //Already alphabetical; the stable sort keeps that order between equally used commands.
+        std::stable_sort(_autocomplete_candidates.begin(), _autocomplete_candidates.end(), [this](const std::string& a, const std::string& b) {
+            return _commands.Find(a)->use_count > _commands.Find(b)->use_count;
+        });
+        return;
+    }
+    _autocomplete_fuzzy = true;
+    std::vector<std::pair<int, std::string>> scored{};
+    _commands.ForEach([prefix, &scored](std::string_view name, const command_t& command) {
+        int score = FuzzyMatchScore(prefix, name);
+        if(score >= 0) {
+            scored.emplace_back(score + static_cast<int>(command.use_count), std::string(name));
         }
+    });
+    std::stable_sort(scored.begin(), scored.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    for(auto& candidate : scored) {
+        _autocomplete_candidates.push_back(std::move(candidate.second));
     }
 }
 
+void Console::InvalidateAutoCompleteCandidates() {
+    _autocomplete_valid = false;
+    _autocomplete_index = std::string::npos;
+    _autocomplete_candidates.clear();
+}
+
 void Console::OutputMsg(const std::string& msg, const Rgba& color) {
     OnMessagePrint.Trigger(msg);
-    output_buffer.push_back(std::make_pair(msg, color));
+    if(msg.empty()) {
+        return;
+    }
+    std::string_view text = msg;
+    if(text.back() == '\n') {
+        text.remove_suffix(1);
+    }
+    for(const auto& line : SplitView(text, '\n', false)) {
+        PushOutputLine(line, color);
+    }
+}
+
+void Console::PushOutputLine(std::string_view text, const Rgba& color) {
+    output_line_t& line = _output_lines[_output_head];
+    line.text.assign(text.data(), text.size());
+    line.color = color;
+    line.glyphs.clear();
+    _output_head = (_output_head + 1) % _output_lines.size();
+    _output_count = (std::min)(_output_count + 1, _output_lines.size());
+    _output_dirty = true;
+}
+
+//Age 0 is the newest line.
+Console::output_line_t& Console::GetOutputLine(std::size_t age) {
+    return _output_lines[(_output_head + _output_lines.size() - 1 - age) % _output_lines.size()];
+}
+
+void Console::ClearOutputBuffer() {
+    for(auto& line : _output_lines) {
+        std::vector<Vertex3D>().swap(line.glyphs);
+    }
+    _output_count = 0;
+    _output_dirty = true;
+}
+
+void Console::UpdateOutputGeometry() {
+    _output_dirty = false;
+    _output_vbo_data.clear();
+    _output_ibo_data.clear();
+
+    float line_height = static_cast<float>(_font->GetLineHeight());
+    auto visible_count = (std::min)(_output_count, static_cast<std::size_t>(std::ceil(_topleft.y / line_height)) + 1);
+    for(std::size_t age = 0; age < _output_count; ++age) {
+        output_line_t& line = GetOutputLine(age);
+        if(visible_count <= age) {
+            //Only on-screen lines hold quads.
+            if(!line.glyphs.empty()) {
+                std::vector<Vertex3D>().swap(line.glyphs);
+            }
+            continue;
+        }
+        if(line.glyphs.empty()) {
+            _renderer->AppendTextLine(_font, line.text, line.color, 0.0f, 0.0f, line.glyphs);
+        }
+        Vector3 offset(_topleft.x, _topleft.y - line_height * (age + 1), 0.0f);
+        std::size_t first_vertex = _output_vbo_data.size();
+        for(auto vertex : line.glyphs) {
+            vertex.position += offset;
+            _output_vbo_data.push_back(vertex);
+        }
+        SimpleRenderer::AppendQuadIndices(first_vertex, line.glyphs.size() / 4, _output_ibo_data);
+    }
+
+    _output_index_count = _output_ibo_data.size();
+    if(_output_index_count == 0) {
+        return;
+    }
+    if(_output_vbo_capacity < _output_vbo_data.size()) {
+        delete _output_vbo;
+        _output_vbo = _renderer->_rhi_device->CreateVertexBuffer(_output_vbo_data, BufferUsage::DYNAMIC, BufferBindUsage::VERTEX_BUFFER);
+        _output_vbo_capacity = _output_vbo_data.size();
+    } else {
+        _output_vbo->Update(_renderer->_rhi_context, _output_vbo_data);
+    }
+    if(_output_ibo_capacity < _output_ibo_data.size()) {
+        delete _output_ibo;
+        _output_ibo = _renderer->_rhi_device->CreateIndexBuffer(_output_ibo_data, BufferUsage::DYNAMIC, BufferBindUsage::INDEX_BUFFER);
+        _output_ibo_capacity = _output_ibo_data.size();
+    } else {
+        _output_ibo->Update(_renderer->_rhi_context, _output_ibo_data);
+    }
 }
 
 int Console::UpdateSelectedRange(int direction) {
@@ -452,7 +671,7 @@ void Console::RegisterCommands() {
 
     RegisterCommand("clear",
     [&](const std::string& /*args*/) {
-        output_buffer.clear(); entryline.clear();
+        ClearOutputBuffer(); entryline.clear();
     }, "Clears the screen.");
     
     RegisterCommand("quit",
@@ -464,19 +683,11 @@ void Console::RegisterCommands() {
     [&](const std::string& args) {
         Arguments arg_set(args);
         std::string start;
-        if(arg_set.GetNext(start)) {
-            RunCommand("clear");
-            for(auto& command : _commands) {
-                if(command.first.find(start) == 0) {
-                    this->NotifyMsg(command.first + ": " + command.second.second);
-                }
-            }
-        } else {
-            RunCommand("clear");
-            for(auto& command : _commands) {
-                this->NotifyMsg(command.first + ": " + command.second.second);
-            }
-        }
+        arg_set.GetNext(start);
+        RunCommand("clear");
+        _commands.ForEachWithPrefix(start, [this](std::string_view name, const command_t& command) {
+            this->NotifyMsg(std::string(name) + ": " + command.help_text);
+        });
     }
     , "Displays all available commands or commands starting with specific string.");
 
@@ -507,6 +718,158 @@ void Console::RegisterCommands() {
     }
     , "Launches a separate process.");
 
+    RegisterCommand("pack_mount",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        std::string pack_filepath;
+        if(!arg_set.GetNext(pack_filepath)) {
+            this->WarnMsg("No pack file specified.");
+            return;
+        }
+        if(FileUtils::MountPackFile(pack_filepath)) {
+            this->NotifyMsg("Mounted " + pack_filepath);
+        } else {
+            this->ErrorMsg("Could not mount " + pack_filepath);
+        }
+    }
+    , "Mounts [pack] so its files take precedence over loose files.");
+
+    RegisterCommand("pack_unmount",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        std::string pack_filepath;
+        if(arg_set.GetNext(pack_filepath)) {
+            FileUtils::UnmountPackFile(pack_filepath);
+        } else {
+            FileUtils::UnmountAllPackFiles();
+        }
+    }
+    , "Unmounts [pack] or every mounted pack file if none specified.");
+
+#ifndef FINAL_BUILD
+    RegisterCommand("pack_build",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        std::string folderpath;
+        std::string pack_filepath;
+        if(!arg_set.GetNext(folderpath) || !arg_set.GetNext(pack_filepath)) {
+            this->WarnMsg("Usage: pack_build [folder] [pack]");
+            return;
+        }
+        if(FileUtils::PackFile::Build(folderpath, pack_filepath)) {
+            this->NotifyMsg("Packed " + folderpath + " into " + pack_filepath);
+        } else {
+            this->ErrorMsg("Could not pack " + folderpath + " into " + pack_filepath);
+        }
+    }
+    , "Packs every file under [folder] into the archive [pack].");
+
+    RegisterCommand("compress_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        std::string filepath;
+        if(!arg_set.GetNext(filepath)) {
+            this->WarnMsg("Usage: compress_bench [file] [block size]");
+            return;
+        }
+        unsigned int block_size = static_cast<unsigned int>(FileUtils::CompressedBinaryStream::DEFAULT_BLOCK_SIZE);
+        arg_set.GetNext(block_size);
+        FileUtils::CompressedBinaryStreamBenchmark(filepath, block_size);
+        this->NotifyMsg("Compression benchmark results written to the log.");
+    }
+    , "Times reading [file] raw against reading a block compressed copy.");
+    RegisterCommand("base64_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        unsigned int byte_count = 16u * 1024u * 1024u;
+        arg_set.GetNext(byte_count);
+        DataUtils::Base64Benchmark(byte_count);
+        this->NotifyMsg("Base64 benchmark results written to the log.");
+    }
+    , "Times Base64 encoding and decoding of [bytes] random bytes on each supported code path.");
+    RegisterCommand("string_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        unsigned int iterations = 100000u;
+        arg_set.GetNext(iterations);
+        StringUtilsBenchmark(iterations);
+        this->NotifyMsg("String benchmark results written to the log.");
+    }
+    , "Times [iterations] calls of Split against SplitView and Stringf against FormatTo.");
+    RegisterCommand("matrix_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        unsigned int iterations = 1000000u;
+        arg_set.GetNext(iterations);
+        Matrix4Benchmark(iterations);
+        this->NotifyMsg("Matrix4 benchmark results written to the log.");
+    }
+    , "Times [iterations] calls of each Matrix4 kernel against the operators they replaced and warns if they disagree.");
+    RegisterCommand("quat_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        unsigned int iterations = 1000000u;
+        arg_set.GetNext(iterations);
+        QuaternionBenchmark(iterations);
+        this->NotifyMsg("Quaternion benchmark results written to the log.");
+    }
+    , "Times [iterations] quaternion interpolations, products and conversions and checks their accuracy.");
+    RegisterCommand("random_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        unsigned int iterations = 1000000u;
+        arg_set.GetNext(iterations);
+        RandomBenchmark(iterations);
+        this->NotifyMsg("Random benchmark results written to the log.");
+    }
+    , "Times [iterations] random floats and points against the old generators and warns if their distribution or replay is off.");
+    RegisterCommand("noise_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        unsigned int iterations = 1000000u;
+        arg_set.GetNext(iterations);
+        NoiseBenchmark(iterations);
+        this->NotifyMsg("Noise benchmark results written to the log.");
+    }
+    , "Times noise grid fills over about [iterations] samples against single-sample calls and warns if they differ.");
+    RegisterCommand("simplex_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        unsigned int iterations = 1000000u;
+        arg_set.GetNext(iterations);
+        SimplexNoiseBenchmark(iterations);
+        this->NotifyMsg("Simplex noise benchmark results written to the log.");
+    }
+    , "Times fractal, Perlin and simplex noise in 2D, 3D and 4D over [iterations] samples each and logs their value ranges.");
+    RegisterCommand("aabbtree_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        unsigned int frames = 60u;
+        arg_set.GetNext(frames);
+        DynamicAABB3TreeBenchmark(frames);
+        this->NotifyMsg("AABB tree benchmark results written to the log.");
+    }
+    , "Moves 10k and 100k objects through a DynamicAABB3Tree for [frames] frames, times updates, pairs and queries and warns if they differ from brute force.");
+    RegisterCommand("spatialhash_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        unsigned int frames = 60u;
+        arg_set.GetNext(frames);
+        SpatialHashGrid2Benchmark(frames);
+        this->NotifyMsg("Spatial hash grid benchmark results written to the log.");
+    }
+    , "Rebuilds a SpatialHashGrid2 over 10k and 100k moving discs for [frames] frames, times builds, pairs and queries and warns if they differ from brute force.");
+    RegisterCommand("frustum_bench",
+    [&](const std::string& args) {
+        Arguments arg_set(args);
+        unsigned int frames = 60u;
+        arg_set.GetNext(frames);
+        FrustumCullingBenchmark(frames);
+        this->NotifyMsg("Frustum culling benchmark results written to the log.");
+    }
+    , "Culls 100k spheres and 100k boxes against a turning frustum for [frames] frames, one at a time, batched and with the coherency cache, and warns if they disagree.");
+#endif
+
 }
 
 void Console::BeginFrame() {
@@ -519,6 +882,15 @@ void Console::Update(float deltaSeconds) {
         _secondsPerBlink = 0.0f;
         _showCaret = !_showCaret;
     }
+    if(_output_dirty && IsConsoleOpen()) {
+        UpdateOutputGeometry();
+    }
+    //Keeps the hint current while typing; leaves the list alone while TAB is cycling through it.
+    const bool cycling = _autocomplete_index < _autocomplete_candidates.size()
+                         && entryline == _autocomplete_candidates[_autocomplete_index];
+    if(IsConsoleOpen() && !cycling) {
+        UpdateAutoCompleteCandidates();
+    }
 }
 
 void Console::Render() const {
@@ -546,28 +918,24 @@ void Console::DrawBackground() const {
 }
 
 void Console::DrawOutputBuffer() const {
-    float draw_loc_y = _topleft.y - _font->GetLineHeight();
-    for(auto riter = output_buffer.rbegin(); riter != output_buffer.rend(); ++riter) {
-        std::istringstream ss;
-        ss.str((*riter).first);
-        std::string curline;
-        while(std::getline(ss, curline)) {
-            _renderer->DrawTextLine(_font, curline, riter->second, _topleft.x, draw_loc_y);
-            draw_loc_y -= _font->GetLineHeight();
-        }
+    if(_output_index_count == 0) {
+        return;
     }
+    _renderer->SetMaterial(_renderer->GetFontMaterial(_font));
+    _renderer->DrawIndexed(PrimitiveType::TRIANGLES, _output_vbo, _output_ibo, _output_index_count);
 }
 
 void Console::DrawEntryline() const {
-    
+    _entryline_layout.SetText(_font, entryline);
+    const auto caret_index = static_cast<std::size_t>(std::distance(entryline.cbegin(), caretPos));
     if(caretPos != selectPos) {
-        _renderer->DrawTextLine(_font, std::string(entryline.begin(), caretPos), Rgba::WHITE, _topleft.x, _topleft.y);
-        _renderer->DrawTextLine(_font, std::string(selectPos, entryline.end()), Rgba::WHITE, _topleft.x + _font->CalculateTextWidth(std::string(entryline.begin(), selectPos)), _topleft.y);
+        const auto select_index = static_cast<std::size_t>(std::distance(entryline.cbegin(), selectPos));
+        _renderer->DrawTextLayout(_entryline_layout, Rgba::WHITE, _topleft.x, _topleft.y);
 
         _renderer->SetMaterial(_renderer->GetMaterial("__unlit"));
 
-        float xPosOffsetToCaret = _font->CalculateTextWidth(std::string(entryline.begin(), caretPos));
-        float xPosOffsetToSelect = _font->CalculateTextWidth(std::string(entryline.begin(), selectPos));
+        float xPosOffsetToCaret = _entryline_layout.GetCursorOffset(caret_index);
+        float xPosOffsetToSelect = _entryline_layout.GetCursorOffset(select_index);
         auto rangeStart = caretPos;
         auto rangeEnd = selectPos;
         if(selectPos < caretPos) {
@@ -586,16 +954,28 @@ void Console::DrawEntryline() const {
                             Rgba(64, 64, 0, 255)
         );
 
-        float xPosOffsetToStart = _font->CalculateTextWidth(std::string(entryline.begin(), rangeStart));
+        float xPosOffsetToStart = xPosOffsetToCaret;
         _renderer->DrawTextLine(_font, std::string(rangeStart, rangeEnd), Rgba::BLACK, _topleft.x + xPosOffsetToStart, _topleft.y);
 
     } else {
-        _renderer->DrawTextLine(_font, entryline, Rgba::WHITE, _topleft.x, _topleft.y);
+        _renderer->DrawTextLayout(_entryline_layout, Rgba::WHITE, _topleft.x, _topleft.y);
+        DrawAutoCompleteHint();
     }
     if(_showCaret) {
-        //Recalculate caret position for rendering
-        _renderer->DrawTextLine(_font, "|", Rgba::WHITE, _topleft.x + _font->CalculateTextWidth(std::string(entryline.begin(), caretPos)), _topleft.y);
+        _renderer->DrawTextLine(_font, "|", Rgba::WHITE, _topleft.x + _entryline_layout.GetCursorOffset(caret_index), _topleft.y);
+    }
+}
+
+//Shows the rest of the best prefix completion after the entry line.
+void Console::DrawAutoCompleteHint() const {
+    if(_autocomplete_fuzzy || _autocomplete_candidates.empty() || _autocomplete_index != std::string::npos) {
+        return;
+    }
+    const std::string& best = _autocomplete_candidates.front();
+    if(best.size() <= entryline.size() || best.compare(0, entryline.size(), entryline) != 0) {
+        return;
     }
+    _renderer->DrawTextLine(_font, best.substr(entryline.size()), Rgba::GREY, _topleft.x + _entryline_layout.GetWidth(), _topleft.y);
 }
 
 void Console::EndFrame() {
@@ -615,28 +995,35 @@ const Rgba& Console::GetTextColor() {
 }
 
 void Console::RegisterCommand(const std::string& command_name, const std::function<void(const std::string&)>& callback, const std::string& help_text) {
-    _commands.insert_or_assign(command_name, std::make_pair(callback, help_text));
+    _commands.InsertOrAssign(command_name, command_t{ callback, help_text });
+    InvalidateAutoCompleteCandidates();
 }
 
 void Console::UnregisterCommand(const std::string& command_name) {
-    _commands.erase(command_name);
+    if(_commands.Erase(command_name)) {
+        InvalidateAutoCompleteCandidates();
+    }
 }
 
 void Console::RunCommand(const std::string& command) {
     if (command.empty()) {
         return;
     }
-    std::string c = command.substr(0, command.find_first_of(' '));
-    std::string args;
-    if (command.find_first_of(' ') != std::string::npos) {
-        args = command.substr(command.find_first_of(' '));
-    }
-    auto command_iter = _commands.find(c);
-    if (command_iter == _commands.end()) {
+    const std::string_view command_view = command;
+    const std::size_t args_start = command_view.find_first_of(' ');
+    command_t* found = _commands.Find(command_view.substr(0, args_start));
+    if (!found) {
         ErrorMsg("INVALID COMMAND");
         return;
     }
-    command_iter->second.first(args);
+    ++found->use_count;
+    //Usage ranks candidates, so rebuild them on the next request.
+    _autocomplete_valid = false;
+    std::string args;
+    if (args_start != std::string_view::npos) {
+        args = command.substr(args_start);
+    }
+    found->callback(args);
 }
 
 Arguments::Arguments(const std::string& args)
@@ -1,21 +1,27 @@
 #pragma once
 
 #include <functional>
-#include <map>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "Engine/Core/EngineSubsystem.hpp"
 #include "Engine/Core/Event.hpp"
 #include "Engine/Core/Rgba.hpp"
+#include "Engine/Core/TextLayout.hpp"
+#include "Engine/Core/Trie.hpp"
 
 #include "Engine/Math/Vector2.hpp"
 
+#include "Engine/Renderer/Vertex3D.hpp"
+
 class Arguments;
 class SimpleRenderer;
 class KerningFont;
 class Texture2D;
+class VertexBuffer;
+class IndexBuffer;
 
 class Console : public EngineSubsystem {
 public:
@@ -93,20 +99,63 @@ private:
     void DrawOutputBuffer() const;
     void DrawBackground() const;
 
+    struct output_line_t {
+        std::string text;
+        Rgba color;
+        //Glyph quads relative to the line origin. Built once the line is on screen.
+        std::vector<Vertex3D> glyphs;
+    };
+
+    void PushOutputLine(std::string_view text, const Rgba& color);
+    output_line_t& GetOutputLine(std::size_t age);
+    void ClearOutputBuffer();
+    void UpdateOutputGeometry();
+
     void PushEntrylineToOutputBuffer();
     void ResetCurrentCommand();
     void SaveEntrylineToBuffer();
     void SetEntryline(const std::string& str);
     void AutoCompleteEntryLine();
-
-    std::vector<std::pair<std::string, Rgba>> output_buffer;
+    void UpdateAutoCompleteCandidates();
+    void InvalidateAutoCompleteCandidates();
+    void DrawAutoCompleteHint() const;
+
+    //Ring of the most recent output lines; _output_head is the next slot written.
+    std::vector<output_line_t> _output_lines;
+    std::size_t _output_head;
+    std::size_t _output_count;
+    //Quads for the visible lines, rebuilt only when the output changes.
+    std::vector<Vertex3D> _output_vbo_data;
+    std::vector<unsigned int> _output_ibo_data;
+    VertexBuffer* _output_vbo;
+    IndexBuffer* _output_ibo;
+    std::size_t _output_vbo_capacity;
+    std::size_t _output_ibo_capacity;
+    std::size_t _output_index_count;
+    bool _output_dirty;
     std::vector<std::string> entryline_buffer;
     std::string entryline;
     std::string::const_iterator caretPos;
     std::string::const_iterator selectPos;
+    //Caret and selection offsets come from here; rebuilt only when entryline changes.
+    mutable TextLayout _entryline_layout;
     std::vector<std::string>::iterator current_command;
 
-    std::map<std::string, std::pair<std::function<void(const std::string& arguments)>, std::string>> _commands;
+    struct command_t {
+        std::function<void(const std::string& arguments)> callback;
+        std::string help_text;
+        //Times run this session. Ranks autocomplete candidates.
+        unsigned int use_count = 0;
+    };
+
+    Trie<command_t> _commands;
+    //Ranked completions of _autocomplete_prefix. Prefix matches if any exist, otherwise fuzzy matches.
+    std::vector<std::string> _autocomplete_candidates;
+    std::string _autocomplete_prefix;
+    //Candidate last inserted by TAB; npos when not cycling.
+    std::size_t _autocomplete_index;
+    bool _autocomplete_fuzzy;
+    bool _autocomplete_valid;
     Vector2 _topleft;
     SimpleRenderer* _renderer;
     KerningFont* _font;
@@ -0,0 +1,69 @@
+#include "Engine/Core/CpuUtils.hpp"
+
+#include <intrin.h>
+
+namespace CpuUtils {
+
+namespace {
+
+struct cpu_features_t {
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+};
+
+cpu_features_t DetectFeatures() {
+    cpu_features_t features{};
+    int info[4] = { 0, 0, 0, 0 };
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+    if(max_leaf < 1) {
+        return features;
+    }
+    __cpuid(info, 1);
+    int ecx = info[2];
+    features.ssse3 = (ecx & (1 << 9)) != 0;
+    features.sse41 = (ecx & (1 << 19)) != 0;
+    bool os_saves_ymm = false;
+    if((ecx & (1 << 27)) != 0) { //OSXSAVE
+        os_saves_ymm = (_xgetbv(0) & 0x6) == 0x6;
+    }
+    features.avx = os_saves_ymm && (ecx & (1 << 28)) != 0;
+    features.fma = features.avx && (ecx & (1 << 12)) != 0;
+    if(max_leaf >= 7) {
+        __cpuidex(info, 7, 0);
+        features.avx2 = features.avx && (info[1] & (1 << 5)) != 0;
+    }
+    return features;
+}
+
+const cpu_features_t& GetFeatures() {
+    static const cpu_features_t features = DetectFeatures();
+    return features;
+}
+
+}
+
+bool HasSSSE3() {
+    return GetFeatures().ssse3;
+}
+
+bool HasSSE41() {
+    return GetFeatures().sse41;
+}
+
+bool HasAVX() {
+    return GetFeatures().avx;
+}
+
+bool HasAVX2() {
+    return GetFeatures().avx2;
+}
+
+bool HasFMA() {
+    return GetFeatures().fma;
+}
+
+}
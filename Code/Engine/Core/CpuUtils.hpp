@@ -0,0 +1,13 @@
+#pragma once
+
+//Runtime instruction set detection for code paths that dispatch on the host CPU.
+//Results are queried once and cached. AVX and later also require OS support for the YMM registers.
+namespace CpuUtils {
+
+bool HasSSSE3();
+bool HasSSE41();
+bool HasAVX();
+bool HasAVX2();
+bool HasFMA();
+
+}
@@ -1,18 +1,33 @@
 #include "Engine/Core/DataUtils.hpp"
 
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 #include "Engine/EngineConfig.hpp"
 
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
 #include "Engine/Core/Logger.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
 
 namespace DataUtils {
 
+tinyxml2::XMLError LoadXmlDocument(tinyxml2::XMLDocument& doc, const std::string& filepath) {
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+    if(FileUtils::GetFileView(filepath, data, size)) {
+        return doc.Parse(reinterpret_cast<const char*>(data), size);
+    }
+    return doc.LoadFile(filepath.c_str());
+}
+
 void ValidateXmlElement(const XMLElement& element,
     const std::string& name,
     const std::string& requiredChildElements,
@@ -33,16 +48,16 @@ void ValidateXmlElement(const XMLElement& element,
         ERROR_AND_DIE(err_ss.str().c_str());
     }
 
-    std::vector<std::string> requiredAttributeNames = Split(requiredAttributes);
+    std::vector<std::string_view> requiredAttributeNames = SplitView(requiredAttributes);
     std::sort(requiredAttributeNames.begin(), requiredAttributeNames.end());
 
-    std::vector<std::string> requiredChildElementNames = Split(requiredChildElements);
+    std::vector<std::string_view> requiredChildElementNames = SplitView(requiredChildElements);
     std::sort(requiredChildElementNames.begin(), requiredChildElementNames.end());
 
-    std::vector<std::string> optionalChildElementNames = Split(optionalChildElements);
+    std::vector<std::string_view> optionalChildElementNames = SplitView(optionalChildElements);
     std::sort(optionalChildElementNames.begin(), optionalChildElementNames.end());
 
-    std::vector<std::string> optionalAttributeNames = Split(optionalAttributes);
+    std::vector<std::string_view> optionalAttributeNames = SplitView(optionalAttributes);
     std::sort(optionalAttributeNames.begin(), optionalAttributeNames.end());
 
     std::vector<std::string> actualChildElementNames = GetChildElementNames(element);
@@ -68,7 +83,7 @@ void ValidateXmlElement(const XMLElement& element,
     std::sort(actualOptionalChildElementNames.begin(), actualOptionalChildElementNames.end());
 
     //Find missing attributes
-    std::vector<std::string> missingRequiredAttributes;
+    std::vector<std::string_view> missingRequiredAttributes;
     std::set_difference(requiredAttributeNames.begin(), requiredAttributeNames.end(),
         actualAttributeNames.begin(), actualAttributeNames.end(),
         std::back_inserter(missingRequiredAttributes));
@@ -82,7 +97,7 @@ void ValidateXmlElement(const XMLElement& element,
     }
 
     //Find missing children
-    std::vector<std::string> missingRequiredChildren;
+    std::vector<std::string_view> missingRequiredChildren;
     std::set_difference(requiredChildElementNames.begin(), requiredChildElementNames.end(),
         actualChildElementNames.begin(), actualChildElementNames.end(),
         std::back_inserter(missingRequiredChildren));
@@ -167,6 +182,295 @@ std::vector<std::string> GetChildElementNames(const XMLElement& element) {
     return childElementNames;
 }
 
+namespace {
+
+std::string_view TrimLeadingWhitespace(std::string_view text) {
+    auto first = text.find_first_not_of(" \t\r\n");
+    return first == std::string_view::npos ? std::string_view{} : text.substr(first);
+}
+
+std::string_view TrimWhitespace(std::string_view text) {
+    text = TrimLeadingWhitespace(text);
+    auto last = text.find_last_not_of(" \t\r\n");
+    return last == std::string_view::npos ? std::string_view{} : text.substr(0, last + 1);
+}
+
+template<typename T>
+bool ParseIntegral(std::string_view text, T& out_value) {
+    text = TrimLeadingWhitespace(text);
+    if(!text.empty() && text.front() == '+') {
+        text.remove_prefix(1);
+    }
+    T value{};
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if(result.ec != std::errc()) {
+        return false;
+    }
+    out_value = value;
+    return true;
+}
+
+template<typename T>
+bool ParseFloatingPoint(std::string_view text, T& out_value) {
+    text = TrimLeadingWhitespace(text);
+    if(!text.empty() && text.front() == '+') {
+        text.remove_prefix(1);
+    }
+    T value{};
+#ifdef __cpp_lib_to_chars
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if(result.ec != std::errc()) {
+        return false;
+    }
+#else
+    //Toolsets without floating point from_chars: strtod needs a terminated copy, kept on the stack.
+    std::array<char, 64> buffer{};
+    std::size_t length = (std::min)(text.size(), buffer.size() - 1);
+    std::memcpy(buffer.data(), text.data(), length);
+    char* end = nullptr;
+    value = static_cast<T>(std::strtod(buffer.data(), &end));
+    if(end == buffer.data()) {
+        return false;
+    }
+#endif
+    out_value = value;
+    return true;
+}
+
+//Parses "[a,b,...]" into at most out_count floats. Components not present are left untouched.
+bool ParseFloatList(std::string_view text, float* out_values, std::size_t out_count) {
+    text = TrimWhitespace(text);
+    if(text.size() < 2 || text.front() != '[' || text.back() != ']') {
+        return false;
+    }
+    text = text.substr(1, text.size() - 2);
+    std::size_t parsed_count = 0;
+    while(parsed_count < out_count) {
+        auto comma = text.find(',');
+        if(!ParseFloatingPoint(text.substr(0, comma), out_values[parsed_count])) {
+            return false;
+        }
+        ++parsed_count;
+        if(comma == std::string_view::npos) {
+            break;
+        }
+        text.remove_prefix(comma + 1);
+    }
+    return parsed_count > 0;
+}
+
+template<typename VectorType, std::size_t N, typename ComponentType>
+bool ParseVector(std::string_view text, VectorType& out_value) {
+    std::array<float, N> components{};
+    if(!ParseFloatList(text, components.data(), components.size())) {
+        return false;
+    }
+    if constexpr(N == 2) {
+        out_value = VectorType(static_cast<ComponentType>(components[0]), static_cast<ComponentType>(components[1]));
+    } else if constexpr(N == 3) {
+        out_value = VectorType(static_cast<ComponentType>(components[0]), static_cast<ComponentType>(components[1]), static_cast<ComponentType>(components[2]));
+    } else {
+        out_value = VectorType(static_cast<ComponentType>(components[0]), static_cast<ComponentType>(components[1]), static_cast<ComponentType>(components[2]), static_cast<ComponentType>(components[3]));
+    }
+    return true;
+}
+
+template<typename T>
+T GetRandomInRange(T lower, T upper) {
+    if constexpr(std::is_same_v<T, float>) {
+        return MathUtils::GetRandomFloatInRange(lower, upper);
+    } else if constexpr(std::is_same_v<T, double>) {
+        return MathUtils::GetRandomDoubleInRange(lower, upper);
+    } else if constexpr(sizeof(T) < sizeof(long)) {
+        return static_cast<T>(MathUtils::GetRandomIntInRange(static_cast<int>(lower), static_cast<int>(upper)));
+    } else if constexpr(sizeof(T) == sizeof(long) && !std::is_same_v<T, long long> && !std::is_same_v<T, unsigned long long>) {
+        return static_cast<T>(MathUtils::GetRandomLongInRange(static_cast<long>(lower), static_cast<long>(upper)));
+    } else {
+        return static_cast<T>(MathUtils::GetRandomLongLongInRange(static_cast<long long>(lower), static_cast<long long>(upper)));
+    }
+}
+
+//Parses "value" or the random range "lower~upper" without copying the attribute.
+template<typename T>
+T ParseNumericAttribute(const XMLElement& element, const char* attributeName, T defaultValue) {
+    auto attrAsCStr = element.Attribute(attributeName); //returns nullptr when Attribute not found!
+    if(!attrAsCStr) {
+        return defaultValue;
+    }
+    std::string_view attr(attrAsCStr);
+    auto tilde_loc = attr.find('~');
+    T lower = defaultValue;
+    if(!ParseValue(attr.substr(0, tilde_loc), lower) || tilde_loc == std::string_view::npos) {
+        return lower;
+    }
+    T upper = lower;
+    if(!ParseValue(attr.substr(tilde_loc + 1), upper)) {
+        return lower;
+    }
+    return GetRandomInRange(lower, upper);
+}
+
+template<typename T>
+T ParseXmlText(const char* text, const T& defaultValue) {
+    if(!text || !*text) {
+        return defaultValue;
+    }
+    T value = defaultValue;
+    ParseValue(text, value);
+    return value;
+}
+
+}
+
+bool ParseValue(std::string_view text, bool& out_value) {
+    text = TrimWhitespace(text);
+    if(text == "true") {
+        out_value = true;
+        return true;
+    }
+    if(text == "false") {
+        out_value = false;
+        return true;
+    }
+    int value = 0;
+    if(!ParseIntegral(text, value)) {
+        return false;
+    }
+    out_value = value != 0;
+    return true;
+}
+
+bool ParseValue(std::string_view text, unsigned char& out_value) {
+    return ParseIntegral(text, out_value);
+}
+
+bool ParseValue(std::string_view text, signed char& out_value) {
+    return ParseIntegral(text, out_value);
+}
+
+bool ParseValue(std::string_view text, unsigned short& out_value) {
+    return ParseIntegral(text, out_value);
+}
+
+bool ParseValue(std::string_view text, short& out_value) {
+    return ParseIntegral(text, out_value);
+}
+
+bool ParseValue(std::string_view text, unsigned int& out_value) {
+    return ParseIntegral(text, out_value);
+}
+
+bool ParseValue(std::string_view text, int& out_value) {
+    return ParseIntegral(text, out_value);
+}
+
+bool ParseValue(std::string_view text, unsigned long& out_value) {
+    return ParseIntegral(text, out_value);
+}
+
+bool ParseValue(std::string_view text, long& out_value) {
+    return ParseIntegral(text, out_value);
+}
+
+bool ParseValue(std::string_view text, unsigned long long& out_value) {
+    return ParseIntegral(text, out_value);
+}
+
+bool ParseValue(std::string_view text, long long& out_value) {
+    return ParseIntegral(text, out_value);
+}
+
+bool ParseValue(std::string_view text, float& out_value) {
+    return ParseFloatingPoint(text, out_value);
+}
+
+bool ParseValue(std::string_view text, double& out_value) {
+    return ParseFloatingPoint(text, out_value);
+}
+
+bool ParseValue(std::string_view text, Rgba& out_value) {
+    text = TrimWhitespace(text);
+    if(text.empty()) {
+        return false;
+    }
+    if(text.front() == '#') {
+        text.remove_prefix(1);
+        if(text.size() != 6 && text.size() != 8) {
+            return false;
+        }
+        uint32_t value = 0;
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value, 16);
+        if(result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+            return false;
+        }
+        if(text.size() == 6) {
+            value = (value << 8) | 0xFFu;
+        }
+        out_value = Rgba(static_cast<unsigned char>((value & 0xff000000u) >> 24)
+                       , static_cast<unsigned char>((value & 0x00ff0000u) >> 16)
+                       , static_cast<unsigned char>((value & 0x0000ff00u) >> 8)
+                       , static_cast<unsigned char>((value & 0x000000ffu) >> 0));
+        return true;
+    }
+    std::array<int, 4> components{ 255, 255, 255, 255 };
+    std::size_t parsed_count = 0;
+    while(parsed_count < components.size()) {
+        auto comma = text.find(',');
+        if(!ParseIntegral(text.substr(0, comma), components[parsed_count])) {
+            return false;
+        }
+        ++parsed_count;
+        if(comma == std::string_view::npos) {
+            break;
+        }
+        text.remove_prefix(comma + 1);
+    }
+    if(parsed_count < 3) {
+        return false;
+    }
+    out_value = Rgba(static_cast<unsigned char>(components[0])
+                   , static_cast<unsigned char>(components[1])
+                   , static_cast<unsigned char>(components[2])
+                   , static_cast<unsigned char>(components[3]));
+    return true;
+}
+
+bool ParseValue(std::string_view text, Vector2& out_value) {
+    return ParseVector<Vector2, 2, float>(text, out_value);
+}
+
+bool ParseValue(std::string_view text, IntVector2& out_value) {
+    return ParseVector<IntVector2, 2, int>(text, out_value);
+}
+
+bool ParseValue(std::string_view text, Vector3& out_value) {
+    return ParseVector<Vector3, 3, float>(text, out_value);
+}
+
+bool ParseValue(std::string_view text, IntVector3& out_value) {
+    return ParseVector<IntVector3, 3, int>(text, out_value);
+}
+
+bool ParseValue(std::string_view text, Vector4& out_value) {
+    return ParseVector<Vector4, 4, float>(text, out_value);
+}
+
+bool ParseValue(std::string_view text, IntVector4& out_value) {
+    return ParseVector<IntVector4, 4, int>(text, out_value);
+}
+
+bool ParseValue(std::string_view text, Matrix4& out_value) {
+    std::array<float, 16> values{ 1.0f, 0.0f, 0.0f, 0.0f,
+                                  0.0f, 1.0f, 0.0f, 0.0f,
+                                  0.0f, 0.0f, 1.0f, 0.0f,
+                                  0.0f, 0.0f, 0.0f, 1.0f };
+    if(!ParseFloatList(text, values.data(), values.size())) {
+        return false;
+    }
+    out_value = Matrix4(values.data());
+    return true;
+}
+
 bool ParseXmlElementText(const XMLElement& element, bool defaultValue) {
     bool retVal = defaultValue;
     element.QueryBoolText(&retVal);
@@ -244,75 +548,36 @@ double ParseXmlElementText(const XMLElement& element, double defaultValue) {
 }
 Rgba ParseXmlElementText(const XMLElement& element, const Rgba& defaultValue) {
     auto s = element.GetText();
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
+    if(!s || !*s) {
         return defaultValue;
-    } else {
-        return Rgba(textVal);
     }
+    Rgba value = defaultValue;
+    if(!ParseValue(s, value)) {
+        //Named colors and error reporting.
+        value = Rgba(std::string(s));
+    }
+    return value;
 }
 Vector2 ParseXmlElementText(const XMLElement& element, const Vector2& defaultValue) {
-    auto s = element.GetText();
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return Vector2(textVal);
-    }
+    return ParseXmlText(element.GetText(), defaultValue);
 }
 IntVector2 ParseXmlElementText(const XMLElement& element, const IntVector2& defaultValue) {
-    auto s = element.GetText();
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return IntVector2(textVal);
-    }
+    return ParseXmlText(element.GetText(), defaultValue);
 }
 Vector3 ParseXmlElementText(const XMLElement& element, const Vector3& defaultValue) {
-    auto s = element.GetText();
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return Vector3(textVal);
-    }
+    return ParseXmlText(element.GetText(), defaultValue);
 }
 IntVector3 ParseXmlElementText(const XMLElement& element, const IntVector3& defaultValue) {
-    auto s = element.GetText();
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return IntVector3(textVal);
-    }
+    return ParseXmlText(element.GetText(), defaultValue);
 }
 Vector4 ParseXmlElementText(const XMLElement& element, const Vector4& defaultValue) {
-    auto s = element.GetText();
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return Vector4(textVal);
-    }
+    return ParseXmlText(element.GetText(), defaultValue);
 }
 IntVector4 ParseXmlElementText(const XMLElement& element, const IntVector4& defaultValue) {
-    auto s = element.GetText();
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return IntVector4(textVal);
-    }
+    return ParseXmlText(element.GetText(), defaultValue);
 }
 Matrix4 ParseXmlElementText(const XMLElement& element, const Matrix4& defaultValue) {
-    auto s = element.GetText();
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return Matrix4(textVal);
-    }
+    return ParseXmlText(element.GetText(), defaultValue);
 }
 
 std::string ParseXmlElementText(const XMLElement& element, const char* defaultValue) {
@@ -330,351 +595,116 @@ std::string ParseXmlElementText(const XMLElement& element, const std::string& de
     }
 }
 
-bool ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, bool defaultValue) {
+bool ParseXmlAttribute(const XMLElement& element, const char* attributeName, bool defaultValue) {
+    auto attrAsCStr = element.Attribute(attributeName); //returns nullptr when Attribute not found!
     bool retVal = defaultValue;
-    element.QueryBoolAttribute(attributeName.c_str(), &retVal);
+    if(attrAsCStr) {
+        ParseValue(attrAsCStr, retVal);
+    }
     return retVal;
 }
 
-unsigned char ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, unsigned char defaultValue) {
-    unsigned int retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryUnsignedAttribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return static_cast<unsigned char>(std::stoul(values[0]));
-        }
-        unsigned char lower = static_cast<unsigned char>(std::stoul(values[0]));
-        unsigned char upper = static_cast<unsigned char>(std::stoul(values[1]));
-        retVal = MathUtils::GetRandomIntInRange(lower, upper);
-    }
-    return static_cast<unsigned char>(retVal);
+unsigned char ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned char defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-signed char ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, signed char defaultValue) {
-    signed int retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryIntAttribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return static_cast<signed char>(std::stoul(values[0]));
-        }
-        signed char lower = static_cast<signed char>(std::stoul(values[0]));
-        signed char upper = static_cast<signed char>(std::stoul(values[1]));
-        retVal = MathUtils::GetRandomIntInRange(lower, upper);
-    }
-    return static_cast<signed char>(retVal);
+signed char ParseXmlAttribute(const XMLElement& element, const char* attributeName, signed char defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-char ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, char defaultValue) {
-    char retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        int retValAsInt = retVal;
-        element.QueryIntAttribute(attributeName.c_str(), &retValAsInt);
-        retVal = static_cast<char>(retValAsInt);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return static_cast<char>(std::stoi(values[0]));
-        }
-        char lower = static_cast<char>(std::stoul(values[0]));
-        char upper = static_cast<char>(std::stoul(values[1]));
-        retVal = static_cast<char>(MathUtils::GetRandomIntInRange(lower, upper));
-    }
-    return static_cast<char>(retVal);
+char ParseXmlAttribute(const XMLElement& element, const char* attributeName, char defaultValue) {
+    return static_cast<char>(ParseNumericAttribute(element, attributeName, static_cast<int>(defaultValue)));
 }
 
-unsigned short ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, unsigned short defaultValue) {
-    unsigned int retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryUnsignedAttribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return static_cast<unsigned short>(std::stoul(values[0]));
-        }
-        unsigned short lower = static_cast<unsigned short>(std::stoul(values[0]));
-        unsigned short upper = static_cast<unsigned short>(std::stoul(values[1]));
-        retVal = MathUtils::GetRandomIntInRange(lower, upper);
-    }
-    return static_cast<unsigned short>(retVal);
+unsigned short ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned short defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-short ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, short defaultValue) {
-    int retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryIntAttribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return static_cast<short>(std::stoi(values[0]));
-        }
-        short lower = static_cast<short>(std::stoi(values[0]));
-        short upper = static_cast<short>(std::stoi(values[1]));
-        retVal = MathUtils::GetRandomIntInRange(lower, upper);
-    }
-    return static_cast<unsigned short>(retVal);
+short ParseXmlAttribute(const XMLElement& element, const char* attributeName, short defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-unsigned int ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, unsigned int defaultValue) {
-    unsigned int retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryUnsignedAttribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return static_cast<unsigned short>(std::stoul(values[0]));
-        }
-        unsigned int lower = static_cast<unsigned int>(std::stoul(values[0]));
-        unsigned int upper = static_cast<unsigned int>(std::stoul(values[1]));
-        retVal = MathUtils::GetRandomIntInRange(lower, upper);
-    }
-    return static_cast<unsigned int>(retVal);
+unsigned int ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned int defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-int ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, int defaultValue) {
-    int retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryIntAttribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return std::stoi(values[0]);
-        }
-        int lower = std::stoi(values[0]);
-        int upper = std::stoi(values[1]);
-        retVal = MathUtils::GetRandomIntInRange(lower, upper);
-    }
-    return retVal;
+int ParseXmlAttribute(const XMLElement& element, const char* attributeName, int defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-unsigned long ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, unsigned long defaultValue) {
-    long long retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryInt64Attribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return std::stoul(values[0]);
-        }
-        long lower = static_cast<long>(std::stoll(values[0]));
-        long upper = static_cast<long>(std::stoll(values[1]));
-        retVal = MathUtils::GetRandomLongInRange(lower, upper);
-    }
-    return static_cast<unsigned long>(retVal);
+unsigned long ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned long defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-long ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, long defaultValue) {
-    long long retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryInt64Attribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return static_cast<long>(std::stoll(values[0]));
-        }
-        long lower = static_cast<long>(std::stoll(values[0]));
-        long upper = static_cast<long>(std::stoll(values[1]));
-        retVal = MathUtils::GetRandomLongInRange(lower, upper);
-    }
-    return static_cast<long>(retVal);
+long ParseXmlAttribute(const XMLElement& element, const char* attributeName, long defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-unsigned long long ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, unsigned long long defaultValue) {
-    long long retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryInt64Attribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return std::stoull(values[0]);
-        }
-        unsigned long long lower = std::stoull(values[0]);
-        unsigned long long upper = std::stoull(values[1]);
-        retVal = MathUtils::GetRandomLongLongInRange(lower, upper);
-    }
-    return static_cast<unsigned long long>(retVal);
+unsigned long long ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned long long defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-long long ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, long long defaultValue) {
-    long long retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryInt64Attribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return std::stoll(values[0]);
-        }
-        long long lower = std::stoll(values[0]);
-        long long upper = std::stoll(values[1]);
-        retVal = MathUtils::GetRandomLongLongInRange(lower, upper);
-    }
-    return static_cast<long long>(retVal);
+long long ParseXmlAttribute(const XMLElement& element, const char* attributeName, long long defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-float ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, float defaultValue) {
-    float retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryFloatAttribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return std::stof(values[0]);
-        }
-        float lower = std::stof(values[0]);
-        float upper = std::stof(values[1]);
-        retVal = MathUtils::GetRandomFloatInRange(lower, upper);
-    }
-    return retVal;
+float ParseXmlAttribute(const XMLElement& element, const char* attributeName, float defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-double ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, double defaultValue) {
-    double retVal = defaultValue;
-    auto attrAsCStr = element.Attribute(attributeName.c_str());
-    auto attr = std::string(attrAsCStr ? attrAsCStr : "");
-    bool is_range = attr.find('~') != std::string::npos;
-    if(!is_range) {
-        element.QueryDoubleAttribute(attributeName.c_str(), &retVal);
-    } else {
-        auto values = Split(attr, '~');
-        if(values.size() == 1) {
-            return std::stod(values[0]);
-        }
-        double lower = std::stod(values[0]);
-        double upper = std::stod(values[1]);
-        retVal = MathUtils::GetRandomDoubleInRange(lower, upper);
-    }
-    return retVal;
+double ParseXmlAttribute(const XMLElement& element, const char* attributeName, double defaultValue) {
+    return ParseNumericAttribute(element, attributeName, defaultValue);
 }
 
-Rgba ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const Rgba& defaultValue) {
-    auto s = element.Attribute(attributeName.c_str()); //returns nullptr when Attribute not found!
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
+Rgba ParseXmlAttribute(const XMLElement& element, const char* attributeName, const Rgba& defaultValue) {
+    auto s = element.Attribute(attributeName); //returns nullptr when Attribute not found!
+    if(!s || !*s) {
         return defaultValue;
-    } else {
-        return Rgba(textVal);
     }
-}
-
-Vector2 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const Vector2& defaultValue) {
-    auto s = element.Attribute(attributeName.c_str()); //returns nullptr when Attribute not found!
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return Vector2(textVal);
+    Rgba value = defaultValue;
+    if(!ParseValue(s, value)) {
+        //Named colors and error reporting.
+        value = Rgba(std::string(s));
     }
+    return value;
 }
 
-IntVector2 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const IntVector2& defaultValue) {
-    auto s = element.Attribute(attributeName.c_str()); //returns nullptr when Attribute not found!
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return IntVector2(Vector2(textVal));
-    }
+Vector2 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const Vector2& defaultValue) {
+    return ParseXmlText(element.Attribute(attributeName), defaultValue);
 }
 
-Vector3 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const Vector3& defaultValue) {
-    auto s = element.Attribute(attributeName.c_str()); //returns nullptr when Attribute not found!
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return Vector3(textVal);
-    }
+IntVector2 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const IntVector2& defaultValue) {
+    return ParseXmlText(element.Attribute(attributeName), defaultValue);
 }
 
-IntVector3 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const IntVector3& defaultValue) {
-    auto s = element.Attribute(attributeName.c_str()); //returns nullptr when Attribute not found!
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return IntVector3(Vector3(textVal));
-    }
+Vector3 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const Vector3& defaultValue) {
+    return ParseXmlText(element.Attribute(attributeName), defaultValue);
 }
 
-Vector4 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const Vector4& defaultValue) {
-    auto s = element.Attribute(attributeName.c_str()); //returns nullptr when Attribute not found!
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return Vector4(textVal);
-    }
+IntVector3 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const IntVector3& defaultValue) {
+    return ParseXmlText(element.Attribute(attributeName), defaultValue);
 }
 
-IntVector4 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const IntVector4& defaultValue) {
-    auto s = element.Attribute(attributeName.c_str()); //returns nullptr when Attribute not found!
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return IntVector4(Vector4(textVal));
-    }
-
+Vector4 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const Vector4& defaultValue) {
+    return ParseXmlText(element.Attribute(attributeName), defaultValue);
 }
 
-Matrix4 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const Matrix4& defaultValue) {
-    auto s = element.Attribute(attributeName.c_str()); //returns nullptr when Attribute not found!
-    std::string textVal(s ? s : "");
-    if(textVal.empty()) {
-        return defaultValue;
-    } else {
-        return Matrix4(textVal);
-    }
+IntVector4 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const IntVector4& defaultValue) {
+    return ParseXmlText(element.Attribute(attributeName), defaultValue);
 }
 
+Matrix4 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const Matrix4& defaultValue) {
+    return ParseXmlText(element.Attribute(attributeName), defaultValue);
+}
 
-std::string ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const char* defaultValue) {
-    std::string textVal_default(defaultValue ? defaultValue : "");
-    return ParseXmlAttribute(element, attributeName, textVal_default);
+std::string ParseXmlAttribute(const XMLElement& element, const char* attributeName, const char* defaultValue) {
+    auto s = element.Attribute(attributeName); //returns nullptr when Attribute not found!
+    return std::string(s ? s : (defaultValue ? defaultValue : ""));
 }
 
 
-std::string ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const std::string& defaultValue) {
-    auto s = element.Attribute(attributeName.c_str()); //returns nullptr when Attribute not found!
+std::string ParseXmlAttribute(const XMLElement& element, const char* attributeName, const std::string& defaultValue) {
+    auto s = element.Attribute(attributeName); //returns nullptr when Attribute not found!
     return (s ? s : defaultValue);
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "ThirdParty/TinyXML2/tinyxml2.h"
 
@@ -17,6 +18,9 @@ using XMLElement = tinyxml2::XMLElement;
 
 namespace DataUtils {
 
+//Parses filepath through the virtual file system so packed XML is read straight from the mapped pack file.
+tinyxml2::XMLError LoadXmlDocument(tinyxml2::XMLDocument& doc, const std::string& filepath);
+
 void ValidateXmlElement(const XMLElement& element,
                         const std::string& name,
                         const std::string& requiredChildElements,
@@ -30,42 +34,72 @@ unsigned int GetChildElementCount(const XMLElement &element, const std::string&
 std::vector<std::string> GetChildElementNames(const XMLElement& element);
 std::vector<std::string> GetAttributeNames(const XMLElement& element);
 
-bool ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, bool defaultValue);
-
-unsigned char ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, unsigned char defaultValue);
-signed char ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, signed char defaultValue);
-char ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, char defaultValue);
-
-unsigned short ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, unsigned short defaultValue);
-short ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, short defaultValue);
-
-unsigned int ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, unsigned int defaultValue);
-int ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, int defaultValue);
-
-unsigned long ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, unsigned long defaultValue);
-long ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, long defaultValue);
-
-unsigned long long ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, unsigned long long defaultValue);
-long long ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, long long defaultValue);
-
-float ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, float defaultValue);
-double ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, double defaultValue);
-
-Rgba ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const Rgba& defaultValue);
-
-Vector2 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const Vector2& defaultValue);
-IntVector2 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const IntVector2& defaultValue);
-
-Vector3 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const Vector3& defaultValue);
-IntVector3 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const IntVector3& defaultValue);
-
-Vector4 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const Vector4& defaultValue);
-IntVector4 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const IntVector4& defaultValue);
-
-Matrix4 ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const Matrix4& defaultValue);
-
-std::string ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const std::string& defaultValue);
-std::string ParseXmlAttribute(const XMLElement& element, const std::string& attributeName, const char* defaultValue);
+//Allocation-free parsing straight from tinyxml2's attribute and element text.
+//Numbers may have leading whitespace and trailing characters, matching the old sscanf/stof behavior.
+//Vectors and matrices use "[x,y,...]"; missing trailing components are zero.
+//Rgba accepts "#RRGGBB[AA]" and "r,g,b[,a]"; named colors return false.
+//Each returns false and leaves out_value unchanged when text is ill-formed.
+bool ParseValue(std::string_view text, bool& out_value);
+bool ParseValue(std::string_view text, unsigned char& out_value);
+bool ParseValue(std::string_view text, signed char& out_value);
+bool ParseValue(std::string_view text, unsigned short& out_value);
+bool ParseValue(std::string_view text, short& out_value);
+bool ParseValue(std::string_view text, unsigned int& out_value);
+bool ParseValue(std::string_view text, int& out_value);
+bool ParseValue(std::string_view text, unsigned long& out_value);
+bool ParseValue(std::string_view text, long& out_value);
+bool ParseValue(std::string_view text, unsigned long long& out_value);
+bool ParseValue(std::string_view text, long long& out_value);
+bool ParseValue(std::string_view text, float& out_value);
+bool ParseValue(std::string_view text, double& out_value);
+bool ParseValue(std::string_view text, Rgba& out_value);
+bool ParseValue(std::string_view text, Vector2& out_value);
+bool ParseValue(std::string_view text, IntVector2& out_value);
+bool ParseValue(std::string_view text, Vector3& out_value);
+bool ParseValue(std::string_view text, IntVector3& out_value);
+bool ParseValue(std::string_view text, Vector4& out_value);
+bool ParseValue(std::string_view text, IntVector4& out_value);
+bool ParseValue(std::string_view text, Matrix4& out_value);
+
+//attributeName goes to tinyxml2 as is, so passing a literal does not allocate.
+//Numeric attributes accept "lower~upper" and return a random value in that range.
+//Ill-formed vector and matrix text returns defaultValue.
+bool ParseXmlAttribute(const XMLElement& element, const char* attributeName, bool defaultValue);
+
+unsigned char ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned char defaultValue);
+signed char ParseXmlAttribute(const XMLElement& element, const char* attributeName, signed char defaultValue);
+char ParseXmlAttribute(const XMLElement& element, const char* attributeName, char defaultValue);
+
+unsigned short ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned short defaultValue);
+short ParseXmlAttribute(const XMLElement& element, const char* attributeName, short defaultValue);
+
+unsigned int ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned int defaultValue);
+int ParseXmlAttribute(const XMLElement& element, const char* attributeName, int defaultValue);
+
+unsigned long ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned long defaultValue);
+long ParseXmlAttribute(const XMLElement& element, const char* attributeName, long defaultValue);
+
+unsigned long long ParseXmlAttribute(const XMLElement& element, const char* attributeName, unsigned long long defaultValue);
+long long ParseXmlAttribute(const XMLElement& element, const char* attributeName, long long defaultValue);
+
+float ParseXmlAttribute(const XMLElement& element, const char* attributeName, float defaultValue);
+double ParseXmlAttribute(const XMLElement& element, const char* attributeName, double defaultValue);
+
+Rgba ParseXmlAttribute(const XMLElement& element, const char* attributeName, const Rgba& defaultValue);
+
+Vector2 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const Vector2& defaultValue);
+IntVector2 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const IntVector2& defaultValue);
+
+Vector3 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const Vector3& defaultValue);
+IntVector3 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const IntVector3& defaultValue);
+
+Vector4 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const Vector4& defaultValue);
+IntVector4 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const IntVector4& defaultValue);
+
+Matrix4 ParseXmlAttribute(const XMLElement& element, const char* attributeName, const Matrix4& defaultValue);
+
+std::string ParseXmlAttribute(const XMLElement& element, const char* attributeName, const std::string& defaultValue);
+std::string ParseXmlAttribute(const XMLElement& element, const char* attributeName, const char* defaultValue);
 
 bool ParseXmlElementText(const XMLElement& element, bool defaultValue);
 
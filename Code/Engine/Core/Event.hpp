@@ -2,8 +2,21 @@
 
 #include "Engine/core/CriticalSection.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+//Multicast callback list.
+//Trigger is wait-free and may run on any number of threads at once: it calls an immutable
+//snapshot of the subscribers. Subscribing and unsubscribing copy the list under a lock and
+//publish the copy, so both are safe from inside a callback; the triggers already running
+//finish with the snapshot they started with. Replaced snapshots are freed once no trigger
+//can still be reading them, tracked with two reader epochs.
+//Queue and DispatchQueued defer triggers to a chosen point in the frame.
 template <typename ...ARGS>
 class Event {
 public:
@@ -11,7 +24,9 @@ public:
     struct event_sub_t;
     using cb_t = void(*)(event_sub_t*, ARGS...);
     using cb_with_arg_t = void(*)(void*, ARGS...);
-    // subscription - when subscribing this is the identifying 
+    //Queued arguments are copied, so references are stored as values.
+    using payload_t = std::tuple<std::decay_t<ARGS>...>;
+    // subscription - when subscribing this is the identifying
     // information (what to call, and what to call with)
 
     struct event_sub_t {
@@ -29,48 +44,34 @@ public:
 
 public:
     Event() = default;
+    Event(const Event&) = delete;
+    Event& operator=(const Event&) = delete;
 
+    //No trigger may be running.
     ~Event() {
-        subscriptions.clear();
+        delete _subscriptions.load();
+        for(auto& retired : _retired) {
+            delete retired.first;
+        }
     }
 
     // Subscribe a single function (
     void Subscribe(void *user_arg, cb_with_arg_t cb) {
-        // Good safeguard in debug to add is to make sure
-        // you're not double subscribing to an event
-        // with a similar pair. 
-        // TODO - ASSERT AGAINST ABOVE
-
-        // Add subscription
         event_sub_t sub;
         sub.cb = FunctionWithArgumentCallback;
         sub.secondary_cb = cb;
         sub.user_arg = user_arg;
-        subscriptions.push_back(sub);
+        Add(sub);
     }
 
     // Unsubscribe a function (using user argument as well)
     void Unsubscribe(void *user_arg, void* cb) {
-        for(std::size_t i = 0; i < subscriptions.size(); ++i) {
-            event_sub_t &sub = subscriptions[i];
-            if((sub.secondary_cb == cb) && (sub.user_arg == user_arg)) {
-                subscriptions.erase(subscriptions.begin() + i);
-                return; // should be unique, so return immeidately
-            }
-        }
+        RemoveIf([user_arg, cb](const event_sub_t& sub) { return (sub.secondary_cb == cb) && (sub.user_arg == user_arg); });
     }
 
     // remove all subscriptions using this user arg.
     void Unsubscribe_by_argument(void *user_arg) {
-        for(std::size_t i = 0; i < subscriptions.size(); ++i) {
-            event_sub_t &sub = subscriptions[i];
-            if(sub.user_arg == obj) {
-                // don't return, just remove this object [could do a fast removal if order doesn't matter
-                // by just setting last to this and popping back]
-                subscriptions.erase(subscriptions.begin() + i);
-                --i;
-            }
-        }
+        RemoveIf([user_arg](const event_sub_t& sub) { return sub.user_arg == user_arg; });
     }
 
     // Be able to subscribe a method;
@@ -80,7 +81,7 @@ public:
         sub.cb = MethodCallback<T, decltype(mcb)>;
         sub.secondary_cb = *(void**)(&mcb);
         sub.user_arg = obj;
-        subscriptions.push_back(sub);
+        Add(sub);
     }
 
     // unsubscribe - just forwards to normal unsubscribe
@@ -97,14 +98,132 @@ public:
 
     // Triggers the call - calls all registered callbacks;
     void Trigger(ARGS ...args) {
-        for(std::size_t i = 0; i < subscriptions.size(); ++i) {
-            event_sub_t &sub = subscriptions[i];
-            sub.cb(&sub, args...);
+        const uint32_t parity = _epoch.load() & 1u;
+        _readers[parity].fetch_add(1);
+        const subscription_list_t* subscriptions = _subscriptions.load();
+        if(subscriptions) {
+            for(const event_sub_t& sub : *subscriptions) {
+                sub.cb(const_cast<event_sub_t*>(&sub), args...);
+            }
         }
+        _readers[parity].fetch_sub(1);
     }
 
-public:
-    std::vector<event_sub_t> subscriptions;
+    std::size_t GetSubscriberCount() const {
+        const subscription_list_t* subscriptions = _subscriptions.load();
+        return subscriptions ? subscriptions->size() : 0;
+    }
+
+    //Preallocates room for count queued triggers so Queue does not allocate.
+    //Call from the thread that runs DispatchQueued.
+    void ReserveQueue(std::size_t count) {
+        _queue_cs.enter();
+        _queued.reserve(count);
+        _queue_cs.leave();
+        _dispatching.reserve(count);
+    }
+
+    //Copies the arguments for the next DispatchQueued. Safe from any thread.
+    void Queue(ARGS ...args) {
+        _queue_cs.enter();
+        _queued.emplace_back(args...);
+        _queue_cs.leave();
+    }
+
+    //Triggers everything queued before the call, in order. Triggers queued by the
+    //callbacks wait for the next dispatch. Call from one thread at a time, never from a callback.
+    void DispatchQueued() {
+        _queue_cs.enter();
+        _queued.swap(_dispatching);
+        _queue_cs.leave();
+        for(auto& payload : _dispatching) {
+            std::apply([this](auto&... args) { Trigger(args...); }, payload);
+        }
+        //Keeps the capacity for reuse.
+        _dispatching.clear();
+    }
+
+    std::size_t GetQueuedCount() {
+        _queue_cs.enter();
+        std::size_t count = _queued.size();
+        _queue_cs.leave();
+        return count;
+    }
+
+protected:
+private:
+    using subscription_list_t = std::vector<event_sub_t>;
+
+    void Add(const event_sub_t& sub) {
+        _write_cs.enter();
+        const subscription_list_t* current = _subscriptions.load();
+        auto* next = current ? new subscription_list_t(*current) : new subscription_list_t();
+        next->push_back(sub);
+        Publish(next);
+        _write_cs.leave();
+    }
+
+    template<typename PRED>
+    void RemoveIf(PRED&& pred) {
+        _write_cs.enter();
+        const subscription_list_t* current = _subscriptions.load();
+        if(current) {
+            auto* next = new subscription_list_t();
+            next->reserve(current->size());
+            for(const event_sub_t& sub : *current) {
+                if(!pred(sub)) {
+                    next->push_back(sub);
+                }
+            }
+            if(next->size() != current->size()) {
+                Publish(next);
+            } else {
+                delete next;
+            }
+        }
+        _write_cs.leave();
+    }
+
+    //Swaps in next and retires the old list. Must hold _write_cs.
+    void Publish(subscription_list_t* next) {
+        const subscription_list_t* previous = _subscriptions.exchange(next);
+        if(previous) {
+            _retired.emplace_back(previous, _epoch.load());
+        }
+        Reclaim();
+    }
+
+    //A trigger counts itself under the parity of the epoch it saw, and the epoch only moves
+    //past the next one once that parity drains. So a list retired at epoch E is unreachable
+    //by the time the epoch is E + 2. Must hold _write_cs.
+    void Reclaim() {
+        for(int step = 0; step < 2; ++step) {
+            const uint32_t epoch = _epoch.load();
+            if(_readers[(epoch + 1u) & 1u].load() != 0) {
+                break;
+            }
+            _epoch.store(epoch + 1u);
+        }
+        const uint32_t current = _epoch.load();
+        auto is_safe = [current](const std::pair<const subscription_list_t*, uint32_t>& retired) {
+            if(current - retired.second >= 2u) {
+                delete retired.first;
+                return true;
+            }
+            return false;
+        };
+        _retired.erase(std::remove_if(_retired.begin(), _retired.end(), is_safe), _retired.end());
+    }
+
+    std::atomic<const subscription_list_t*> _subscriptions{ nullptr };
+    std::atomic<uint32_t> _epoch{ 0 };
+    std::atomic<uint32_t> _readers[2]{};
+    std::vector<std::pair<const subscription_list_t*, uint32_t>> _retired{};
+    CriticalSection _write_cs{};
+
+    std::vector<payload_t> _queued{};
+    std::vector<payload_t> _dispatching{};
+    CriticalSection _queue_cs{};
 };
 
 
@@ -1,10 +1,17 @@
 #include "Engine/Core/FileUtils.hpp"
 
+#include <algorithm>
 #include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
 
 #include "Engine/EngineConfig.hpp"
 
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/PackFile.hpp"
 #include "Engine/Core/Rgba.hpp"
 
 #include "Engine/Math/Matrix4.hpp"
@@ -33,7 +40,36 @@ bool WriteBufferToFile(void* buffer, std::size_t size, const std::string& filePa
     return !(numBytesWritten < buffer_size && isFileError);
 }
 
+namespace {
+//IO threads read through the mounted packs while the main thread mounts and unmounts them.
+std::shared_mutex s_mounted_packs_mutex{};
+std::vector<std::unique_ptr<PackFile>> s_mounted_packs{};
+
+bool GetMountedFileView(const std::string& filePath, const unsigned char*& out_data, std::size_t& out_size) {
+    for(auto& pack : s_mounted_packs) {
+        if(pack->GetFileView(filePath, out_data, out_size)) {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
 bool ReadBufferFromFile(std::vector<unsigned char>& out_buffer, const std::string& filePath) {
+    {
+        //Hold the lock while copying so the pack cannot be unmapped underneath the copy.
+        std::shared_lock<std::shared_mutex> read_lock(s_mounted_packs_mutex);
+        const unsigned char* data = nullptr;
+        std::size_t size = 0;
+        if(GetMountedFileView(filePath, data, size)) {
+            out_buffer.assign(data, data + size);
+            return true;
+        }
+    }
+    return ReadBufferFromDisk(out_buffer, filePath);
+}
+
+bool ReadBufferFromDisk(std::vector<unsigned char>& out_buffer, const std::string& filePath) {
     FILE* file = nullptr;
     errno_t errorCode = fopen_s(&file, filePath.c_str(), "rb");
     if(errorCode != 0) return false;
@@ -51,6 +87,104 @@ bool ReadBufferFromFile(std::vector<unsigned char>& out_buffer, const std::strin
     return !(numBytesRead < numBytes && isFileError);
 }
 
+bool MountPackFile(const std::string& pack_filepath) {
+    auto pack = std::make_unique<PackFile>();
+    if(!pack->Open(pack_filepath)) {
+        return false;
+    }
+    std::unique_lock<std::shared_mutex> write_lock(s_mounted_packs_mutex);
+    s_mounted_packs.erase(std::remove_if(s_mounted_packs.begin(), s_mounted_packs.end(),
+                                         [&pack_filepath](const std::unique_ptr<PackFile>& mounted) { return mounted->GetFilepath() == pack_filepath; }),
+                          s_mounted_packs.end());
+    s_mounted_packs.push_back(std::move(pack));
+    return true;
+}
+
+void UnmountPackFile(const std::string& pack_filepath) {
+    std::unique_lock<std::shared_mutex> write_lock(s_mounted_packs_mutex);
+    s_mounted_packs.erase(std::remove_if(s_mounted_packs.begin(), s_mounted_packs.end(),
+                                         [&pack_filepath](const std::unique_ptr<PackFile>& pack) { return pack->GetFilepath() == pack_filepath; }),
+                          s_mounted_packs.end());
+}
+
+void UnmountAllPackFiles() {
+    std::unique_lock<std::shared_mutex> write_lock(s_mounted_packs_mutex);
+    s_mounted_packs.clear();
+}
+
+bool FileExists(const std::string& filePath) {
+    {
+        std::shared_lock<std::shared_mutex> read_lock(s_mounted_packs_mutex);
+        for(auto& pack : s_mounted_packs) {
+            if(pack->Contains(filePath)) {
+                return true;
+            }
+        }
+    }
+    namespace FS = std::filesystem;
+    std::error_code ec;
+    return FS::exists(FS::path(filePath), ec);
+}
+
+bool FolderExists(const std::string& folderpath) {
+    {
+        std::shared_lock<std::shared_mutex> read_lock(s_mounted_packs_mutex);
+        std::vector<std::string> packed_paths;
+        for(auto& pack : s_mounted_packs) {
+            pack->EnumerateFiles(folderpath, true, packed_paths);
+            if(!packed_paths.empty()) {
+                return true;
+            }
+        }
+    }
+    namespace FS = std::filesystem;
+    std::error_code ec;
+    return FS::is_directory(FS::path(folderpath), ec);
+}
+
+bool GetFileView(const std::string& filePath, const unsigned char*& out_data, std::size_t& out_size) {
+    std::shared_lock<std::shared_mutex> read_lock(s_mounted_packs_mutex);
+    return GetMountedFileView(filePath, out_data, out_size);
+}
+
+std::vector<std::string> EnumerateFiles(const std::string& folderpath, bool recursive /*= false*/) {
+    std::vector<std::string> result;
+    {
+        std::shared_lock<std::shared_mutex> read_lock(s_mounted_packs_mutex);
+        for(auto& pack : s_mounted_packs) {
+            pack->EnumerateFiles(folderpath, recursive, result);
+        }
+    }
+
+    namespace FS = std::filesystem;
+    FS::path p(folderpath);
+    { //Avoid pollution by error code.
+        std::error_code ec;
+        if(!FS::is_directory(p, ec)) {
+            return result;
+        }
+    }
+    std::set<std::string> packed_paths;
+    for(auto& packed_path : result) {
+        packed_paths.insert(PackFile::NormalizePath(packed_path));
+    }
+    auto add_loose_file = [&](const FS::path& current_path) {
+        if(FS::is_directory(current_path)) return;
+        if(!packed_paths.empty() && packed_paths.count(PackFile::NormalizePath(current_path.string()))) return;
+        result.push_back(current_path.string());
+    };
+    if(!recursive) {
+        for(FS::directory_iterator dir_iter(p); dir_iter != FS::directory_iterator{} /* defaults to end iter */; ++dir_iter) {
+            add_loose_file(dir_iter->path());
+        }
+    } else {
+        for(FS::recursive_directory_iterator dir_iter(p); dir_iter != FS::recursive_directory_iterator{} /* defaults to end iter */; ++dir_iter) {
+            add_loose_file(dir_iter->path());
+        }
+    }
+    return result;
+}
+
 bool constexpr IsBigEndian() {
     return (reinterpret_cast<const char*>(&ENDIAN_CHECK))[0] == 0x01;
 }
@@ -144,6 +278,18 @@ std::size_t BinaryStream::read_bytes_endian_aware(void* bytes, std::size_t count
     }
     return bytes_read;
 }
+bool BinaryStream::is_seekable() const {
+    return false;
+}
+
+bool BinaryStream::seek_read(std::size_t /*position*/) {
+    return false;
+}
+
+std::size_t BinaryStream::tell_read() const {
+    return 0;
+}
+
 void BinaryStream::CopyReversed(unsigned char* copy, const void* bytes, std::size_t count) const {
     copy = const_cast<unsigned char*>(reinterpret_cast<const unsigned char*>(bytes));
     std::size_t last_index = count - 1u;
@@ -344,6 +490,22 @@ std::size_t FileBinaryStream::write_bytes(const void* buffer, const std::size_t
 
     return bytes_read;
 }
+bool FileBinaryStream::is_seekable() const {
+    return is_open();
+}
+bool FileBinaryStream::seek_read(std::size_t position) {
+    if(!is_open()) {
+        return false;
+    }
+    return _fseeki64(file_pointer, static_cast<long long>(position), SEEK_SET) == 0;
+}
+std::size_t FileBinaryStream::tell_read() const {
+    if(!is_open()) {
+        return 0;
+    }
+    long long position = _ftelli64(file_pointer);
+    return position < 0 ? 0 : static_cast<std::size_t>(position);
+}
 bool FileBinaryStream::is_open() const {
     return file_pointer != nullptr;
 }
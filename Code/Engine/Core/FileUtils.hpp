@@ -22,8 +22,34 @@ namespace Net {
 namespace FileUtils {
 
 bool WriteBufferToFile(void* buffer, std::size_t size, const std::string& filePath);
+
+//Reads from the first mounted pack file that contains filePath, otherwise from disk.
 bool ReadBufferFromFile(std::vector<unsigned char>& out_buffer, const std::string& filePath);
 
+//Always reads the loose file on disk, ignoring mounted pack files.
+bool ReadBufferFromDisk(std::vector<unsigned char>& out_buffer, const std::string& filePath);
+
+//------------------------------------------------------------------------------
+// VIRTUAL FILE SYSTEM
+//------------------------------------------------------------------------------
+// Mounted pack files are searched in mount order before falling back to
+// loose files on disk, so development builds keep working without a pack.
+// Lookups may run on any thread while packs are mounted or unmounted.
+
+bool MountPackFile(const std::string& pack_filepath);
+void UnmountPackFile(const std::string& pack_filepath);
+void UnmountAllPackFiles();
+
+bool FileExists(const std::string& filePath);
+bool FolderExists(const std::string& folderpath);
+
+//Zero-copy access to a file stored in a mounted pack file. Returns false for loose files.
+//The view stays valid until that pack file is unmounted; prefer ReadBufferFromFile off the main thread.
+bool GetFileView(const std::string& filePath, const unsigned char*& out_data, std::size_t& out_size);
+
+//Packed files first, then loose files not already found in a pack.
+std::vector<std::string> EnumerateFiles(const std::string& folderpath, bool recursive = false);
+
 static constexpr uint32_t ENDIAN_CHECK = 0x01020304;
 
 bool constexpr IsBigEndian();
@@ -74,6 +100,12 @@ public:
 
     std::size_t read_bytes_endian_aware(void* bytes, std::size_t count);
 
+    //Streams that can reposition their read cursor override these.
+    //The defaults report the stream as forward-only.
+    virtual bool is_seekable() const;
+    virtual bool seek_read(std::size_t position);
+    virtual std::size_t tell_read() const;
+
 protected:
     void CopyReversed(unsigned char* copy, const void* bytes, std::size_t count) const;
 private:
@@ -183,6 +215,15 @@ public:
     //----------------------------------------------------------------------------
     virtual std::size_t write_bytes(const void* buffer, const std::size_t size) const override;
 
+    //----------------------------------------------------------------------------
+    virtual bool is_seekable() const override;
+
+    //----------------------------------------------------------------------------
+    virtual bool seek_read(std::size_t position) override;
+
+    //----------------------------------------------------------------------------
+    virtual std::size_t tell_read() const override;
+
     //----------------------------------------------------------------------------
     bool is_open() const;
 
@@ -0,0 +1,114 @@
+#include "Engine/Core/FixedStepScheduler.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/Clock.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+namespace {
+
+int64_t HzToStepTicks(float hz) {
+    GUARANTEE_OR_DIE(hz > 0.0f, "FixedStepScheduler: step rate must be positive.");
+    return (std::max)(Clock::SecondsToTicks(1.0 / hz), int64_t{ 1 });
+}
+
+}
+
+FixedStepScheduler::FixedStepScheduler(Clock& clock)
+    : _clock(&clock)
+    , _last_clock_ticks(clock.GetTotalTicks())
+    , _steps{}
+    , _next_id(INVALID_STEP_ID + 1)
+    , _updating(false)
+{
+    /* DO NOTHING */
+}
+
+FixedStepScheduler::~FixedStepScheduler() {
+    _clock = nullptr; //Observing pointer
+}
+
+FixedStepScheduler::step_id FixedStepScheduler::Register(float hz, const step_cb& cb, unsigned int max_steps_per_update /*= 4*/) {
+    auto step = std::make_unique<fixed_step_t>();
+    step->id = _next_id++;
+    if(_next_id == INVALID_STEP_ID) {
+        ++_next_id;
+    }
+    step->cb = cb;
+    step->step_ticks = HzToStepTicks(hz);
+    step->max_steps = (std::max)(max_steps_per_update, 1u);
+    step_id id = step->id;
+    _steps.push_back(std::move(step));
+    return id;
+}
+
+void FixedStepScheduler::Unregister(step_id id) {
+    fixed_step_t* step = Find(id);
+    if(!step) {
+        return;
+    }
+    if(_updating) {
+        step->removed = true;
+        return;
+    }
+    _steps.erase(std::remove_if(_steps.begin(), _steps.end(), [id](const std::unique_ptr<fixed_step_t>& s) { return s->id == id; }), _steps.end());
+}
+
+void FixedStepScheduler::SetRate(step_id id, float hz) {
+    if(fixed_step_t* step = Find(id)) {
+        step->step_ticks = HzToStepTicks(hz);
+        step->accumulated_ticks = (std::min)(step->accumulated_ticks, step->step_ticks - 1);
+    }
+}
+
+void FixedStepScheduler::Update() {
+    int64_t now = _clock->GetTotalTicks();
+    int64_t elapsed = now - _last_clock_ticks;
+    _last_clock_ticks = now;
+    if(elapsed <= 0) {
+        return;
+    }
+    _updating = true;
+    //Only steps registered before this Update run; ones added by callbacks wait a frame.
+    const std::size_t step_count = _steps.size();
+    for(std::size_t i = 0; i < step_count; ++i) {
+        fixed_step_t* step = _steps[i].get();
+        if(step->removed) {
+            continue;
+        }
+        step->accumulated_ticks += elapsed;
+        const float step_seconds = static_cast<float>(Clock::TicksToSeconds(step->step_ticks));
+        unsigned int steps_run = 0;
+        while(step->accumulated_ticks >= step->step_ticks && !step->removed) {
+            if(steps_run == step->max_steps) {
+                uint64_t behind = static_cast<uint64_t>(step->accumulated_ticks / step->step_ticks);
+                step->dropped_steps += behind;
+                step->accumulated_ticks -= static_cast<int64_t>(behind) * step->step_ticks;
+                break;
+            }
+            step->accumulated_ticks -= step->step_ticks;
+            ++steps_run;
+            step->cb(step_seconds);
+        }
+    }
+    _updating = false;
+    _steps.erase(std::remove_if(_steps.begin(), _steps.end(), [](const std::unique_ptr<fixed_step_t>& s) { return s->removed; }), _steps.end());
+}
+
+float FixedStepScheduler::GetAlpha(step_id id) const {
+    fixed_step_t* step = Find(id);
+    if(!step) {
+        return 0.0f;
+    }
+    return static_cast<float>(static_cast<double>(step->accumulated_ticks) / static_cast<double>(step->step_ticks));
+}
+
+uint64_t FixedStepScheduler::GetDroppedStepCount(step_id id) const {
+    fixed_step_t* step = Find(id);
+    return step ? step->dropped_steps : 0;
+}
+
+FixedStepScheduler::fixed_step_t* FixedStepScheduler::Find(step_id id) const {
+    auto found = std::find_if(_steps.begin(), _steps.end(), [id](const std::unique_ptr<fixed_step_t>& s) { return s->id == id && !s->removed; });
+    return found != _steps.end() ? found->get() : nullptr;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Clock;
+
+//Runs callbacks at fixed rates off a Clock, for work that needs a constant step such as
+//physics or NetObjectSystem::SystemStep:
+//    scheduler.Register(20.0f, [](float) { Net::NetObjectSystem::SystemStep(); });
+//Time is accumulated in integer clock ticks, so rates stay exact over long sessions.
+//When a callback falls behind it catches up with extra steps, at most max_steps_per_update
+//per Update; time beyond that is dropped so a slow step cannot spiral.
+class FixedStepScheduler {
+public:
+    using step_cb = std::function<void(float stepSeconds)>;
+    using step_id = unsigned int;
+    static constexpr step_id INVALID_STEP_ID = 0;
+
+    explicit FixedStepScheduler(Clock& clock);
+    ~FixedStepScheduler();
+
+    //Safe to call from a step callback; the new step starts on the next Update.
+    step_id Register(float hz, const step_cb& cb, unsigned int max_steps_per_update = 4);
+    //Safe to call from a step callback, including the step's own.
+    void Unregister(step_id id);
+    void SetRate(step_id id, float hz);
+
+    //Runs every step that is due. Call once per frame after the clock advances.
+    void Update();
+
+    //How far the clock is into the step's next period, in [0, 1). For interpolating between steps.
+    float GetAlpha(step_id id) const;
+    //Steps skipped so far because they could not be caught up.
+    uint64_t GetDroppedStepCount(step_id id) const;
+
+protected:
+private:
+    struct fixed_step_t {
+        step_id id = INVALID_STEP_ID;
+        step_cb cb{};
+        int64_t step_ticks = 0;
+        int64_t accumulated_ticks = 0;
+        unsigned int max_steps = 0;
+        uint64_t dropped_steps = 0;
+        bool removed = false;
+    };
+
+    fixed_step_t* Find(step_id id) const;
+
+    Clock* _clock;
+    int64_t _last_clock_ticks;
+    //Steps are heap-allocated so callbacks can register more mid-update.
+    std::vector<std::unique_ptr<fixed_step_t>> _steps;
+    step_id _next_id;
+    bool _updating;
+};
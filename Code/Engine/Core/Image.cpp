@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
 
 #include "ThirdParty/stb/stb_image.h"
 
@@ -14,7 +15,13 @@ Image::Image(const std::string& filePath)
     , m_filepath(filePath)
     , m_memload(false)
 {
-    m_texelBytes = stbi_load(m_filepath.c_str(), &m_dimensions.x, &m_dimensions.y, &m_bytesPerTexel, 4);
+    const unsigned char* packed_data = nullptr;
+    std::size_t packed_size = 0;
+    if(FileUtils::GetFileView(m_filepath, packed_data, packed_size)) {
+        m_texelBytes = stbi_load_from_memory(packed_data, static_cast<int>(packed_size), &m_dimensions.x, &m_dimensions.y, &m_bytesPerTexel, 4);
+    } else {
+        m_texelBytes = stbi_load(m_filepath.c_str(), &m_dimensions.x, &m_dimensions.y, &m_bytesPerTexel, 4);
+    }
     std::ostringstream ss;
     ss << "Failed to load image. " << m_filepath << " is not a supported image type.";
     ASSERT_OR_DIE(m_texelBytes != nullptr, ss.str());
@@ -1,5 +1,8 @@
 #include "Engine/Core/JobSystem.hpp"
 
+#include <algorithm>
+#include <atomic>
+
 #include "Engine/Core/Atomic.hpp"
 #include "Engine/Core/Signal.hpp"
 #include "Engine/Core/Time.hpp"
@@ -19,6 +22,19 @@ static void GenericJobThread(Signal *signal) {
     }
 }
 
+//Dedicated to blocking file reads so they never stall generic work.
+static void IOJobThread(Signal *signal) {
+    JobConsumer jc;
+    if(g_theJobSystem) {
+        jc.add_category(JobType::JOBTYPE_IO);
+        while(g_theJobSystem && g_theJobSystem->is_running) {
+            signal->wait();
+            jc.consume_all();
+        }
+        jc.consume_all();
+    }
+}
+
 void JobSystem::BeginFrame() {
     MainStep();
 }
@@ -35,6 +51,7 @@ JobSystem::JobSystem()
     , main_consumer(nullptr)
     , io_consumer(nullptr)
     , queue_count(0)
+    , generic_worker_count(0)
     , is_running(false)
     , mainJobSignal(nullptr)
 {
@@ -47,6 +64,9 @@ JobSystem::~JobSystem() {
     delete generic_consumer;
     generic_consumer = nullptr;
 
+    delete io_consumer;
+    io_consumer = nullptr;
+
     for(std::size_t i = 0; i < JOBTYPE_MAX; ++i) {
         if(signals[i] == nullptr) {
             continue;
@@ -66,12 +86,13 @@ JobSystem::~JobSystem() {
     signals.clear();
 
     queue_count = 0;
+    generic_worker_count = 0;
     is_running = false;
 
 }
 
 
-void JobSystem::Startup(int generic_thread_count, unsigned int category_count, Signal* mainJobSignal) {
+void JobSystem::Startup(int generic_thread_count, unsigned int category_count, Signal* mainJobSignal, unsigned int io_thread_count /*= 2*/) {
     int core_count = static_cast<int>(std::thread::hardware_concurrency());
     if(generic_thread_count <= 0) {
         core_count += generic_thread_count;
@@ -84,6 +105,7 @@ void JobSystem::Startup(int generic_thread_count, unsigned int category_count, S
     g_theJobSystem->queues.resize(category_count);
     g_theJobSystem->signals.resize(category_count);
     g_theJobSystem->queue_count = category_count;
+    g_theJobSystem->generic_worker_count = 1u + static_cast<unsigned int>((std::max)(core_count, 0));
     g_theJobSystem->is_running = true;
 
     for(unsigned int i = 0; i < category_count; ++i) {
@@ -114,6 +136,20 @@ void JobSystem::Startup(int generic_thread_count, unsigned int category_count, S
         std::thread t(GenericJobThread, g_theJobSystem->signals[JOBTYPE_GENERIC]);
         t.detach();
     }
+
+    if(io_thread_count == 0 || JOBTYPE_IO >= category_count) {
+        return;
+    }
+    g_theJobSystem->signals[JOBTYPE_IO] = new Signal();
+
+    JobConsumer* io_consumer = new JobConsumer();
+    io_consumer->add_category(JOBTYPE_IO);
+    g_theJobSystem->io_consumer = io_consumer;
+
+    for(unsigned int i = 0; i < io_thread_count; ++i) {
+        std::thread t(IOJobThread, g_theJobSystem->signals[JOBTYPE_IO]);
+        t.detach();
+    }
 }
 
 void JobSystem::Shutdown() {
@@ -184,6 +220,42 @@ void JobSystem::WaitAndRelease(Job* job) {
     JobSystem::Release(job);
 }
 
+std::size_t JobSystem::CalcSliceCount(std::size_t count, std::size_t min_per_slice) {
+    if(!g_theJobSystem || count < 2 * min_per_slice) {
+        return 1;
+    }
+    const std::size_t thread_count = g_theJobSystem->generic_worker_count + std::size_t{1};
+    return (std::min)(thread_count, count / min_per_slice);
+}
+
+std::size_t JobSystem::CalcSliceBegin(std::size_t count, std::size_t slice_count, std::size_t slice) {
+    return count * slice / slice_count;
+}
+
+void JobSystem::ForEachSlice(std::size_t count, std::size_t slice_count, const slice_work_cb& work) {
+    if(slice_count <= 1) {
+        work(0, count, 0);
+        return;
+    }
+    std::atomic<std::size_t> remaining{slice_count - 1};
+    for(std::size_t slice = 0; slice + 1 < slice_count; ++slice) {
+        const std::size_t begin = CalcSliceBegin(count, slice_count, slice);
+        const std::size_t end = CalcSliceBegin(count, slice_count, slice + 1);
+        Run(JobType::JOBTYPE_GENERIC, [&work, &remaining, begin, end, slice](void* /*user_data*/) {
+            work(begin, end, slice);
+            remaining.fetch_sub(1, std::memory_order_release);
+        }, nullptr);
+    }
+    work(CalcSliceBegin(count, slice_count, slice_count - 1), count, slice_count - 1);
+    JobConsumer helper;
+    helper.add_category(JobType::JOBTYPE_GENERIC);
+    while(remaining.load(std::memory_order_acquire) != 0) {
+        if(!helper.consume_job()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
 std::size_t JobSystem::GetLiveJobCount() {
     std::size_t count = 0;
     for(auto& i : this->queues) {
@@ -224,7 +296,8 @@ bool JobConsumer::consume_job() {
         job->work_cb(job->user_data);
         job->on_finish();
         job->state = JOBSTATE_FINISHED;
-        delete job;
+        //Drops the reference Dispatch took; whoever releases last deletes the job.
+        JobSystem::Release(job);
     }
     return true;
 }
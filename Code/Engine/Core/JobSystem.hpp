@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <thread>
 #include <vector>
 
@@ -29,6 +31,8 @@ enum JobState : unsigned int {
 
 //typedef void(*job_work_cb)(void*);
 typedef std::function<void(void*)> job_work_cb;
+//Called with [begin, end) and the slice's index.
+typedef std::function<void(std::size_t, std::size_t, std::size_t)> slice_work_cb;
 
 class Job {
 public:
@@ -65,7 +69,7 @@ public:
 
 class JobSystem : public EngineSubsystem {
 public:
-    static void Startup(int generic_thread_count, unsigned int category_count, Signal* mainJobSignal);
+    static void Startup(int generic_thread_count, unsigned int category_count, Signal* mainJobSignal, unsigned int io_thread_count = 2);
     static void Shutdown();
 
     static void MainStep();
@@ -82,6 +86,16 @@ public:
 
     static void WaitAndRelease(Job* job);
 
+    //One slice per generic worker plus one for the caller at most, each of at least
+    //min_per_slice items. 1 when the job system is not running or the work is too small
+    //to be worth splitting.
+    static std::size_t CalcSliceCount(std::size_t count, std::size_t min_per_slice);
+    static std::size_t CalcSliceBegin(std::size_t count, std::size_t slice_count, std::size_t slice);
+    //Calls work on slice_count consecutive slices of [0, count) and returns when all are done.
+    //All but the last slice run as generic jobs. The calling thread runs the last one and then
+    //works through queued generic jobs, so a call from inside a job cannot starve.
+    static void ForEachSlice(std::size_t count, std::size_t slice_count, const slice_work_cb& work);
+
     std::size_t GetLiveJobCount();
     std::size_t GetActiveJobCount();
 
@@ -99,5 +113,7 @@ public:
     JobConsumer* io_consumer;
     Signal* mainJobSignal;
     unsigned int queue_count;
+    //Generic job threads started by Startup.
+    unsigned int generic_worker_count;
     bool is_running;
 };
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "Engine/Core/KerningFont.hpp"
 
+#include <algorithm>
 #include <filesystem>
-#include <map>
 #include <string>
 #include <sstream>
 #include <tuple>
@@ -10,13 +10,17 @@
 
 #include "ThirdParty/TinyXML2/tinyxml2.h"
 
+#include "Engine/Core/DataUtils.hpp"
 #include "Engine/core/ErrorWarningAssert.hpp"
 
 KerningFont::KerningFont()
     : _image_paths{}
     , _filepath{}
-    , _charmap()
-    , _kernmap()
+    , _dense_glyphs(DENSE_GLYPH_COUNT)
+    , _sparse_glyphs{}
+    , _fallback_glyph()
+    , _kernings{}
+    , _kerning_mask(0)
     , _info()
     , _common()
 {
@@ -27,28 +31,18 @@ KerningFont::~KerningFont() {
     _image_paths.clear();
 }
 
-float KerningFont::CalculateTextHeight(const std::string& str, float scale /*= 1.0f*/) {
+float KerningFont::CalculateTextHeight(std::string_view str, float scale /*= 1.0f*/) const {
     return static_cast<float>((1 + std::count(str.begin(), str.end(), '\n')) * GetLineHeight() * scale);
 }
 
-float KerningFont::CalculateTextWidth(const std::string& text, float scale /*= 1.0f*/) {
-
-    float cursor_x = 0;
-
-    for(auto char_iter = text.begin(); char_iter != text.end(); /* DO NOTHING */) {
-        KerningFont::CharDef current_charDef = GetCharDef(*char_iter);
-
-        auto previous_char = char_iter++;
-        float kern_value = 0.0f;
-        if(char_iter != text.end()) {
-            auto kern_iter = _kernmap.find(std::make_pair(*previous_char, *char_iter));
-            if(kern_iter != _kernmap.end()) {
-                kern_value = static_cast<float>(kern_iter->second);
-            }
-            cursor_x += (current_charDef.xadvance + kern_value);
-        } else {
-            KerningFont::CharDef previous_charDef = GetCharDef(*previous_char);
-            cursor_x += (previous_charDef.xadvance);
+float KerningFont::CalculateTextWidth(std::string_view text, float scale /*= 1.0f*/) const {
+    float cursor_x = 0.0f;
+    const std::size_t count = text.size();
+    for(std::size_t i = 0; i < count; ++i) {
+        const CharDef& current_charDef = GetGlyph(text[i]);
+        cursor_x += static_cast<float>(current_charDef.xadvance);
+        if(i + 1 < count) {
+            cursor_x += static_cast<float>(GetKerning(static_cast<unsigned char>(text[i]), static_cast<unsigned char>(text[i + 1])));
         }
     }
     return cursor_x * scale;
@@ -63,15 +57,67 @@ float KerningFont::GetLineHeightAsUV() const {
 }
 
 KerningFont::CharDef KerningFont::GetCharDef(int ch) const {
-    auto chardef_iter = _charmap.find(ch);
-    if(chardef_iter == _charmap.end()) {
-        chardef_iter = _charmap.find(-1);
-        if(chardef_iter == _charmap.end()) {
-            return CharDef();
+    return GetGlyph(ch);
+}
+
+const KerningFont::CharDef& KerningFont::GetSparseGlyph(int codepoint) const {
+    auto found = _sparse_glyphs.find(codepoint);
+    return found != _sparse_glyphs.end() ? found->second : _fallback_glyph;
+}
+
+int KerningFont::GetKerning(int first, int second) const {
+    if(_kernings.empty()) {
+        return 0;
+    }
+    const uint64_t key = MakeKerningKey(first, second);
+    //Fibonacci hashing spreads the packed pair across the table.
+    std::size_t slot = static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & _kerning_mask;
+    for(;;) {
+        const kerning_entry_t& entry = _kernings[slot];
+        if(entry.key == key) {
+            return entry.amount;
+        }
+        if(entry.key == EMPTY_KERNING_KEY) {
+            return 0;
+        }
+        slot = (slot + 1) & _kerning_mask;
+    }
+}
+
+void KerningFont::BuildGlyphTables(const std::unordered_map<int, CharDef>& glyphs) {
+    auto fallback = glyphs.find(-1);
+    _fallback_glyph = fallback != glyphs.end() ? fallback->second : CharDef();
+    _dense_glyphs.assign(DENSE_GLYPH_COUNT, _fallback_glyph);
+    _sparse_glyphs.clear();
+    for(const auto& glyph : glyphs) {
+        if(0 <= glyph.first && glyph.first < DENSE_GLYPH_COUNT) {
+            _dense_glyphs[glyph.first] = glyph.second;
+        } else if(glyph.first != -1) {
+            _sparse_glyphs.insert(glyph);
+        }
+    }
+}
+
+void KerningFont::BuildKerningTable(const std::vector<std::pair<uint64_t, int>>& kernings) {
+    _kernings.clear();
+    _kerning_mask = 0;
+    if(kernings.empty()) {
+        return;
+    }
+    //At most half full so probes stay short.
+    std::size_t capacity = 16;
+    while(capacity < kernings.size() * 2) {
+        capacity *= 2;
+    }
+    _kernings.assign(capacity, kerning_entry_t{ EMPTY_KERNING_KEY, 0 });
+    _kerning_mask = capacity - 1;
+    for(const auto& kerning : kernings) {
+        std::size_t slot = static_cast<std::size_t>((kerning.first * 0x9E3779B97F4A7C15ull) >> 32) & _kerning_mask;
+        while(_kernings[slot].key != EMPTY_KERNING_KEY && _kernings[slot].key != kerning.first) {
+            slot = (slot + 1) & _kerning_mask;
         }
-        return chardef_iter->second;
+        _kernings[slot] = kerning_entry_t{ kerning.first, kerning.second };
     }
-    return chardef_iter->second;
 }
 
 KerningFont::CommonDef KerningFont::GetCommonDef() const {
@@ -87,7 +133,7 @@ bool KerningFont::LoadFromFile(const std::string& filepath) {
     _filepath = filepath;
 
     tinyxml2::XMLDocument doc;
-    tinyxml2::XMLError doc_result = doc.LoadFile(filepath.c_str());
+    tinyxml2::XMLError doc_result = DataUtils::LoadXmlDocument(doc, filepath);
     if(doc_result != tinyxml2::XML_SUCCESS) {
         return false;
     }
@@ -215,7 +261,7 @@ bool KerningFont::LoadFromFile(const std::string& filepath) {
     }
 
     {//Scope constraint
-        namespace FS = std::experimental::filesystem;
+        namespace FS = std::filesystem;
         FS::path p("Data/Fonts/");
         for(auto xml_page = xml_pages->FirstChildElement("page"); xml_page != nullptr; xml_page = xml_page->NextSiblingElement("page")) {
             unsigned int page_id = xml_page->UnsignedAttribute("id");
@@ -231,8 +277,9 @@ bool KerningFont::LoadFromFile(const std::string& filepath) {
         return false;
     }
     unsigned int char_count = xml_chars->UnsignedAttribute("count");
-    char_count; //UNUSED
 
+    std::unordered_map<int, CharDef> glyphs{};
+    glyphs.reserve(char_count);
     for(auto xml_char = xml_chars->FirstChildElement("char"); xml_char != nullptr; xml_char = xml_char->NextSiblingElement("char")) {
         int id = xml_char->IntAttribute("id");
         CharDef t;
@@ -246,9 +293,11 @@ bool KerningFont::LoadFromFile(const std::string& filepath) {
         t.page = xml_char->IntAttribute("page");
         t.channel = xml_char->IntAttribute("chnl");
 
-        _charmap.insert_or_assign(id, t);
+        glyphs.insert_or_assign(id, t);
     }
+    BuildGlyphTables(glyphs);
 
+    std::vector<std::pair<uint64_t, int>> kernings{};
     auto xml_kernings = xml_root->FirstChildElement("kernings");
     if(xml_kernings) {
         for(auto xml_kern = xml_kernings->FirstChildElement("kerning"); xml_kern != nullptr; xml_kern = xml_kern->NextSiblingElement("kerning")) {
@@ -256,9 +305,10 @@ bool KerningFont::LoadFromFile(const std::string& filepath) {
             int second = xml_kern->IntAttribute("second");
             int amount = xml_kern->IntAttribute("amount");
 
-            _kernmap.insert_or_assign(std::make_pair(first, second), amount);
+            kernings.emplace_back(MakeKerningKey(first, second), amount);
         }
     }
+    BuildKerningTable(kernings);
 
 
     return true;
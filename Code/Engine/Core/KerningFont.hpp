@@ -1,7 +1,9 @@
 #pragma once
 
-#include <map>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 class KerningFont {
@@ -68,22 +70,56 @@ public:
 	KerningFont();
 	~KerningFont();
 
-    float CalculateTextHeight(const std::string& text, float scale = 1.0f);
-    float CalculateTextWidth(const std::string& text, float scale = 1.0f);
+    float CalculateTextHeight(std::string_view text, float scale = 1.0f) const;
+    float CalculateTextWidth(std::string_view text, float scale = 1.0f) const;
     int GetLineHeight() const;
     float GetLineHeightAsUV() const;
     CharDef GetCharDef(int ch) const;
+
+    //Glyph for codepoint, or the font's fallback glyph (id -1) if it has none.
+    //Codepoints below DENSE_GLYPH_COUNT are a direct array index.
+    const CharDef& GetGlyph(int codepoint) const {
+        if(0 <= codepoint && codepoint < DENSE_GLYPH_COUNT) {
+            return _dense_glyphs[codepoint];
+        }
+        return GetSparseGlyph(codepoint);
+    }
+    const CharDef& GetGlyph(char ch) const {
+        return _dense_glyphs[static_cast<unsigned char>(ch)];
+    }
+
+    //Kerning adjustment between two codepoints, 0 if the pair has none.
+    int GetKerning(int first, int second) const;
     CommonDef GetCommonDef() const;
     InfoDef GetInfoDef() const;
 protected:
 private:
-    using CharMap = std::map<int, CharDef>;
-    using KerningMap = std::map<std::pair<int, int>, int>;
+    static constexpr int DENSE_GLYPH_COUNT = 256;
+
+    //Open-addressed, linearly probed. Empty slots hold EMPTY_KERNING_KEY.
+    struct kerning_entry_t {
+        uint64_t key;
+        int amount;
+    };
+    static constexpr uint64_t EMPTY_KERNING_KEY = ~uint64_t{ 0 };
+
+    static uint64_t MakeKerningKey(int first, int second) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(first)) << 32) | static_cast<uint32_t>(second);
+    }
+
     bool LoadFromFile(const std::string& filepath);
+    const CharDef& GetSparseGlyph(int codepoint) const;
+    void BuildGlyphTables(const std::unordered_map<int, CharDef>& glyphs);
+    void BuildKerningTable(const std::vector<std::pair<uint64_t, int>>& kernings);
+
     std::vector<std::string> _image_paths;
     std::string _filepath;
-    CharMap _charmap;
-    KerningMap _kernmap;
+    //Missing dense entries hold a copy of the fallback glyph.
+    std::vector<CharDef> _dense_glyphs;
+    std::unordered_map<int, CharDef> _sparse_glyphs;
+    CharDef _fallback_glyph;
+    std::vector<kerning_entry_t> _kernings;
+    std::size_t _kerning_mask;
     InfoDef _info;
     CommonDef _common;
 
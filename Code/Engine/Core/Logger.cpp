@@ -91,7 +91,7 @@ void Logger::logWorker() {
 }
 
 void JobCopyLog(void* user_data) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     copy_log_job_t* data = (copy_log_job_t*)user_data;
     Logger* logger = data->logger;
     logger->GetStream().flush();
@@ -138,7 +138,7 @@ void Logger::SetIsRunning(bool isRunning /*= true*/) {
 }
 void Logger::LogStartup(const char* filepath) {
 
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     std::string f = (filepath == nullptr ? "" : filepath);
     FS::path p(f);
     FS::path parent_path = p.parent_path();
@@ -219,6 +219,14 @@ void Logger::LogTagf(const char* tag, const char* messageFormat, ...) {
 }
 
 void Logger::LogTagf_list(const char* tag, const char* messageFormat, va_list variableArgumentList) {
+    //disablemode = blacklist
+    bool foundTag = _tagList.find(StringId::Hashed(tag)) != _tagList.end();
+    bool enableMode = _logMode == Logger::LogMode::ENABLE;
+    bool shouldPush = (!foundTag && enableMode) || (foundTag && !enableMode);
+    if(!shouldPush) {
+        return;
+    }
+
     const int MESSAGE_MAX_LENGTH = 2048;
     char messageLiteral[MESSAGE_MAX_LENGTH];
     vsnprintf_s(messageLiteral, MESSAGE_MAX_LENGTH, _TRUNCATE, messageFormat, variableArgumentList);
@@ -229,14 +237,8 @@ void Logger::LogTagf_list(const char* tag, const char* messageFormat, va_list va
     InsertTag(msg, tag);
     InsertMessage(msg, messageLiteral);
 
-    //disablemode = blacklist
-    bool foundTag = _tagList.find(tag) != _tagList.end();
-    bool enableMode = _logMode == Logger::LogMode::ENABLE;
-    bool shouldPush = (!foundTag && enableMode) || (foundTag && !enableMode);
-    if(shouldPush) {
-        _workerQueue.push(msg.str());
-        _log_signal.notify_all();
-    }
+    _workerQueue.push(msg.str());
+    _log_signal.notify_all();
 }
 
 void Logger::InsertTimeStamp(std::stringstream& msg) {
@@ -289,10 +291,10 @@ void Logger::LogThreadTest(const std::string& path, unsigned int byte_size) {
 }
 
 void Logger::LogEnableTag(const char* tag) {
-    _tagList.erase(tag);
+    _tagList.erase(StringId::Hashed(tag));
 }
 void Logger::LogDisableTag(const char* tag) {
-    _tagList.insert(tag);
+    _tagList.insert(StringId(tag));
 }
 void Logger::LogFlushTest() {
     g_theFileLogger->Lock();
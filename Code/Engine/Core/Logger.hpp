@@ -10,6 +10,7 @@
 #include "Engine/Core/EngineSubsystem.hpp"
 #include "Engine/Core/CriticalSection.hpp"
 #include "Engine/Core/Signal.hpp"
+#include "Engine/Core/StringId.hpp"
 #include "Engine/Core/ThreadSafeQueue.hpp"
 
 class Logger : public EngineSubsystem {
@@ -66,7 +67,7 @@ protected:
     std::ofstream _stream;
     std::thread _thread;
     ThreadSafeQueue<std::string> _workerQueue;
-    std::set<std::string> _tagList;
+    std::set<StringId> _tagList;
     Signal _log_signal;
     Logger::LogMode _logMode;
     bool _isRunning;
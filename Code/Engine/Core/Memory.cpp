@@ -77,63 +77,54 @@ void Memory::TickMemoryProfiler() {
 }
 
 std::string Memory::GetFriendlyByteString(const std::size_t& bytes) {
+    char buffer[32];
+    return std::string(buffer, GetFriendlyByteString(bytes, buffer, sizeof(buffer)));
+}
+
+std::size_t Memory::GetFriendlyByteString(const std::size_t& bytes, char* buffer, std::size_t buffer_size) {
 
     const long double maxBytesAsKiB = MathUtils::ConvertKiBToBytes(2.0f);
     const long double maxBytesAsMiB = MathUtils::ConvertMiBToBytes(2.0f);
     const long double maxBytesAsGiB = MathUtils::ConvertGiBToBytes(2.0f);
 
-    const char* measurement = "GB";
-    bool useGB = bytes >= maxBytesAsGiB;
-    bool useMB = bytes < maxBytesAsGiB;
-    bool useKB = bytes < maxBytesAsMiB;
-
-    useGB = true;
-    useMB = false;
-    useKB = false;
-    if(bytes < maxBytesAsGiB) {
-        measurement = "MB";
-        useGB = false;
-        useMB = true;
-        useKB = false;
+    if(bytes < maxBytesAsKiB) {
+        return FormatTo(buffer, buffer_size, "{:.2}  B", static_cast<long double>(bytes));
     }
     if(bytes < maxBytesAsMiB) {
-        measurement = "KB";
-        useGB = false;
-        useMB = false;
-        useKB = true;
+        return FormatTo(buffer, buffer_size, "{:.2} KB", MathUtils::ConvertBytesToKiB(bytes));
     }
-    if(bytes < maxBytesAsKiB) {
-        measurement = " B";
-        useGB = false;
-        useMB = false;
-        useKB = false;
+    if(bytes < maxBytesAsGiB) {
+        return FormatTo(buffer, buffer_size, "{:.2} MB", MathUtils::ConvertBytesToMiB(bytes));
     }
-    return Stringf("%.2Lf %s", (useGB ? MathUtils::ConvertBytesToGiB(bytes)
-                             : (useMB ? MathUtils::ConvertBytesToMiB(bytes)
-                             : (useKB ? MathUtils::ConvertBytesToKiB(bytes)
-                             : (bytes))))
-                   , measurement);
+    return FormatTo(buffer, buffer_size, "{:.2} GB", MathUtils::ConvertBytesToGiB(bytes));
 }
 
 unsigned int Memory::PrintMemoryProfileData(SimpleRenderer* renderer, unsigned int line_idx) {
 
-    unsigned int tab_count = 0;
-    std::string tab_str(++tab_count * 2, ' ');
+    KerningFont* font = g_theConsole->GetFont();
+    float tab_width = static_cast<float>(font->CalculateTextWidth(std::string(2, ' ')));
+    float line_height = static_cast<float>(font->GetLineHeight());
 
-    std::string allocCount_str = std::to_string(GetAllocCount());
-    renderer->DrawTextLine(g_theConsole->GetFont(), std::string("Total Allocations: ") + allocCount_str, Rgba::WHITE, static_cast<float>(g_theConsole->GetFont()->CalculateTextWidth(tab_str)), line_idx++ * static_cast<float>(g_theConsole->GetFont()->GetLineHeight()));
+    //Lines are formatted on the stack; the one string DrawTextLine needs is reused for every line.
+    char line[128];
+    char bytes[32];
+    std::string line_str;
+    line_str.reserve(sizeof(line));
+    auto draw_line = [&](std::size_t length) {
+        line_str.assign(line, length);
+        renderer->DrawTextLine(font, line_str, Rgba::WHITE, tab_width, line_idx++ * line_height);
+    };
 
-    std::string friendlyBytes_str = GetFriendlyByteString(GetAllocBytes());
-    renderer->DrawTextLine(g_theConsole->GetFont(), std::string("Bytes Allocated: ") + friendlyBytes_str, Rgba::WHITE, static_cast<float>(g_theConsole->GetFont()->CalculateTextWidth(tab_str)), line_idx++ * static_cast<float>(g_theConsole->GetFont()->GetLineHeight()));
+    draw_line(FormatTo(line, "Total Allocations: {}", GetAllocCount()));
 
-    std::string allocHW_str = GetFriendlyByteString(GetAllocHighWater());
-    renderer->DrawTextLine(g_theConsole->GetFont(), std::string("Peak Bytes Allocated: ") + allocHW_str, Rgba::WHITE, static_cast<float>(g_theConsole->GetFont()->CalculateTextWidth(tab_str)), line_idx++ * static_cast<float>(g_theConsole->GetFont()->GetLineHeight()));
+    GetFriendlyByteString(GetAllocBytes(), bytes, sizeof(bytes));
+    draw_line(FormatTo(line, "Bytes Allocated: {}", bytes));
 
-    std::string allocFrameAlloc_str = std::to_string(GetPrevFrameAllocs());
-    renderer->DrawTextLine(g_theConsole->GetFont(), std::string("Allocations last frame: ") + allocFrameAlloc_str, Rgba::WHITE, static_cast<float>(g_theConsole->GetFont()->CalculateTextWidth(tab_str)), line_idx++ * static_cast<float>(g_theConsole->GetFont()->GetLineHeight()));
+    GetFriendlyByteString(GetAllocHighWater(), bytes, sizeof(bytes));
+    draw_line(FormatTo(line, "Peak Bytes Allocated: {}", bytes));
 
-    std::string allocFrameFree_str = std::to_string(GetPrevFrameFrees());
-    renderer->DrawTextLine(g_theConsole->GetFont(), std::string("Frees last frame: ") + allocFrameFree_str, Rgba::WHITE, static_cast<float>(g_theConsole->GetFont()->CalculateTextWidth(tab_str)), line_idx++ * static_cast<float>(g_theConsole->GetFont()->GetLineHeight()));
+    draw_line(FormatTo(line, "Allocations last frame: {}", GetPrevFrameAllocs()));
+    draw_line(FormatTo(line, "Frees last frame: {}", GetPrevFrameFrees()));
     return line_idx;
 }
 
@@ -34,6 +34,8 @@ allocation_t* GetAllocationList();
 void TickMemoryProfiler();
 
 std::string GetFriendlyByteString(const std::size_t& bytes);
+//Writes into buffer without allocating. Returns the number of characters written.
+std::size_t GetFriendlyByteString(const std::size_t& bytes, char* buffer, std::size_t buffer_size);
 
 void PrintBasicMemoryProfile(SimpleRenderer* renderer);
 void PrintVerboseMemoryProfile(SimpleRenderer* renderer);
@@ -0,0 +1,378 @@
+#include "Engine/Core/PackFile.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+
+#include "Engine/EngineConfig.hpp"
+
+namespace FileUtils {
+
+namespace {
+
+//Forward slashes, no leading "./", no repeated separators. Case is preserved.
+std::string CleanPath(const std::string& filepath) {
+    std::string result;
+    result.reserve(filepath.size());
+    for(auto c : filepath) {
+        if(c == '\\') {
+            c = '/';
+        }
+        if(c == '/' && !result.empty() && result.back() == '/') {
+            continue;
+        }
+        result.push_back(c);
+    }
+    while(result.size() > 1 && result[0] == '.' && result[1] == '/') {
+        result.erase(0, 2);
+    }
+    return result;
+}
+
+char NormalizeChar(char c) {
+    if(c == '\\') {
+        return '/';
+    }
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+//Compares a stored (cleaned) path against an already normalized path without allocating.
+bool IsSamePath(const char* stored, std::size_t stored_length, const std::string& normalized) {
+    if(stored_length != normalized.size()) {
+        return false;
+    }
+    for(std::size_t i = 0; i < stored_length; ++i) {
+        if(NormalizeChar(stored[i]) != normalized[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StartsWithFolder(const char* stored, std::size_t stored_length, const std::string& normalized_folder) {
+    if(stored_length <= normalized_folder.size()) {
+        return false;
+    }
+    for(std::size_t i = 0; i < normalized_folder.size(); ++i) {
+        if(NormalizeChar(stored[i]) != normalized_folder[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t AlignUp(uint64_t value, uint32_t alignment) {
+    return (value + (alignment - 1)) & ~static_cast<uint64_t>(alignment - 1);
+}
+
+bool WritePadding(FILE* file, uint64_t count) {
+    static const unsigned char zeroes[64] = { 0 };
+    while(count > 0) {
+        std::size_t chunk = static_cast<std::size_t>((std::min)(count, static_cast<uint64_t>(sizeof(zeroes))));
+        if(std::fwrite(zeroes, 1, chunk, file) != chunk) {
+            return false;
+        }
+        count -= chunk;
+    }
+    return true;
+}
+
+}
+
+PackFile::PackFile()
+    : _filepath{}
+    , _file_handle(INVALID_HANDLE_VALUE)
+    , _mapping_handle(nullptr)
+    , _view(nullptr)
+    , _view_size(0)
+    , _header(nullptr)
+    , _entries(nullptr)
+    , _paths(nullptr)
+{
+    /* DO NOTHING */
+}
+
+PackFile::~PackFile() {
+    Close();
+}
+
+bool PackFile::Open(const std::string& pack_filepath) {
+    ASSERT_OR_DIE(!IsOpen(), "PackFile::Open: PACK FILE ALREADY OPEN.");
+
+    HANDLE file = ::CreateFileA(pack_filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if(file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER file_size{};
+    if(!::GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(sizeof(PackHeader))) {
+        ::CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping == nullptr) {
+        ::CloseHandle(file);
+        return false;
+    }
+    void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(view == nullptr) {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return false;
+    }
+
+    _filepath = pack_filepath;
+    _file_handle = file;
+    _mapping_handle = mapping;
+    _view = reinterpret_cast<const unsigned char*>(view);
+    _view_size = static_cast<std::size_t>(file_size.QuadPart);
+    _header = reinterpret_cast<const PackHeader*>(_view);
+    _entries = reinterpret_cast<const PackEntry*>(_view + sizeof(PackHeader));
+    _paths = reinterpret_cast<const char*>(_view + _header->paths_offset);
+
+    if(!IsValidArchive()) {
+        std::ostringstream ss;
+        ss << "PackFile::Open: \"" << pack_filepath << "\" is not a valid pack file.\n";
+        g_theFileLogger->LogErrorf(ss.str().c_str());
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool PackFile::IsValidArchive() const {
+    if(_header->magic != PACK_MAGIC || _header->version != PACK_VERSION) {
+        return false;
+    }
+    if(_header->alignment == 0 || (_header->alignment & (_header->alignment - 1)) != 0) {
+        return false;
+    }
+    uint64_t table_end = sizeof(PackHeader) + static_cast<uint64_t>(_header->entry_count) * sizeof(PackEntry);
+    if(table_end > _view_size || _header->paths_offset < table_end || _header->paths_offset + _header->paths_size > _view_size) {
+        return false;
+    }
+    for(uint32_t i = 0; i < _header->entry_count; ++i) {
+        const PackEntry& entry = _entries[i];
+        if(static_cast<uint64_t>(entry.path_offset) + entry.path_length > _header->paths_size) {
+            return false;
+        }
+        if(entry.data_offset + entry.data_size > _view_size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PackFile::Close() {
+    if(_view) {
+        ::UnmapViewOfFile(_view);
+    }
+    if(_mapping_handle) {
+        ::CloseHandle(_mapping_handle);
+    }
+    if(_file_handle != INVALID_HANDLE_VALUE) {
+        ::CloseHandle(_file_handle);
+    }
+    _filepath.clear();
+    _file_handle = INVALID_HANDLE_VALUE;
+    _mapping_handle = nullptr;
+    _view = nullptr;
+    _view_size = 0;
+    _header = nullptr;
+    _entries = nullptr;
+    _paths = nullptr;
+}
+
+bool PackFile::IsOpen() const {
+    return _view != nullptr;
+}
+
+const std::string& PackFile::GetFilepath() const {
+    return _filepath;
+}
+
+std::size_t PackFile::GetEntryCount() const {
+    return IsOpen() ? _header->entry_count : 0;
+}
+
+bool PackFile::Contains(const std::string& filepath) const {
+    return FindEntry(filepath) != nullptr;
+}
+
+bool PackFile::GetFileView(const std::string& filepath, const unsigned char*& out_data, std::size_t& out_size) const {
+    const PackEntry* entry = FindEntry(filepath);
+    if(entry == nullptr) {
+        return false;
+    }
+    out_data = _view + entry->data_offset;
+    out_size = static_cast<std::size_t>(entry->data_size);
+    return true;
+}
+
+void PackFile::EnumerateFiles(const std::string& folderpath, bool recursive, std::vector<std::string>& out_paths) const {
+    if(!IsOpen()) {
+        return;
+    }
+    std::string folder = NormalizePath(folderpath);
+    if(!folder.empty() && folder.back() != '/') {
+        folder.push_back('/');
+    }
+    for(uint32_t i = 0; i < _header->entry_count; ++i) {
+        const PackEntry& entry = _entries[i];
+        const char* path = _paths + entry.path_offset;
+        if(!StartsWithFolder(path, entry.path_length, folder)) {
+            continue;
+        }
+        if(!recursive) {
+            const char* remainder_begin = path + folder.size();
+            const char* remainder_end = path + entry.path_length;
+            if(std::find(remainder_begin, remainder_end, '/') != remainder_end) {
+                continue;
+            }
+        }
+        out_paths.push_back(GetEntryPath(entry));
+    }
+}
+
+const PackEntry* PackFile::FindEntry(const std::string& filepath) const {
+    if(!IsOpen()) {
+        return nullptr;
+    }
+    std::string normalized = NormalizePath(filepath);
+    uint64_t hash = HashPath(normalized);
+    const PackEntry* first = _entries;
+    const PackEntry* last = _entries + _header->entry_count;
+    auto iter = std::lower_bound(first, last, hash, [](const PackEntry& entry, uint64_t value) { return entry.path_hash < value; });
+    for(/* DO NOTHING */; iter != last && iter->path_hash == hash; ++iter) {
+        if(IsSamePath(_paths + iter->path_offset, iter->path_length, normalized)) {
+            return iter;
+        }
+    }
+    return nullptr;
+}
+
+std::string PackFile::GetEntryPath(const PackEntry& entry) const {
+    return std::string(_paths + entry.path_offset, entry.path_length);
+}
+
+std::string PackFile::NormalizePath(const std::string& filepath) {
+    std::string result = CleanPath(filepath);
+    std::transform(result.begin(), result.end(), result.begin(), [](char c) { return NormalizeChar(c); });
+    return result;
+}
+
+//FNV-1a
+uint64_t PackFile::HashPath(const std::string& normalized_filepath) {
+    uint64_t hash = 14695981039346656037ull;
+    for(auto c : normalized_filepath) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool PackFile::Build(const std::string& folderpath, const std::string& pack_filepath, uint32_t alignment /*= PACK_DEFAULT_ALIGNMENT*/) {
+    namespace FS = std::filesystem;
+
+    if(alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return false;
+    }
+
+    FS::path p(folderpath);
+    { //Avoid pollution by error code.
+        std::error_code ec;
+        if(!FS::exists(p) || !FS::is_directory(p, ec)) {
+            std::ostringstream ss;
+            ss << "PackFile::Build: \"" << folderpath << "\" does not exist or is not a directory. Filesystem reported the following error: " << ec.message() << "\n";
+            g_theFileLogger->LogErrorf(ss.str().c_str());
+            return false;
+        }
+    }
+
+    struct build_entry_t {
+        std::string source_path;
+        std::string stored_path;
+        std::string normalized_path;
+        PackEntry entry;
+    };
+    std::vector<build_entry_t> build_entries;
+    for(FS::recursive_directory_iterator dir_iter(p); dir_iter != FS::recursive_directory_iterator{} /* defaults to end iter */; ++dir_iter) {
+        FS::path current_path = dir_iter->path();
+        if(FS::is_directory(current_path)) continue;
+        build_entry_t e{};
+        e.source_path = current_path.string();
+        e.stored_path = CleanPath(e.source_path);
+        e.normalized_path = NormalizePath(e.stored_path);
+        e.entry.path_hash = HashPath(e.normalized_path);
+        e.entry.data_size = static_cast<uint64_t>(FS::file_size(current_path));
+        build_entries.push_back(std::move(e));
+    }
+
+    std::sort(build_entries.begin(), build_entries.end(), [](const build_entry_t& a, const build_entry_t& b) {
+        return std::tie(a.entry.path_hash, a.normalized_path) < std::tie(b.entry.path_hash, b.normalized_path);
+    });
+    build_entries.erase(std::unique(build_entries.begin(), build_entries.end(), [](const build_entry_t& a, const build_entry_t& b) {
+        return a.normalized_path == b.normalized_path;
+    }), build_entries.end());
+
+    PackHeader header{};
+    header.magic = PACK_MAGIC;
+    header.version = PACK_VERSION;
+    header.entry_count = static_cast<uint32_t>(build_entries.size());
+    header.alignment = alignment;
+    header.paths_offset = sizeof(PackHeader) + build_entries.size() * sizeof(PackEntry);
+
+    uint64_t paths_size = 0;
+    for(auto& e : build_entries) {
+        e.entry.path_offset = static_cast<uint32_t>(paths_size);
+        e.entry.path_length = static_cast<uint32_t>(e.stored_path.size());
+        paths_size += e.stored_path.size();
+    }
+    header.paths_size = paths_size;
+
+    uint64_t data_offset = AlignUp(header.paths_offset + header.paths_size, alignment);
+    for(auto& e : build_entries) {
+        e.entry.data_offset = data_offset;
+        data_offset = AlignUp(data_offset + e.entry.data_size, alignment);
+    }
+
+    FILE* file = nullptr;
+    errno_t errorCode = fopen_s(&file, pack_filepath.c_str(), "wb");
+    if(errorCode != 0) return false;
+
+    bool success = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    for(auto iter = build_entries.begin(); success && iter != build_entries.end(); ++iter) {
+        success = std::fwrite(&iter->entry, sizeof(PackEntry), 1, file) == 1;
+    }
+    for(auto iter = build_entries.begin(); success && iter != build_entries.end(); ++iter) {
+        success = std::fwrite(iter->stored_path.data(), 1, iter->stored_path.size(), file) == iter->stored_path.size();
+    }
+    uint64_t written = header.paths_offset + header.paths_size;
+    std::vector<unsigned char> buffer;
+    for(auto iter = build_entries.begin(); success && iter != build_entries.end(); ++iter) {
+        success = WritePadding(file, iter->entry.data_offset - written);
+        success = success && ReadBufferFromDisk(buffer, iter->source_path) && buffer.size() == iter->entry.data_size;
+        success = success && std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+        written = iter->entry.data_offset + iter->entry.data_size;
+    }
+    success = success && !ferror(file);
+    fclose(file);
+
+    if(!success) {
+        std::ostringstream ss;
+        ss << "PackFile::Build: Failed to write \"" << pack_filepath << "\".\n";
+        g_theFileLogger->LogErrorf(ss.str().c_str());
+    }
+    return success;
+}
+
+}
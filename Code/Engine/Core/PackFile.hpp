@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace FileUtils {
+
+//------------------------------------------------------------------------------
+// PACK FILE
+//------------------------------------------------------------------------------
+// Layout (host order, little endian on every supported platform):
+//
+//  PackHeader
+//  PackEntry[entry_count]      sorted by (path_hash, normalized path)
+//  path table                  original paths, not null-terminated
+//  padding
+//  file data                   each entry starts on an 'alignment' boundary
+//
+// The whole archive is memory-mapped on open so a lookup is a binary search
+// over the entry table and a read is a pointer into the mapped view.
+//------------------------------------------------------------------------------
+
+static constexpr uint32_t PACK_MAGIC = 0x4B415047; //"GPAK"
+static constexpr uint32_t PACK_VERSION = 1;
+static constexpr uint32_t PACK_DEFAULT_ALIGNMENT = 16;
+
+struct PackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t alignment;
+    uint64_t paths_offset;
+    uint64_t paths_size;
+};
+
+struct PackEntry {
+    uint64_t path_hash;
+    uint64_t data_offset;
+    uint64_t data_size;
+    uint32_t path_offset;
+    uint32_t path_length;
+};
+
+class PackFile {
+public:
+    PackFile();
+    ~PackFile();
+
+    PackFile(const PackFile& other) = delete;
+    PackFile& operator=(const PackFile& other) = delete;
+
+    bool Open(const std::string& pack_filepath);
+    void Close();
+    bool IsOpen() const;
+
+    const std::string& GetFilepath() const;
+    std::size_t GetEntryCount() const;
+
+    bool Contains(const std::string& filepath) const;
+    bool GetFileView(const std::string& filepath, const unsigned char*& out_data, std::size_t& out_size) const;
+
+    //Appends the original paths of every entry inside folderpath.
+    void EnumerateFiles(const std::string& folderpath, bool recursive, std::vector<std::string>& out_paths) const;
+
+    //Packs every file under folderpath into a single archive at pack_filepath.
+    //Entries are stored with the path the engine would use to load them, i.e. folderpath + relative path.
+    static bool Build(const std::string& folderpath, const std::string& pack_filepath, uint32_t alignment = PACK_DEFAULT_ALIGNMENT);
+
+    static std::string NormalizePath(const std::string& filepath);
+    static uint64_t HashPath(const std::string& normalized_filepath);
+
+protected:
+private:
+    const PackEntry* FindEntry(const std::string& filepath) const;
+    std::string GetEntryPath(const PackEntry& entry) const;
+    bool IsValidArchive() const;
+
+    std::string _filepath;
+    void* _file_handle;
+    void* _mapping_handle;
+    const unsigned char* _view;
+    std::size_t _view_size;
+    const PackHeader* _header;
+    const PackEntry* _entries;
+    const char* _paths;
+};
+
+}
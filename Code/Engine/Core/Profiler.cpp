@@ -14,6 +14,7 @@
 #include "Engine/Core/KerningFont.hpp"
 #include "Engine/Core/Memory.hpp"
 #include "Engine/Core/Rgba.hpp"
+#include "Engine/Core/StringId.hpp"
 #include "Engine/Core/Time.hpp"
 
 #include "Engine/Math/AABB2.hpp"
@@ -35,7 +36,7 @@ Rgba GetHistoryColorFromFrameTime(double frame_time);
 void DeleteTree(profiler_node_t*& head);
 
 struct profiler_node_t {
-    std::string tagName;
+    StringId tagName;
     double startTime;
     double endTime;
     profiler_node_t* parent;
@@ -57,7 +58,7 @@ struct profiler_node_t {
 };
 
 struct profiler_data_t {
-    std::string tagName;
+    StringId tagName;
     std::size_t callCount;
     double selfTime;
     double totalTime;
@@ -188,7 +189,7 @@ void ProfilerReport::Log() {
 void ProfilerReport::PrintRow(const profiler_data_t* data) {
     std::ostringstream ss;
     ss << std::left;
-    ss << std::setw(60) << data->tagName;
+    ss << std::setw(60) << data->tagName.GetString();
     ss << std::setw(10) << data->callCount;
     ss << std::setw(10) << std::fixed << std::setprecision(2) << data->totalRatio * 100.0;
     ss << std::dec;
@@ -304,6 +305,8 @@ void Profiler::Render() const {
         return;
     }
 
+    //Overlay text is drawn together after the graphs.
+    _renderer->BeginTextBatch();
 #ifdef TRACK_MEMORY
     Memory::RenderMemoryGraph(_renderer);
     RenderProfilerGraph(_renderer);
@@ -315,6 +318,7 @@ void Profiler::Render() const {
 #else //Never gets called!
     Memory::PrintDisabledMemoryProfile(_renderer);
 #endif
+    _renderer->EndTextBatch();
 
 }
 
@@ -507,7 +511,7 @@ void Profiler::ProfilerPush(const char* tag) {
 
     profiler_node_t* node = new profiler_node_t;
 
-    node->tagName = tag;
+    node->tagName = StringId(tag);
     node->startTime = GetCurrentTimeSeconds();
     node->parent = _activeNode;
 
@@ -603,7 +607,7 @@ profiler_node_t* Profiler::ProfilerGetPreviousFrame() {
 profiler_node_t* Profiler::ProfilerGetPreviousFrame(const std::string& root_tag) {
     VerifyThreadSymmetry(__FUNCTION__);
     auto last_with_tag = std::find_if(_completedList.rbegin(), _completedList.rend(),
-                                      [&](profiler_node_t* node) { return node->tagName == root_tag; });
+                                      [&](profiler_node_t* node) { return node->tagName == StringId::Hashed(root_tag); });
     if(last_with_tag == _completedList.rend()) {
         return nullptr;
     }
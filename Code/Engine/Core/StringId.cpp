@@ -0,0 +1,114 @@
+#include "Engine/Core/StringId.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+namespace {
+
+class string_id_table_t {
+public:
+    string_id_table_t() {
+        Intern(std::string_view(""), HashString32(""));
+    }
+
+    std::string_view Intern(std::string_view str, uint32_t id) {
+        {
+            std::shared_lock<std::shared_mutex> read_lock(_mutex);
+            auto found = _strings.find(id);
+            if(found != _strings.end()) {
+                VerifyNoCollision(found->second, str);
+                return found->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> write_lock(_mutex);
+        //Another thread may have interned it between the locks.
+        auto found = _strings.find(id);
+        if(found != _strings.end()) {
+            VerifyNoCollision(found->second, str);
+            return found->second;
+        }
+        std::string_view stored = Store(str);
+        _strings.emplace(id, stored);
+        return stored;
+    }
+
+    std::string_view Find(uint32_t id) {
+        std::shared_lock<std::shared_mutex> read_lock(_mutex);
+        auto found = _strings.find(id);
+        return found != _strings.end() ? found->second : std::string_view("");
+    }
+
+private:
+    static constexpr std::size_t BLOCK_SIZE = 16 * 1024;
+
+    void VerifyNoCollision(std::string_view existing, std::string_view str) {
+        if(existing != str) {
+            std::ostringstream err_ss;
+            err_ss << "StringId hash collision between \"" << existing << "\" and \"" << str << "\".\n";
+            ERROR_AND_DIE(err_ss.str().c_str());
+        }
+    }
+
+    //Copies str with a terminator into block storage that is never moved or freed.
+    std::string_view Store(std::string_view str) {
+        std::size_t size = str.size() + 1;
+        if(size > _block_remaining) {
+            std::size_t block_size = (std::max)(BLOCK_SIZE, size);
+            _blocks.emplace_back(std::make_unique<char[]>(block_size));
+            _block_cursor = _blocks.back().get();
+            _block_remaining = block_size;
+        }
+        char* stored = _block_cursor;
+        std::memcpy(stored, str.data(), str.size());
+        stored[str.size()] = '\0';
+        _block_cursor += size;
+        _block_remaining -= size;
+        return std::string_view(stored, str.size());
+    }
+
+    std::shared_mutex _mutex;
+    std::unordered_map<uint32_t, std::string_view> _strings;
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    char* _block_cursor = nullptr;
+    std::size_t _block_remaining = 0;
+};
+
+string_id_table_t& GetStringIdTable() {
+    static string_id_table_t table;
+    return table;
+}
+
+}
+
+StringId::StringId(std::string_view str)
+    : _id(HashString32(str))
+{
+    std::string_view stored = GetStringIdTable().Intern(str, _id);
+    _size = static_cast<uint32_t>(stored.size());
+    _text = stored.data();
+}
+
+StringId::StringId(const char* str)
+    : StringId(std::string_view(str ? str : ""))
+{
+    /* DO NOTHING */
+}
+
+std::string_view StringId::GetString() const {
+    if(_text) {
+        return std::string_view(_text, _size);
+    }
+    return GetStringIdTable().Find(_id);
+}
+
+const char* StringId::c_str() const {
+    return GetString().data();
+}
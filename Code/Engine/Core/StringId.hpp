@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+//32-bit FNV-1a. Usable in constant expressions so literal tags hash at compile time.
+constexpr uint32_t HashString32(std::string_view str) noexcept {
+    uint32_t hash = 0x811C9DC5u;
+    for(char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+//Interned string. The id is the hash of the text, so it is stable across runs and
+//machines and literal ids can be made at compile time. Interned text lives until shutdown.
+//Interning two different strings with the same hash is a fatal error.
+//An interned id keeps a pointer to its text, so reading it back never locks the table.
+class StringId {
+public:
+    constexpr StringId() noexcept = default;
+
+    //Interns str. Thread-safe.
+    explicit StringId(std::string_view str);
+    explicit StringId(const char* str);
+
+    //Identifies str without interning it. Compares equal to the interned id;
+    //GetString only finds the text if something else interned it.
+    static constexpr StringId Hashed(std::string_view str) noexcept {
+        return StringId(HashString32(str), 0);
+    }
+
+    //Null-terminated. Empty if the text was never interned.
+    //Only ids made by Hashed look the text up in the intern table.
+    std::string_view GetString() const;
+    const char* c_str() const;
+
+    constexpr uint32_t GetId() const noexcept {
+        return _id;
+    }
+
+    constexpr bool operator==(const StringId& rhs) const noexcept {
+        return _id == rhs._id;
+    }
+    constexpr bool operator!=(const StringId& rhs) const noexcept {
+        return _id != rhs._id;
+    }
+    //Orders by id, not alphabetically.
+    constexpr bool operator<(const StringId& rhs) const noexcept {
+        return _id < rhs._id;
+    }
+
+protected:
+private:
+    constexpr StringId(uint32_t id, int /*tag*/) noexcept
+        : _id(id)
+    {
+        /* DO NOTHING */
+    }
+
+    uint32_t _id = HashString32("");
+    //The interned text and its size. Null for ids made by Hashed.
+    uint32_t _size = 0;
+    const char* _text = nullptr;
+};
+
+//Finds str in a map keyed by interned StringIds, or returns end. str is hashed once and the
+//map compares ids. A string that was never interned can still collide with a key, so a hit
+//is checked against the key's own text, which takes no lock.
+template<typename Map>
+auto FindStringId(Map& map, std::string_view str) -> decltype(map.begin()) {
+    auto found = map.find(StringId::Hashed(str));
+    if(found != map.end() && found->first.GetString() != str) {
+        return map.end();
+    }
+    return found;
+}
+
+namespace StringIdLiterals {
+
+//"name"_sid: a compile-time StringId::Hashed.
+constexpr StringId operator"" _sid(const char* str, std::size_t size) noexcept {
+    return StringId::Hashed(std::string_view(str, size));
+}
+
+}
+
+namespace std {
+
+template<>
+struct hash<StringId> {
+    std::size_t operator()(const StringId& id) const noexcept {
+        return id.GetId();
+    }
+};
+
+}
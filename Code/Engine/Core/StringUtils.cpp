@@ -3,9 +3,19 @@
 #include <stdarg.h>
 
 #include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <locale>
 #include <sstream>
 
+#include "Engine/EngineConfig.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
+
 const int STRINGF_STACK_LOCAL_TEMP_LENGTH = 2048;
 
 const std::string Stringf( const char* format, ... ) {
@@ -62,6 +72,42 @@ std::vector<std::string> Split(const std::string& string, char delim /*= ','*/)
     return std::move(result);
 }
 
+std::vector<std::string_view> SplitView(std::string_view string, char delim /*= ','*/, bool skip_empty /*= true*/) {
+    std::vector<std::string_view> result;
+    result.reserve(std::count(string.begin(), string.end(), delim) + 1);
+    std::size_t start = 0;
+    while(start <= string.size()) {
+        std::size_t end = string.find(delim, start);
+        if(end == std::string_view::npos) {
+            end = string.size();
+        }
+        if(end != start || !skip_empty) {
+            result.push_back(string.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return result;
+}
+
+std::size_t SplitView(std::string_view string, char delim, std::string_view* out_tokens, std::size_t max_tokens, bool skip_empty /*= true*/) {
+    std::size_t token_count = 0;
+    std::size_t start = 0;
+    while(start <= string.size()) {
+        std::size_t end = string.find(delim, start);
+        if(end == std::string_view::npos) {
+            end = string.size();
+        }
+        if(end != start || !skip_empty) {
+            if(token_count < max_tokens) {
+                out_tokens[token_count] = string.substr(start, end - start);
+            }
+            ++token_count;
+        }
+        start = end + 1;
+    }
+    return token_count;
+}
+
 std::string ToUpperCase(std::string str) {
     std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) -> unsigned char { return std::toupper(c, std::locale("")); });
     return str;
@@ -72,4 +118,172 @@ std::string ToLowerCase(std::string str) {
     return str;
 }
 
+namespace {
+
+struct format_spec_t {
+    int precision = -1;
+    bool hex = false;
+};
+
+//Parses the text between the braces: [:][.precision][x]
+format_spec_t ParseFormatSpec(std::string_view spec) {
+    format_spec_t result{};
+    if(!spec.empty() && spec.front() == ':') {
+        spec.remove_prefix(1);
+    }
+    if(!spec.empty() && spec.front() == '.') {
+        int precision = 0;
+        auto parse_result = std::from_chars(spec.data() + 1, spec.data() + spec.size(), precision);
+        if(parse_result.ec == std::errc{}) {
+            result.precision = precision;
+        }
+        spec.remove_prefix(parse_result.ptr - spec.data());
+    }
+    result.hex = !spec.empty() && spec.front() == 'x';
+    return result;
+}
+
+class format_writer_t {
+public:
+    format_writer_t(char* buffer, std::size_t buffer_size)
+        : _out(buffer)
+        , _last(buffer + buffer_size - 1)
+    {
+        /* DO NOTHING */
+    }
+
+    void Append(const char* str, std::size_t size) {
+        size = (std::min)(size, Remaining());
+        std::memcpy(_out, str, size);
+        _out += size;
+    }
+
+    void Append(const format_arg_t& arg, const format_spec_t& spec) {
+        char number[32];
+        switch(arg.type) {
+        case format_arg_t::Type::Bool:
+            arg.as_bool ? Append("true", 4) : Append("false", 5);
+            break;
+        case format_arg_t::Type::Char:
+            Append(&arg.as_char, 1);
+            break;
+        case format_arg_t::Type::Signed:
+        {
+            auto result = std::to_chars(number, number + sizeof(number), arg.as_signed, spec.hex ? 16 : 10);
+            Append(number, result.ptr - number);
+            break;
+        }
+        case format_arg_t::Type::Unsigned:
+        {
+            auto result = std::to_chars(number, number + sizeof(number), arg.as_unsigned, spec.hex ? 16 : 10);
+            Append(number, result.ptr - number);
+            break;
+        }
+        case format_arg_t::Type::Floating:
+        {
+            //snprintf truncates in place, so large values never need a temporary.
+            int length = spec.precision < 0 ? std::snprintf(_out, Remaining() + 1, "%Lg", arg.as_floating)
+                                            : std::snprintf(_out, Remaining() + 1, "%.*Lf", spec.precision, arg.as_floating);
+            _out += (std::min)(static_cast<std::size_t>((std::max)(length, 0)), Remaining());
+            break;
+        }
+        case format_arg_t::Type::String:
+            Append(arg.as_string.data, arg.as_string.size);
+            break;
+        case format_arg_t::Type::Pointer:
+        {
+            auto result = std::to_chars(number, number + sizeof(number), reinterpret_cast<std::uintptr_t>(arg.as_pointer), 16);
+            Append("0x", 2);
+            Append(number, result.ptr - number);
+            break;
+        }
+        }
+    }
+
+    std::size_t Finish(const char* buffer) {
+        *_out = '\0';
+        return static_cast<std::size_t>(_out - buffer);
+    }
+
+private:
+    std::size_t Remaining() const {
+        return static_cast<std::size_t>(_last - _out);
+    }
+
+    char* _out = nullptr;
+    char* _last = nullptr;
+};
+
+}
+
+std::size_t FormatToArgs(char* buffer, std::size_t buffer_size, std::string_view format, const format_arg_t* args, std::size_t arg_count) {
+    if(buffer == nullptr || buffer_size == 0) {
+        return 0;
+    }
+    format_writer_t writer(buffer, buffer_size);
+    std::size_t next_arg = 0;
+    std::size_t placeholder_count = 0;
+    std::size_t i = 0;
+    while(i < format.size()) {
+        std::size_t brace = format.find_first_of("{}", i);
+        if(brace == std::string_view::npos) {
+            writer.Append(format.data() + i, format.size() - i);
+            break;
+        }
+        writer.Append(format.data() + i, brace - i);
+        bool escaped = brace + 1 < format.size() && format[brace + 1] == format[brace];
+        if(escaped || format[brace] == '}') {
+            writer.Append(format.data() + brace, 1);
+            i = brace + (escaped ? 2 : 1);
+            continue;
+        }
+        std::size_t close = format.find('}', brace + 1);
+        if(close == std::string_view::npos) {
+            writer.Append(format.data() + brace, format.size() - brace);
+            break;
+        }
+        //Placeholders without a matching argument are dropped.
+        ++placeholder_count;
+        if(next_arg < arg_count) {
+            writer.Append(args[next_arg++], ParseFormatSpec(format.substr(brace + 1, close - brace - 1)));
+        }
+        i = close + 1;
+    }
+    ASSERT_OR_DIE(placeholder_count == arg_count, "FormatTo: the number of {} placeholders does not match the number of arguments.");
+    return writer.Finish(buffer);
+}
+
+void StringUtilsBenchmark(std::size_t iterations) {
+    const std::string csv("position,normal,color,uv,tangent,bitangent,,weights,indices");
+    std::size_t checksum = 0;
+
+    double start = GetCurrentTimeSeconds();
+    for(std::size_t i = 0; i < iterations; ++i) {
+        checksum += Split(csv).size();
+    }
+    double split_seconds = GetCurrentTimeSeconds() - start;
+
+    start = GetCurrentTimeSeconds();
+    for(std::size_t i = 0; i < iterations; ++i) {
+        std::string_view tokens[16];
+        checksum += SplitView(csv, ',', tokens);
+    }
+    double split_view_seconds = GetCurrentTimeSeconds() - start;
+
+    start = GetCurrentTimeSeconds();
+    for(std::size_t i = 0; i < iterations; ++i) {
+        checksum += Stringf("Bytes Allocated: %.2f %s (%u)", 1.5f + i, "MB", static_cast<unsigned int>(i)).size();
+    }
+    double stringf_seconds = GetCurrentTimeSeconds() - start;
 
+    start = GetCurrentTimeSeconds();
+    for(std::size_t i = 0; i < iterations; ++i) {
+        char buffer[64];
+        checksum += FormatTo(buffer, "Bytes Allocated: {:.2} {} ({})", 1.5f + i, "MB", i);
+    }
+    double format_to_seconds = GetCurrentTimeSeconds() - start;
+
+    auto nanoseconds_per_call = [iterations](double seconds) { return iterations ? seconds * 1.0e9 / iterations : 0.0; };
+    g_theFileLogger->LogTagf("test", "Split: %.1f ns/call. SplitView: %.1f ns/call.\n", nanoseconds_per_call(split_seconds), nanoseconds_per_call(split_view_seconds));
+    g_theFileLogger->LogTagf("test", "Stringf: %.1f ns/call. FormatTo: %.1f ns/call. (checksum %zu)\n", nanoseconds_per_call(stringf_seconds), nanoseconds_per_call(format_to_seconds), checksum);
+}
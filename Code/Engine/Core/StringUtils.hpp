@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 const std::string Stringf( const char* format, ... );
@@ -9,7 +12,112 @@ const std::string Stringf( const int maxLength, const char* format, ... );
 std::vector<std::string> Split(const char* string, char delim = ',');
 std::vector<std::string> Split(const std::string& string, char delim = ',');
 
+//Splits without copying: the views point into string, which must outlive them.
+//Empty tokens are skipped like Split unless skip_empty is false.
+std::vector<std::string_view> SplitView(std::string_view string, char delim = ',', bool skip_empty = true);
+
+//Allocation-free form. Fills out_tokens with at most max_tokens views and returns the
+//total number of tokens, which is greater than max_tokens if some did not fit.
+std::size_t SplitView(std::string_view string, char delim, std::string_view* out_tokens, std::size_t max_tokens, bool skip_empty = true);
+
+template<std::size_t N>
+std::size_t SplitView(std::string_view string, char delim, std::string_view (&out_tokens)[N], bool skip_empty = true) {
+    return SplitView(string, delim, out_tokens, N, skip_empty);
+}
+
 std::string ToUpperCase(std::string str);
 std::string ToLowerCase(std::string str);
 
+//Type-erased FormatTo argument. Built by MakeFormatArg; holds no copies, so it must not outlive the call.
+struct format_arg_t {
+    enum class Type {
+        Bool,
+        Char,
+        Signed,
+        Unsigned,
+        Floating,
+        String,
+        Pointer,
+    };
+    struct string_t {
+        const char* data;
+        std::size_t size;
+    };
+    Type type;
+    union {
+        bool as_bool;
+        char as_char;
+        long long as_signed;
+        unsigned long long as_unsigned;
+        long double as_floating;
+        string_t as_string;
+        const void* as_pointer;
+    };
+};
+
+template<typename T>
+struct format_arg_unsupported : std::false_type {};
+
+template<typename T>
+format_arg_t MakeFormatArg(const T& value) {
+    using U = std::decay_t<T>;
+    format_arg_t arg{};
+    if constexpr(std::is_same_v<U, bool>) {
+        arg.type = format_arg_t::Type::Bool;
+        arg.as_bool = value;
+    } else if constexpr(std::is_same_v<U, char>) {
+        arg.type = format_arg_t::Type::Char;
+        arg.as_char = value;
+    } else if constexpr(std::is_integral_v<U> && std::is_signed_v<U>) {
+        arg.type = format_arg_t::Type::Signed;
+        arg.as_signed = value;
+    } else if constexpr(std::is_integral_v<U>) {
+        arg.type = format_arg_t::Type::Unsigned;
+        arg.as_unsigned = value;
+    } else if constexpr(std::is_enum_v<U>) {
+        return MakeFormatArg(static_cast<std::underlying_type_t<U>>(value));
+    } else if constexpr(std::is_floating_point_v<U>) {
+        arg.type = format_arg_t::Type::Floating;
+        arg.as_floating = value;
+    } else if constexpr(std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+        const char* str = value ? value : "(null)";
+        arg.type = format_arg_t::Type::String;
+        arg.as_string = format_arg_t::string_t{ str, std::char_traits<char>::length(str) };
+    } else if constexpr(std::is_convertible_v<const T&, std::string_view>) {
+        std::string_view view = value;
+        arg.type = format_arg_t::Type::String;
+        arg.as_string = format_arg_t::string_t{ view.data(), view.size() };
+    } else if constexpr(std::is_pointer_v<U>) {
+        arg.type = format_arg_t::Type::Pointer;
+        arg.as_pointer = value;
+    } else {
+        static_assert(format_arg_unsupported<T>::value, "FormatTo: argument type is not formattable.");
+    }
+    return arg;
+}
+
+std::size_t FormatToArgs(char* buffer, std::size_t buffer_size, std::string_view format, const format_arg_t* args, std::size_t arg_count);
+
+//Formats into buffer without touching the heap. Argument types are checked at compile time.
+//Each "{}" is replaced by the next argument; "{:.N}" prints floating point arguments with
+//N decimal places and "{:x}" prints integers and pointers in hex. "{{" and "}}" are literal braces.
+//The number of placeholders must match the number of arguments; a mismatch asserts.
+//Output is truncated to fit and always null-terminated.
+//Returns the number of characters written, not counting the terminator.
+template<typename... Args>
+std::size_t FormatTo(char* buffer, std::size_t buffer_size, std::string_view format, const Args&... args) {
+    if constexpr(sizeof...(Args) == 0) {
+        return FormatToArgs(buffer, buffer_size, format, nullptr, 0);
+    } else {
+        const format_arg_t arg_list[] = { MakeFormatArg(args)... };
+        return FormatToArgs(buffer, buffer_size, format, arg_list, sizeof...(Args));
+    }
+}
+
+template<std::size_t N, typename... Args>
+std::size_t FormatTo(char (&buffer)[N], std::string_view format, const Args&... args) {
+    return FormatTo(buffer, N, format, args...);
+}
 
+//Times Split against SplitView and Stringf against FormatTo. Results are logged with the "test" tag.
+void StringUtilsBenchmark(std::size_t iterations);
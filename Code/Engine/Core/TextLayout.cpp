@@ -0,0 +1,103 @@
+#include "Engine/Core/TextLayout.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/KerningFont.hpp"
+
+TextLayout::TextLayout(const KerningFont* font, std::string_view text) {
+    SetText(font, text);
+}
+
+bool TextLayout::SetText(const KerningFont* font, std::string_view text) {
+    if(font == _font && text == _text && !_cursor_offsets.empty()) {
+        return false;
+    }
+    _font = font;
+    _text.assign(text.data(), text.size());
+    Build();
+    return true;
+}
+
+void TextLayout::Clear() {
+    _font = nullptr;
+    _text.clear();
+    _glyphs.clear();
+    _cursor_offsets.clear();
+    _page = 0;
+}
+
+const KerningFont* TextLayout::GetFont() const {
+    return _font;
+}
+
+const std::string& TextLayout::GetText() const {
+    return _text;
+}
+
+const std::vector<TextLayout::glyph_t>& TextLayout::GetGlyphs() const {
+    return _glyphs;
+}
+
+int TextLayout::GetPage() const {
+    return _page;
+}
+
+float TextLayout::GetWidth(float scale /*= 1.0f*/) const {
+    return _cursor_offsets.empty() ? 0.0f : _cursor_offsets.back() * scale;
+}
+
+float TextLayout::GetHeight(float scale /*= 1.0f*/) const {
+    return _font ? _font->CalculateTextHeight(_text, scale) : 0.0f;
+}
+
+float TextLayout::GetCursorOffset(std::size_t char_index, float scale /*= 1.0f*/) const {
+    if(_cursor_offsets.empty()) {
+        return 0.0f;
+    }
+    return _cursor_offsets[(std::min)(char_index, _cursor_offsets.size() - 1)] * scale;
+}
+
+void TextLayout::Build() {
+    _glyphs.clear();
+    _cursor_offsets.clear();
+    _page = 0;
+    if(_font == nullptr) {
+        return;
+    }
+    _glyphs.reserve(_text.size());
+    _cursor_offsets.reserve(_text.size() + 1);
+
+    const KerningFont::CommonDef common = _font->GetCommonDef();
+    const float line_top = -static_cast<float>(common.base);
+    const float texture_w = static_cast<float>(common.scaleW);
+    const float texture_h = static_cast<float>(common.scaleH);
+
+    float cursor_x = 0.0f;
+    const std::size_t count = _text.size();
+    if(count) {
+        _page = _font->GetGlyph(_text.front()).page;
+    }
+    for(std::size_t i = 0; i < count; ++i) {
+        const KerningFont::CharDef& current_charDef = _font->GetGlyph(_text[i]);
+        ASSERT_OR_DIE(current_charDef.page == _page, "Font characters not on single page!");
+        _cursor_offsets.push_back(cursor_x);
+
+        glyph_t glyph;
+        glyph.uv_left = current_charDef.x / texture_w;
+        glyph.uv_top = current_charDef.y / texture_h;
+        glyph.uv_right = glyph.uv_left + (current_charDef.width / texture_w);
+        glyph.uv_bottom = glyph.uv_top + (current_charDef.height / texture_h);
+        glyph.top = line_top + current_charDef.yoffset;
+        glyph.bottom = glyph.top + static_cast<float>(current_charDef.height);
+        glyph.left = cursor_x + static_cast<float>(current_charDef.xoffset);
+        glyph.right = glyph.left + current_charDef.width;
+        _glyphs.push_back(glyph);
+
+        cursor_x += static_cast<float>(current_charDef.xadvance);
+        if(i + 1 < count) {
+            cursor_x += static_cast<float>(_font->GetKerning(static_cast<unsigned char>(_text[i]), static_cast<unsigned char>(_text[i + 1])));
+        }
+    }
+    _cursor_offsets.push_back(cursor_x);
+}
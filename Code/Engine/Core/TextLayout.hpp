@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class KerningFont;
+
+//One line of text measured and positioned in a font. Glyph quads and cursor offsets are
+//computed once when the text or font changes, so drawing or measuring it again costs no
+//font lookups. Coordinates are relative to the line's start, matching DrawTextLine.
+class TextLayout {
+public:
+    struct glyph_t {
+        float left;
+        float top;
+        float right;
+        float bottom;
+        float uv_left;
+        float uv_top;
+        float uv_right;
+        float uv_bottom;
+    };
+
+    TextLayout() = default;
+    TextLayout(const KerningFont* font, std::string_view text);
+
+    //Returns false, doing nothing, if neither font nor text changed.
+    bool SetText(const KerningFont* font, std::string_view text);
+    void Clear();
+
+    const KerningFont* GetFont() const;
+    const std::string& GetText() const;
+    //One per character, in order.
+    const std::vector<glyph_t>& GetGlyphs() const;
+    //Texture page shared by every glyph.
+    int GetPage() const;
+
+    //Same as KerningFont::CalculateTextWidth of the whole text.
+    float GetWidth(float scale = 1.0f) const;
+    float GetHeight(float scale = 1.0f) const;
+    //Cursor offset before the character at char_index; the text size gives the full width.
+    float GetCursorOffset(std::size_t char_index, float scale = 1.0f) const;
+
+protected:
+private:
+    void Build();
+
+    const KerningFont* _font = nullptr;
+    std::string _text{};
+    std::vector<glyph_t> _glyphs{};
+    //_text.size() + 1 entries.
+    std::vector<float> _cursor_offsets{};
+    int _page = 0;
+};
@@ -15,10 +15,11 @@ public:
         return result;
     }
     bool pop(T& out) {
-        if(empty()) {
+        _cs.enter();
+        if(_internal_queue.empty()) {
+            _cs.leave();
             return false;
         }
-        _cs.enter();
         out = _internal_queue.front();
         _internal_queue.pop();
         _cs.leave();
@@ -10,26 +10,61 @@
 
 
 //-----------------------------------------------------------------------------------------------
-double InitializeTime( LARGE_INTEGER& out_initialTime )
+struct TimeBase
 {
+	LARGE_INTEGER initialTime;
 	LARGE_INTEGER countsPerSecond;
-	QueryPerformanceFrequency( &countsPerSecond );
-	QueryPerformanceCounter( &out_initialTime );
-	return( 1.0 / static_cast< double >( countsPerSecond.QuadPart ) );
+	double secondsPerCount;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+TimeBase InitializeTime()
+{
+	TimeBase timeBase;
+	QueryPerformanceFrequency( &timeBase.countsPerSecond );
+	QueryPerformanceCounter( &timeBase.initialTime );
+	timeBase.secondsPerCount = 1.0 / static_cast< double >( timeBase.countsPerSecond.QuadPart );
+	return timeBase;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//Shared by both getters, so seconds and nanoseconds count from the same moment.
+const TimeBase& GetTimeBase()
+{
+	static const TimeBase timeBase = InitializeTime();
+	return timeBase;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 double GetCurrentTimeSeconds()
 {
-	static LARGE_INTEGER initialTime;
-	static double secondsPerCount = InitializeTime( initialTime );
+	const TimeBase& timeBase = GetTimeBase();
 	LARGE_INTEGER currentCount;
 	QueryPerformanceCounter( &currentCount );
-	LONGLONG elapsedCountsSinceInitialTime = currentCount.QuadPart - initialTime.QuadPart;
+	LONGLONG elapsedCountsSinceInitialTime = currentCount.QuadPart - timeBase.initialTime.QuadPart;
 
-	double currentSeconds = static_cast< double >( elapsedCountsSinceInitialTime ) * secondsPerCount;
+	double currentSeconds = static_cast< double >( elapsedCountsSinceInitialTime ) * timeBase.secondsPerCount;
 	return currentSeconds;
 }
 
 
+//-----------------------------------------------------------------------------------------------
+int64_t GetCurrentTimeNanoseconds()
+{
+	const TimeBase& timeBase = GetTimeBase();
+	LARGE_INTEGER currentCount;
+	QueryPerformanceCounter( &currentCount );
+	LONGLONG elapsedCounts = currentCount.QuadPart - timeBase.initialTime.QuadPart;
+
+	//Split so the multiply cannot overflow.
+	const int64_t nanosecondsPerSecond = 1000000000;
+	const LONGLONG countsPerSecond = timeBase.countsPerSecond.QuadPart;
+	int64_t wholeSeconds = elapsedCounts / countsPerSecond;
+	int64_t remainderCounts = elapsedCounts % countsPerSecond;
+	return wholeSeconds * nanosecondsPerSecond + ( remainderCounts * nanosecondsPerSecond ) / countsPerSecond;
+}
+
+
@@ -4,7 +4,12 @@
 //	based on code by Squirrel Eiserloh
 #pragma once
 
+#include <cstdint>
 
 //-----------------------------------------------------------------------------------------------
 double GetCurrentTimeSeconds();
 
+//Nanoseconds since the first call. Integer, so it keeps full precision however long
+//the process runs.
+int64_t GetCurrentTimeNanoseconds();
+
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+//Character trie mapping strings to values. Lookups take string_views and do not allocate,
+//and visiting a prefix only walks the keys that start with it, in lexicographic order.
+//Values are heap-allocated so references to them survive later inserts.
+template<typename T>
+class Trie {
+public:
+    Trie() {
+        _nodes.emplace_back();
+    }
+
+    //Returns true if key is new, false if an existing value was replaced.
+    bool InsertOrAssign(std::string_view key, T value) {
+        std::size_t node = 0;
+        for(char c : key) {
+            node = FindOrAddChild(node, c);
+        }
+        bool added = !_nodes[node].value;
+        _nodes[node].value = std::make_unique<T>(std::move(value));
+        if(added) {
+            ++_size;
+        }
+        return added;
+    }
+
+    //Returns true if key was present. Nodes no longer leading to a value are recycled.
+    bool Erase(std::string_view key) {
+        std::size_t node = FindNode(key);
+        if(node == NO_NODE || !_nodes[node].value) {
+            return false;
+        }
+        _nodes[node].value.reset();
+        --_size;
+        while(node != 0 && !_nodes[node].value && _nodes[node].children.empty()) {
+            std::size_t parent = _nodes[node].parent;
+            auto& siblings = _nodes[parent].children;
+            siblings.erase(std::find_if(siblings.begin(), siblings.end(), [node](const child_t& child) { return child.second == node; }));
+            _free_nodes.push_back(node);
+            node = parent;
+        }
+        return true;
+    }
+
+    T* Find(std::string_view key) {
+        std::size_t node = FindNode(key);
+        return node != NO_NODE ? _nodes[node].value.get() : nullptr;
+    }
+    const T* Find(std::string_view key) const {
+        std::size_t node = FindNode(key);
+        return node != NO_NODE ? _nodes[node].value.get() : nullptr;
+    }
+
+    //Calls f(std::string_view key, T& value) for each key starting with prefix, in lexicographic order.
+    //f must not insert or erase keys.
+    template<typename F>
+    void ForEachWithPrefix(std::string_view prefix, F&& f) {
+        std::size_t node = FindNode(prefix);
+        if(node == NO_NODE) {
+            return;
+        }
+        std::string key(prefix);
+        Visit(node, key, f);
+    }
+    template<typename F>
+    void ForEachWithPrefix(std::string_view prefix, F&& f) const {
+        const_cast<Trie*>(this)->ForEachWithPrefix(prefix, [&f](std::string_view key, const T& value) { f(key, value); });
+    }
+
+    template<typename F>
+    void ForEach(F&& f) {
+        ForEachWithPrefix(std::string_view{}, std::forward<F>(f));
+    }
+    template<typename F>
+    void ForEach(F&& f) const {
+        ForEachWithPrefix(std::string_view{}, std::forward<F>(f));
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+    void clear() {
+        _nodes.clear();
+        _nodes.emplace_back();
+        _free_nodes.clear();
+        _size = 0;
+    }
+
+protected:
+private:
+    static constexpr std::size_t NO_NODE = static_cast<std::size_t>(-1);
+    using child_t = std::pair<char, std::size_t>;
+
+    struct node_t {
+        //Sorted by character.
+        std::vector<child_t> children;
+        std::unique_ptr<T> value;
+        std::size_t parent = 0;
+    };
+
+    std::size_t FindChild(std::size_t node, char c) const {
+        const auto& children = _nodes[node].children;
+        auto found = std::lower_bound(children.begin(), children.end(), c, [](const child_t& child, char c) { return child.first < c; });
+        return (found != children.end() && found->first == c) ? found->second : NO_NODE;
+    }
+
+    std::size_t FindOrAddChild(std::size_t node, char c) {
+        auto& children = _nodes[node].children;
+        auto found = std::lower_bound(children.begin(), children.end(), c, [](const child_t& child, char c) { return child.first < c; });
+        if(found != children.end() && found->first == c) {
+            return found->second;
+        }
+        std::size_t child = _nodes.size();
+        if(!_free_nodes.empty()) {
+            child = _free_nodes.back();
+            _free_nodes.pop_back();
+        }
+        children.insert(found, std::make_pair(c, child));
+        //Growing _nodes invalidates children, so it is not touched after this.
+        if(child == _nodes.size()) {
+            _nodes.emplace_back();
+        }
+        _nodes[child].parent = node;
+        return child;
+    }
+
+    std::size_t FindNode(std::string_view key) const {
+        std::size_t node = 0;
+        for(char c : key) {
+            node = FindChild(node, c);
+            if(node == NO_NODE) {
+                break;
+            }
+        }
+        return node;
+    }
+
+    template<typename F>
+    void Visit(std::size_t node, std::string& key, F& f) {
+        if(_nodes[node].value) {
+            f(std::string_view(key), *_nodes[node].value);
+        }
+        for(const auto& child : _nodes[node].children) {
+            key.push_back(child.first);
+            Visit(child.second, key, f);
+            key.pop_back();
+        }
+    }
+
+    std::vector<node_t> _nodes;
+    std::vector<std::size_t> _free_nodes;
+    std::size_t _size = 0;
+};
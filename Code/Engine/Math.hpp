@@ -4,6 +4,8 @@
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/Capsule2.hpp"
 #include "Engine/Math/Disc2.hpp"
+#include "Engine/Math/DynamicAABB3Tree.hpp"
+#include "Engine/Math/FrustumCuller.hpp"
 #include "Engine/Math/IntVector2.hpp"
 #include "Engine/Math/IntVector3.hpp"
 #include "Engine/Math/IntVector4.hpp"
@@ -16,6 +18,7 @@
 #include "Engine/Math/Plane2.hpp"
 #include "Engine/Math/Plane3.hpp"
 #include "Engine/Math/Quaternion.hpp"
+#include "Engine/Math/SpatialHashGrid2.hpp"
 #include "Engine/Math/Sphere3.hpp"
 #include "Engine/Math/Transform.hpp"
 #include "Engine/Math/Vector2.hpp"
@@ -0,0 +1,731 @@
+#include "Engine/Math/DynamicAABB3Tree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "Engine/EngineConfig.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include "Engine/Math/LineSegment3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Plane3.hpp"
+#include "Engine/Math/RandomEngine.hpp"
+#include "Engine/Math/Sphere3.hpp"
+
+namespace {
+
+//Depth-first traversal stack. A balanced tree of a million proxies is about 30 deep, so the
+//overflow vector is only there to keep pathological trees correct.
+template<typename T>
+class TraversalStack {
+public:
+    void Push(const T& value) {
+        if(_size < FIXED_CAPACITY) {
+            _fixed[_size++] = value;
+            return;
+        }
+        _overflow.push_back(value);
+        ++_size;
+    }
+    T Pop() {
+        --_size;
+        if(_size < FIXED_CAPACITY) {
+            return _fixed[_size];
+        }
+        T value = _overflow.back();
+        _overflow.pop_back();
+        return value;
+    }
+    bool IsEmpty() const {
+        return _size == 0;
+    }
+private:
+    static constexpr std::size_t FIXED_CAPACITY = 64;
+    T _fixed[FIXED_CAPACITY];
+    std::vector<T> _overflow{};
+    std::size_t _size = 0;
+};
+
+struct FrustumEntry {
+    int node = -1;
+    //Planes the node still straddles; planes it is entirely in front of are dropped.
+    std::uint32_t plane_mask = 0;
+};
+
+AABB3 Union(const AABB3& a, const AABB3& b) {
+    return AABB3((std::min)(a.mins.x, b.mins.x), (std::min)(a.mins.y, b.mins.y), (std::min)(a.mins.z, b.mins.z),
+                 (std::max)(a.maxs.x, b.maxs.x), (std::max)(a.maxs.y, b.maxs.y), (std::max)(a.maxs.z, b.maxs.z));
+}
+
+//Half the surface area; only ratios matter to the insertion cost.
+float CalcHalfSurfaceArea(const AABB3& box) {
+    const float dx = box.maxs.x - box.mins.x;
+    const float dy = box.maxs.y - box.mins.y;
+    const float dz = box.maxs.z - box.mins.z;
+    return dx * dy + dy * dz + dz * dx;
+}
+
+bool Contains(const AABB3& outer, const AABB3& inner) {
+    return outer.mins.x <= inner.mins.x && outer.mins.y <= inner.mins.y && outer.mins.z <= inner.mins.z
+        && inner.maxs.x <= outer.maxs.x && inner.maxs.y <= outer.maxs.y && inner.maxs.z <= outer.maxs.z;
+}
+
+//Slab test along origin + t * direction for t in [0, max_t]. An infinite inv_direction
+//component marks a zero direction component; the ray then stays in that slab or misses it.
+bool DoesRayHitAABB3(const Vector3& origin, const Vector3& inv_direction, float max_t, const AABB3& box) {
+    float t_min = 0.0f;
+    float t_max = max_t;
+    const float origins[3] = {origin.x, origin.y, origin.z};
+    const float inv_directions[3] = {inv_direction.x, inv_direction.y, inv_direction.z};
+    const float mins[3] = {box.mins.x, box.mins.y, box.mins.z};
+    const float maxs[3] = {box.maxs.x, box.maxs.y, box.maxs.z};
+    for(std::size_t axis = 0; axis < 3; ++axis) {
+        if(std::isinf(inv_directions[axis])) {
+            if(origins[axis] < mins[axis] || maxs[axis] < origins[axis]) {
+                return false;
+            }
+            continue;
+        }
+        const float t1 = (mins[axis] - origins[axis]) * inv_directions[axis];
+        const float t2 = (maxs[axis] - origins[axis]) * inv_directions[axis];
+        t_min = (std::max)(t_min, (std::min)(t1, t2));
+        t_max = (std::min)(t_max, (std::max)(t1, t2));
+    }
+    return t_min <= t_max;
+}
+
+Vector3 CalcInverseDirection(const Vector3& direction) {
+    const float infinity = std::numeric_limits<float>::infinity();
+    return Vector3(direction.x != 0.0f ? 1.0f / direction.x : infinity,
+                   direction.y != 0.0f ? 1.0f / direction.y : infinity,
+                   direction.z != 0.0f ? 1.0f / direction.z : infinity);
+}
+
+//The box corner furthest along the plane normal is behind the plane.
+bool IsAABB3BehindPlane(const AABB3& box, const Plane3& plane) {
+    const Vector3 corner(plane.normal.x >= 0.0f ? box.maxs.x : box.mins.x,
+                         plane.normal.y >= 0.0f ? box.maxs.y : box.mins.y,
+                         plane.normal.z >= 0.0f ? box.maxs.z : box.mins.z);
+    return MathUtils::IsPointBehindPlane(corner, plane);
+}
+
+//The box corner furthest against the plane normal is in front of the plane.
+bool IsAABB3InFrontOfPlane(const AABB3& box, const Plane3& plane) {
+    const Vector3 corner(plane.normal.x >= 0.0f ? box.mins.x : box.maxs.x,
+                         plane.normal.y >= 0.0f ? box.mins.y : box.maxs.y,
+                         plane.normal.z >= 0.0f ? box.mins.z : box.maxs.z);
+    return MathUtils::IsPointInFrontOfPlane(corner, plane);
+}
+
+bool IsAABB3OutsidePlanes(const AABB3& box, std::span<const Plane3> planes) {
+    for(const auto& plane : planes) {
+        if(IsAABB3BehindPlane(box, plane)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} //End anonymous namespace
+
+DynamicAABB3Tree::DynamicAABB3Tree(float margin /*= 0.1f*/, float displacement_multiplier /*= 2.0f*/)
+    : _margin(margin)
+    , _displacement_multiplier(displacement_multiplier)
+{
+    /* DO NOTHING */
+}
+
+int DynamicAABB3Tree::CreateProxy(const AABB3& bounds, void* user_data /*= nullptr*/) {
+    const int proxy = AllocateNode();
+    AABB3 fat_bounds(bounds);
+    fat_bounds.AddPaddingToSides(_margin, _margin, _margin);
+    _nodes[proxy].bounds = fat_bounds;
+    _user_data[proxy] = user_data;
+    InsertLeaf(proxy);
+    ++_proxy_count;
+    _moved[proxy] = 1;
+    _move_buffer.push_back(proxy);
+    return proxy;
+}
+
+void DynamicAABB3Tree::DestroyProxy(int proxy) {
+    ASSERT_OR_DIE(0 <= proxy && proxy < static_cast<int>(_nodes.size()) && _heights[proxy] == 0, "DynamicAABB3Tree::DestroyProxy: not a proxy.");
+    RemoveLeaf(proxy);
+    _moved[proxy] = 0;
+    FreeNode(proxy);
+    --_proxy_count;
+}
+
+bool DynamicAABB3Tree::MoveProxy(int proxy, const AABB3& bounds, const Vector3& displacement /*= Vector3::ZERO*/) {
+    ASSERT_OR_DIE(0 <= proxy && proxy < static_cast<int>(_nodes.size()) && _heights[proxy] == 0, "DynamicAABB3Tree::MoveProxy: not a proxy.");
+
+    //Predict the next few moves by stretching the fat bounds ahead of the displacement.
+    AABB3 fat_bounds(bounds);
+    fat_bounds.AddPaddingToSides(_margin, _margin, _margin);
+    const Vector3 prediction = displacement * _displacement_multiplier;
+    (prediction.x < 0.0f ? fat_bounds.mins.x : fat_bounds.maxs.x) += prediction.x;
+    (prediction.y < 0.0f ? fat_bounds.mins.y : fat_bounds.maxs.y) += prediction.y;
+    (prediction.z < 0.0f ? fat_bounds.mins.z : fat_bounds.maxs.z) += prediction.z;
+
+    //Keep the old fat bounds while they still contain the proxy, unless they have grown so
+    //loose (e.g. after a fast move) that they would produce needless candidates.
+    const AABB3& tree_bounds = _nodes[proxy].bounds;
+    if(Contains(tree_bounds, bounds)) {
+        AABB3 loosest_bounds(fat_bounds);
+        const float loose_margin = 4.0f * _margin;
+        loosest_bounds.AddPaddingToSides(loose_margin, loose_margin, loose_margin);
+        if(Contains(loosest_bounds, tree_bounds)) {
+            return false;
+        }
+    }
+
+    RemoveLeaf(proxy);
+    _nodes[proxy].bounds = fat_bounds;
+    InsertLeaf(proxy);
+    if(!_moved[proxy]) {
+        _moved[proxy] = 1;
+        _move_buffer.push_back(proxy);
+    }
+    return true;
+}
+
+void DynamicAABB3Tree::Clear() {
+    _nodes.clear();
+    _parents.clear();
+    _heights.clear();
+    _user_data.clear();
+    _moved.clear();
+    _move_buffer.clear();
+    _root = NULL_NODE;
+    _free_list = NULL_NODE;
+    _proxy_count = 0;
+}
+
+void DynamicAABB3Tree::Reserve(std::size_t proxy_count) {
+    //A tree of n leaves has n - 1 branches.
+    const std::size_t node_count = 2 * proxy_count;
+    _nodes.reserve(node_count);
+    _parents.reserve(node_count);
+    _heights.reserve(node_count);
+    _user_data.reserve(node_count);
+    _moved.reserve(node_count);
+    _move_buffer.reserve(proxy_count);
+}
+
+void* DynamicAABB3Tree::GetUserData(int proxy) const {
+    return _user_data[proxy];
+}
+
+const AABB3& DynamicAABB3Tree::GetFatBounds(int proxy) const {
+    return _nodes[proxy].bounds;
+}
+
+std::size_t DynamicAABB3Tree::GetProxyCount() const {
+    return _proxy_count;
+}
+
+int DynamicAABB3Tree::GetHeight() const {
+    return _root == NULL_NODE ? -1 : _heights[_root];
+}
+
+template<typename Overlaps>
+void DynamicAABB3Tree::Query(Overlaps&& overlaps, std::vector<int>& results) const {
+    if(_root == NULL_NODE) {
+        return;
+    }
+    TraversalStack<int> stack;
+    stack.Push(_root);
+    while(!stack.IsEmpty()) {
+        const int node = stack.Pop();
+        const Node& current = _nodes[node];
+        if(!overlaps(current.bounds)) {
+            continue;
+        }
+        if(current.child1 == NULL_NODE) {
+            results.push_back(node);
+            continue;
+        }
+        stack.Push(current.child1);
+        stack.Push(current.child2);
+    }
+}
+
+void DynamicAABB3Tree::QueryOverlaps(const AABB3& bounds, std::vector<int>& results) const {
+    Query([&bounds](const AABB3& box) { return MathUtils::DoAABB3sOverlap(bounds, box); }, results);
+}
+
+void DynamicAABB3Tree::QuerySphere(const Sphere3& sphere, std::vector<int>& results) const {
+    const float radius_squared = sphere.radius * sphere.radius;
+    Query([&sphere, radius_squared](const AABB3& box) { return CalcDistanceSquared(sphere.center, CalcClosestPoint(sphere.center, box)) <= radius_squared; }, results);
+}
+
+void DynamicAABB3Tree::QuerySegment(const LineSegment3& segment, std::vector<int>& results) const {
+    const Vector3 inv_direction = CalcInverseDirection(segment.CalcDisplacement());
+    Query([&segment, &inv_direction](const AABB3& box) { return DoesRayHitAABB3(segment.start, inv_direction, 1.0f, box); }, results);
+}
+
+void DynamicAABB3Tree::QueryRay(const Vector3& origin, const Vector3& direction, std::vector<int>& results, float max_distance /*= (std::numeric_limits<float>::max)()*/) const {
+    const float length = direction.CalcLength();
+    if(length == 0.0f) {
+        return;
+    }
+    const Vector3 inv_direction = CalcInverseDirection(direction);
+    const float max_t = max_distance / length;
+    Query([&origin, &inv_direction, max_t](const AABB3& box) { return DoesRayHitAABB3(origin, inv_direction, max_t, box); }, results);
+}
+
+void DynamicAABB3Tree::QueryFrustum(std::span<const Plane3> planes, std::vector<int>& results) const {
+    ASSERT_OR_DIE(planes.size() <= 32, "DynamicAABB3Tree::QueryFrustum: too many planes.");
+    if(_root == NULL_NODE) {
+        return;
+    }
+    const std::uint32_t all_planes = planes.size() == 32 ? 0xFFFFFFFFu : (1u << planes.size()) - 1u;
+    TraversalStack<FrustumEntry> stack;
+    stack.Push(FrustumEntry{_root, all_planes});
+    while(!stack.IsEmpty()) {
+        const FrustumEntry entry = stack.Pop();
+        const Node& current = _nodes[entry.node];
+        std::uint32_t plane_mask = entry.plane_mask;
+        bool culled = false;
+        for(std::size_t i = 0; i < planes.size(); ++i) {
+            const std::uint32_t bit = 1u << i;
+            if(!(plane_mask & bit)) {
+                continue;
+            }
+            if(IsAABB3BehindPlane(current.bounds, planes[i])) {
+                culled = true;
+                break;
+            }
+            if(IsAABB3InFrontOfPlane(current.bounds, planes[i])) {
+                plane_mask &= ~bit;
+            }
+        }
+        if(culled) {
+            continue;
+        }
+        //Entirely inside: everything below is visible without further tests.
+        if(plane_mask == 0) {
+            CollectLeaves(entry.node, results);
+            continue;
+        }
+        if(current.child1 == NULL_NODE) {
+            results.push_back(entry.node);
+            continue;
+        }
+        stack.Push(FrustumEntry{current.child1, plane_mask});
+        stack.Push(FrustumEntry{current.child2, plane_mask});
+    }
+}
+
+void DynamicAABB3Tree::FindAllPairs(std::vector<std::pair<int, int>>& pairs) const {
+    std::vector<int> candidates{};
+    const int node_count = static_cast<int>(_nodes.size());
+    for(int proxy = 0; proxy < node_count; ++proxy) {
+        if(_heights[proxy] != 0) {
+            continue;
+        }
+        candidates.clear();
+        QueryOverlaps(_nodes[proxy].bounds, candidates);
+        for(int other : candidates) {
+            if(proxy < other) {
+                pairs.emplace_back(proxy, other);
+            }
+        }
+    }
+}
+
+void DynamicAABB3Tree::FindMovedPairs(std::vector<std::pair<int, int>>& pairs) {
+    //A proxy destroyed and recreated under the same id can be listed twice.
+    std::sort(_move_buffer.begin(), _move_buffer.end());
+    _move_buffer.erase(std::unique(_move_buffer.begin(), _move_buffer.end()), _move_buffer.end());
+
+    std::vector<int> candidates{};
+    for(int proxy : _move_buffer) {
+        if(!_moved[proxy]) {
+            continue;
+        }
+        candidates.clear();
+        QueryOverlaps(_nodes[proxy].bounds, candidates);
+        for(int other : candidates) {
+            if(other == proxy) {
+                continue;
+            }
+            //When both moved, only the lower id reports the pair.
+            if(_moved[other] && other < proxy) {
+                continue;
+            }
+            pairs.emplace_back((std::min)(proxy, other), (std::max)(proxy, other));
+        }
+    }
+    for(int proxy : _move_buffer) {
+        _moved[proxy] = 0;
+    }
+    _move_buffer.clear();
+}
+
+void DynamicAABB3Tree::Validate() const {
+    if(_root != NULL_NODE) {
+        ASSERT_OR_DIE(_parents[_root] == NULL_NODE, "DynamicAABB3Tree::Validate: root has a parent.");
+        ValidateNode(_root);
+    }
+    std::size_t free_count = 0;
+    for(int node = _free_list; node != NULL_NODE; node = _parents[node]) {
+        ASSERT_OR_DIE(_heights[node] == -1, "DynamicAABB3Tree::Validate: free node in use.");
+        ++free_count;
+    }
+    const std::size_t used_count = _proxy_count == 0 ? 0 : 2 * _proxy_count - 1;
+    ASSERT_OR_DIE(free_count + used_count == _nodes.size(), "DynamicAABB3Tree::Validate: nodes lost.");
+}
+
+void DynamicAABB3Tree::ValidateNode(int node) const {
+    const Node& current = _nodes[node];
+    if(current.child1 == NULL_NODE) {
+        ASSERT_OR_DIE(current.child2 == NULL_NODE && _heights[node] == 0, "DynamicAABB3Tree::Validate: malformed leaf.");
+        return;
+    }
+    const int child1 = current.child1;
+    const int child2 = current.child2;
+    ASSERT_OR_DIE(_parents[child1] == node && _parents[child2] == node, "DynamicAABB3Tree::Validate: wrong parent.");
+    ASSERT_OR_DIE(_heights[node] == 1 + (std::max)(_heights[child1], _heights[child2]), "DynamicAABB3Tree::Validate: wrong height.");
+    const AABB3 expected = Union(_nodes[child1].bounds, _nodes[child2].bounds);
+    ASSERT_OR_DIE(Contains(expected, current.bounds) && Contains(current.bounds, expected), "DynamicAABB3Tree::Validate: wrong bounds.");
+    ValidateNode(child1);
+    ValidateNode(child2);
+}
+
+int DynamicAABB3Tree::AllocateNode() {
+    if(_free_list == NULL_NODE) {
+        _nodes.emplace_back();
+        _parents.push_back(NULL_NODE);
+        _heights.push_back(0);
+        _user_data.push_back(nullptr);
+        _moved.push_back(0);
+        return static_cast<int>(_nodes.size()) - 1;
+    }
+    const int node = _free_list;
+    _free_list = _parents[node];
+    _nodes[node] = Node{};
+    _parents[node] = NULL_NODE;
+    _heights[node] = 0;
+    _user_data[node] = nullptr;
+    return node;
+}
+
+void DynamicAABB3Tree::FreeNode(int node) {
+    _parents[node] = _free_list;
+    _heights[node] = -1;
+    _free_list = node;
+}
+
+bool DynamicAABB3Tree::IsLeaf(int node) const {
+    return _nodes[node].child1 == NULL_NODE;
+}
+
+void DynamicAABB3Tree::InsertLeaf(int leaf) {
+    if(_root == NULL_NODE) {
+        _root = leaf;
+        _parents[leaf] = NULL_NODE;
+        return;
+    }
+
+    //Branch and bound for the cheapest sibling. Pairing with a node costs the area of the new
+    //branch, plus what every branch above it grows by ("inherited"). Going deeper never costs
+    //less than the leaf's own area plus what is inherited so far, which bounds the search.
+    const AABB3 leaf_bounds = _nodes[leaf].bounds;
+    const float leaf_area = CalcHalfSurfaceArea(leaf_bounds);
+    int sibling = _root;
+    float best_cost = CalcHalfSurfaceArea(Union(_nodes[_root].bounds, leaf_bounds));
+    auto cheaper_first = [](const SiblingCandidate& a, const SiblingCandidate& b) { return a.inherited_cost > b.inherited_cost; };
+    _sibling_candidates.clear();
+    _sibling_candidates.push_back(SiblingCandidate{_root, 0.0f});
+    while(!_sibling_candidates.empty()) {
+        std::pop_heap(_sibling_candidates.begin(), _sibling_candidates.end(), cheaper_first);
+        const SiblingCandidate candidate = _sibling_candidates.back();
+        _sibling_candidates.pop_back();
+        if(best_cost <= candidate.inherited_cost + leaf_area) {
+            break;
+        }
+        const Node& current = _nodes[candidate.node];
+        const float combined_area = CalcHalfSurfaceArea(Union(current.bounds, leaf_bounds));
+        const float cost = combined_area + candidate.inherited_cost;
+        if(cost < best_cost) {
+            best_cost = cost;
+            sibling = candidate.node;
+        }
+        if(current.child1 == NULL_NODE) {
+            continue;
+        }
+        const float inherited_cost = candidate.inherited_cost + combined_area - CalcHalfSurfaceArea(current.bounds);
+        if(inherited_cost + leaf_area < best_cost) {
+            _sibling_candidates.push_back(SiblingCandidate{current.child1, inherited_cost});
+            std::push_heap(_sibling_candidates.begin(), _sibling_candidates.end(), cheaper_first);
+            _sibling_candidates.push_back(SiblingCandidate{current.child2, inherited_cost});
+            std::push_heap(_sibling_candidates.begin(), _sibling_candidates.end(), cheaper_first);
+        }
+    }
+
+    //Allocating may reallocate _nodes, so nothing above holds a reference across it.
+    const int old_parent = _parents[sibling];
+    const int new_parent = AllocateNode();
+    _parents[new_parent] = old_parent;
+    _nodes[new_parent].bounds = Union(leaf_bounds, _nodes[sibling].bounds);
+    _nodes[new_parent].child1 = sibling;
+    _nodes[new_parent].child2 = leaf;
+    _heights[new_parent] = _heights[sibling] + 1;
+    _parents[sibling] = new_parent;
+    _parents[leaf] = new_parent;
+    if(old_parent == NULL_NODE) {
+        _root = new_parent;
+    } else if(_nodes[old_parent].child1 == sibling) {
+        _nodes[old_parent].child1 = new_parent;
+    } else {
+        _nodes[old_parent].child2 = new_parent;
+    }
+
+    RefitAncestors(new_parent);
+}
+
+void DynamicAABB3Tree::RemoveLeaf(int leaf) {
+    if(leaf == _root) {
+        _root = NULL_NODE;
+        return;
+    }
+    const int parent = _parents[leaf];
+    const int grandparent = _parents[parent];
+    const int sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+    FreeNode(parent);
+    if(grandparent == NULL_NODE) {
+        _root = sibling;
+        _parents[sibling] = NULL_NODE;
+        return;
+    }
+    if(_nodes[grandparent].child1 == parent) {
+        _nodes[grandparent].child1 = sibling;
+    } else {
+        _nodes[grandparent].child2 = sibling;
+    }
+    _parents[sibling] = grandparent;
+    RefitAncestors(grandparent);
+}
+
+void DynamicAABB3Tree::RefitAncestors(int node) {
+    while(node != NULL_NODE) {
+        node = Balance(node);
+        Node& current = _nodes[node];
+        current.bounds = Union(_nodes[current.child1].bounds, _nodes[current.child2].bounds);
+        _heights[node] = 1 + (std::max)(_heights[current.child1], _heights[current.child2]);
+        node = _parents[node];
+    }
+}
+
+//If one child of a is more than one level taller than the other, rotates it up to take a's
+//place, and a takes over its shorter grandchild. Returns the node now in a's place.
+int DynamicAABB3Tree::Balance(int a) {
+    if(IsLeaf(a) || _heights[a] < 2) {
+        return a;
+    }
+    const int b = _nodes[a].child1;
+    const int c = _nodes[a].child2;
+    const int balance = _heights[c] - _heights[b];
+    if(-1 <= balance && balance <= 1) {
+        return a;
+    }
+
+    //Rotate the taller child up. a keeps its other child and adopts the taller child's
+    //shorter grandchild; the taller child keeps its taller grandchild.
+    const bool rotate_c = balance > 1;
+    const int up = rotate_c ? c : b;
+    const int kept = rotate_c ? b : c;
+    const int f = _nodes[up].child1;
+    const int g = _nodes[up].child2;
+    const bool keep_f = _heights[f] > _heights[g];
+    const int stays = keep_f ? f : g;
+    const int moves = keep_f ? g : f;
+
+    const int a_parent = _parents[a];
+    _parents[up] = a_parent;
+    _parents[a] = up;
+    if(a_parent == NULL_NODE) {
+        _root = up;
+    } else if(_nodes[a_parent].child1 == a) {
+        _nodes[a_parent].child1 = up;
+    } else {
+        _nodes[a_parent].child2 = up;
+    }
+
+    _nodes[up].child1 = a;
+    _nodes[up].child2 = stays;
+    if(rotate_c) {
+        _nodes[a].child2 = moves;
+    } else {
+        _nodes[a].child1 = moves;
+    }
+    _parents[moves] = a;
+
+    _nodes[a].bounds = Union(_nodes[kept].bounds, _nodes[moves].bounds);
+    _heights[a] = 1 + (std::max)(_heights[kept], _heights[moves]);
+    _nodes[up].bounds = Union(_nodes[a].bounds, _nodes[stays].bounds);
+    _heights[up] = 1 + (std::max)(_heights[a], _heights[stays]);
+    return up;
+}
+
+void DynamicAABB3Tree::CollectLeaves(int node, std::vector<int>& results) const {
+    TraversalStack<int> stack;
+    stack.Push(node);
+    while(!stack.IsEmpty()) {
+        const int current = stack.Pop();
+        const Node& n = _nodes[current];
+        if(n.child1 == NULL_NODE) {
+            results.push_back(current);
+            continue;
+        }
+        stack.Push(n.child1);
+        stack.Push(n.child2);
+    }
+}
+
+void DynamicAABB3TreeBenchmark(unsigned int frames) {
+    frames = (std::max)(frames, 1u);
+    g_theFileLogger->LogTagf("test", "DynamicAABB3Tree, %u frames of motion:\n", frames);
+
+    const std::size_t object_counts[] = {10000, 100000};
+    for(std::size_t object_count : object_counts) {
+        //Unit boxes at a density of about two overlaps each, drifting and bouncing off the walls.
+        const float world_size = std::cbrt(4.0f * static_cast<float>(object_count));
+        const float half_extent = 0.5f;
+        const float max_speed = 0.05f;
+        RandomEngine rng(12345u);
+        std::vector<Vector3> positions(object_count);
+        std::vector<Vector3> velocities(object_count);
+        for(std::size_t i = 0; i < object_count; ++i) {
+            positions[i] = Vector3(rng.NextFloat() * world_size, rng.NextFloat() * world_size, rng.NextFloat() * world_size);
+            velocities[i] = Vector3(rng.NextFloat() * 2.0f - 1.0f, rng.NextFloat() * 2.0f - 1.0f, rng.NextFloat() * 2.0f - 1.0f) * max_speed;
+        }
+        auto bounds_of = [&](std::size_t i) { return AABB3(positions[i], half_extent, half_extent, half_extent); };
+
+        DynamicAABB3Tree tree;
+        std::vector<int> proxies(object_count);
+        double start = GetCurrentTimeSeconds();
+        tree.Reserve(object_count);
+        for(std::size_t i = 0; i < object_count; ++i) {
+            proxies[i] = tree.CreateProxy(bounds_of(i));
+        }
+        const double build_ms = (GetCurrentTimeSeconds() - start) * 1000.0;
+
+        std::vector<std::pair<int, int>> pairs{};
+        tree.FindMovedPairs(pairs);
+        std::size_t reinserted = 0;
+        std::size_t new_pairs = 0;
+        double move_seconds = 0.0;
+        double pair_seconds = 0.0;
+        for(unsigned int frame = 0; frame < frames; ++frame) {
+            start = GetCurrentTimeSeconds();
+            for(std::size_t i = 0; i < object_count; ++i) {
+                Vector3& p = positions[i];
+                Vector3& v = velocities[i];
+                p += v;
+                if(p.x < 0.0f || world_size < p.x) { v.x = -v.x; }
+                if(p.y < 0.0f || world_size < p.y) { v.y = -v.y; }
+                if(p.z < 0.0f || world_size < p.z) { v.z = -v.z; }
+                reinserted += tree.MoveProxy(proxies[i], bounds_of(i), v) ? 1 : 0;
+            }
+            move_seconds += GetCurrentTimeSeconds() - start;
+            start = GetCurrentTimeSeconds();
+            pairs.clear();
+            tree.FindMovedPairs(pairs);
+            pair_seconds += GetCurrentTimeSeconds() - start;
+            new_pairs += pairs.size();
+        }
+        tree.Validate();
+
+        start = GetCurrentTimeSeconds();
+        pairs.clear();
+        tree.FindAllPairs(pairs);
+        const double all_pairs_ms = (GetCurrentTimeSeconds() - start) * 1000.0;
+
+        //A 90 degree frustum from the middle of the world looking down +z.
+        const float center = world_size * 0.5f;
+        const Vector3 apex(center, center, center);
+        const Vector3 planes_normals[] = {Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, -1.0f),
+                                          Vector3(MathUtils::M_1_SQRT2, 0.0f, MathUtils::M_1_SQRT2), Vector3(-MathUtils::M_1_SQRT2, 0.0f, MathUtils::M_1_SQRT2),
+                                          Vector3(0.0f, MathUtils::M_1_SQRT2, MathUtils::M_1_SQRT2), Vector3(0.0f, -MathUtils::M_1_SQRT2, MathUtils::M_1_SQRT2)};
+        Plane3 frustum[6];
+        for(std::size_t i = 0; i < 6; ++i) {
+            frustum[i] = Plane3(planes_normals[i], MathUtils::DotProduct(planes_normals[i], apex));
+        }
+        frustum[0].dist += 1.0f;
+        frustum[1].dist = -world_size;
+        std::vector<int> visible{};
+        start = GetCurrentTimeSeconds();
+        tree.QueryFrustum(frustum, visible);
+        const double frustum_ms = (GetCurrentTimeSeconds() - start) * 1000.0;
+
+        const unsigned int ray_count = 1000;
+        std::vector<LineSegment3> segments(ray_count);
+        for(auto& segment : segments) {
+            segment = LineSegment3(Vector3(rng.NextFloat() * world_size, rng.NextFloat() * world_size, rng.NextFloat() * world_size),
+                                   Vector3(rng.NextFloat() * world_size, rng.NextFloat() * world_size, rng.NextFloat() * world_size));
+        }
+        std::vector<int> hits{};
+        start = GetCurrentTimeSeconds();
+        for(const auto& segment : segments) {
+            tree.QuerySegment(segment, hits);
+        }
+        const double segment_us = (GetCurrentTimeSeconds() - start) * 1.0e6 / ray_count;
+
+        g_theFileLogger->LogTagf("test", "  %u objects: build %.2f ms, height %d; per frame: move %.3f ms (%.1f%% reinserted), moved pairs %.3f ms (%.0f new)\n",
+                                 static_cast<unsigned int>(object_count), build_ms, tree.GetHeight(), move_seconds * 1000.0 / frames,
+                                 100.0 * static_cast<double>(reinserted) / (static_cast<double>(object_count) * frames),
+                                 pair_seconds * 1000.0 / frames, static_cast<double>(new_pairs) / frames);
+        g_theFileLogger->LogTagf("test", "    all %u pairs %.2f ms, frustum %u visible %.3f ms, segment %u hits %.2f us each\n",
+                                 static_cast<unsigned int>(pairs.size()), all_pairs_ms, static_cast<unsigned int>(visible.size()), frustum_ms,
+                                 static_cast<unsigned int>(hits.size()), segment_us);
+
+        //The tree must find exactly what testing every fat box would; n^2 is only affordable for the smaller set.
+        if(object_count > 10000) {
+            continue;
+        }
+        std::vector<std::pair<int, int>> brute_pairs{};
+        std::vector<int> brute_visible{};
+        std::vector<int> brute_hits{};
+        start = GetCurrentTimeSeconds();
+        for(std::size_t i = 0; i < object_count; ++i) {
+            const AABB3& a = tree.GetFatBounds(proxies[i]);
+            for(std::size_t j = i + 1; j < object_count; ++j) {
+                if(MathUtils::DoAABB3sOverlap(a, tree.GetFatBounds(proxies[j]))) {
+                    brute_pairs.emplace_back((std::min)(proxies[i], proxies[j]), (std::max)(proxies[i], proxies[j]));
+                }
+            }
+        }
+        const double brute_pairs_ms = (GetCurrentTimeSeconds() - start) * 1000.0;
+        for(std::size_t i = 0; i < object_count; ++i) {
+            if(!IsAABB3OutsidePlanes(tree.GetFatBounds(proxies[i]), frustum)) {
+                brute_visible.push_back(proxies[i]);
+            }
+        }
+        for(const auto& segment : segments) {
+            const Vector3 inv_direction = CalcInverseDirection(segment.CalcDisplacement());
+            for(std::size_t i = 0; i < object_count; ++i) {
+                if(DoesRayHitAABB3(segment.start, inv_direction, 1.0f, tree.GetFatBounds(proxies[i]))) {
+                    brute_hits.push_back(proxies[i]);
+                }
+            }
+        }
+        //Compare the sets, not just their sizes.
+        std::sort(pairs.begin(), pairs.end());
+        std::sort(brute_pairs.begin(), brute_pairs.end());
+        std::sort(visible.begin(), visible.end());
+        std::sort(brute_visible.begin(), brute_visible.end());
+        std::sort(hits.begin(), hits.end());
+        std::sort(brute_hits.begin(), brute_hits.end());
+        const bool results_match = brute_pairs == pairs && brute_visible == visible && brute_hits == hits;
+        g_theFileLogger->LogTagf("test", "    brute force: %u pairs %.2f ms, %u visible, %u segment hits. %s\n",
+                                 static_cast<unsigned int>(brute_pairs.size()), brute_pairs_ms, static_cast<unsigned int>(brute_visible.size()), static_cast<unsigned int>(brute_hits.size()),
+                                 results_match ? "Results match." : "RESULTS DIFFER.");
+        GUARANTEE_RECOVERABLE(results_match, "DynamicAABB3Tree queries differ from brute force.");
+    }
+}
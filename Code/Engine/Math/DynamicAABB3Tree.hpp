@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Vector3.hpp"
+
+class LineSegment3;
+class Plane3;
+class Sphere3;
+
+//Bounding volume hierarchy over AABB3s for broad-phase queries, built incrementally.
+//Each proxy is stored with fat bounds: its bounds padded by a margin and stretched along its
+//last displacement. Small moves stay inside the fat bounds and cost nothing; only proxies that
+//leave them are reinserted. Insertion picks the sibling that adds the least surface area to
+//the tree, and tree rotations keep it shallow.
+//Every query tests the fat bounds, so results are candidates for an exact test.
+//Queries append to their output and leave existing contents alone.
+class DynamicAABB3Tree {
+public:
+    static constexpr int NULL_PROXY = -1;
+
+    //margin pads every side of a proxy's bounds. displacement_multiplier scales how far the
+    //fat bounds are stretched ahead along a move's displacement.
+    explicit DynamicAABB3Tree(float margin = 0.1f, float displacement_multiplier = 2.0f);
+    ~DynamicAABB3Tree() = default;
+
+    //Returns a proxy id that stays valid until DestroyProxy.
+    int CreateProxy(const AABB3& bounds, void* user_data = nullptr);
+    void DestroyProxy(int proxy);
+    //Returns true if the proxy left its fat bounds (or they became too loose) and was reinserted.
+    bool MoveProxy(int proxy, const AABB3& bounds, const Vector3& displacement = Vector3::ZERO);
+    void Clear();
+    void Reserve(std::size_t proxy_count);
+
+    void* GetUserData(int proxy) const;
+    const AABB3& GetFatBounds(int proxy) const;
+    std::size_t GetProxyCount() const;
+    //Zero for a single proxy, -1 when empty.
+    int GetHeight() const;
+
+    void QueryOverlaps(const AABB3& bounds, std::vector<int>& results) const;
+    void QuerySphere(const Sphere3& sphere, std::vector<int>& results) const;
+    void QuerySegment(const LineSegment3& segment, std::vector<int>& results) const;
+    void QueryRay(const Vector3& origin, const Vector3& direction, std::vector<int>& results, float max_distance = (std::numeric_limits<float>::max)()) const;
+    //A box is culled when it is entirely behind one of the planes, i.e. the planes face
+    //inward, as with IsPointInFrontOfPlane. Takes a Camera3D::CameraFrustum directly.
+    //At most 32 planes.
+    void QueryFrustum(std::span<const Plane3> planes, std::vector<int>& results) const;
+
+    //Every overlapping pair once, as (lower id, higher id).
+    void FindAllPairs(std::vector<std::pair<int, int>>& pairs) const;
+    //Overlapping pairs in which at least one proxy was created or reinserted since the last
+    //call, each once. Pairs of proxies that stayed inside their fat bounds are not repeated,
+    //so callers keep their own pair list up to date from these.
+    void FindMovedPairs(std::vector<std::pair<int, int>>& pairs);
+
+    //Dies if the parent links, heights or bounds are inconsistent.
+    void Validate() const;
+
+protected:
+private:
+    static constexpr int NULL_NODE = -1;
+
+    //Only what traversal reads, so two nodes share a cache line. Leaves have no children.
+    struct alignas(32) Node {
+        AABB3 bounds{};
+        int child1 = NULL_NODE;
+        int child2 = NULL_NODE;
+    };
+    struct SiblingCandidate {
+        int node = NULL_NODE;
+        float inherited_cost = 0.0f;
+    };
+
+    int AllocateNode();
+    void FreeNode(int node);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int node);
+    void RefitAncestors(int node);
+    bool IsLeaf(int node) const;
+    void CollectLeaves(int node, std::vector<int>& results) const;
+    void ValidateNode(int node) const;
+
+    template<typename Overlaps>
+    void Query(Overlaps&& overlaps, std::vector<int>& results) const;
+
+    std::vector<Node> _nodes{};
+    //Parent while in use, next free node while on the free list.
+    std::vector<int> _parents{};
+    //-1 while on the free list.
+    std::vector<int> _heights{};
+    std::vector<void*> _user_data{};
+    std::vector<unsigned char> _moved{};
+    std::vector<int> _move_buffer{};
+    //Scratch heap for InsertLeaf, kept to avoid an allocation per insert.
+    std::vector<SiblingCandidate> _sibling_candidates{};
+    float _margin = 0.1f;
+    float _displacement_multiplier = 2.0f;
+    int _root = NULL_NODE;
+    int _free_list = NULL_NODE;
+    std::size_t _proxy_count = 0;
+};
+
+void DynamicAABB3TreeBenchmark(unsigned int frames);
@@ -0,0 +1,513 @@
+#include "Engine/Math/FrustumCuller.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "Engine/EngineConfig.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Plane3.hpp"
+#include "Engine/Math/RandomEngine.hpp"
+#include "Engine/Math/Simd.hpp"
+#include "Engine/Math/Sphere3.hpp"
+#include "Engine/Math/Vector3.hpp"
+
+namespace {
+
+//The SoA storage is padded to this many volumes, enough for the widest kernel.
+constexpr std::size_t SOA_PADDING = 8;
+//Below this many lane groups a job costs more than the work it takes off the calling thread.
+constexpr std::size_t MIN_GROUPS_PER_JOB = 2048;
+//Keeps a cache entry that Cull did not write inside the plane table.
+constexpr std::uint8_t PLANE_INDEX_MASK = FrustumCuller::MAX_PLANES - 1;
+static_assert((FrustumCuller::MAX_PLANES & PLANE_INDEX_MASK) == 0, "MAX_PLANES must be a power of two.");
+
+std::size_t RoundUpToPadding(std::size_t count) {
+    return (count + SOA_PADDING - 1) / SOA_PADDING * SOA_PADDING;
+}
+
+//One register of volumes. Each kernel below is written once against these.
+#if defined(ENGINE_SIMD_AVX)
+
+constexpr std::size_t LANE_COUNT = 8;
+using FloatLanes = __m256;
+
+FloatLanes LoadLanes(const float* values) { return _mm256_loadu_ps(values); }
+FloatLanes SplatLanes(float value) { return _mm256_set1_ps(value); }
+FloatLanes AddLanes(FloatLanes a, FloatLanes b) { return _mm256_add_ps(a, b); }
+FloatLanes MultiplyLanes(FloatLanes a, FloatLanes b) { return _mm256_mul_ps(a, b); }
+FloatLanes AbsLanes(FloatLanes a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+unsigned int CalcLessBits(FloatLanes a, FloatLanes b) { return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ))); }
+
+//Transposes the plane rows the lanes index into one register per plane component. The lower
+//128 bits take lanes 0-3 and the upper 128 bits lanes 4-7, as _MM_TRANSPOSE4_PS does per half.
+void GatherPlaneLanes(const float (*planes)[4], const std::uint8_t* indices, FloatLanes (&components)[4]) {
+    const __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(planes[indices[0] & PLANE_INDEX_MASK])), _mm_load_ps(planes[indices[4] & PLANE_INDEX_MASK]), 1);
+    const __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(planes[indices[1] & PLANE_INDEX_MASK])), _mm_load_ps(planes[indices[5] & PLANE_INDEX_MASK]), 1);
+    const __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(planes[indices[2] & PLANE_INDEX_MASK])), _mm_load_ps(planes[indices[6] & PLANE_INDEX_MASK]), 1);
+    const __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(planes[indices[3] & PLANE_INDEX_MASK])), _mm_load_ps(planes[indices[7] & PLANE_INDEX_MASK]), 1);
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    components[0] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    components[1] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    components[2] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    components[3] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+#elif defined(ENGINE_SIMD_SSE)
+
+constexpr std::size_t LANE_COUNT = 4;
+using FloatLanes = __m128;
+
+FloatLanes LoadLanes(const float* values) { return _mm_loadu_ps(values); }
+FloatLanes SplatLanes(float value) { return _mm_set1_ps(value); }
+FloatLanes AddLanes(FloatLanes a, FloatLanes b) { return _mm_add_ps(a, b); }
+FloatLanes MultiplyLanes(FloatLanes a, FloatLanes b) { return _mm_mul_ps(a, b); }
+FloatLanes AbsLanes(FloatLanes a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+unsigned int CalcLessBits(FloatLanes a, FloatLanes b) { return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(a, b))); }
+
+//Transposes the plane rows the lanes index into one register per plane component.
+void GatherPlaneLanes(const float (*planes)[4], const std::uint8_t* indices, FloatLanes (&components)[4]) {
+    components[0] = _mm_load_ps(planes[indices[0] & PLANE_INDEX_MASK]);
+    components[1] = _mm_load_ps(planes[indices[1] & PLANE_INDEX_MASK]);
+    components[2] = _mm_load_ps(planes[indices[2] & PLANE_INDEX_MASK]);
+    components[3] = _mm_load_ps(planes[indices[3] & PLANE_INDEX_MASK]);
+    _MM_TRANSPOSE4_PS(components[0], components[1], components[2], components[3]);
+}
+
+#else
+
+constexpr std::size_t LANE_COUNT = 1;
+using FloatLanes = float;
+
+FloatLanes LoadLanes(const float* values) { return *values; }
+FloatLanes SplatLanes(float value) { return value; }
+FloatLanes AddLanes(FloatLanes a, FloatLanes b) { return a + b; }
+FloatLanes MultiplyLanes(FloatLanes a, FloatLanes b) { return a * b; }
+FloatLanes AbsLanes(FloatLanes a) { return std::fabs(a); }
+unsigned int CalcLessBits(FloatLanes a, FloatLanes b) { return a < b ? 1u : 0u; }
+
+void GatherPlaneLanes(const float (*planes)[4], const std::uint8_t* indices, FloatLanes (&components)[4]) {
+    for(std::size_t i = 0; i < 4; ++i) {
+        components[i] = planes[indices[0] & PLANE_INDEX_MASK][i];
+    }
+}
+
+#endif
+
+static_assert(LANE_COUNT <= SOA_PADDING, "The SoA padding must cover a full lane group.");
+
+struct PlaneLanes {
+    FloatLanes normal_x;
+    FloatLanes normal_y;
+    FloatLanes normal_z;
+    FloatLanes dist;
+};
+
+PlaneLanes MakePlaneLanes(const FloatLanes (&components)[4]) {
+    return PlaneLanes{components[0], components[1], components[2], components[3]};
+}
+
+FloatLanes CalcDotLanes(const PlaneLanes& plane, FloatLanes x, FloatLanes y, FloatLanes z) {
+    return AddLanes(AddLanes(MultiplyLanes(plane.normal_x, x), MultiplyLanes(plane.normal_y, y)), MultiplyLanes(plane.normal_z, z));
+}
+
+//A sphere is behind a plane when even its point furthest along the normal is.
+struct SphereGroup {
+    FloatLanes center_x;
+    FloatLanes center_y;
+    FloatLanes center_z;
+    FloatLanes radius;
+
+    unsigned int CalcBehindBits(const PlaneLanes& plane) const {
+        return CalcLessBits(AddLanes(CalcDotLanes(plane, center_x, center_y, center_z), radius), plane.dist);
+    }
+};
+
+struct SphereLanes {
+    const float* center_x;
+    const float* center_y;
+    const float* center_z;
+    const float* radius;
+
+    SphereGroup Load(std::size_t first) const {
+        return SphereGroup{LoadLanes(center_x + first), LoadLanes(center_y + first), LoadLanes(center_z + first), LoadLanes(radius + first)};
+    }
+};
+
+//A box reaches |n.x| * half.x + |n.y| * half.y + |n.z| * half.z past its center along n.
+struct BoxGroup {
+    FloatLanes center_x;
+    FloatLanes center_y;
+    FloatLanes center_z;
+    FloatLanes half_x;
+    FloatLanes half_y;
+    FloatLanes half_z;
+
+    unsigned int CalcBehindBits(const PlaneLanes& plane) const {
+        const FloatLanes reach = AddLanes(AddLanes(MultiplyLanes(AbsLanes(plane.normal_x), half_x), MultiplyLanes(AbsLanes(plane.normal_y), half_y)), MultiplyLanes(AbsLanes(plane.normal_z), half_z));
+        return CalcLessBits(AddLanes(CalcDotLanes(plane, center_x, center_y, center_z), reach), plane.dist);
+    }
+};
+
+struct BoxLanes {
+    const float* center_x;
+    const float* center_y;
+    const float* center_z;
+    const float* half_x;
+    const float* half_y;
+    const float* half_z;
+
+    BoxGroup Load(std::size_t first) const {
+        return BoxGroup{LoadLanes(center_x + first), LoadLanes(center_y + first), LoadLanes(center_z + first),
+                        LoadLanes(half_x + first), LoadLanes(half_y + first), LoadLanes(half_z + first)};
+    }
+};
+
+//A 90 degree frustum at eye looking along yaw in the xz plane, facing inward like
+//Camera3D::CalcFrustum.
+void CalcBenchmarkFrustum(const Vector3& eye, float yaw_degrees, float far_distance, Plane3 (&planes)[6]) {
+    const Vector3 forward(MathUtils::SinDegrees(yaw_degrees), 0.0f, MathUtils::CosDegrees(yaw_degrees));
+    const Vector3 right(MathUtils::CosDegrees(yaw_degrees), 0.0f, -MathUtils::SinDegrees(yaw_degrees));
+    const Vector3 side_normals[4] = {(forward - right) * MathUtils::M_1_SQRT2, (forward + right) * MathUtils::M_1_SQRT2,
+                                     (forward - Vector3::Y_AXIS) * MathUtils::M_1_SQRT2, (forward + Vector3::Y_AXIS) * MathUtils::M_1_SQRT2};
+    for(std::size_t i = 0; i < 4; ++i) {
+        planes[i] = Plane3(side_normals[i], MathUtils::DotProduct(side_normals[i], eye));
+    }
+    const float eye_distance = MathUtils::DotProduct(forward, eye);
+    planes[4] = Plane3(forward, eye_distance + 0.1f);
+    planes[5] = Plane3(-forward, -(eye_distance + far_distance));
+}
+
+//The one-at-a-time tests the kernels replace, summed in the same order so results match exactly.
+bool IsSphereBehindAnyPlane(const Sphere3& sphere, std::span<const Plane3> planes) {
+    for(const Plane3& plane : planes) {
+        if(MathUtils::DotProduct(plane.normal, sphere.center) + sphere.radius < plane.dist) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool IsBoxBehindAnyPlane(const AABB3& box, std::span<const Plane3> planes) {
+    const Vector3 center((box.mins.x + box.maxs.x) * 0.5f, (box.mins.y + box.maxs.y) * 0.5f, (box.mins.z + box.maxs.z) * 0.5f);
+    const Vector3 half((box.maxs.x - box.mins.x) * 0.5f, (box.maxs.y - box.mins.y) * 0.5f, (box.maxs.z - box.mins.z) * 0.5f);
+    for(const Plane3& plane : planes) {
+        const float reach = std::fabs(plane.normal.x) * half.x + std::fabs(plane.normal.y) * half.y + std::fabs(plane.normal.z) * half.z;
+        if(MathUtils::DotProduct(plane.normal, center) + reach < plane.dist) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void BoundingSphereSoA::Clear() {
+    Resize(0);
+}
+
+void BoundingSphereSoA::Reserve(std::size_t count) {
+    const std::size_t padded = RoundUpToPadding(count);
+    _center_x.reserve(padded);
+    _center_y.reserve(padded);
+    _center_z.reserve(padded);
+    _radius.reserve(padded);
+}
+
+std::size_t BoundingSphereSoA::Add(const Sphere3& sphere) {
+    return Add(sphere.center, sphere.radius);
+}
+
+std::size_t BoundingSphereSoA::Add(const Vector3& center, float radius) {
+    const std::size_t index = _count;
+    Resize(_count + 1);
+    Set(index, center, radius);
+    return index;
+}
+
+void BoundingSphereSoA::Set(std::size_t index, const Sphere3& sphere) {
+    Set(index, sphere.center, sphere.radius);
+}
+
+void BoundingSphereSoA::Set(std::size_t index, const Vector3& center, float radius) {
+    _center_x[index] = center.x;
+    _center_y[index] = center.y;
+    _center_z[index] = center.z;
+    _radius[index] = radius;
+}
+
+std::size_t BoundingSphereSoA::GetCount() const {
+    return _count;
+}
+
+void BoundingSphereSoA::Resize(std::size_t count) {
+    const std::size_t padded = RoundUpToPadding(count);
+    _center_x.resize(padded);
+    _center_y.resize(padded);
+    _center_z.resize(padded);
+    _radius.resize(padded);
+    _count = count;
+}
+
+void BoundingBoxSoA::Clear() {
+    Resize(0);
+}
+
+void BoundingBoxSoA::Reserve(std::size_t count) {
+    const std::size_t padded = RoundUpToPadding(count);
+    _center_x.reserve(padded);
+    _center_y.reserve(padded);
+    _center_z.reserve(padded);
+    _half_x.reserve(padded);
+    _half_y.reserve(padded);
+    _half_z.reserve(padded);
+}
+
+std::size_t BoundingBoxSoA::Add(const AABB3& box) {
+    const std::size_t index = _count;
+    Resize(_count + 1);
+    Set(index, box);
+    return index;
+}
+
+void BoundingBoxSoA::Set(std::size_t index, const AABB3& box) {
+    _center_x[index] = (box.mins.x + box.maxs.x) * 0.5f;
+    _center_y[index] = (box.mins.y + box.maxs.y) * 0.5f;
+    _center_z[index] = (box.mins.z + box.maxs.z) * 0.5f;
+    _half_x[index] = (box.maxs.x - box.mins.x) * 0.5f;
+    _half_y[index] = (box.maxs.y - box.mins.y) * 0.5f;
+    _half_z[index] = (box.maxs.z - box.mins.z) * 0.5f;
+}
+
+std::size_t BoundingBoxSoA::GetCount() const {
+    return _count;
+}
+
+void BoundingBoxSoA::Resize(std::size_t count) {
+    const std::size_t padded = RoundUpToPadding(count);
+    _center_x.resize(padded);
+    _center_y.resize(padded);
+    _center_z.resize(padded);
+    _half_x.resize(padded);
+    _half_y.resize(padded);
+    _half_z.resize(padded);
+    _count = count;
+}
+
+FrustumCuller::FrustumCuller(std::span<const Plane3> planes) {
+    SetPlanes(planes);
+}
+
+void FrustumCuller::SetPlanes(std::span<const Plane3> planes) {
+    ASSERT_OR_DIE(planes.size() <= MAX_PLANES, "FrustumCuller supports at most eight planes.");
+    for(std::size_t i = 0; i < MAX_PLANES; ++i) {
+        const bool used = i < planes.size();
+        _planes[i][0] = used ? planes[i].normal.x : 0.0f;
+        _planes[i][1] = used ? planes[i].normal.y : 0.0f;
+        _planes[i][2] = used ? planes[i].normal.z : 0.0f;
+        _planes[i][3] = used ? planes[i].dist : 0.0f;
+    }
+    _plane_count = planes.size();
+}
+
+std::size_t FrustumCuller::GetPlaneCount() const {
+    return _plane_count;
+}
+
+void FrustumCuller::Cull(const BoundingSphereSoA& spheres, std::vector<std::uint32_t>& visible, std::vector<std::uint8_t>* last_rejecting_planes /*= nullptr*/) const {
+    const SphereLanes lanes{spheres._center_x.data(), spheres._center_y.data(), spheres._center_z.data(), spheres._radius.data()};
+    CullBatches(lanes, spheres.GetCount(), visible, last_rejecting_planes);
+}
+
+void FrustumCuller::Cull(const BoundingBoxSoA& boxes, std::vector<std::uint32_t>& visible, std::vector<std::uint8_t>* last_rejecting_planes /*= nullptr*/) const {
+    const BoxLanes lanes{boxes._center_x.data(), boxes._center_y.data(), boxes._center_z.data(), boxes._half_x.data(), boxes._half_y.data(), boxes._half_z.data()};
+    CullBatches(lanes, boxes.GetCount(), visible, last_rejecting_planes);
+}
+
+//Each slice of lane groups writes its survivors at its own offset in visible, which has room
+//for every volume; the slices are then moved together.
+template<typename Batch>
+void FrustumCuller::CullBatches(const Batch& batch, std::size_t count, std::vector<std::uint32_t>& visible, std::vector<std::uint8_t>* last_rejecting_planes) const {
+    visible.resize(count);
+    const std::size_t group_count = (count + LANE_COUNT - 1) / LANE_COUNT;
+    if(last_rejecting_planes) {
+        last_rejecting_planes->resize(RoundUpToPadding(count), 0);
+    }
+    PlaneLanes planes[MAX_PLANES];
+    for(std::size_t p = 0; p < _plane_count; ++p) {
+        planes[p] = PlaneLanes{SplatLanes(_planes[p][0]), SplatLanes(_planes[p][1]), SplatLanes(_planes[p][2]), SplatLanes(_planes[p][3])};
+    }
+
+    const std::size_t slice_count = JobSystem::CalcSliceCount(group_count, MIN_GROUPS_PER_JOB);
+    std::vector<std::size_t> slice_visible_counts(slice_count, 0);
+    JobSystem::ForEachSlice(group_count, slice_count, [&](std::size_t begin, std::size_t end, std::size_t slice) {
+        std::uint32_t* out = visible.data() + begin * LANE_COUNT;
+        std::size_t visible_count = 0;
+        for(std::size_t group = begin; group < end; ++group) {
+            const std::size_t first = group * LANE_COUNT;
+            const std::size_t lanes_used = (std::min)(count - first, LANE_COUNT);
+            const unsigned int used_bits = (1u << lanes_used) - 1u;
+            const auto volumes = batch.Load(first);
+            unsigned int behind_bits = 0;
+            if(last_rejecting_planes) {
+                std::uint8_t* cached = last_rejecting_planes->data() + first;
+                FloatLanes components[4];
+                GatherPlaneLanes(_planes, cached, components);
+                behind_bits = volumes.CalcBehindBits(MakePlaneLanes(components)) & used_bits;
+                for(std::size_t p = 0; p < _plane_count && behind_bits != used_bits; ++p) {
+                    unsigned int newly_behind = volumes.CalcBehindBits(planes[p]) & ~behind_bits;
+                    behind_bits |= newly_behind;
+                    for(; newly_behind != 0; newly_behind &= newly_behind - 1u) {
+                        cached[std::countr_zero(newly_behind)] = static_cast<std::uint8_t>(p);
+                    }
+                }
+            } else {
+                for(std::size_t p = 0; p < _plane_count; ++p) {
+                    behind_bits |= volumes.CalcBehindBits(planes[p]);
+                }
+            }
+            for(unsigned int kept = ~behind_bits & used_bits; kept != 0; kept &= kept - 1u) {
+                out[visible_count++] = static_cast<std::uint32_t>(first + static_cast<std::size_t>(std::countr_zero(kept)));
+            }
+        }
+        slice_visible_counts[slice] = visible_count;
+    });
+
+    std::size_t visible_count = slice_visible_counts[0];
+    for(std::size_t slice = 1; slice < slice_count; ++slice) {
+        const std::uint32_t* slice_begin = visible.data() + JobSystem::CalcSliceBegin(group_count, slice_count, slice) * LANE_COUNT;
+        std::copy(slice_begin, slice_begin + slice_visible_counts[slice], visible.data() + visible_count);
+        visible_count += slice_visible_counts[slice];
+    }
+    visible.resize(visible_count);
+}
+
+void FrustumCullingBenchmark(unsigned int frames) {
+    frames = (std::max)(frames, 1u);
+    g_theFileLogger->LogTagf("test", "FrustumCuller, %u frames of a turning camera, %s with %u lanes, %s:\n",
+                             frames, MathUtils::GetSimdInstructionSetName(), static_cast<unsigned int>(LANE_COUNT), g_theJobSystem ? "as jobs" : "in sequence");
+
+    //Volumes scattered through a cube around the camera, about a tenth of them in view.
+    const std::size_t volume_count = 100000;
+    const float world_half_extent = 500.0f;
+    const float far_distance = 400.0f;
+    RandomEngine rng(12345u);
+    std::vector<Sphere3> spheres(volume_count);
+    std::vector<AABB3> boxes(volume_count);
+    auto random_coordinate = [&rng, world_half_extent]() { return (rng.NextFloat() * 2.0f - 1.0f) * world_half_extent; };
+    for(std::size_t i = 0; i < volume_count; ++i) {
+        const Vector3 center(random_coordinate(), random_coordinate(), random_coordinate());
+        const Vector3 half(0.5f + rng.NextFloat() * 4.5f, 0.5f + rng.NextFloat() * 4.5f, 0.5f + rng.NextFloat() * 4.5f);
+        spheres[i] = Sphere3(center, half.CalcLength());
+        boxes[i] = AABB3(center - half, center + half);
+    }
+
+    //In random order, then grouped by coarse cell the way a scene kept in spatial order would be;
+    //the coherency cache pays off when neighbouring volumes tend to be rejected together.
+    for(int layout = 0; layout < 2; ++layout) {
+        if(layout == 1) {
+            const float cell_size = 50.0f;
+            auto cell_key = [world_half_extent, cell_size](const Vector3& p) {
+                const int cells_per_axis = static_cast<int>(2.0f * world_half_extent / cell_size) + 1;
+                const int x = static_cast<int>((p.x + world_half_extent) / cell_size);
+                const int y = static_cast<int>((p.y + world_half_extent) / cell_size);
+                const int z = static_cast<int>((p.z + world_half_extent) / cell_size);
+                return (x * cells_per_axis + z) * cells_per_axis + y;
+            };
+            std::vector<std::size_t> order(volume_count);
+            for(std::size_t i = 0; i < volume_count; ++i) {
+                order[i] = i;
+            }
+            std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return cell_key(spheres[a].center) < cell_key(spheres[b].center); });
+            std::vector<Sphere3> sorted_spheres(volume_count);
+            std::vector<AABB3> sorted_boxes(volume_count);
+            for(std::size_t i = 0; i < volume_count; ++i) {
+                sorted_spheres[i] = spheres[order[i]];
+                sorted_boxes[i] = boxes[order[i]];
+            }
+            spheres.swap(sorted_spheres);
+            boxes.swap(sorted_boxes);
+        }
+        BoundingSphereSoA sphere_soa;
+        BoundingBoxSoA box_soa;
+        sphere_soa.Reserve(volume_count);
+        box_soa.Reserve(volume_count);
+        for(std::size_t i = 0; i < volume_count; ++i) {
+            sphere_soa.Add(spheres[i]);
+            box_soa.Add(boxes[i]);
+        }
+
+        enum Method { SCALAR, BATCHED, CACHED, METHOD_COUNT };
+        double sphere_seconds[METHOD_COUNT]{};
+        double box_seconds[METHOD_COUNT]{};
+        std::size_t sphere_visible = 0;
+        std::size_t box_visible = 0;
+        std::size_t mismatches = 0;
+        std::vector<std::uint32_t> reference{};
+        std::vector<std::uint32_t> visible{};
+        std::vector<std::uint8_t> sphere_cache{};
+        std::vector<std::uint8_t> box_cache{};
+        for(unsigned int frame = 0; frame < frames; ++frame) {
+            Plane3 planes[6];
+            CalcBenchmarkFrustum(Vector3::ZERO, static_cast<float>(frame) * 0.5f, far_distance, planes);
+            const FrustumCuller culler(planes);
+
+            double start = GetCurrentTimeSeconds();
+            reference.clear();
+            for(std::size_t i = 0; i < volume_count; ++i) {
+                if(!IsSphereBehindAnyPlane(spheres[i], planes)) {
+                    reference.push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+            sphere_seconds[SCALAR] += GetCurrentTimeSeconds() - start;
+            sphere_visible += reference.size();
+            start = GetCurrentTimeSeconds();
+            culler.Cull(sphere_soa, visible);
+            sphere_seconds[BATCHED] += GetCurrentTimeSeconds() - start;
+            mismatches += visible == reference ? 0 : 1;
+            start = GetCurrentTimeSeconds();
+            culler.Cull(sphere_soa, visible, &sphere_cache);
+            sphere_seconds[CACHED] += GetCurrentTimeSeconds() - start;
+            mismatches += visible == reference ? 0 : 1;
+
+            start = GetCurrentTimeSeconds();
+            reference.clear();
+            for(std::size_t i = 0; i < volume_count; ++i) {
+                if(!IsBoxBehindAnyPlane(boxes[i], planes)) {
+                    reference.push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+            box_seconds[SCALAR] += GetCurrentTimeSeconds() - start;
+            box_visible += reference.size();
+            start = GetCurrentTimeSeconds();
+            culler.Cull(box_soa, visible);
+            box_seconds[BATCHED] += GetCurrentTimeSeconds() - start;
+            mismatches += visible == reference ? 0 : 1;
+            start = GetCurrentTimeSeconds();
+            culler.Cull(box_soa, visible, &box_cache);
+            box_seconds[CACHED] += GetCurrentTimeSeconds() - start;
+            mismatches += visible == reference ? 0 : 1;
+        }
+
+        const double ms_per_frame = 1000.0 / frames;
+        g_theFileLogger->LogTagf("test", "  %s order:\n", layout == 0 ? "Random" : "Spatial");
+        g_theFileLogger->LogTagf("test", "    %u spheres, %.0f visible: one at a time %.3f ms, batched %.3f ms, batched with coherency cache %.3f ms\n",
+                                 static_cast<unsigned int>(volume_count), static_cast<double>(sphere_visible) / frames,
+                                 sphere_seconds[SCALAR] * ms_per_frame, sphere_seconds[BATCHED] * ms_per_frame, sphere_seconds[CACHED] * ms_per_frame);
+        g_theFileLogger->LogTagf("test", "    %u boxes, %.0f visible: one at a time %.3f ms, batched %.3f ms, batched with coherency cache %.3f ms\n",
+                                 static_cast<unsigned int>(volume_count), static_cast<double>(box_visible) / frames,
+                                 box_seconds[SCALAR] * ms_per_frame, box_seconds[BATCHED] * ms_per_frame, box_seconds[CACHED] * ms_per_frame);
+        g_theFileLogger->LogTagf("test", "    %s\n", mismatches == 0 ? "Results match." : "RESULTS DIFFER.");
+        GUARANTEE_RECOVERABLE(mismatches == 0, "FrustumCuller results differ from one-at-a-time culling.");
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class AABB3;
+class Plane3;
+class Sphere3;
+class Vector3;
+
+//Bounding spheres as a structure of arrays, so the culler loads one field of a whole batch
+//with a single instruction. Storage is padded to a multiple of eight volumes.
+class BoundingSphereSoA {
+public:
+    void Clear();
+    void Reserve(std::size_t count);
+    //Returns the new sphere's index.
+    std::size_t Add(const Sphere3& sphere);
+    std::size_t Add(const Vector3& center, float radius);
+    void Set(std::size_t index, const Sphere3& sphere);
+    void Set(std::size_t index, const Vector3& center, float radius);
+    std::size_t GetCount() const;
+
+protected:
+private:
+    void Resize(std::size_t count);
+
+    std::vector<float> _center_x{};
+    std::vector<float> _center_y{};
+    std::vector<float> _center_z{};
+    std::vector<float> _radius{};
+    std::size_t _count = 0;
+
+    friend class FrustumCuller;
+};
+
+//Axis-aligned boxes as a structure of arrays of centers and half extents.
+//Storage is padded to a multiple of eight volumes.
+class BoundingBoxSoA {
+public:
+    void Clear();
+    void Reserve(std::size_t count);
+    //Returns the new box's index.
+    std::size_t Add(const AABB3& box);
+    void Set(std::size_t index, const AABB3& box);
+    std::size_t GetCount() const;
+
+protected:
+private:
+    void Resize(std::size_t count);
+
+    std::vector<float> _center_x{};
+    std::vector<float> _center_y{};
+    std::vector<float> _center_z{};
+    std::vector<float> _half_x{};
+    std::vector<float> _half_y{};
+    std::vector<float> _half_z{};
+    std::size_t _count = 0;
+
+    friend class FrustumCuller;
+};
+
+//Tests batches of bounding volumes against a set of planes, four volumes at a time with SSE
+//and eight with AVX. A volume is culled when it is entirely behind one of the planes, i.e. the
+//planes face inward as with IsPointInFrontOfPlane; a Camera3D::CameraFrustum works directly.
+//The test is conservative: a volume near a frustum corner may be kept although it is outside.
+//Large batches are split into JobSystem jobs when it is running.
+class FrustumCuller {
+public:
+    static constexpr std::size_t MAX_PLANES = 8;
+
+    FrustumCuller() = default;
+    explicit FrustumCuller(std::span<const Plane3> planes);
+    ~FrustumCuller() = default;
+
+    void SetPlanes(std::span<const Plane3> planes);
+    std::size_t GetPlaneCount() const;
+
+    //Overwrites visible with the indices of the volumes that survive, in ascending order.
+    //last_rejecting_planes is an optional coherency cache kept by the caller across frames,
+    //one entry per volume: each volume's rejecting plane is tested first next time, and a
+    //batch whose volumes are all still behind their cached planes costs one plane test.
+    //That only pays off when neighbouring volumes are usually rejected together, i.e. when
+    //they are stored in spatial order; for volumes in arbitrary order leave it out.
+    void Cull(const BoundingSphereSoA& spheres, std::vector<std::uint32_t>& visible, std::vector<std::uint8_t>* last_rejecting_planes = nullptr) const;
+    void Cull(const BoundingBoxSoA& boxes, std::vector<std::uint32_t>& visible, std::vector<std::uint8_t>* last_rejecting_planes = nullptr) const;
+
+protected:
+private:
+    template<typename Batch>
+    void CullBatches(const Batch& batch, std::size_t count, std::vector<std::uint32_t>& visible, std::vector<std::uint8_t>* last_rejecting_planes) const;
+
+    //Rows of normal x, y, z and dist, so each lane's cached plane loads as one row.
+    //Unused rows are zero and never reject, so a stale cached plane index is harmless.
+    alignas(16) float _planes[MAX_PLANES][4]{};
+    std::size_t _plane_count = 0;
+};
+
+void FrustumCullingBenchmark(unsigned int frames);
@@ -1,5 +1,6 @@
 #include "Engine/Math/MathUtils.hpp"
 
+#include <atomic>
 #include <cmath>
 #include <limits>
 
@@ -8,6 +9,7 @@
 #include "Engine/Math/LineSegment2.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Plane2.hpp"
+#include "Engine/Math/RandomEngine.hpp"
 
 #include "Engine/Math/Quaternion.hpp"
 
@@ -36,12 +38,40 @@ std::mt19937_64& GetBigCryptoRandomEngine(unsigned long long seed /*= 0*/) {
     return engine;
 }
 
-//NOT THREAD SAFE!
-std::minstd_rand& GetRandomEngine(unsigned long seed /*= 0*/) {
-    static std::minstd_rand engine = std::minstd_rand(!seed ? GetRandomDevice()() : seed);
+namespace {
+
+std::uint64_t GetProcessRandomSeed() {
+    //Function-local statics initialize once even when several threads race to the first call.
+    static const std::uint64_t seed = (std::uint64_t{GetRandomDevice()()} << 32) | GetRandomDevice()();
+    return seed;
+}
+
+std::atomic<std::uint64_t> g_nextRandomStream{0};
+
+//Picks the integer overload for ranges wider than 32 bits. The range and the offset are
+//added in unsigned 64-bit arithmetic, so ranges wider than the type's maximum do not overflow.
+template<typename T>
+T GetRandomIntegerInRange(T minValueInclusive, T maxValueInclusive) {
+    const auto span = static_cast<std::uint64_t>(maxValueInclusive) - static_cast<std::uint64_t>(minValueInclusive);
+    if(span < 0xFFFFFFFFull) {
+        const std::uint64_t offset = GetRandomEngine().NextBelow(static_cast<std::uint32_t>(span + 1));
+        return static_cast<T>(static_cast<std::uint64_t>(minValueInclusive) + offset);
+    }
+    std::uniform_int_distribution<T> dist(minValueInclusive, maxValueInclusive);
+    return dist(GetRandomEngine());
+}
+
+}
+
+RandomEngine& GetRandomEngine() {
+    thread_local RandomEngine engine(GetProcessRandomSeed(), g_nextRandomStream.fetch_add(1, std::memory_order_relaxed));
     return engine;
 }
 
+void SeedRandomEngine(std::uint64_t seed, std::uint64_t stream /*= 0*/) {
+    GetRandomEngine().Seed(seed, stream);
+}
+
 long double ConvertBytesToKiB(const std::size_t& bytes) {
     return bytes * KIB_BYTES_RATIO;
 }
@@ -188,7 +218,7 @@ float ConvertCelciusToFahrenheit(float C) {
 Vector3 GetRandomPointInSphere(const Sphere3& s) {
     float r = s.radius;
     Vector3 p = GetRandomPointInCube(r);
-    while(p.CalcLength() > r) {
+    while(p.CalcLengthSquared() > r * r) {
         p = GetRandomPointInCube(r);
     }
     return p + s.center;
@@ -203,6 +233,27 @@ Vector3 GetRandomPointInCube(float r) {
     float z = GetRandomFloatInRange(-1.0f, 1.0f) * r;
     return Vector3(x, y, z);
 }
+
+void GetRandomFloatsInRange(std::span<float> out, float minimumInclusive, float maximumExclusive) {
+    GetRandomEngine().FillFloats(out, minimumInclusive, maximumExclusive);
+}
+
+void GetRandomUnitVectors(std::span<Vector3> out) {
+    GetRandomEngine().FillUnitVectors(out);
+}
+
+void GetRandomPointsInSphere(std::span<Vector3> out, const Vector3& pos, float r) {
+    GetRandomEngine().FillPointsInSphere(out, pos, r);
+}
+
+void GetRandomPointsInSphere(std::span<Vector3> out, const Sphere3& s) {
+    GetRandomEngine().FillPointsInSphere(out, s.center, s.radius);
+}
+
+void GetRandomPointsInCube(std::span<Vector3> out, float r) {
+    GetRandomEngine().FillPointsInCube(out, r);
+}
+
 float CosDegrees(float degrees) {
 	float radians = ConvertDegreesToRadians(degrees);
 	return std::cosf(radians);
@@ -241,41 +292,35 @@ float CalcShortestAngularDistance(float startDegrees, float endDegrees) {
 }
 
 int GetRandomIntLessThan(int maxValueNotInclusive) {
-    int randomInt = std::rand();
-	return randomInt % maxValueNotInclusive;
+    return static_cast<int>(GetRandomEngine().NextBelow(static_cast<std::uint32_t>(maxValueNotInclusive)));
 }
 
 int GetRandomIntInRange(int minValueInclusive, int maxValueInclusive) {
-    int numPossibilities = (maxValueInclusive - minValueInclusive + 1);
-    return minValueInclusive + GetRandomIntLessThan(numPossibilities);
+    return GetRandomIntegerInRange(minValueInclusive, maxValueInclusive);
 }
 
 long GetRandomLongLessThan(long maxValueNotInclusive) {
-    std::uniform_int_distribution<long> dist(0, maxValueNotInclusive - 1);
-    return dist(GetRandomEngine());
+    return GetRandomIntegerInRange(0L, maxValueNotInclusive - 1);
 }
 
 long GetRandomLongInRange(long minValueInclusive, long maxValueInclusive) {
-    std::uniform_int_distribution<long> dist(minValueInclusive, maxValueInclusive);
-    return dist(GetRandomEngine());
+    return GetRandomIntegerInRange(minValueInclusive, maxValueInclusive);
 }
 
 long long GetRandomLongLongLessThan(long long maxValueNotInclusive) {
-    std::uniform_int_distribution<long long> dist(0, maxValueNotInclusive - 1);
-    return dist(GetRandomEngine());
+    return GetRandomIntegerInRange(0LL, maxValueNotInclusive - 1);
 }
 
 long long GetRandomLongLongInRange(long long minValueInclusive, long long maxValueInclusive) {
-    std::uniform_int_distribution<long long> dist(minValueInclusive, maxValueInclusive);
-    return dist(GetRandomEngine());
+    return GetRandomIntegerInRange(minValueInclusive, maxValueInclusive);
 }
 
 float GetRandomFloatZeroToOne() {
-	return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    return GetRandomEngine().NextFloat();
 }
 
-float GetRandomFloatInRange(float minimumInclusive, float maximumInclusive) {
-    return minimumInclusive + (GetRandomFloatZeroToOne() * (maximumInclusive - minimumInclusive));
+float GetRandomFloatInRange(float minimumInclusive, float maximumExclusive) {
+    return minimumInclusive + (GetRandomFloatZeroToOne() * (maximumExclusive - minimumInclusive));
 }
 
 bool IsPercentChance(float probability) {
@@ -284,12 +329,11 @@ bool IsPercentChance(float probability) {
 }
 
 double GetRandomDoubleZeroToOne() {
-    std::uniform_real_distribution<double> dist; //defaults to [0.0,1.0)
-    return dist(GetRandomEngine());
+    return GetRandomEngine().NextDouble();
 }
 
-double GetRandomDoubleInRange(double minimumInclusive, double maximumInclusive) {
-    return minimumInclusive + (GetRandomDoubleZeroToOne() * (maximumInclusive - minimumInclusive));
+double GetRandomDoubleInRange(double minimumInclusive, double maximumExclusive) {
+    return minimumInclusive + (GetRandomDoubleZeroToOne() * (maximumExclusive - minimumInclusive));
 }
 
 bool IsPercentChance(double probability) {
@@ -437,7 +481,7 @@ bool DoAABB3sOverlap(const AABB3& a, const AABB3& b) {
     if(a.maxs.z < b.mins.z) {
         return false;
     }
-    if(b.maxs.z < a.maxs.z) {
+    if(b.maxs.z < a.mins.z) {
         return false;
     }
     return true;
@@ -471,7 +515,7 @@ Vector2 Rotate(const Vector2& v, const Quaternion& q) {
 }
 
 Vector3 Rotate(const Vector3& v, const Quaternion& q) {
-    return (q * v * q.CalcInverse()).axis;
+    return q.Rotate(v);
 }
 
 unsigned int CalculateManhattanDistance(const IntVector2& start, const IntVector2& end) {
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <random>
+#include <span>
 #include <utility>
 
 #include "Engine/Math/IntVector2.hpp"
@@ -13,6 +15,8 @@
 #include "Engine/Math/Vector4.hpp"
 #include "Engine/Math/Quaternion.hpp"
 
+class RandomEngine;
+
 class AABB2;
 class Disc2;
 class LineSegment2;
@@ -53,8 +57,12 @@ std::random_device& GetRandomDevice();
 std::mt19937& GetCryptoRandomEngine(unsigned long seed = 0);
 //NOT THREAD SAFE!
 std::mt19937_64& GetBigCryptoRandomEngine(unsigned long long seed = 0);
-//NOT THREAD SAFE!
-std::minstd_rand& GetRandomEngine(unsigned long seed = 0);
+//The calling thread's engine. Unless seeded, each thread starts on its own stream of a seed
+//drawn once per process.
+RandomEngine& GetRandomEngine();
+//Reseeds the calling thread's engine, e.g. for deterministic replay. Give each job worker
+//the same seed and its own stream.
+void SeedRandomEngine(std::uint64_t seed, std::uint64_t stream = 0);
 
 long double ConvertBytesToMiB(const std::size_t& bytes);
 long double ConvertBytesToKiB(const std::size_t& bytes);
@@ -104,6 +112,13 @@ Vector3 GetRandomPointInSphere(const Sphere3& s);
 
 Vector3 GetRandomPointInCube(float r);
 
+//Batch versions of the above, from the calling thread's engine with a SIMD path.
+void GetRandomFloatsInRange(std::span<float> out, float minimumInclusive, float maximumExclusive);
+void GetRandomUnitVectors(std::span<Vector3> out);
+void GetRandomPointsInSphere(std::span<Vector3> out, const Vector3& pos, float r);
+void GetRandomPointsInSphere(std::span<Vector3> out, const Sphere3& s);
+void GetRandomPointsInCube(std::span<Vector3> out, float r);
+
 float CosDegrees(float degrees);
 float SinDegrees(float degrees);
 float Atan2Degrees(float y, float x);
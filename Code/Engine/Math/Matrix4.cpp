@@ -1,14 +1,503 @@
 #include "Engine/Math/Matrix4.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
 #include <sstream>
+#include <vector>
+
+#include "Engine/EngineConfig.hpp"
 
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
 
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Simd.hpp"
 
 #include "Engine/Renderer/Camera3D.hpp"
 #include "Engine/Renderer/TextureBase.hpp"
 
+namespace {
+
+//[00 01 02 03] [0   1  2  3]
+//[10 11 12 13] [4   5  6  7]
+//[20 21 22 23] [8   9 10 11]
+//[30 31 32 33] [12 13 14 15]
+//
+//Kernels work on row-major float[16]. The scalar ones back ENGINE_NO_SIMD and batch tails. The
+//SIMD multiply, transform and transpose add in the same order and give bit-identical results.
+
+void ScalarMultiply(const float* a, const float* b, float* out) {
+    for(int r = 0; r < 4; ++r) {
+        const float* row = a + 4 * r;
+        for(int c = 0; c < 4; ++c) {
+            out[4 * r + c] = row[0] * b[c] + row[1] * b[4 + c] + row[2] * b[8 + c] + row[3] * b[12 + c];
+        }
+    }
+}
+
+void ScalarTransform(const float* m, float x, float y, float z, float w, float* out) {
+    for(int r = 0; r < 4; ++r) {
+        const float* row = m + 4 * r;
+        out[r] = row[0] * x + row[1] * y + row[2] * z + row[3] * w;
+    }
+}
+
+void ScalarTranspose(const float* m, float* out) {
+    for(int r = 0; r < 4; ++r) {
+        for(int c = 0; c < 4; ++c) {
+            out[4 * c + r] = m[4 * r + c];
+        }
+    }
+}
+
+//Minors, Cofactors, Adjugates method.
+//See http://www.mathsisfun.com/algebra/matrix-inverse-minors-cofactors-adjugate.html
+void ScalarInverse(const float* m, float* out) {
+    using MathUtils::CalculateMatrix3Determinant;
+    const float m00 = CalculateMatrix3Determinant(m[5], m[6], m[7], m[9], m[10], m[11], m[13], m[14], m[15]);
+    const float m01 = CalculateMatrix3Determinant(m[4], m[6], m[7], m[8], m[10], m[11], m[12], m[14], m[15]);
+    const float m02 = CalculateMatrix3Determinant(m[4], m[5], m[7], m[8], m[9], m[11], m[12], m[13], m[15]);
+    const float m03 = CalculateMatrix3Determinant(m[4], m[5], m[6], m[8], m[9], m[10], m[12], m[13], m[14]);
+
+    const float m10 = CalculateMatrix3Determinant(m[1], m[2], m[3], m[9], m[10], m[11], m[13], m[14], m[15]);
+    const float m11 = CalculateMatrix3Determinant(m[0], m[2], m[3], m[8], m[10], m[11], m[12], m[14], m[15]);
+    const float m12 = CalculateMatrix3Determinant(m[0], m[1], m[3], m[8], m[9], m[11], m[12], m[13], m[15]);
+    const float m13 = CalculateMatrix3Determinant(m[0], m[1], m[2], m[8], m[9], m[10], m[12], m[13], m[14]);
+
+    const float m20 = CalculateMatrix3Determinant(m[1], m[2], m[3], m[5], m[6], m[7], m[13], m[14], m[15]);
+    const float m21 = CalculateMatrix3Determinant(m[0], m[2], m[3], m[4], m[6], m[7], m[12], m[14], m[15]);
+    const float m22 = CalculateMatrix3Determinant(m[0], m[1], m[3], m[4], m[5], m[7], m[12], m[13], m[15]);
+    const float m23 = CalculateMatrix3Determinant(m[0], m[1], m[2], m[4], m[5], m[6], m[12], m[13], m[14]);
+
+    const float m30 = CalculateMatrix3Determinant(m[1], m[2], m[3], m[5], m[6], m[7], m[9], m[10], m[11]);
+    const float m31 = CalculateMatrix3Determinant(m[0], m[2], m[3], m[4], m[6], m[7], m[8], m[10], m[11]);
+    const float m32 = CalculateMatrix3Determinant(m[0], m[1], m[3], m[4], m[5], m[7], m[8], m[9], m[11]);
+    const float m33 = CalculateMatrix3Determinant(m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10]);
+
+    const float det = (m[0] * m00) - (m[1] * m01) + (m[2] * m02) - (m[3] * m03);
+    const float inv_det = 1.0f / det;
+
+    //Adjugate is the transposed cofactor matrix.
+    const float adjugate[16] = {  m00, -m10,  m20, -m30,
+                                 -m01,  m11, -m21,  m31,
+                                  m02, -m12,  m22, -m32,
+                                 -m03,  m13, -m23,  m33 };
+    for(int i = 0; i < 16; ++i) {
+        out[i] = inv_det * adjugate[i];
+    }
+}
+
+//Inverts the upper 3x3 through cross products of its rows and moves the translation
+//back through it. Only valid when the bottom row is (0, 0, 0, 1).
+void ScalarAffineInverse(const float* m, float* out) {
+    const float r0[3] = { m[0], m[1], m[2] };
+    const float r1[3] = { m[4], m[5], m[6] };
+    const float r2[3] = { m[8], m[9], m[10] };
+    auto cross = [](const float* a, const float* b, float* result) {
+        result[0] = a[1] * b[2] - a[2] * b[1];
+        result[1] = a[2] * b[0] - a[0] * b[2];
+        result[2] = a[0] * b[1] - a[1] * b[0];
+    };
+    //Columns of the inverse, before dividing by the determinant.
+    float c0[3];
+    float c1[3];
+    float c2[3];
+    cross(r1, r2, c0);
+    cross(r2, r0, c1);
+    cross(r0, r1, c2);
+    const float inv_det = 1.0f / (r0[0] * c0[0] + r0[1] * c0[1] + r0[2] * c0[2]);
+    for(int i = 0; i < 3; ++i) {
+        out[4 * i + 0] = c0[i] * inv_det;
+        out[4 * i + 1] = c1[i] * inv_det;
+        out[4 * i + 2] = c2[i] * inv_det;
+    }
+    for(int i = 0; i < 3; ++i) {
+        out[4 * i + 3] = -(out[4 * i + 0] * m[3] + out[4 * i + 1] * m[7] + out[4 * i + 2] * m[11]);
+    }
+    out[12] = 0.0f;
+    out[13] = 0.0f;
+    out[14] = 0.0f;
+    out[15] = 1.0f;
+}
+
+#if defined(ENGINE_SIMD_SSE)
+
+//Matrix4 storage is not over-aligned, so every load and store is unaligned. On aligned data
+//these cost the same as the aligned forms.
+
+inline __m128 Splat(__m128 v, int lane) {
+    switch(lane) {
+    case 0: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+    case 1: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+    case 2: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+    default: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+}
+
+//Each output row is a weighted sum of b's rows, accumulated in the scalar order.
+void SimdMultiply(const float* a, const float* b, float* out) {
+#if defined(ENGINE_SIMD_AVX)
+    const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 0));
+    const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+    const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+    const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+    //Two rows per pass, one in each 128-bit lane.
+    for(int r = 0; r < 4; r += 2) {
+        const __m256 rows = _mm256_loadu_ps(a + 4 * r);
+        __m256 result = _mm256_mul_ps(_mm256_permute_ps(rows, 0x00), b0);
+        result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_permute_ps(rows, 0x55), b1));
+        result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_permute_ps(rows, 0xAA), b2));
+        result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_permute_ps(rows, 0xFF), b3));
+        _mm256_storeu_ps(out + 4 * r, result);
+    }
+#else
+    const __m128 b0 = _mm_loadu_ps(b + 0);
+    const __m128 b1 = _mm_loadu_ps(b + 4);
+    const __m128 b2 = _mm_loadu_ps(b + 8);
+    const __m128 b3 = _mm_loadu_ps(b + 12);
+    for(int r = 0; r < 4; ++r) {
+        const __m128 row = _mm_loadu_ps(a + 4 * r);
+        __m128 result = _mm_mul_ps(Splat(row, 0), b0);
+        result = _mm_add_ps(result, _mm_mul_ps(Splat(row, 1), b1));
+        result = _mm_add_ps(result, _mm_mul_ps(Splat(row, 2), b2));
+        result = _mm_add_ps(result, _mm_mul_ps(Splat(row, 3), b3));
+        _mm_storeu_ps(out + 4 * r, result);
+    }
+#endif
+}
+
+//Weighted sum of m's columns, accumulated in the scalar order.
+void SimdTransform(const float* m, float x, float y, float z, float w, float* out) {
+    __m128 c0 = _mm_loadu_ps(m + 0);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    __m128 result = _mm_mul_ps(c0, _mm_set1_ps(x));
+    result = _mm_add_ps(result, _mm_mul_ps(c1, _mm_set1_ps(y)));
+    result = _mm_add_ps(result, _mm_mul_ps(c2, _mm_set1_ps(z)));
+    result = _mm_add_ps(result, _mm_mul_ps(c3, _mm_set1_ps(w)));
+    _mm_storeu_ps(out, result);
+}
+
+void SimdTranspose(const float* m, float* out) {
+    __m128 r0 = _mm_loadu_ps(m + 0);
+    __m128 r1 = _mm_loadu_ps(m + 4);
+    __m128 r2 = _mm_loadu_ps(m + 8);
+    __m128 r3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(out + 0, r0);
+    _mm_storeu_ps(out + 4, r1);
+    _mm_storeu_ps(out + 8, r2);
+    _mm_storeu_ps(out + 12, r3);
+}
+
+//2x2 blocks are held in one register as (m00, m01, m10, m11).
+#define ENGINE_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps((a), (b), _MM_SHUFFLE((w), (z), (y), (x)))
+#define ENGINE_SWIZZLE(v, x, y, z, w) ENGINE_SHUFFLE((v), (v), (x), (y), (z), (w))
+
+//A * B
+inline __m128 Mat2Mul(__m128 a, __m128 b) {
+    return _mm_add_ps(_mm_mul_ps(a, ENGINE_SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(ENGINE_SWIZZLE(a, 1, 0, 3, 2), ENGINE_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+//adj(A) * B
+inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(ENGINE_SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(ENGINE_SWIZZLE(a, 1, 1, 2, 2), ENGINE_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+//A * adj(B)
+inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(a, ENGINE_SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(ENGINE_SWIZZLE(a, 1, 0, 3, 2), ENGINE_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+//Block-wise inverse: with M = [A B; C D] in 2x2 blocks, each block of the inverse is built
+//from 2x2 adjugates and determinants, so no 3x3 minors are needed.
+void SimdInverse(const float* m, float* out) {
+    const __m128 r0 = _mm_loadu_ps(m + 0);
+    const __m128 r1 = _mm_loadu_ps(m + 4);
+    const __m128 r2 = _mm_loadu_ps(m + 8);
+    const __m128 r3 = _mm_loadu_ps(m + 12);
+
+    const __m128 A = _mm_movelh_ps(r0, r1);
+    const __m128 B = _mm_movehl_ps(r1, r0);
+    const __m128 C = _mm_movelh_ps(r2, r3);
+    const __m128 D = _mm_movehl_ps(r3, r2);
+
+    //(|A|, |B|, |C|, |D|)
+    const __m128 det_sub = _mm_sub_ps(_mm_mul_ps(ENGINE_SHUFFLE(r0, r2, 0, 2, 0, 2), ENGINE_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+                                      _mm_mul_ps(ENGINE_SHUFFLE(r0, r2, 1, 3, 1, 3), ENGINE_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+    const __m128 det_A = ENGINE_SWIZZLE(det_sub, 0, 0, 0, 0);
+    const __m128 det_B = ENGINE_SWIZZLE(det_sub, 1, 1, 1, 1);
+    const __m128 det_C = ENGINE_SWIZZLE(det_sub, 2, 2, 2, 2);
+    const __m128 det_D = ENGINE_SWIZZLE(det_sub, 3, 3, 3, 3);
+
+    const __m128 D_C = Mat2AdjMul(D, C);
+    const __m128 A_B = Mat2AdjMul(A, B);
+    //Adjugates of the inverse's blocks, X Y on top and Z W below.
+    __m128 X = _mm_sub_ps(_mm_mul_ps(det_D, A), Mat2Mul(B, D_C));
+    __m128 W = _mm_sub_ps(_mm_mul_ps(det_A, D), Mat2Mul(C, A_B));
+    __m128 Y = _mm_sub_ps(_mm_mul_ps(det_B, C), Mat2MulAdj(D, A_B));
+    __m128 Z = _mm_sub_ps(_mm_mul_ps(det_C, B), Mat2MulAdj(A, D_C));
+
+    //|M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    __m128 trace = _mm_mul_ps(A_B, ENGINE_SWIZZLE(D_C, 0, 2, 1, 3));
+    trace = _mm_add_ps(trace, ENGINE_SWIZZLE(trace, 2, 3, 0, 1));
+    trace = _mm_add_ps(trace, ENGINE_SWIZZLE(trace, 1, 0, 3, 2));
+    const __m128 det_M = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_A, det_D), _mm_mul_ps(det_B, det_C)), trace);
+
+    const __m128 inv_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det_M);
+    X = _mm_mul_ps(X, inv_det);
+    Y = _mm_mul_ps(Y, inv_det);
+    Z = _mm_mul_ps(Z, inv_det);
+    W = _mm_mul_ps(W, inv_det);
+
+    //Undo the adjugates while interleaving the blocks back into rows.
+    _mm_storeu_ps(out + 0, ENGINE_SHUFFLE(X, Y, 3, 1, 3, 1));
+    _mm_storeu_ps(out + 4, ENGINE_SHUFFLE(X, Y, 2, 0, 2, 0));
+    _mm_storeu_ps(out + 8, ENGINE_SHUFFLE(Z, W, 3, 1, 3, 1));
+    _mm_storeu_ps(out + 12, ENGINE_SHUFFLE(Z, W, 2, 0, 2, 0));
+}
+
+//a.yzx * b.zxy - a.zxy * b.yzx. Lane 3 comes out zero.
+inline __m128 Cross3(__m128 a, __m128 b) {
+    const __m128 a_yzx = ENGINE_SWIZZLE(a, 1, 2, 0, 3);
+    const __m128 b_yzx = ENGINE_SWIZZLE(b, 1, 2, 0, 3);
+    const __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+    return ENGINE_SWIZZLE(c, 1, 2, 0, 3);
+}
+
+void SimdAffineInverse(const float* m, float* out) {
+    //Lane 3 of each row holds the translation, which the cross products cancel.
+    const __m128 r0 = _mm_loadu_ps(m + 0);
+    const __m128 r1 = _mm_loadu_ps(m + 4);
+    const __m128 r2 = _mm_loadu_ps(m + 8);
+    __m128 c0 = Cross3(r1, r2);
+    __m128 c1 = Cross3(r2, r0);
+    __m128 c2 = Cross3(r0, r1);
+
+    __m128 det = _mm_mul_ps(r0, c0);
+    det = _mm_add_ps(ENGINE_SWIZZLE(det, 0, 0, 0, 0), _mm_add_ps(ENGINE_SWIZZLE(det, 1, 1, 1, 1), ENGINE_SWIZZLE(det, 2, 2, 2, 2)));
+    const __m128 inv_det = _mm_div_ps(_mm_set1_ps(1.0f), det);
+    c0 = _mm_mul_ps(c0, inv_det);
+    c1 = _mm_mul_ps(c1, inv_det);
+    c2 = _mm_mul_ps(c2, inv_det);
+
+    __m128 t = _mm_mul_ps(c0, _mm_set1_ps(m[3]));
+    t = _mm_add_ps(t, _mm_mul_ps(c1, _mm_set1_ps(m[7])));
+    t = _mm_add_ps(t, _mm_mul_ps(c2, _mm_set1_ps(m[11])));
+    t = _mm_sub_ps(_mm_setzero_ps(), t);
+
+    _MM_TRANSPOSE4_PS(c0, c1, c2, t);
+    _mm_storeu_ps(out + 0, c0);
+    _mm_storeu_ps(out + 4, c1);
+    _mm_storeu_ps(out + 8, c2);
+    _mm_storeu_ps(out + 12, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+#undef ENGINE_SWIZZLE
+#undef ENGINE_SHUFFLE
+
+void MatrixMultiply(const float* a, const float* b, float* out) { SimdMultiply(a, b, out); }
+void MatrixTransform(const float* m, float x, float y, float z, float w, float* out) { SimdTransform(m, x, y, z, w, out); }
+void MatrixTranspose(const float* m, float* out) { SimdTranspose(m, out); }
+void MatrixInverse(const float* m, float* out) { SimdInverse(m, out); }
+void MatrixAffineInverse(const float* m, float* out) { SimdAffineInverse(m, out); }
+
+#else
+
+void MatrixMultiply(const float* a, const float* b, float* out) { ScalarMultiply(a, b, out); }
+void MatrixTransform(const float* m, float x, float y, float z, float w, float* out) { ScalarTransform(m, x, y, z, w, out); }
+void MatrixTranspose(const float* m, float* out) { ScalarTranspose(m, out); }
+void MatrixInverse(const float* m, float* out) { ScalarInverse(m, out); }
+void MatrixAffineInverse(const float* m, float* out) { ScalarAffineInverse(m, out); }
+
+#endif
+
+//Batch kernels. w is 1 for positions and 0 for directions. Each element is read before it is
+//written, so input and output may alias. Results match the single-element calls bit for bit.
+
+const Vector3& StridedAt(const void* first, std::size_t index, std::size_t stride) {
+    return *reinterpret_cast<const Vector3*>(static_cast<const unsigned char*>(first) + index * stride);
+}
+
+Vector3& StridedAt(void* first, std::size_t index, std::size_t stride) {
+    return *reinterpret_cast<Vector3*>(static_cast<unsigned char*>(first) + index * stride);
+}
+
+void BatchTransform3(const float* m, const void* in, void* out, std::size_t count, std::size_t in_stride, std::size_t out_stride, float w) {
+#if defined(ENGINE_SIMD_SSE)
+    //Columns stay in registers for the whole batch; the single-element call reloads them.
+    __m128 c0 = _mm_loadu_ps(m + 0);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    const __m128 t = _mm_mul_ps(c3, _mm_set1_ps(w));
+    for(std::size_t i = 0; i < count; ++i) {
+        const Vector3& p = StridedAt(in, i, in_stride);
+        __m128 result = _mm_mul_ps(c0, _mm_set1_ps(p.x));
+        result = _mm_add_ps(result, _mm_mul_ps(c1, _mm_set1_ps(p.y)));
+        result = _mm_add_ps(result, _mm_mul_ps(c2, _mm_set1_ps(p.z)));
+        result = _mm_add_ps(result, t);
+        //Three floats only: a full store would run into the next element.
+        Vector3& q = StridedAt(out, i, out_stride);
+        _mm_storel_pi(reinterpret_cast<__m64*>(&q.x), result);
+        _mm_store_ss(&q.z, _mm_movehl_ps(result, result));
+    }
+#else
+    for(std::size_t i = 0; i < count; ++i) {
+        const Vector3& p = StridedAt(in, i, in_stride);
+        float result[4];
+        ScalarTransform(m, p.x, p.y, p.z, w, result);
+        StridedAt(out, i, out_stride) = Vector3(result[0], result[1], result[2]);
+    }
+#endif
+}
+
+void BatchTransform4(const float* m, const Vector4* in, Vector4* out, std::size_t count) {
+#if defined(ENGINE_SIMD_SSE)
+    __m128 c0 = _mm_loadu_ps(m + 0);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    for(std::size_t i = 0; i < count; ++i) {
+        const Vector4 v = in[i];
+        __m128 result = _mm_mul_ps(c0, _mm_set1_ps(v.x));
+        result = _mm_add_ps(result, _mm_mul_ps(c1, _mm_set1_ps(v.y)));
+        result = _mm_add_ps(result, _mm_mul_ps(c2, _mm_set1_ps(v.z)));
+        result = _mm_add_ps(result, _mm_mul_ps(c3, _mm_set1_ps(v.w)));
+        _mm_storeu_ps(&out[i].x, result);
+    }
+#else
+    for(std::size_t i = 0; i < count; ++i) {
+        const Vector4 v = in[i];
+        float result[4];
+        ScalarTransform(m, v.x, v.y, v.z, v.w, result);
+        out[i] = Vector4(result[0], result[1], result[2], result[3]);
+    }
+#endif
+}
+
+//Structure-of-arrays streams, transformed in place a register's width of elements at a time.
+void BatchTransformSoA(const float* m, float* xs, float* ys, float* zs, std::size_t count, float w) {
+    std::size_t i = 0;
+#if defined(ENGINE_SIMD_AVX)
+    {
+        const __m256 tx = _mm256_set1_ps(m[3] * w);
+        const __m256 ty = _mm256_set1_ps(m[7] * w);
+        const __m256 tz = _mm256_set1_ps(m[11] * w);
+        for(; i + 8 <= count; i += 8) {
+            const __m256 x = _mm256_loadu_ps(xs + i);
+            const __m256 y = _mm256_loadu_ps(ys + i);
+            const __m256 z = _mm256_loadu_ps(zs + i);
+            __m256 rx = _mm256_mul_ps(_mm256_set1_ps(m[0]), x);
+            rx = _mm256_add_ps(rx, _mm256_mul_ps(_mm256_set1_ps(m[1]), y));
+            rx = _mm256_add_ps(rx, _mm256_mul_ps(_mm256_set1_ps(m[2]), z));
+            __m256 ry = _mm256_mul_ps(_mm256_set1_ps(m[4]), x);
+            ry = _mm256_add_ps(ry, _mm256_mul_ps(_mm256_set1_ps(m[5]), y));
+            ry = _mm256_add_ps(ry, _mm256_mul_ps(_mm256_set1_ps(m[6]), z));
+            __m256 rz = _mm256_mul_ps(_mm256_set1_ps(m[8]), x);
+            rz = _mm256_add_ps(rz, _mm256_mul_ps(_mm256_set1_ps(m[9]), y));
+            rz = _mm256_add_ps(rz, _mm256_mul_ps(_mm256_set1_ps(m[10]), z));
+            _mm256_storeu_ps(xs + i, _mm256_add_ps(rx, tx));
+            _mm256_storeu_ps(ys + i, _mm256_add_ps(ry, ty));
+            _mm256_storeu_ps(zs + i, _mm256_add_ps(rz, tz));
+        }
+    }
+#endif
+#if defined(ENGINE_SIMD_SSE)
+    {
+        const __m128 tx = _mm_set1_ps(m[3] * w);
+        const __m128 ty = _mm_set1_ps(m[7] * w);
+        const __m128 tz = _mm_set1_ps(m[11] * w);
+        for(; i + 4 <= count; i += 4) {
+            const __m128 x = _mm_loadu_ps(xs + i);
+            const __m128 y = _mm_loadu_ps(ys + i);
+            const __m128 z = _mm_loadu_ps(zs + i);
+            __m128 rx = _mm_mul_ps(_mm_set1_ps(m[0]), x);
+            rx = _mm_add_ps(rx, _mm_mul_ps(_mm_set1_ps(m[1]), y));
+            rx = _mm_add_ps(rx, _mm_mul_ps(_mm_set1_ps(m[2]), z));
+            __m128 ry = _mm_mul_ps(_mm_set1_ps(m[4]), x);
+            ry = _mm_add_ps(ry, _mm_mul_ps(_mm_set1_ps(m[5]), y));
+            ry = _mm_add_ps(ry, _mm_mul_ps(_mm_set1_ps(m[6]), z));
+            __m128 rz = _mm_mul_ps(_mm_set1_ps(m[8]), x);
+            rz = _mm_add_ps(rz, _mm_mul_ps(_mm_set1_ps(m[9]), y));
+            rz = _mm_add_ps(rz, _mm_mul_ps(_mm_set1_ps(m[10]), z));
+            _mm_storeu_ps(xs + i, _mm_add_ps(rx, tx));
+            _mm_storeu_ps(ys + i, _mm_add_ps(ry, ty));
+            _mm_storeu_ps(zs + i, _mm_add_ps(rz, tz));
+        }
+    }
+#endif
+    for(; i < count; ++i) {
+        float result[4];
+        ScalarTransform(m, xs[i], ys[i], zs[i], w, result);
+        xs[i] = result[0];
+        ys[i] = result[1];
+        zs[i] = result[2];
+    }
+}
+
+//World bounds of a transformed box without visiting its corners: the center moves as a
+//position and each extent is the box's extents dotted with the absolute row.
+void BatchTransformBounds(const float* m, const AABB3* in, AABB3* out, std::size_t count) {
+#if defined(ENGINE_SIMD_SSE)
+    __m128 c0 = _mm_loadu_ps(m + 0);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    const __m128 a0 = _mm_andnot_ps(sign_mask, c0);
+    const __m128 a1 = _mm_andnot_ps(sign_mask, c1);
+    const __m128 a2 = _mm_andnot_ps(sign_mask, c2);
+    const __m128 half = _mm_set1_ps(0.5f);
+    for(std::size_t i = 0; i < count; ++i) {
+        const AABB3& box = in[i];
+        const __m128 mins = _mm_setr_ps(box.mins.x, box.mins.y, box.mins.z, 0.0f);
+        const __m128 maxs = _mm_setr_ps(box.maxs.x, box.maxs.y, box.maxs.z, 0.0f);
+        const __m128 center = _mm_mul_ps(_mm_add_ps(mins, maxs), half);
+        const __m128 extents = _mm_mul_ps(_mm_sub_ps(maxs, mins), half);
+        __m128 new_center = _mm_mul_ps(c0, _mm_shuffle_ps(center, center, _MM_SHUFFLE(0, 0, 0, 0)));
+        new_center = _mm_add_ps(new_center, _mm_mul_ps(c1, _mm_shuffle_ps(center, center, _MM_SHUFFLE(1, 1, 1, 1))));
+        new_center = _mm_add_ps(new_center, _mm_mul_ps(c2, _mm_shuffle_ps(center, center, _MM_SHUFFLE(2, 2, 2, 2))));
+        new_center = _mm_add_ps(new_center, c3);
+        __m128 new_extents = _mm_mul_ps(a0, _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(0, 0, 0, 0)));
+        new_extents = _mm_add_ps(new_extents, _mm_mul_ps(a1, _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(1, 1, 1, 1))));
+        new_extents = _mm_add_ps(new_extents, _mm_mul_ps(a2, _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(2, 2, 2, 2))));
+        float new_mins[4];
+        float new_maxs[4];
+        _mm_storeu_ps(new_mins, _mm_sub_ps(new_center, new_extents));
+        _mm_storeu_ps(new_maxs, _mm_add_ps(new_center, new_extents));
+        out[i] = AABB3(new_mins[0], new_mins[1], new_mins[2], new_maxs[0], new_maxs[1], new_maxs[2]);
+    }
+#else
+    for(std::size_t i = 0; i < count; ++i) {
+        const AABB3& box = in[i];
+        const float center[3] = {(box.mins.x + box.maxs.x) * 0.5f, (box.mins.y + box.maxs.y) * 0.5f, (box.mins.z + box.maxs.z) * 0.5f};
+        const float extents[3] = {(box.maxs.x - box.mins.x) * 0.5f, (box.maxs.y - box.mins.y) * 0.5f, (box.maxs.z - box.mins.z) * 0.5f};
+        float new_mins[3];
+        float new_maxs[3];
+        for(int r = 0; r < 3; ++r) {
+            const float* row = m + 4 * r;
+            const float new_center = row[0] * center[0] + row[1] * center[1] + row[2] * center[2] + row[3];
+            const float new_extent = std::fabs(row[0]) * extents[0] + std::fabs(row[1]) * extents[1] + std::fabs(row[2]) * extents[2];
+            new_mins[r] = new_center - new_extent;
+            new_maxs[r] = new_center + new_extent;
+        }
+        out[i] = AABB3(new_mins[0], new_mins[1], new_mins[2], new_maxs[0], new_maxs[1], new_maxs[2]);
+    }
+#endif
+}
+
+}
+
 Matrix4::Matrix4()
 : m_indicies{1.0f, 0.0f, 0.0f, 0.0f,
             0.0f, 1.0f, 0.0f, 0.0f,
@@ -67,28 +556,30 @@ Matrix4::Matrix4(const float* arrayOfFloats)
 }
 
 Matrix4::Matrix4(const Quaternion& q) {
-
-    auto q_norm = q.GetNormalize();
-
-    float x = q.axis.x;
-    float y = q.axis.y;
-    float z = q.axis.z;
-    float w = q.w;
-
-    Matrix4 left;
-    left.m_indicies[0]  = w; left.m_indicies[1]   = -z; left.m_indicies[2]  = y; left.m_indicies[3]  = -x;
-    left.m_indicies[4]  = z; left.m_indicies[5]   = w; left.m_indicies[6]   = -x; left.m_indicies[7] = -y;
-    left.m_indicies[8]  = -y; left.m_indicies[9]  = x; left.m_indicies[10]  = w; left.m_indicies[11] = -z;
-    left.m_indicies[12] = x; left.m_indicies[13]  = y; left.m_indicies[14]  = z; left.m_indicies[15] = w;
-
-    Matrix4 right;
-    right.m_indicies[0] = w; right.m_indicies[1] = -z; right.m_indicies[2] = y; right.m_indicies[3] = x;
-    right.m_indicies[4] = z; right.m_indicies[5] = w; right.m_indicies[6] = -x; right.m_indicies[7] = y;
-    right.m_indicies[8] = -y; right.m_indicies[9] = x; right.m_indicies[10] = w; right.m_indicies[11] = z;
-    right.m_indicies[12] = -x; right.m_indicies[13] = -y; right.m_indicies[14] = -z; right.m_indicies[15] = w;
-
-    m_indicies = (left * right).m_indicies;
-
+    //Rotation matrix written out directly. Scaling by 2 / |q|^2 instead of 2 keeps the result
+    //a pure rotation for quaternions that have drifted from unit length.
+    const float x = q.axis.x;
+    const float y = q.axis.y;
+    const float z = q.axis.z;
+    const float w = q.w;
+    const float length_sq = q.CalcLengthSquared();
+    const float s = length_sq > 0.0f ? 2.0f / length_sq : 0.0f;
+    const float xs = x * s;
+    const float ys = y * s;
+    const float zs = z * s;
+    const float wx = w * xs;
+    const float wy = w * ys;
+    const float wz = w * zs;
+    const float xx = x * xs;
+    const float xy = x * ys;
+    const float xz = x * zs;
+    const float yy = y * ys;
+    const float yz = y * zs;
+    const float zz = z * zs;
+    m_indicies = {1.0f - (yy + zz), xy - wz, xz + wy, 0.0f,
+                  xy + wz, 1.0f - (xx + zz), yz - wx, 0.0f,
+                  xz - wy, yz + wx, 1.0f - (xx + yy), 0.0f,
+                  0.0f, 0.0f, 0.0f, 1.0f};
 }
 Matrix4::Matrix4(const Vector2& iBasis, const Vector2& jBasis, const Vector2& translation /*= Vector2::ZERO*/)
 : m_indicies{iBasis.x, jBasis.x, 0.0f, translation.x,
@@ -340,32 +831,15 @@ void Matrix4::Identity() {
 
 }
 void Matrix4::Transpose() {
-
-    //[00 01 02 03] [0   1  2  3]
-    //[10 11 12 13] [4   5  6  7]
-    //[20 21 22 23] [8   9 10 11]
-    //[30 31 32 33] [12 13 14 15]
-    //
-    //[00 10 20 30] [0 4 8  12]
-    //[01 11 21 31] [1 5 9  13]
-    //[02 12 22 32] [2 6 10 14]
-    //[03 13 23 33] [3 7 11 15]
-
-    std::swap(m_indicies[1], m_indicies[4]);
-    std::swap(m_indicies[2], m_indicies[8]);
-    std::swap(m_indicies[3], m_indicies[12]);
-
-    std::swap(m_indicies[6] ,m_indicies[9]);
-    std::swap(m_indicies[7] ,m_indicies[13]);
-    std::swap(m_indicies[11],m_indicies[14]);
-
+    Matrix4 result;
+    MatrixTranspose(m_indicies.data(), result.m_indicies.data());
+    m_indicies = result.m_indicies;
 }
 
 Matrix4 Matrix4::CreateTransposeMatrix(const Matrix4& mat) {
-    return Matrix4(mat.m_indicies[0], mat.m_indicies[4], mat.m_indicies[8], mat.m_indicies[12],
-                   mat.m_indicies[1], mat.m_indicies[5], mat.m_indicies[9], mat.m_indicies[13],
-                   mat.m_indicies[2], mat.m_indicies[6], mat.m_indicies[10], mat.m_indicies[14],
-                   mat.m_indicies[3], mat.m_indicies[7], mat.m_indicies[11], mat.m_indicies[15]);
+    Matrix4 result;
+    MatrixTranspose(mat.m_indicies.data(), result.m_indicies.data());
+    return result;
 }
 
 Matrix4 Matrix4::CreatePerspectiveProjectionMatrix(float top, float bottom, float right, float left, float nearZ, float farZ) {
@@ -455,47 +929,19 @@ void Matrix4::CalculateInverse() {
 }
 
 Matrix4 Matrix4::CalculateInverse(const Matrix4& mat) {
+    Matrix4 result;
+    MatrixInverse(mat.m_indicies.data(), result.m_indicies.data());
+    return result;
+}
 
-    //Minors, Cofactors, Adjugates method.
-    //See http://www.mathsisfun.com/algebra/matrix-inverse-minors-cofactors-adjugate.html
-
-    //[00 01 02 03] [0   1  2  3]
-    //[10 11 12 13] [4   5  6  7]
-    //[20 21 22 23] [8   9 10 11]
-    //[30 31 32 33] [12 13 14 15]
-
-    //Calculate minors
-    float m00 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[5], mat.m_indicies[6], mat.m_indicies[7], mat.m_indicies[9], mat.m_indicies[10], mat.m_indicies[11], mat.m_indicies[13], mat.m_indicies[14], mat.m_indicies[15]);
-    float m01 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[4], mat.m_indicies[6], mat.m_indicies[7], mat.m_indicies[8], mat.m_indicies[10], mat.m_indicies[11], mat.m_indicies[12], mat.m_indicies[14], mat.m_indicies[15]);
-    float m02 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[4], mat.m_indicies[5], mat.m_indicies[7], mat.m_indicies[8], mat.m_indicies[9], mat.m_indicies[11], mat.m_indicies[12], mat.m_indicies[13], mat.m_indicies[15]);
-    float m03 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[4], mat.m_indicies[5], mat.m_indicies[6], mat.m_indicies[8], mat.m_indicies[9], mat.m_indicies[10], mat.m_indicies[12], mat.m_indicies[13], mat.m_indicies[14]);
-
-    float m10 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[1], mat.m_indicies[2], mat.m_indicies[3], mat.m_indicies[9], mat.m_indicies[10], mat.m_indicies[11], mat.m_indicies[13], mat.m_indicies[14], mat.m_indicies[15]);
-    float m11 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[0], mat.m_indicies[2], mat.m_indicies[3], mat.m_indicies[8], mat.m_indicies[10], mat.m_indicies[11], mat.m_indicies[12], mat.m_indicies[14], mat.m_indicies[15]);
-    float m12 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[0], mat.m_indicies[1], mat.m_indicies[3], mat.m_indicies[8], mat.m_indicies[9], mat.m_indicies[11], mat.m_indicies[12], mat.m_indicies[13], mat.m_indicies[15]);
-    float m13 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[0], mat.m_indicies[1], mat.m_indicies[2], mat.m_indicies[8], mat.m_indicies[9], mat.m_indicies[10], mat.m_indicies[12], mat.m_indicies[13], mat.m_indicies[14]);
-
-    float m20 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[1], mat.m_indicies[2], mat.m_indicies[3], mat.m_indicies[5], mat.m_indicies[6], mat.m_indicies[7], mat.m_indicies[13], mat.m_indicies[14], mat.m_indicies[15]);
-    float m21 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[0], mat.m_indicies[2], mat.m_indicies[3], mat.m_indicies[4], mat.m_indicies[6], mat.m_indicies[7], mat.m_indicies[12], mat.m_indicies[14], mat.m_indicies[15]);
-    float m22 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[0], mat.m_indicies[1], mat.m_indicies[3], mat.m_indicies[4], mat.m_indicies[5], mat.m_indicies[7], mat.m_indicies[12], mat.m_indicies[13], mat.m_indicies[15]);
-    float m23 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[0], mat.m_indicies[1], mat.m_indicies[2], mat.m_indicies[4], mat.m_indicies[5], mat.m_indicies[6], mat.m_indicies[12], mat.m_indicies[13], mat.m_indicies[14]);
-
-    float m30 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[1], mat.m_indicies[2], mat.m_indicies[3], mat.m_indicies[5], mat.m_indicies[6], mat.m_indicies[7], mat.m_indicies[9], mat.m_indicies[10], mat.m_indicies[11]);
-    float m31 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[0], mat.m_indicies[2], mat.m_indicies[3], mat.m_indicies[4], mat.m_indicies[6], mat.m_indicies[7], mat.m_indicies[8], mat.m_indicies[10], mat.m_indicies[11]);
-    float m32 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[0], mat.m_indicies[1], mat.m_indicies[3], mat.m_indicies[4], mat.m_indicies[5], mat.m_indicies[7], mat.m_indicies[8], mat.m_indicies[9], mat.m_indicies[11]);
-    float m33 = MathUtils::CalculateMatrix3Determinant(mat.m_indicies[0], mat.m_indicies[1], mat.m_indicies[2], mat.m_indicies[4], mat.m_indicies[5], mat.m_indicies[6], mat.m_indicies[8], mat.m_indicies[9], mat.m_indicies[10]);
-
-    Matrix4 cofactors(m00, -m01,  m02, -m03,
-                     -m10,  m11, -m12,  m13,
-                      m20, -m21,  m22, -m23,
-                     -m30,  m31, -m32,  m33);
-
-    Matrix4 adjugate(Matrix4::CreateTransposeMatrix(cofactors));
-
-    float det_mat = mat.CalculateDeterminant();
-    float inv_det = 1.0f / det_mat;
+void Matrix4::CalculateAffineInverse() {
+    *this = Matrix4::CalculateAffineInverse(*this);
+}
 
-    return inv_det * adjugate;
+Matrix4 Matrix4::CalculateAffineInverse(const Matrix4& mat) {
+    Matrix4 result;
+    MatrixAffineInverse(mat.m_indicies.data(), result.m_indicies.data());
+    return result;
 }
 
 void Matrix4::OrthoNormalizeIKJ() {
@@ -706,41 +1152,75 @@ Matrix4 Matrix4::GetTransformed(const Matrix4& other) const {
     return this->operator*(other);
 }
 Vector2 Matrix4::TransformPosition(const Vector2& position) const {
-    Vector4 v(position.x, position.y, 0.0f, 1.0f);
+    float result[4];
+    MatrixTransform(m_indicies.data(), position.x, position.y, 0.0f, 1.0f, result);
+    return Vector2(result[0], result[1]);
+}
+Vector3 Matrix4::TransformPosition(const Vector3& position) const {
+    float result[4];
+    MatrixTransform(m_indicies.data(), position.x, position.y, position.z, 1.0f, result);
+    return Vector3(result[0], result[1], result[2]);
+}
+Vector2 Matrix4::TransformDirection(const Vector2& direction) const {
+    float result[4];
+    MatrixTransform(m_indicies.data(), direction.x, direction.y, 0.0f, 0.0f, result);
+    return Vector2(result[0], result[1]);
+}
+Vector3 Matrix4::TransformDirection(const Vector3& direction) const {
+    float result[4];
+    MatrixTransform(m_indicies.data(), direction.x, direction.y, direction.z, 0.0f, result);
+    return Vector3(result[0], result[1], result[2]);
+}
+Vector4 Matrix4::TransformVector(const Vector4& homogeneousVector) const {
+    return this->operator*(homogeneousVector);
+}
 
-    float x = MathUtils::DotProduct(this->GetXComponents(), v);
-    float y = MathUtils::DotProduct(this->GetYComponents(), v);
+void Matrix4::TransformPositions(std::span<const Vector3> positions, std::span<Vector3> result) const {
+    ASSERT_OR_DIE(positions.size() == result.size(), "Matrix4::TransformPositions: span sizes differ.");
+    BatchTransform3(m_indicies.data(), positions.data(), result.data(), positions.size(), sizeof(Vector3), sizeof(Vector3), 1.0f);
+}
 
-    return Vector2(x, y);
+void Matrix4::TransformDirections(std::span<const Vector3> directions, std::span<Vector3> result) const {
+    ASSERT_OR_DIE(directions.size() == result.size(), "Matrix4::TransformDirections: span sizes differ.");
+    BatchTransform3(m_indicies.data(), directions.data(), result.data(), directions.size(), sizeof(Vector3), sizeof(Vector3), 0.0f);
 }
-Vector3 Matrix4::TransformPosition(const Vector3& position) const {
-    Vector4 v(position.x, position.y, position.z, 1.0f);
 
-    float x = MathUtils::DotProduct(this->GetXComponents(), v);
-    float y = MathUtils::DotProduct(this->GetYComponents(), v);
-    float z = MathUtils::DotProduct(this->GetZComponents(), v);
+void Matrix4::TransformVectors(std::span<const Vector4> homogeneousVectors, std::span<Vector4> result) const {
+    ASSERT_OR_DIE(homogeneousVectors.size() == result.size(), "Matrix4::TransformVectors: span sizes differ.");
+    BatchTransform4(m_indicies.data(), homogeneousVectors.data(), result.data(), homogeneousVectors.size());
+}
 
-    return Vector3(x, y, z);
+void Matrix4::TransformPositions(Vector3* first, std::size_t count, std::size_t stride_bytes) const {
+    BatchTransform3(m_indicies.data(), first, first, count, stride_bytes, stride_bytes, 1.0f);
 }
-Vector2 Matrix4::TransformDirection(const Vector2& direction) const {
-    Vector4 v(direction.x, direction.y, 0.0f, 0.0f);
 
-    float x = MathUtils::DotProduct(this->GetXComponents(), v);
-    float y = MathUtils::DotProduct(this->GetYComponents(), v);
+void Matrix4::TransformDirections(Vector3* first, std::size_t count, std::size_t stride_bytes) const {
+    BatchTransform3(m_indicies.data(), first, first, count, stride_bytes, stride_bytes, 0.0f);
+}
 
-    return Vector2(x, y);
+void Matrix4::TransformPositions(std::span<float> xs, std::span<float> ys, std::span<float> zs) const {
+    ASSERT_OR_DIE(xs.size() == ys.size() && xs.size() == zs.size(), "Matrix4::TransformPositions: stream sizes differ.");
+    BatchTransformSoA(m_indicies.data(), xs.data(), ys.data(), zs.data(), xs.size(), 1.0f);
 }
-Vector3 Matrix4::TransformDirection(const Vector3& direction) const {
-    Vector4 v(direction.x, direction.y, direction.z, 0.0f);
 
-    float x = MathUtils::DotProduct(this->GetXComponents(), v);
-    float y = MathUtils::DotProduct(this->GetYComponents(), v);
-    float z = MathUtils::DotProduct(this->GetZComponents(), v);
+void Matrix4::TransformDirections(std::span<float> xs, std::span<float> ys, std::span<float> zs) const {
+    ASSERT_OR_DIE(xs.size() == ys.size() && xs.size() == zs.size(), "Matrix4::TransformDirections: stream sizes differ.");
+    BatchTransformSoA(m_indicies.data(), xs.data(), ys.data(), zs.data(), xs.size(), 0.0f);
+}
 
-    return Vector3(x, y, z);
+void Matrix4::TransformBounds(std::span<const AABB3> bounds, std::span<AABB3> result) const {
+    ASSERT_OR_DIE(bounds.size() == result.size(), "Matrix4::TransformBounds: span sizes differ.");
+    BatchTransformBounds(m_indicies.data(), bounds.data(), result.data(), bounds.size());
 }
-Vector4 Matrix4::TransformVector(const Vector4& homogeneousVector) const {
-    return this->operator*(homogeneousVector);
+
+void Matrix4::Multiply(std::span<const Matrix4> lhs, std::span<const Matrix4> rhs, std::span<Matrix4> result) {
+    ASSERT_OR_DIE(lhs.size() == rhs.size() && lhs.size() == result.size(), "Matrix4::Multiply: span sizes differ.");
+    for(std::size_t i = 0; i < lhs.size(); ++i) {
+        //Through a temporary so result may alias either input.
+        float product[16];
+        MatrixMultiply(lhs[i].m_indicies.data(), rhs[i].m_indicies.data(), product);
+        std::memcpy(result[i].m_indicies.data(), product, sizeof(product));
+    }
 }
 
 Vector2 Matrix4::WorldToScreenPoint(const Camera3D& c, const Vector3& worldPos) {
@@ -805,39 +1285,10 @@ Vector3 Matrix4::GetScale() const {
 Vector3 Matrix4::GetScale() {
     return static_cast<const Matrix4&>(*this).GetScale();
 }
-Matrix4 Matrix4::operator*(const Matrix4& rhs) const 
-{
-    using namespace MathUtils;
-
-    Vector4 myI = this->GetIBasis();
-    Vector4 myJ = this->GetJBasis();
-    Vector4 myK = this->GetKBasis();
-    Vector4 myT = this->GetTBasis();
-    Vector4 myX = this->GetXComponents();
-    Vector4 myY = this->GetYComponents();
-    Vector4 myZ = this->GetZComponents();
-    Vector4 myW = this->GetWComponents();
-
-    Vector4 rhsI = rhs.GetIBasis();
-    Vector4 rhsJ = rhs.GetJBasis();
-    Vector4 rhsK = rhs.GetKBasis();
-    Vector4 rhsT = rhs.GetTBasis();
-    Vector4 rhsX = rhs.GetXComponents();
-    Vector4 rhsY = rhs.GetYComponents();
-    Vector4 rhsZ = rhs.GetZComponents();
-    Vector4 rhsW = rhs.GetWComponents();
-
-    float m00 = DotProduct(myX, rhsI);  float m01 = DotProduct(myX, rhsJ); float m02 = DotProduct(myX, rhsK);  float m03 = DotProduct(myX, rhsT);
-    float m10 = DotProduct(myY, rhsI);  float m11 = DotProduct(myY, rhsJ); float m12 = DotProduct(myY, rhsK);; float m13 = DotProduct(myY, rhsT);;
-    float m20 = DotProduct(myZ, rhsI);  float m21 = DotProduct(myZ, rhsJ); float m22 = DotProduct(myZ, rhsK);  float m23 = DotProduct(myZ, rhsT);
-    float m30 = DotProduct(myW, rhsI);  float m31 = DotProduct(myW, rhsJ); float m32 = DotProduct(myW, rhsK);  float m33 = DotProduct(myW, rhsT);
-
-    Matrix4 result(  m00, m01, m02, m03
-                   , m10, m11, m12, m13
-                   , m20, m21, m22, m23
-                   , m30, m31, m32, m33
-                   );
-   return result;
+Matrix4 Matrix4::operator*(const Matrix4& rhs) const {
+    Matrix4 result;
+    MatrixMultiply(m_indicies.data(), rhs.m_indicies.data(), result.m_indicies.data());
+    return result;
 }
 
 Matrix4 Matrix4::operator*(float scalar) const {
@@ -848,38 +1299,16 @@ Matrix4 Matrix4::operator*(float scalar) const {
 }
 
 Vector4 Matrix4::operator*(const Vector4& rhs) const {
-    return Vector4(MathUtils::DotProduct(this->GetXComponents(), rhs),
-                   MathUtils::DotProduct(this->GetYComponents(), rhs),
-                   MathUtils::DotProduct(this->GetZComponents(), rhs),
-                   MathUtils::DotProduct(this->GetWComponents(), rhs));
+    float result[4];
+    MatrixTransform(m_indicies.data(), rhs.x, rhs.y, rhs.z, rhs.w, result);
+    return Vector4(result[0], result[1], result[2], result[3]);
 }
 
 Matrix4& Matrix4::operator*=(const Matrix4& rhs) {
-    Vector4 iBasis = this->GetIBasis();
-    Vector4 jBasis = this->GetJBasis();
-    Vector4 kBasis = this->GetKBasis();
-    Vector4 tBasis = this->GetTBasis();
-
-    m_indicies[0] = MathUtils::DotProduct(iBasis, rhs.GetXComponents());
-    m_indicies[1] = MathUtils::DotProduct(iBasis, rhs.GetYComponents());
-    m_indicies[2] = MathUtils::DotProduct(iBasis, rhs.GetZComponents());
-    m_indicies[3] = MathUtils::DotProduct(iBasis, rhs.GetWComponents());
-
-    m_indicies[4] = MathUtils::DotProduct(jBasis, rhs.GetXComponents());
-    m_indicies[5] = MathUtils::DotProduct(jBasis, rhs.GetYComponents());
-    m_indicies[6] = MathUtils::DotProduct(jBasis, rhs.GetZComponents());
-    m_indicies[7] = MathUtils::DotProduct(jBasis, rhs.GetWComponents());
-
-    m_indicies[8]  = MathUtils::DotProduct(kBasis, rhs.GetXComponents());
-    m_indicies[9]  = MathUtils::DotProduct(kBasis, rhs.GetYComponents());
-    m_indicies[10] = MathUtils::DotProduct(kBasis, rhs.GetZComponents());
-    m_indicies[11] = MathUtils::DotProduct(kBasis, rhs.GetWComponents());
-
-    m_indicies[12] = MathUtils::DotProduct(tBasis, rhs.GetXComponents());
-    m_indicies[13] = MathUtils::DotProduct(tBasis, rhs.GetYComponents());
-    m_indicies[14] = MathUtils::DotProduct(tBasis, rhs.GetZComponents());
-    m_indicies[15] = MathUtils::DotProduct(tBasis, rhs.GetWComponents());
-
+    //Dots this matrix's basis vectors with rhs's rows, which is (rhs * this) transposed.
+    Matrix4 product;
+    MatrixMultiply(rhs.m_indicies.data(), m_indicies.data(), product.m_indicies.data());
+    MatrixTranspose(product.m_indicies.data(), m_indicies.data());
     return *this;
 }
 
@@ -1061,3 +1490,229 @@ std::istream& operator>>(std::istream& in_stream, Matrix4& m) {
 
     return in_stream;
 }
+
+/************************************************************************/
+/* BENCHMARK                                                            */
+/************************************************************************/
+
+namespace {
+
+//The operators as they were before the SIMD kernels, kept as the reference the kernels
+//are checked against. Multiply and transform add in the same order as the kernels. The
+//inverses are checked against ScalarInverse.
+
+Matrix4 ReferenceMultiply(const Matrix4& lhs, const Matrix4& rhs) {
+    using namespace MathUtils;
+
+    Vector4 myX = lhs.GetXComponents();
+    Vector4 myY = lhs.GetYComponents();
+    Vector4 myZ = lhs.GetZComponents();
+    Vector4 myW = lhs.GetWComponents();
+
+    Vector4 rhsI = rhs.GetIBasis();
+    Vector4 rhsJ = rhs.GetJBasis();
+    Vector4 rhsK = rhs.GetKBasis();
+    Vector4 rhsT = rhs.GetTBasis();
+
+    float m00 = DotProduct(myX, rhsI);  float m01 = DotProduct(myX, rhsJ); float m02 = DotProduct(myX, rhsK);  float m03 = DotProduct(myX, rhsT);
+    float m10 = DotProduct(myY, rhsI);  float m11 = DotProduct(myY, rhsJ); float m12 = DotProduct(myY, rhsK);  float m13 = DotProduct(myY, rhsT);
+    float m20 = DotProduct(myZ, rhsI);  float m21 = DotProduct(myZ, rhsJ); float m22 = DotProduct(myZ, rhsK);  float m23 = DotProduct(myZ, rhsT);
+    float m30 = DotProduct(myW, rhsI);  float m31 = DotProduct(myW, rhsJ); float m32 = DotProduct(myW, rhsK);  float m33 = DotProduct(myW, rhsT);
+
+    const float result[16] = {  m00, m01, m02, m03
+                              , m10, m11, m12, m13
+                              , m20, m21, m22, m23
+                              , m30, m31, m32, m33 };
+    return Matrix4(result);
+}
+
+Vector4 ReferenceTransform(const Matrix4& mat, const Vector4& rhs) {
+    return Vector4(MathUtils::DotProduct(mat.GetXComponents(), rhs),
+                   MathUtils::DotProduct(mat.GetYComponents(), rhs),
+                   MathUtils::DotProduct(mat.GetZComponents(), rhs),
+                   MathUtils::DotProduct(mat.GetWComponents(), rhs));
+}
+
+//GetAsFloatArray only accepts affine matrices, so read the rows through their accessors.
+void ReferenceLoad(const Matrix4& mat, float* m) {
+    const Vector4 rows[4] = { mat.GetXComponents(), mat.GetYComponents(), mat.GetZComponents(), mat.GetWComponents() };
+    for(int r = 0; r < 4; ++r) {
+        m[4 * r + 0] = rows[r].x;
+        m[4 * r + 1] = rows[r].y;
+        m[4 * r + 2] = rows[r].z;
+        m[4 * r + 3] = rows[r].w;
+    }
+}
+
+Matrix4 ReferenceTranspose(const Matrix4& mat) {
+    float m[16];
+    ReferenceLoad(mat, m);
+    const float result[16] = { m[0], m[4], m[8], m[12],
+                               m[1], m[5], m[9], m[13],
+                               m[2], m[6], m[10], m[14],
+                               m[3], m[7], m[11], m[15] };
+    return Matrix4(result);
+}
+
+double CalcMaxRelativeError(const float* actual, const float* expected, std::size_t count) {
+    double max_error = 0.0;
+    for(std::size_t i = 0; i < count; ++i) {
+        max_error = (std::max)(max_error, std::fabs(static_cast<double>(actual[i]) - expected[i]) / (std::max)(1.0, std::fabs(static_cast<double>(expected[i]))));
+    }
+    return max_error;
+}
+
+}
+
+void Matrix4Benchmark(unsigned int iterations) {
+    constexpr std::size_t MATRIX_COUNT = 256;
+    std::mt19937 rng(1729);
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> scale_dist(0.25f, 4.0f);
+
+    //Random translate-rotate-scale matrices for the affine inverse, and the same with a
+    //noisy bottom row for the general one.
+    std::vector<Matrix4> affine(MATRIX_COUNT);
+    std::vector<Matrix4> general(MATRIX_COUNT);
+    for(std::size_t i = 0; i < MATRIX_COUNT; ++i) {
+        affine[i] = Matrix4::CreateTranslationMatrix(Vector3(dist(rng), dist(rng), dist(rng)))
+                  * Matrix4::Create3DXRotationDegreesMatrix(dist(rng) * 18.0f)
+                  * Matrix4::Create3DYRotationDegreesMatrix(dist(rng) * 18.0f)
+                  * Matrix4::Create3DZRotationDegreesMatrix(dist(rng) * 18.0f)
+                  * Matrix4::CreateScaleMatrix(Vector3(scale_dist(rng), scale_dist(rng), scale_dist(rng)));
+        general[i] = affine[i];
+        float* m = general[i].m_indicies.data();
+        m[12] = dist(rng) * 0.01f;
+        m[13] = dist(rng) * 0.01f;
+        m[14] = dist(rng) * 0.01f;
+        m[15] = 1.0f + dist(rng) * 0.01f;
+    }
+
+    std::size_t mismatches = 0;
+    double max_inverse_error = 0.0;
+    double max_affine_inverse_error = 0.0;
+    for(std::size_t i = 0; i < MATRIX_COUNT; ++i) {
+        const Matrix4& a = general[i];
+        const Matrix4& b = general[(i + 1) % MATRIX_COUNT];
+        float simd[16];
+        MatrixMultiply(a.m_indicies.data(), b.m_indicies.data(), simd);
+        mismatches += std::memcmp(simd, ReferenceMultiply(a, b).m_indicies.data(), sizeof(simd)) != 0;
+        MatrixTranspose(a.m_indicies.data(), simd);
+        mismatches += std::memcmp(simd, ReferenceTranspose(a).m_indicies.data(), sizeof(simd)) != 0;
+        const Vector4 v = b.GetXComponents();
+        MatrixTransform(a.m_indicies.data(), v.x, v.y, v.z, v.w, simd);
+        const Vector4 expected_v = ReferenceTransform(a, v);
+        mismatches += std::memcmp(simd, &expected_v, 4 * sizeof(float)) != 0;
+
+        float expected[16];
+        MatrixInverse(a.m_indicies.data(), simd);
+        ScalarInverse(a.m_indicies.data(), expected);
+        max_inverse_error = (std::max)(max_inverse_error, CalcMaxRelativeError(simd, expected, 16));
+        MatrixAffineInverse(affine[i].m_indicies.data(), simd);
+        ScalarInverse(affine[i].m_indicies.data(), expected);
+        max_affine_inverse_error = (std::max)(max_affine_inverse_error, CalcMaxRelativeError(simd, expected, 16));
+    }
+
+    float checksum = 0.0f;
+    auto time_kernel = [&](auto&& kernel) {
+        double start = GetCurrentTimeSeconds();
+        for(unsigned int i = 0; i < iterations; ++i) {
+            checksum += kernel(general[i % MATRIX_COUNT], affine[i % MATRIX_COUNT]);
+        }
+        double seconds = GetCurrentTimeSeconds() - start;
+        return iterations ? seconds * 1.0e9 / iterations : 0.0;
+    };
+    const double multiply_ns = time_kernel([](const Matrix4& a, const Matrix4& b) { return (a * b).m_indicies[0]; });
+    const double reference_multiply_ns = time_kernel([](const Matrix4& a, const Matrix4& b) { return ReferenceMultiply(a, b).m_indicies[0]; });
+    const double transform_ns = time_kernel([](const Matrix4& a, const Matrix4& b) { return (a * b.GetTBasis()).x; });
+    const double reference_transform_ns = time_kernel([](const Matrix4& a, const Matrix4& b) { return ReferenceTransform(a, b.GetTBasis()).x; });
+    const double transpose_ns = time_kernel([](const Matrix4& a, const Matrix4&) { return Matrix4::CreateTransposeMatrix(a).m_indicies[1]; });
+    const double reference_transpose_ns = time_kernel([](const Matrix4& a, const Matrix4&) { return ReferenceTranspose(a).m_indicies[1]; });
+    const double inverse_ns = time_kernel([](const Matrix4& a, const Matrix4&) { return Matrix4::CalculateInverse(a).m_indicies[0]; });
+    const double reference_inverse_ns = time_kernel([](const Matrix4& a, const Matrix4&) { float out[16]; ScalarInverse(a.m_indicies.data(), out); return out[0]; });
+    const double affine_inverse_ns = time_kernel([](const Matrix4&, const Matrix4& b) { return Matrix4::CalculateAffineInverse(b).m_indicies[0]; });
+
+    const char* name = MathUtils::GetSimdInstructionSetName();
+    g_theFileLogger->LogTagf("test", "Matrix4 %s operators, ns/call (pre-SIMD operators in parentheses):\n", name);
+    g_theFileLogger->LogTagf("test", "  multiply %.1f (%.1f), transform %.1f (%.1f), transpose %.1f (%.1f)\n", multiply_ns, reference_multiply_ns, transform_ns, reference_transform_ns, transpose_ns, reference_transpose_ns);
+    g_theFileLogger->LogTagf("test", "  inverse %.1f (%.1f), affine inverse %.1f\n", inverse_ns, reference_inverse_ns, affine_inverse_ns);
+    g_theFileLogger->LogTagf("test", "  %zu bitwise mismatches in multiply/transform/transpose. Max relative error: inverse %g, affine inverse %g. (checksum %g)\n", mismatches, max_inverse_error, max_affine_inverse_error, checksum);
+    GUARANTEE_RECOVERABLE(mismatches == 0, "Matrix4 multiply, transform or transpose kernels differ from the reference operators.");
+    GUARANTEE_RECOVERABLE(max_inverse_error < 1.0e-3 && max_affine_inverse_error < 1.0e-3, "Matrix4 inverse kernels differ from the scalar inverse.");
+
+    //Batch forms against the single-element calls they replace.
+    constexpr std::size_t POINT_COUNT = 4096;
+    std::vector<Vector3> points(POINT_COUNT);
+    std::vector<AABB3> boxes(POINT_COUNT);
+    for(std::size_t i = 0; i < POINT_COUNT; ++i) {
+        points[i] = Vector3(dist(rng), dist(rng), dist(rng));
+        const Vector3 half_extents(scale_dist(rng), scale_dist(rng), scale_dist(rng));
+        boxes[i] = AABB3(points[i] - half_extents, points[i] + half_extents);
+    }
+    std::vector<Vector3> transformed(POINT_COUNT);
+    std::vector<float> xs(POINT_COUNT);
+    std::vector<float> ys(POINT_COUNT);
+    std::vector<float> zs(POINT_COUNT);
+    std::vector<AABB3> transformed_boxes(POINT_COUNT);
+    std::vector<Matrix4> products(MATRIX_COUNT);
+
+    std::size_t batch_mismatches = 0;
+    double max_bounds_error = 0.0;
+    for(std::size_t i = 0; i < MATRIX_COUNT; ++i) {
+        const Matrix4& m = affine[i];
+        m.TransformPositions(points, transformed);
+        for(std::size_t j = 0; j < POINT_COUNT; ++j) {
+            xs[j] = points[j].x;
+            ys[j] = points[j].y;
+            zs[j] = points[j].z;
+        }
+        m.TransformPositions(xs, ys, zs);
+        for(std::size_t j = 0; j < POINT_COUNT; ++j) {
+            const Vector3 expected = m.TransformPosition(points[j]);
+            batch_mismatches += std::memcmp(&expected, &transformed[j], sizeof(Vector3)) != 0;
+            batch_mismatches += expected.x != xs[j] || expected.y != ys[j] || expected.z != zs[j];
+        }
+        m.TransformBounds(boxes, transformed_boxes);
+        for(std::size_t j = 0; j < POINT_COUNT; j += 64) {
+            const AABB3& box = boxes[j];
+            const Vector3 first_corner = m.TransformPosition(box.mins);
+            AABB3 expected(first_corner, first_corner);
+            for(int corner = 1; corner < 8; ++corner) {
+                expected.StretchToIncludePoint(m.TransformPosition(Vector3((corner & 1) ? box.maxs.x : box.mins.x, (corner & 2) ? box.maxs.y : box.mins.y, (corner & 4) ? box.maxs.z : box.mins.z)));
+            }
+            const AABB3& actual = transformed_boxes[j];
+            const float errors[6] = {expected.mins.x - actual.mins.x, expected.mins.y - actual.mins.y, expected.mins.z - actual.mins.z
+                                   , expected.maxs.x - actual.maxs.x, expected.maxs.y - actual.maxs.y, expected.maxs.z - actual.maxs.z};
+            for(float error : errors) {
+                max_bounds_error = (std::max)(max_bounds_error, std::fabs(static_cast<double>(error)));
+            }
+        }
+    }
+    Matrix4::Multiply(general, affine, products);
+    for(std::size_t i = 0; i < MATRIX_COUNT; ++i) {
+        const Matrix4 expected = general[i] * affine[i];
+        batch_mismatches += std::memcmp(expected.m_indicies.data(), products[i].m_indicies.data(), sizeof(float) * 16) != 0;
+    }
+
+    const unsigned int rounds = (std::max)(1u, iterations / static_cast<unsigned int>(POINT_COUNT));
+    auto time_batch = [&](auto&& batch) {
+        double start = GetCurrentTimeSeconds();
+        for(unsigned int i = 0; i < rounds; ++i) {
+            batch(affine[i % MATRIX_COUNT]);
+        }
+        double seconds = GetCurrentTimeSeconds() - start;
+        return seconds * 1.0e9 / (static_cast<double>(rounds) * POINT_COUNT);
+    };
+    const double single_ns = time_batch([&](const Matrix4& m) {
+        for(std::size_t j = 0; j < POINT_COUNT; ++j) {
+            transformed[j] = m.TransformPosition(points[j]);
+        }
+    });
+    const double batch_ns = time_batch([&](const Matrix4& m) { m.TransformPositions(points, transformed); });
+    const double soa_ns = time_batch([&](const Matrix4& m) { m.TransformPositions(xs, ys, zs); });
+    const double bounds_ns = time_batch([&](const Matrix4& m) { m.TransformBounds(boxes, transformed_boxes); });
+    g_theFileLogger->LogTagf("test", "  positions, ns/element: per call %.2f, batch %.2f, SoA batch %.2f; bounds batch %.2f\n", single_ns, batch_ns, soa_ns, bounds_ns);
+    g_theFileLogger->LogTagf("test", "  %zu bitwise mismatches in batch transforms. Max bounds error against transformed corners: %g\n", batch_mismatches, max_bounds_error);
+    GUARANTEE_RECOVERABLE(batch_mismatches == 0, "Matrix4 batch transforms differ from the per-element calls.");
+    GUARANTEE_RECOVERABLE(max_bounds_error < 1.0e-3, "Matrix4::TransformBounds differs from the transformed corners.");
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <span>
 #include <string>
 
 #include "Engine/Math/Vector2.hpp"
@@ -8,6 +9,7 @@
 #include "Engine/Math/Vector4.hpp"
 #include "Engine/Math/Quaternion.hpp"
 
+class AABB3;
 class Camera3D;
 
 class Matrix4 {
@@ -64,6 +66,10 @@ public:
     float CalculateDeterminant() const;
     float CalculateDeterminant();
     static Matrix4 CalculateInverse(const Matrix4& mat);
+    //Cheaper inverse for matrices whose bottom row is (0, 0, 0, 1): any mix of
+    //translation, rotation, scale and shear.
+    void CalculateAffineInverse();
+    static Matrix4 CalculateAffineInverse(const Matrix4& mat);
 
     void OrthoNormalizeIKJ();
 
@@ -95,6 +101,27 @@ public:
 
     Vector4 TransformVector(const Vector4& homogeneousVector) const;
 
+    //Batch forms of the above. result[i] is input[i] transformed; spans must be the same
+    //size and may be the same memory. Elements are independent, so a large batch can be
+    //split into subspans and handed to separate jobs.
+    void TransformPositions(std::span<const Vector3> positions, std::span<Vector3> result) const;
+    void TransformDirections(std::span<const Vector3> directions, std::span<Vector3> result) const;
+    void TransformVectors(std::span<const Vector4> homogeneousVectors, std::span<Vector4> result) const;
+
+    //In place over interleaved data, e.g. TransformPositions(&vertices[0].position, vertices.size(), sizeof(Vertex3D)).
+    void TransformPositions(Vector3* first, std::size_t count, std::size_t stride_bytes) const;
+    void TransformDirections(Vector3* first, std::size_t count, std::size_t stride_bytes) const;
+
+    //In place over structure-of-arrays streams of equal length.
+    void TransformPositions(std::span<float> xs, std::span<float> ys, std::span<float> zs) const;
+    void TransformDirections(std::span<float> xs, std::span<float> ys, std::span<float> zs) const;
+
+    //Tightest axis-aligned bounds of each transformed box.
+    void TransformBounds(std::span<const AABB3> bounds, std::span<AABB3> result) const;
+
+    //result[i] = lhs[i] * rhs[i]. result may alias either input.
+    static void Multiply(std::span<const Matrix4> lhs, std::span<const Matrix4> rhs, std::span<Matrix4> result);
+
     Vector2 WorldToScreenPoint(const Camera3D& c, const Vector3& worldPos);
     Vector3 ScreenToWorldPoint(const Camera3D& c, const Vector2& screenPos);
 
@@ -199,5 +226,11 @@ private:
     std::array<float, 16> m_indicies;
 
     friend class Quaternion;
+    friend void Matrix4Benchmark(unsigned int iterations);
 
 };
+
+//Times the Matrix4 operators this build selected against the operators they replaced and checks
+//that multiply, transform and transpose match them bit for bit. Results go to the log, and a
+//mismatch raises a recoverable warning.
+void Matrix4Benchmark(unsigned int iterations);
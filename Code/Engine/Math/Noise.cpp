@@ -5,8 +5,22 @@
 //-----------------------------------------------------------------------------------------------
 #include "Engine/Math/Noise.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Simd.hpp"
 #include "Engine/Math/Vector2.hpp"
 
+#include "Engine/EngineConfig.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
 
 //-----------------------------------------------------------------------------------------------
 // Returns an unsigned integer containing 32 reasonably-well-scrambled bits, based on a given
@@ -767,9 +781,1067 @@ float Compute4dPerlinNoise( float posX, float posY, float posZ, float posT, floa
 }
 
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Simplex noise
+//
+// The skew factors map a grid of regular simplices (triangles, tetrahedra, 5-cells) onto the
+//	integer lattice, so the containing simplex can be found with floor() and a few compares, and
+//	its corners hashed with the same Get*dNoiseUint functions as everything else.  Each corner
+//	contributes ( r^2 - d^2 )^4 times the dot of its gradient and displacement, with r^2 = 0.5 so a
+//	corner has fallen off completely before the position leaves its simplices (the 0.6 often used
+//	in 3D and 4D leaves small seams).  Gradients are the same tables Perlin noise uses.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+const float SIMPLEX_RADIUS_SQUARED = 0.5f;
+
+
+//-----------------------------------------------------------------------------------------------
+// Radial falloff for a corner at <distanceSquared>: zero at the edge of its influence, smooth there.
+//	Clamped with arithmetic rather than a branch, since whether a corner is in range is a coin flip.
+//
+inline float GetSimplexFalloff( float distanceSquared )
+{
+	float falloff = SIMPLEX_RADIUS_SQUARED - distanceSquared;
+	falloff = 0.5f * (falloff + fabsf( falloff )); // max( falloff, 0 ), exactly
+	falloff *= falloff;
+	return falloff * falloff;
+}
+
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Simplex noise is Perlin noise over a grid of triangles instead of squares: 3 corners instead of 4.
+//
+float Compute2dSimplexNoise( float posX, float posY, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
+	const float SKEW = 0.366025403784f; // ( sqrt(3) - 1 ) / 2; turns pairs of triangles into unit squares
+	const float UNSKEW = 0.211324865405f; // ( 3 - sqrt(3) ) / 6; and back
+	const Vector2 gradients[ 8 ] = // Normalized unit vectors in 8 quarter-cardinal directions
+	{
+		Vector2( +0.923879533f, +0.382683432f ), //  22.5 degrees (ENE)
+		Vector2( +0.382683432f, +0.923879533f ), //  67.5 degrees (NNE)
+		Vector2( -0.382683432f, +0.923879533f ), // 112.5 degrees (NNW)
+		Vector2( -0.923879533f, +0.382683432f ), // 157.5 degrees (WNW)
+		Vector2( -0.923879533f, -0.382683432f ), // 202.5 degrees (WSW)
+		Vector2( -0.382683432f, -0.923879533f ), // 247.5 degrees (SSW)
+		Vector2( +0.382683432f, -0.923879533f ), // 292.5 degrees (SSE)
+		Vector2( +0.923879533f, -0.382683432f )	 // 337.5 degrees (ESE)
+	};
+
+	float totalNoise = 0.f;
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / scale);
+	Vector2 currentPos( posX * invScale, posY * invScale );
+
+	for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++ octaveNum )
+	{
+		// Find the skewed square we're in; its diagonal splits it into two triangles
+		float skew = (currentPos.x + currentPos.y) * SKEW;
+		Vector2 cellMins( floorf( currentPos.x + skew ), floorf( currentPos.y + skew ) );
+		int indexX = (int) cellMins.x;
+		int indexY = (int) cellMins.y;
+		float unskew = (cellMins.x + cellMins.y) * UNSKEW;
+		Vector2 displacementFromFirst( currentPos.x - (cellMins.x - unskew), currentPos.y - (cellMins.y - unskew) );
+
+		// Below the diagonal the middle corner is east of the first one, above it north
+		int middleOffsetX = (int) (displacementFromFirst.x > displacementFromFirst.y);
+		int middleOffsetY = 1 - middleOffsetX;
+		Vector2 displacementFromMiddle( displacementFromFirst.x - (float) middleOffsetX + UNSKEW, displacementFromFirst.y - (float) middleOffsetY + UNSKEW );
+		Vector2 displacementFromLast( displacementFromFirst.x - 1.f + (2.f * UNSKEW), displacementFromFirst.y - 1.f + (2.f * UNSKEW) );
+
+		// Mask with 7 (mod 8) to look up in gradients table
+		Vector2 gradientFirst  = gradients[ Get2dNoiseUint( indexX, indexY, seed ) & 0x00000007 ];
+		Vector2 gradientMiddle = gradients[ Get2dNoiseUint( indexX + middleOffsetX, indexY + middleOffsetY, seed ) & 0x00000007 ];
+		Vector2 gradientLast   = gradients[ Get2dNoiseUint( indexX + 1, indexY + 1, seed ) & 0x00000007 ];
+
+		// Sum each corner's dot product, weighted by its radial falloff
+		float sumOfCorners = 0.f;
+		sumOfCorners += GetSimplexFalloff( displacementFromFirst.CalcLengthSquared() ) * MathUtils::DotProduct( gradientFirst, displacementFromFirst );
+		sumOfCorners += GetSimplexFalloff( displacementFromMiddle.CalcLengthSquared() ) * MathUtils::DotProduct( gradientMiddle, displacementFromMiddle );
+		sumOfCorners += GetSimplexFalloff( displacementFromLast.CalcLengthSquared() ) * MathUtils::DotProduct( gradientLast, displacementFromLast );
+		float noiseThisOctave = 99.f * sumOfCorners; // 2D simplex is in ~[-.010,.010]; map to ~[-1,1]
+
+		// Accumulate results and prepare for next octave (if any)
+		totalNoise += noiseThisOctave * currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+		currentPos *= octaveScale;
+		currentPos.x += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.y += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		++ seed; // Eliminates octaves "echoing" each other (since each octave is uniquely seeded)
+	}
+
+	// Re-normalize total noise to within [-1,1] and fix octaves pulling us far away from limits
+	if( renormalize && totalAmplitude > 0.f )
+	{
+		totalNoise /= totalAmplitude;				// Amplitude exceeds 1.0 if octaves are used
+		totalNoise = (totalNoise * 0.5f) + 0.5f;	// Map to [0,1]
+		totalNoise = MathUtils::EasingFunctions::SmoothStep3( totalNoise );		// Push towards extents (octaves pull us away)
+		totalNoise = (totalNoise * 2.0f) - 1.f;		// Map back to [-1,1]
+	}
+
+	return totalNoise;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// In 3D the simplex is a tetrahedron: 4 corners instead of the cube's 8.  Which of the six
+//	tetrahedra in a skewed cube we're in comes from ordering the displacement's components.
+//
+float Compute3dSimplexNoise( float posX, float posY, float posZ, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
+	const float SKEW = 1.f / 3.f; // ( sqrt(4) - 1 ) / 3
+	const float UNSKEW = 1.f / 6.f; // ( 4 - sqrt(4) ) / 12
+	const Vector3 gradients[ 8 ] = // Same cube-corner gradients as 3D Perlin noise
+	{
+		Vector3( +MathUtils::M_SQRT3_3, +MathUtils::M_SQRT3_3, +MathUtils::M_SQRT3_3 ),
+		Vector3( -MathUtils::M_SQRT3_3, +MathUtils::M_SQRT3_3, +MathUtils::M_SQRT3_3 ),
+		Vector3( +MathUtils::M_SQRT3_3, -MathUtils::M_SQRT3_3, +MathUtils::M_SQRT3_3 ),
+		Vector3( -MathUtils::M_SQRT3_3, -MathUtils::M_SQRT3_3, +MathUtils::M_SQRT3_3 ),
+		Vector3( +MathUtils::M_SQRT3_3, +MathUtils::M_SQRT3_3, -MathUtils::M_SQRT3_3 ),
+		Vector3( -MathUtils::M_SQRT3_3, +MathUtils::M_SQRT3_3, -MathUtils::M_SQRT3_3 ),
+		Vector3( +MathUtils::M_SQRT3_3, -MathUtils::M_SQRT3_3, -MathUtils::M_SQRT3_3 ),
+		Vector3( -MathUtils::M_SQRT3_3, -MathUtils::M_SQRT3_3, -MathUtils::M_SQRT3_3 )
+	};
+
+	float totalNoise = 0.f;
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / scale);
+	Vector3 currentPos( posX * invScale, posY * invScale, posZ * invScale );
+
+	for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++ octaveNum )
+	{
+		// Find the skewed cube we're in
+		float skew = (currentPos.x + currentPos.y + currentPos.z) * SKEW;
+		Vector3 cellMins( floorf( currentPos.x + skew ), floorf( currentPos.y + skew ), floorf( currentPos.z + skew ) );
+		int indexX = (int) cellMins.x;
+		int indexY = (int) cellMins.y;
+		int indexZ = (int) cellMins.z;
+		float unskew = (cellMins.x + cellMins.y + cellMins.z) * UNSKEW;
+		Vector3 displacementFromFirst( currentPos.x - (cellMins.x - unskew), currentPos.y - (cellMins.y - unskew), currentPos.z - (cellMins.z - unskew) );
+
+		// The second corner steps along the largest component, the third along the largest two
+		//	(ties go to the first).  Comparisons are turned into 0/1 rather than branched on.
+		int xBeatsY = (int) (displacementFromFirst.x >= displacementFromFirst.y);
+		int xBeatsZ = (int) (displacementFromFirst.x >= displacementFromFirst.z);
+		int yBeatsZ = (int) (displacementFromFirst.y >= displacementFromFirst.z);
+		int secondOffsetX = xBeatsY & xBeatsZ;
+		int secondOffsetY = (xBeatsY ^ 1) & yBeatsZ;
+		int secondOffsetZ = (xBeatsZ ^ 1) & (yBeatsZ ^ 1);
+		int thirdOffsetX = xBeatsY | xBeatsZ;
+		int thirdOffsetY = (xBeatsY ^ 1) | yBeatsZ;
+		int thirdOffsetZ = (xBeatsZ ^ 1) | (yBeatsZ ^ 1);
+
+		Vector3 displacementFromSecond( displacementFromFirst.x - (float) secondOffsetX + UNSKEW, displacementFromFirst.y - (float) secondOffsetY + UNSKEW, displacementFromFirst.z - (float) secondOffsetZ + UNSKEW );
+		Vector3 displacementFromThird( displacementFromFirst.x - (float) thirdOffsetX + (2.f * UNSKEW), displacementFromFirst.y - (float) thirdOffsetY + (2.f * UNSKEW), displacementFromFirst.z - (float) thirdOffsetZ + (2.f * UNSKEW) );
+		Vector3 displacementFromLast( displacementFromFirst.x - 1.f + (3.f * UNSKEW), displacementFromFirst.y - 1.f + (3.f * UNSKEW), displacementFromFirst.z - 1.f + (3.f * UNSKEW) );
+
+		// Mask with 7 (mod 8) to look up in gradients table
+		Vector3 gradientFirst  = gradients[ Get3dNoiseUint( indexX, indexY, indexZ, seed ) & 0x00000007 ];
+		Vector3 gradientSecond = gradients[ Get3dNoiseUint( indexX + secondOffsetX, indexY + secondOffsetY, indexZ + secondOffsetZ, seed ) & 0x00000007 ];
+		Vector3 gradientThird  = gradients[ Get3dNoiseUint( indexX + thirdOffsetX, indexY + thirdOffsetY, indexZ + thirdOffsetZ, seed ) & 0x00000007 ];
+		Vector3 gradientLast   = gradients[ Get3dNoiseUint( indexX + 1, indexY + 1, indexZ + 1, seed ) & 0x00000007 ];
+
+		// Sum each corner's dot product, weighted by its radial falloff
+		float sumOfCorners = 0.f;
+		sumOfCorners += GetSimplexFalloff( displacementFromFirst.CalcLengthSquared() ) * MathUtils::DotProduct( gradientFirst, displacementFromFirst );
+		sumOfCorners += GetSimplexFalloff( displacementFromSecond.CalcLengthSquared() ) * MathUtils::DotProduct( gradientSecond, displacementFromSecond );
+		sumOfCorners += GetSimplexFalloff( displacementFromThird.CalcLengthSquared() ) * MathUtils::DotProduct( gradientThird, displacementFromThird );
+		sumOfCorners += GetSimplexFalloff( displacementFromLast.CalcLengthSquared() ) * MathUtils::DotProduct( gradientLast, displacementFromLast );
+		float noiseThisOctave = 107.f * sumOfCorners; // 3D simplex is in ~[-.0093,.0093]; map to ~[-1,1]
+
+		// Accumulate results and prepare for next octave (if any)
+		totalNoise += noiseThisOctave * currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+		currentPos *= octaveScale;
+		currentPos.x += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.y += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.z += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		++ seed; // Eliminates octaves "echoing" each other (since each octave is uniquely seeded)
+	}
+
+	// Re-normalize total noise to within [-1,1] and fix octaves pulling us far away from limits
+	if( renormalize && totalAmplitude > 0.f )
+	{
+		totalNoise /= totalAmplitude;				// Amplitude exceeds 1.0 if octaves are used
+		totalNoise = (totalNoise * 0.5f) + 0.5f;	// Map to [0,1]
+		totalNoise = MathUtils::EasingFunctions::SmoothStep3( totalNoise );		// Push towards extents (octaves pull us away)
+		totalNoise = (totalNoise * 2.0f) - 1.f;		// Map back to [-1,1]
+	}
+
+	return totalNoise;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// In 4D the simplex is a 5-cell: 5 corners instead of the hypercube's 16, which is where simplex
+//	noise really pays off.  Ranking the displacement's components (how many others each one beats)
+//	gives the order in which the middle corners step along each axis.
+//
+float Compute4dSimplexNoise( float posX, float posY, float posZ, float posT, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
+	const float SKEW = 0.309016994375f; // ( sqrt(5) - 1 ) / 4
+	const float UNSKEW = 0.138196601125f; // ( 5 - sqrt(5) ) / 20
+	const Vector4 gradients[ 16 ] = // Same hypercube-corner gradients as 4D Perlin noise
+	{
+		Vector4( +0.5f, +0.5f, +0.5f, +0.5f ),
+		Vector4( -0.5f, +0.5f, +0.5f, +0.5f ),
+		Vector4( +0.5f, -0.5f, +0.5f, +0.5f ),
+		Vector4( -0.5f, -0.5f, +0.5f, +0.5f ),
+		Vector4( +0.5f, +0.5f, -0.5f, +0.5f ),
+		Vector4( -0.5f, +0.5f, -0.5f, +0.5f ),
+		Vector4( +0.5f, -0.5f, -0.5f, +0.5f ),
+		Vector4( -0.5f, -0.5f, -0.5f, +0.5f ),
+		Vector4( +0.5f, +0.5f, +0.5f, -0.5f ),
+		Vector4( -0.5f, +0.5f, +0.5f, -0.5f ),
+		Vector4( +0.5f, -0.5f, +0.5f, -0.5f ),
+		Vector4( -0.5f, -0.5f, +0.5f, -0.5f ),
+		Vector4( +0.5f, +0.5f, -0.5f, -0.5f ),
+		Vector4( -0.5f, +0.5f, -0.5f, -0.5f ),
+		Vector4( +0.5f, -0.5f, -0.5f, -0.5f ),
+		Vector4( -0.5f, -0.5f, -0.5f, -0.5f )
+	};
+
+	float totalNoise = 0.f;
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / scale);
+	Vector4 currentPos( posX * invScale, posY * invScale, posZ * invScale, posT * invScale );
+
+	for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++ octaveNum )
+	{
+		// Find the skewed hypercube we're in
+		float skew = (currentPos.x + currentPos.y + currentPos.z + currentPos.w) * SKEW;
+		Vector4 cellMins( floorf( currentPos.x + skew ), floorf( currentPos.y + skew ), floorf( currentPos.z + skew ), floorf( currentPos.w + skew ) );
+		int indexX = (int) cellMins.x;
+		int indexY = (int) cellMins.y;
+		int indexZ = (int) cellMins.z;
+		int indexT = (int) cellMins.w;
+		float unskew = (cellMins.x + cellMins.y + cellMins.z + cellMins.w) * UNSKEW;
+		Vector4 displacementFromFirst( currentPos.x - (cellMins.x - unskew), currentPos.y - (cellMins.y - unskew), currentPos.z - (cellMins.z - unskew), currentPos.w - (cellMins.w - unskew) );
+
+		// Rank each component by how many of the others it is larger than (ties go to the later component).
+		//	Comparisons are turned into 0/1 rather than branched on.
+		int xBeatsY = (int) (displacementFromFirst.x > displacementFromFirst.y);
+		int xBeatsZ = (int) (displacementFromFirst.x > displacementFromFirst.z);
+		int xBeatsT = (int) (displacementFromFirst.x > displacementFromFirst.w);
+		int yBeatsZ = (int) (displacementFromFirst.y > displacementFromFirst.z);
+		int yBeatsT = (int) (displacementFromFirst.y > displacementFromFirst.w);
+		int zBeatsT = (int) (displacementFromFirst.z > displacementFromFirst.w);
+		int rankX = xBeatsY + xBeatsZ + xBeatsT;
+		int rankY = (1 - xBeatsY) + yBeatsZ + yBeatsT;
+		int rankZ = (1 - xBeatsZ) + (1 - yBeatsZ) + zBeatsT;
+		int rankT = (1 - xBeatsT) + (1 - yBeatsT) + (1 - zBeatsT);
+
+		// The Nth middle corner has stepped along the N largest components; ranks are 0-3, so rank >= 3, >= 2 and >= 1 are bit tests
+		int secondOffsetX = (rankX >> 1) & rankX, secondOffsetY = (rankY >> 1) & rankY, secondOffsetZ = (rankZ >> 1) & rankZ, secondOffsetT = (rankT >> 1) & rankT;
+		int thirdOffsetX  = rankX >> 1,           thirdOffsetY  = rankY >> 1,           thirdOffsetZ  = rankZ >> 1,           thirdOffsetT  = rankT >> 1;
+		int fourthOffsetX = (rankX >> 1) | (rankX & 1), fourthOffsetY = (rankY >> 1) | (rankY & 1), fourthOffsetZ = (rankZ >> 1) | (rankZ & 1), fourthOffsetT = (rankT >> 1) | (rankT & 1);
+
+		Vector4 displacementFromSecond( displacementFromFirst.x - (float) secondOffsetX + UNSKEW, displacementFromFirst.y - (float) secondOffsetY + UNSKEW, displacementFromFirst.z - (float) secondOffsetZ + UNSKEW, displacementFromFirst.w - (float) secondOffsetT + UNSKEW );
+		Vector4 displacementFromThird( displacementFromFirst.x - (float) thirdOffsetX + (2.f * UNSKEW), displacementFromFirst.y - (float) thirdOffsetY + (2.f * UNSKEW), displacementFromFirst.z - (float) thirdOffsetZ + (2.f * UNSKEW), displacementFromFirst.w - (float) thirdOffsetT + (2.f * UNSKEW) );
+		Vector4 displacementFromFourth( displacementFromFirst.x - (float) fourthOffsetX + (3.f * UNSKEW), displacementFromFirst.y - (float) fourthOffsetY + (3.f * UNSKEW), displacementFromFirst.z - (float) fourthOffsetZ + (3.f * UNSKEW), displacementFromFirst.w - (float) fourthOffsetT + (3.f * UNSKEW) );
+		Vector4 displacementFromLast( displacementFromFirst.x - 1.f + (4.f * UNSKEW), displacementFromFirst.y - 1.f + (4.f * UNSKEW), displacementFromFirst.z - 1.f + (4.f * UNSKEW), displacementFromFirst.w - 1.f + (4.f * UNSKEW) );
+
+		// Mask with 15 (mod 16) to look up in gradients table
+		Vector4 gradientFirst  = gradients[ Get4dNoiseUint( indexX, indexY, indexZ, indexT, seed ) & 0x0000000F ];
+		Vector4 gradientSecond = gradients[ Get4dNoiseUint( indexX + secondOffsetX, indexY + secondOffsetY, indexZ + secondOffsetZ, indexT + secondOffsetT, seed ) & 0x0000000F ];
+		Vector4 gradientThird  = gradients[ Get4dNoiseUint( indexX + thirdOffsetX, indexY + thirdOffsetY, indexZ + thirdOffsetZ, indexT + thirdOffsetT, seed ) & 0x0000000F ];
+		Vector4 gradientFourth = gradients[ Get4dNoiseUint( indexX + fourthOffsetX, indexY + fourthOffsetY, indexZ + fourthOffsetZ, indexT + fourthOffsetT, seed ) & 0x0000000F ];
+		Vector4 gradientLast   = gradients[ Get4dNoiseUint( indexX + 1, indexY + 1, indexZ + 1, indexT + 1, seed ) & 0x0000000F ];
+
+		// Sum each corner's dot product, weighted by its radial falloff
+		float sumOfCorners = 0.f;
+		sumOfCorners += GetSimplexFalloff( displacementFromFirst.CalcLengthSquared4D() ) * MathUtils::DotProduct( gradientFirst, displacementFromFirst );
+		sumOfCorners += GetSimplexFalloff( displacementFromSecond.CalcLengthSquared4D() ) * MathUtils::DotProduct( gradientSecond, displacementFromSecond );
+		sumOfCorners += GetSimplexFalloff( displacementFromThird.CalcLengthSquared4D() ) * MathUtils::DotProduct( gradientThird, displacementFromThird );
+		sumOfCorners += GetSimplexFalloff( displacementFromFourth.CalcLengthSquared4D() ) * MathUtils::DotProduct( gradientFourth, displacementFromFourth );
+		sumOfCorners += GetSimplexFalloff( displacementFromLast.CalcLengthSquared4D() ) * MathUtils::DotProduct( gradientLast, displacementFromLast );
+		float noiseThisOctave = 108.f * sumOfCorners; // 4D simplex is in ~[-.0092,.0092]; map to ~[-1,1]
+
+		// Accumulate results and prepare for next octave (if any)
+		totalNoise += noiseThisOctave * currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+		currentPos *= octaveScale;
+		currentPos.x += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.y += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.z += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.w += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		++ seed; // Eliminates octaves "echoing" each other (since each octave is uniquely seeded)
+	}
+
+	// Re-normalize total noise to within [-1,1] and fix octaves pulling us far away from limits
+	if( renormalize && totalAmplitude > 0.f )
+	{
+		totalNoise /= totalAmplitude;				// Amplitude exceeds 1.0 if octaves are used
+		totalNoise = (totalNoise * 0.5f) + 0.5f;	// Map to [0,1]
+		totalNoise = MathUtils::EasingFunctions::SmoothStep3( totalNoise );		// Push towards extents (octaves pull us away)
+		totalNoise = (totalNoise * 2.0f) - 1.f;		// Map back to [-1,1]
+	}
+
+	return totalNoise;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Grid fills
+//
+// Every sample in a row shares its Y (and Z) position, so the Y/Z half of the octave loop -- cell
+//	index, displacements, weights and the Y/Z part of each corner's hash index -- is done once per
+//	row.  The X half runs four samples at a time and repeats the single-sample arithmetic in the
+//	same order, which keeps the results bit-identical.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+const float OCTAVE_OFFSET = 0.636764989593174f; // Same as the single-sample functions
+const int LATTICE_PRIME1 = 198491317; // Same as Get2dNoiseUint/Get3dNoiseUint
+const int LATTICE_PRIME2 = 6542989;
+
+
+//-----------------------------------------------------------------------------------------------
+// One octave's worth of row-constant values.
+//
+struct NoiseRowOctave
+{
+	unsigned int seed = 0;
+	float amplitude = 0.f;
+	unsigned int lattice[ 4 ] = {};		// Y/Z part of the hash index: south, north, then above-south, above-north in 3D
+	float displacementFromMinY = 0.f;	// From the south edge of the cell; also the fractal noise displacement
+	float displacementFromMaxY = 0.f;	// From the north edge
+	float weightNorth = 0.f;
+	float weightSouth = 0.f;
+	float displacementFromMinZ = 0.f;
+	float displacementFromMaxZ = 0.f;
+	float weightAbove = 0.f;
+	float weightBelow = 0.f;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Returns the first row past the range, after checking that <out> holds the whole grid.
+//
+int GetLastGridRow( std::size_t outSize, int width, int rowSize, int rowTotal, int firstRow, int rowCount )
+{
+	ASSERT_OR_DIE( width >= 0 && rowSize >= 0 && rowTotal >= 0, "Noise grid dimensions must not be negative." );
+	ASSERT_OR_DIE( outSize >= static_cast<std::size_t>( rowSize ) * static_cast<std::size_t>( rowTotal ), "Noise grid output is smaller than the grid." );
+	ASSERT_OR_DIE( firstRow >= 0 && firstRow <= rowTotal, "Noise grid row range starts outside the grid." );
+	return rowCount < 0 ? rowTotal : (std::min)( rowTotal, firstRow + rowCount );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs the Y (and Z) half of the octave loop for one row.  Returns the total amplitude.
+//
+float SetupRowOctaves( std::vector<NoiseRowOctave>& octaves, float posY, float posZ, bool is3d, float scale, float octavePersistence, float octaveScale, unsigned int seed )
+{
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / scale);
+	float currentY = posY * invScale;
+	float currentZ = posZ * invScale;
+	for( NoiseRowOctave& octave : octaves )
+	{
+		float cellMinY = floorf( currentY );
+		float cellMinZ = floorf( currentZ );
+		unsigned int latticeSouth = static_cast<unsigned int>( LATTICE_PRIME1 ) * static_cast<unsigned int>( (int) cellMinY );
+		unsigned int latticeNorth = latticeSouth + static_cast<unsigned int>( LATTICE_PRIME1 );
+		unsigned int latticeBelow = is3d ? static_cast<unsigned int>( LATTICE_PRIME2 ) * static_cast<unsigned int>( (int) cellMinZ ) : 0u;
+		unsigned int latticeAbove = latticeBelow + static_cast<unsigned int>( LATTICE_PRIME2 );
+		octave.lattice[ 0 ] = latticeSouth + latticeBelow;
+		octave.lattice[ 1 ] = latticeNorth + latticeBelow;
+		octave.lattice[ 2 ] = latticeSouth + latticeAbove;
+		octave.lattice[ 3 ] = latticeNorth + latticeAbove;
+
+		octave.displacementFromMinY = currentY - cellMinY;
+		octave.displacementFromMaxY = currentY - (cellMinY + 1.f);
+		octave.weightNorth = MathUtils::EasingFunctions::SmoothStep3( octave.displacementFromMinY );
+		octave.weightSouth = 1.f - octave.weightNorth;
+		octave.displacementFromMinZ = currentZ - cellMinZ;
+		octave.displacementFromMaxZ = currentZ - (cellMinZ + 1.f);
+		octave.weightAbove = MathUtils::EasingFunctions::SmoothStep3( octave.displacementFromMinZ );
+		octave.weightBelow = 1.f - octave.weightAbove;
+
+		octave.seed = seed;
+		octave.amplitude = currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+		currentY *= octaveScale;
+		currentY += OCTAVE_OFFSET;
+		currentZ *= octaveScale;
+		currentZ += OCTAVE_OFFSET;
+		++ seed;
+	}
+	return totalAmplitude;
+}
+
+
+#if defined( ENGINE_SIMD_SSE )
+
+//-----------------------------------------------------------------------------------------------
+// Low 32 bits of each lane's product.  SSE2 only multiplies even lanes, so it takes two passes.
+//
+__m128i MultiplyLanes( __m128i a, __m128i b )
+{
+#if defined( ENGINE_SIMD_AVX )
+	return _mm_mullo_epi32( a, b );
+#else
+	const __m128i evenProducts = _mm_mul_epu32( a, b );
+	const __m128i oddProducts = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+	return _mm_unpacklo_epi32( _mm_shuffle_epi32( evenProducts, _MM_SHUFFLE( 0, 0, 2, 0 ) ), _mm_shuffle_epi32( oddProducts, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Get1dNoiseUint for four positions.
+//
+__m128i Get1dNoiseUintLanes( __m128i positionX, __m128i seed )
+{
+	const __m128i BIT_NOISE1 = _mm_set1_epi32( 0x68E31DA4 );
+	const __m128i BIT_NOISE2 = _mm_set1_epi32( static_cast<int>( 0xB5297A4D ) );
+	const __m128i BIT_NOISE3 = _mm_set1_epi32( 0x1B56C4E9 );
+
+	__m128i mangledBits = MultiplyLanes( positionX, BIT_NOISE1 );
+	mangledBits = _mm_add_epi32( mangledBits, seed );
+	mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 8 ) );
+	mangledBits = _mm_add_epi32( mangledBits, BIT_NOISE2 );
+	mangledBits = _mm_xor_si128( mangledBits, _mm_slli_epi32( mangledBits, 8 ) );
+	mangledBits = MultiplyLanes( mangledBits, BIT_NOISE3 );
+	mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 8 ) );
+	return mangledBits;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Get1dNoiseZeroToOne's conversion, through double exactly like the scalar version.
+//
+__m128 ConvertNoiseToZeroToOneLanes( __m128i noise )
+{
+	const __m128d ONE_OVER_MAX_UINT = _mm_set1_pd( 1.0 / (double) 0xFFFFFFFF );
+	const __m128d TWO_TO_THE_31 = _mm_set1_pd( 2147483648.0 );
+
+	// Unsigned to double: flip the top bit, convert as signed, add the 2^31 back
+	const __m128i flipped = _mm_xor_si128( noise, _mm_set1_epi32( static_cast<int>( 0x80000000 ) ) );
+	const __m128d low = _mm_add_pd( _mm_cvtepi32_pd( flipped ), TWO_TO_THE_31 );
+	const __m128d high = _mm_add_pd( _mm_cvtepi32_pd( _mm_shuffle_epi32( flipped, _MM_SHUFFLE( 1, 0, 3, 2 ) ) ), TWO_TO_THE_31 );
+	return _mm_movelh_ps( _mm_cvtpd_ps( _mm_mul_pd( ONE_OVER_MAX_UINT, low ) ), _mm_cvtpd_ps( _mm_mul_pd( ONE_OVER_MAX_UINT, high ) ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// floorf for four values, also returned as ints.
+//
+__m128 FloorLanes( __m128 value, __m128i& outIndex )
+{
+#if defined( ENGINE_SIMD_AVX )
+	const __m128 floored = _mm_floor_ps( value );
+	outIndex = _mm_cvttps_epi32( floored );
+	return floored;
+#else
+	// Truncate, then step down where that rounded up.  Or-ing in the sign keeps floorf( -0 ) == -0.
+	const __m128i truncated = _mm_cvttps_epi32( value );
+	const __m128 truncatedFloat = _mm_cvtepi32_ps( truncated );
+	const __m128 roundedUp = _mm_cmpgt_ps( truncatedFloat, value );
+	outIndex = _mm_add_epi32( truncated, _mm_castps_si128( roundedUp ) );
+	const __m128 floored = _mm_sub_ps( truncatedFloat, _mm_and_ps( roundedUp, _mm_set1_ps( 1.f ) ) );
+	return _mm_or_ps( floored, _mm_and_ps( value, _mm_set1_ps( -0.f ) ) );
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// SmoothStep3 exactly as MathUtils::EasingFunctions evaluates it.
+//
+__m128 SmoothStep3Lanes( __m128 t )
+{
+	const __m128 ONE = _mm_set1_ps( 1.f );
+	const __m128 HALF = _mm_set1_ps( 0.5f );
+	const __m128 start = _mm_mul_ps( _mm_mul_ps( t, t ), t );
+	const __m128 oneMinusT = _mm_sub_ps( ONE, t );
+	const __m128 stop = _mm_sub_ps( ONE, _mm_mul_ps( _mm_mul_ps( oneMinusT, oneMinusT ), oneMinusT ) );
+	return _mm_add_ps( _mm_mul_ps( HALF, start ), _mm_mul_ps( HALF, stop ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// The X half of an octave: cell, displacements, weights and the two X lattice indices.
+//
+struct NoiseLanesX
+{
+	__m128i indexWest;
+	__m128i indexEast;
+	__m128 displacementFromMinX;
+	__m128 displacementFromMaxX;
+	__m128 weightEast;
+	__m128 weightWest;
+	__m128i seed;
+};
+
+NoiseLanesX ComputeNoiseLanesX( __m128 currentX, const NoiseRowOctave& octave )
+{
+	const __m128 ONE = _mm_set1_ps( 1.f );
+	NoiseLanesX lanes;
+	const __m128 cellMinX = FloorLanes( currentX, lanes.indexWest );
+	lanes.indexEast = _mm_add_epi32( lanes.indexWest, _mm_set1_epi32( 1 ) );
+	lanes.displacementFromMinX = _mm_sub_ps( currentX, cellMinX );
+	lanes.displacementFromMaxX = _mm_sub_ps( currentX, _mm_add_ps( cellMinX, ONE ) );
+	lanes.weightEast = SmoothStep3Lanes( lanes.displacementFromMinX );
+	lanes.weightWest = _mm_sub_ps( ONE, lanes.weightEast );
+	lanes.seed = _mm_set1_epi32( static_cast<int>( octave.seed ) );
+	return lanes;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+__m128 Blend( __m128 weightA, __m128 valueA, __m128 weightB, __m128 valueB )
+{
+	return _mm_add_ps( _mm_mul_ps( weightA, valueA ), _mm_mul_ps( weightB, valueB ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+__m128 ComputeFractalCornerLanes( __m128i indexX, unsigned int lattice, __m128i seed )
+{
+	return ConvertNoiseToZeroToOneLanes( Get1dNoiseUintLanes( _mm_add_epi32( indexX, _mm_set1_epi32( static_cast<int>( lattice ) ) ), seed ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Dot of the 2D Perlin gradient picked by <noise> & 7 with a displacement.  The gradients sit
+//	at 22.5 + 45n degrees, so each component is +/-0.9238 or +/-0.3827 chosen by the low bits.
+//
+__m128 ComputePerlin2dCornerLanes( __m128i indexX, unsigned int lattice, __m128i seed, __m128 displacementX, __m128 displacementY )
+{
+	const __m128 LONG_COMPONENT = _mm_set1_ps( 0.923879533f );
+	const __m128 SHORT_COMPONENT = _mm_set1_ps( 0.382683432f );
+	const __m128i SIGN_BIT = _mm_set1_epi32( static_cast<int>( 0x80000000 ) );
+
+	const __m128i noise = Get1dNoiseUintLanes( _mm_add_epi32( indexX, _mm_set1_epi32( static_cast<int>( lattice ) ) ), seed );
+	const __m128 xIsLong = _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( _mm_xor_si128( noise, _mm_srli_epi32( noise, 1 ) ), _mm_set1_epi32( 1 ) ), _mm_setzero_si128() ) );
+	const __m128 signX = _mm_castsi128_ps( _mm_and_si128( _mm_slli_epi32( _mm_add_epi32( noise, _mm_set1_epi32( 2 ) ), 29 ), SIGN_BIT ) );
+	const __m128 signY = _mm_castsi128_ps( _mm_and_si128( _mm_slli_epi32( noise, 29 ), SIGN_BIT ) );
+	const __m128 gradientX = _mm_or_ps( _mm_or_ps( _mm_and_ps( xIsLong, LONG_COMPONENT ), _mm_andnot_ps( xIsLong, SHORT_COMPONENT ) ), signX );
+	const __m128 gradientY = _mm_or_ps( _mm_or_ps( _mm_and_ps( xIsLong, SHORT_COMPONENT ), _mm_andnot_ps( xIsLong, LONG_COMPONENT ) ), signY );
+	return _mm_add_ps( _mm_mul_ps( gradientX, displacementX ), _mm_mul_ps( gradientY, displacementY ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Dot of the 3D Perlin gradient picked by <noise> & 7 with a displacement.  The gradients point
+//	at cube corners, so bits 0, 1 and 2 are the signs of x, y and z.
+//
+__m128 ComputePerlin3dCornerLanes( __m128i indexX, unsigned int lattice, __m128i seed, __m128 displacementX, __m128 displacementY, __m128 displacementZ )
+{
+	const __m128 COMPONENT = _mm_set1_ps( MathUtils::M_SQRT3_3 );
+	const __m128i SIGN_BIT = _mm_set1_epi32( static_cast<int>( 0x80000000 ) );
+
+	const __m128i noise = Get1dNoiseUintLanes( _mm_add_epi32( indexX, _mm_set1_epi32( static_cast<int>( lattice ) ) ), seed );
+	const __m128 gradientX = _mm_or_ps( COMPONENT, _mm_castsi128_ps( _mm_slli_epi32( noise, 31 ) ) );
+	const __m128 gradientY = _mm_or_ps( COMPONENT, _mm_castsi128_ps( _mm_and_si128( _mm_slli_epi32( noise, 30 ), SIGN_BIT ) ) );
+	const __m128 gradientZ = _mm_or_ps( COMPONENT, _mm_castsi128_ps( _mm_and_si128( _mm_slli_epi32( noise, 29 ), SIGN_BIT ) ) );
+	return _mm_add_ps( _mm_add_ps( _mm_mul_ps( gradientX, displacementX ), _mm_mul_ps( gradientY, displacementY ) ), _mm_mul_ps( gradientZ, displacementZ ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+__m128 Compute2dFractalOctaveLanes( __m128 currentX, const NoiseRowOctave& octave )
+{
+	const NoiseLanesX x = ComputeNoiseLanesX( currentX, octave );
+	const __m128 valueSouthWest = ComputeFractalCornerLanes( x.indexWest, octave.lattice[ 0 ], x.seed );
+	const __m128 valueSouthEast = ComputeFractalCornerLanes( x.indexEast, octave.lattice[ 0 ], x.seed );
+	const __m128 valueNorthWest = ComputeFractalCornerLanes( x.indexWest, octave.lattice[ 1 ], x.seed );
+	const __m128 valueNorthEast = ComputeFractalCornerLanes( x.indexEast, octave.lattice[ 1 ], x.seed );
+
+	const __m128 blendSouth = Blend( x.weightEast, valueSouthEast, x.weightWest, valueSouthWest );
+	const __m128 blendNorth = Blend( x.weightEast, valueNorthEast, x.weightWest, valueNorthWest );
+	const __m128 blendTotal = Blend( _mm_set1_ps( octave.weightSouth ), blendSouth, _mm_set1_ps( octave.weightNorth ), blendNorth );
+	return _mm_mul_ps( _mm_set1_ps( 2.f ), _mm_sub_ps( blendTotal, _mm_set1_ps( 0.5f ) ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+__m128 Compute3dFractalOctaveLanes( __m128 currentX, const NoiseRowOctave& octave )
+{
+	const NoiseLanesX x = ComputeNoiseLanesX( currentX, octave );
+	const __m128 belowSouthWest = ComputeFractalCornerLanes( x.indexWest, octave.lattice[ 0 ], x.seed );
+	const __m128 belowSouthEast = ComputeFractalCornerLanes( x.indexEast, octave.lattice[ 0 ], x.seed );
+	const __m128 belowNorthWest = ComputeFractalCornerLanes( x.indexWest, octave.lattice[ 1 ], x.seed );
+	const __m128 belowNorthEast = ComputeFractalCornerLanes( x.indexEast, octave.lattice[ 1 ], x.seed );
+	const __m128 aboveSouthWest = ComputeFractalCornerLanes( x.indexWest, octave.lattice[ 2 ], x.seed );
+	const __m128 aboveSouthEast = ComputeFractalCornerLanes( x.indexEast, octave.lattice[ 2 ], x.seed );
+	const __m128 aboveNorthWest = ComputeFractalCornerLanes( x.indexWest, octave.lattice[ 3 ], x.seed );
+	const __m128 aboveNorthEast = ComputeFractalCornerLanes( x.indexEast, octave.lattice[ 3 ], x.seed );
+
+	const __m128 weightSouth = _mm_set1_ps( octave.weightSouth );
+	const __m128 weightNorth = _mm_set1_ps( octave.weightNorth );
+	const __m128 blendBelowSouth = Blend( x.weightEast, belowSouthEast, x.weightWest, belowSouthWest );
+	const __m128 blendBelowNorth = Blend( x.weightEast, belowNorthEast, x.weightWest, belowNorthWest );
+	const __m128 blendAboveSouth = Blend( x.weightEast, aboveSouthEast, x.weightWest, aboveSouthWest );
+	const __m128 blendAboveNorth = Blend( x.weightEast, aboveNorthEast, x.weightWest, aboveNorthWest );
+	const __m128 blendBelow = Blend( weightSouth, blendBelowSouth, weightNorth, blendBelowNorth );
+	const __m128 blendAbove = Blend( weightSouth, blendAboveSouth, weightNorth, blendAboveNorth );
+	const __m128 blendTotal = Blend( _mm_set1_ps( octave.weightBelow ), blendBelow, _mm_set1_ps( octave.weightAbove ), blendAbove );
+	return _mm_mul_ps( _mm_set1_ps( 2.f ), _mm_sub_ps( blendTotal, _mm_set1_ps( 0.5f ) ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+__m128 Compute2dPerlinOctaveLanes( __m128 currentX, const NoiseRowOctave& octave )
+{
+	const NoiseLanesX x = ComputeNoiseLanesX( currentX, octave );
+	const __m128 displacementFromMinY = _mm_set1_ps( octave.displacementFromMinY );
+	const __m128 displacementFromMaxY = _mm_set1_ps( octave.displacementFromMaxY );
+	const __m128 dotSouthWest = ComputePerlin2dCornerLanes( x.indexWest, octave.lattice[ 0 ], x.seed, x.displacementFromMinX, displacementFromMinY );
+	const __m128 dotSouthEast = ComputePerlin2dCornerLanes( x.indexEast, octave.lattice[ 0 ], x.seed, x.displacementFromMaxX, displacementFromMinY );
+	const __m128 dotNorthWest = ComputePerlin2dCornerLanes( x.indexWest, octave.lattice[ 1 ], x.seed, x.displacementFromMinX, displacementFromMaxY );
+	const __m128 dotNorthEast = ComputePerlin2dCornerLanes( x.indexEast, octave.lattice[ 1 ], x.seed, x.displacementFromMaxX, displacementFromMaxY );
+
+	const __m128 blendSouth = Blend( x.weightEast, dotSouthEast, x.weightWest, dotSouthWest );
+	const __m128 blendNorth = Blend( x.weightEast, dotNorthEast, x.weightWest, dotNorthWest );
+	const __m128 blendTotal = Blend( _mm_set1_ps( octave.weightSouth ), blendSouth, _mm_set1_ps( octave.weightNorth ), blendNorth );
+	return _mm_mul_ps( _mm_set1_ps( 1.5f ), blendTotal );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+__m128 Compute3dPerlinOctaveLanes( __m128 currentX, const NoiseRowOctave& octave )
+{
+	const NoiseLanesX x = ComputeNoiseLanesX( currentX, octave );
+	const __m128 displacementFromMinY = _mm_set1_ps( octave.displacementFromMinY );
+	const __m128 displacementFromMaxY = _mm_set1_ps( octave.displacementFromMaxY );
+	const __m128 displacementFromMinZ = _mm_set1_ps( octave.displacementFromMinZ );
+	const __m128 displacementFromMaxZ = _mm_set1_ps( octave.displacementFromMaxZ );
+	const __m128 dotBelowSW = ComputePerlin3dCornerLanes( x.indexWest, octave.lattice[ 0 ], x.seed, x.displacementFromMinX, displacementFromMinY, displacementFromMinZ );
+	const __m128 dotBelowSE = ComputePerlin3dCornerLanes( x.indexEast, octave.lattice[ 0 ], x.seed, x.displacementFromMaxX, displacementFromMinY, displacementFromMinZ );
+	const __m128 dotBelowNW = ComputePerlin3dCornerLanes( x.indexWest, octave.lattice[ 1 ], x.seed, x.displacementFromMinX, displacementFromMaxY, displacementFromMinZ );
+	const __m128 dotBelowNE = ComputePerlin3dCornerLanes( x.indexEast, octave.lattice[ 1 ], x.seed, x.displacementFromMaxX, displacementFromMaxY, displacementFromMinZ );
+	const __m128 dotAboveSW = ComputePerlin3dCornerLanes( x.indexWest, octave.lattice[ 2 ], x.seed, x.displacementFromMinX, displacementFromMinY, displacementFromMaxZ );
+	const __m128 dotAboveSE = ComputePerlin3dCornerLanes( x.indexEast, octave.lattice[ 2 ], x.seed, x.displacementFromMaxX, displacementFromMinY, displacementFromMaxZ );
+	const __m128 dotAboveNW = ComputePerlin3dCornerLanes( x.indexWest, octave.lattice[ 3 ], x.seed, x.displacementFromMinX, displacementFromMaxY, displacementFromMaxZ );
+	const __m128 dotAboveNE = ComputePerlin3dCornerLanes( x.indexEast, octave.lattice[ 3 ], x.seed, x.displacementFromMaxX, displacementFromMaxY, displacementFromMaxZ );
+
+	const __m128 weightSouth = _mm_set1_ps( octave.weightSouth );
+	const __m128 weightNorth = _mm_set1_ps( octave.weightNorth );
+	const __m128 blendBelowSouth = Blend( x.weightEast, dotBelowSE, x.weightWest, dotBelowSW );
+	const __m128 blendBelowNorth = Blend( x.weightEast, dotBelowNE, x.weightWest, dotBelowNW );
+	const __m128 blendAboveSouth = Blend( x.weightEast, dotAboveSE, x.weightWest, dotAboveSW );
+	const __m128 blendAboveNorth = Blend( x.weightEast, dotAboveNE, x.weightWest, dotAboveNW );
+	const __m128 blendBelow = Blend( weightSouth, blendBelowSouth, weightNorth, blendBelowNorth );
+	const __m128 blendAbove = Blend( weightSouth, blendAboveSouth, weightNorth, blendAboveNorth );
+	const __m128 blendTotal = Blend( _mm_set1_ps( octave.weightBelow ), blendBelow, _mm_set1_ps( octave.weightAbove ), blendAbove );
+	return _mm_mul_ps( _mm_set1_ps( 1.66666666f ), blendTotal );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fills one row four samples at a time: the X half of the octave loop, then the renormalization.
+//
+template<typename OctaveFunction>
+void FillRowLanes( float* row, int width, float originX, float stepX, float scale, float octaveScale, bool renormalize, const std::vector<NoiseRowOctave>& octaves, float totalAmplitude, OctaveFunction computeOctave )
+{
+	const __m128 HALF = _mm_set1_ps( 0.5f );
+	const __m128 ONE = _mm_set1_ps( 1.f );
+	const __m128 TWO = _mm_set1_ps( 2.f );
+	const __m128 invScale = _mm_set1_ps( 1.f / scale );
+	const __m128 octaveScaleLanes = _mm_set1_ps( octaveScale );
+	const __m128 octaveOffset = _mm_set1_ps( OCTAVE_OFFSET );
+	const __m128 origin = _mm_set1_ps( originX );
+	const __m128 step = _mm_set1_ps( stepX );
+	const __m128i laneOffsets = _mm_setr_epi32( 0, 1, 2, 3 );
+	const bool applyRenormalize = renormalize && totalAmplitude > 0.f;
+
+	for( int i = 0; i < width; i += 4 )
+	{
+		const __m128 index = _mm_cvtepi32_ps( _mm_add_epi32( _mm_set1_epi32( i ), laneOffsets ) );
+		__m128 currentX = _mm_mul_ps( _mm_add_ps( origin, _mm_mul_ps( index, step ) ), invScale );
+		__m128 totalNoise = _mm_setzero_ps();
+		for( const NoiseRowOctave& octave : octaves )
+		{
+			totalNoise = _mm_add_ps( totalNoise, _mm_mul_ps( computeOctave( currentX, octave ), _mm_set1_ps( octave.amplitude ) ) );
+			currentX = _mm_add_ps( _mm_mul_ps( currentX, octaveScaleLanes ), octaveOffset );
+		}
+
+		if( applyRenormalize )
+		{
+			totalNoise = _mm_div_ps( totalNoise, _mm_set1_ps( totalAmplitude ) );
+			totalNoise = _mm_add_ps( _mm_mul_ps( totalNoise, HALF ), HALF );
+			totalNoise = SmoothStep3Lanes( totalNoise );
+			totalNoise = _mm_sub_ps( _mm_mul_ps( totalNoise, TWO ), ONE );
+		}
+
+		if( i + 4 <= width )
+		{
+			_mm_storeu_ps( row + i, totalNoise );
+		}
+		else
+		{
+			alignas( 16 ) float tail[ 4 ];
+			_mm_store_ps( tail, totalNoise );
+			std::copy_n( tail, width - i, row + i );
+		}
+	}
+}
+
+#endif
+
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Fill2dFractalNoise( std::span<float> out, const Vector2& origin, const Vector2& step, int width, int height, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, int firstRow, int rowCount )
+{
+	const int lastRow = GetLastGridRow( out.size(), width, width, height, firstRow, rowCount );
+#if defined( ENGINE_SIMD_SSE )
+	std::vector<NoiseRowOctave> octaves( numOctaves );
+#endif
+	for( int j = firstRow; j < lastRow; ++ j )
+	{
+		float* row = out.data() + static_cast<std::size_t>( j ) * width;
+		const float posY = origin.y + static_cast<float>( j ) * step.y;
+#if defined( ENGINE_SIMD_SSE )
+		const float totalAmplitude = SetupRowOctaves( octaves, posY, 0.f, false, scale, octavePersistence, octaveScale, seed );
+		FillRowLanes( row, width, origin.x, step.x, scale, octaveScale, renormalize, octaves, totalAmplitude, Compute2dFractalOctaveLanes );
+#else
+		for( int i = 0; i < width; ++ i )
+		{
+			row[ i ] = Compute2dFractalNoise( origin.x + static_cast<float>( i ) * step.x, posY, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+		}
+#endif
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Fill3dFractalNoise( std::span<float> out, const Vector3& origin, const Vector3& step, int width, int height, int depth, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, int firstSlice, int sliceCount )
+{
+	const int lastSlice = GetLastGridRow( out.size(), width, width * height, depth, firstSlice, sliceCount );
+#if defined( ENGINE_SIMD_SSE )
+	std::vector<NoiseRowOctave> octaves( numOctaves );
+#endif
+	for( int k = firstSlice; k < lastSlice; ++ k )
+	{
+		const float posZ = origin.z + static_cast<float>( k ) * step.z;
+		for( int j = 0; j < height; ++ j )
+		{
+			float* row = out.data() + ( static_cast<std::size_t>( k ) * height + j ) * width;
+			const float posY = origin.y + static_cast<float>( j ) * step.y;
+#if defined( ENGINE_SIMD_SSE )
+			const float totalAmplitude = SetupRowOctaves( octaves, posY, posZ, true, scale, octavePersistence, octaveScale, seed );
+			FillRowLanes( row, width, origin.x, step.x, scale, octaveScale, renormalize, octaves, totalAmplitude, Compute3dFractalOctaveLanes );
+#else
+			for( int i = 0; i < width; ++ i )
+			{
+				row[ i ] = Compute3dFractalNoise( origin.x + static_cast<float>( i ) * step.x, posY, posZ, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+			}
+#endif
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Fill2dPerlinNoise( std::span<float> out, const Vector2& origin, const Vector2& step, int width, int height, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, int firstRow, int rowCount )
+{
+	const int lastRow = GetLastGridRow( out.size(), width, width, height, firstRow, rowCount );
+#if defined( ENGINE_SIMD_SSE )
+	std::vector<NoiseRowOctave> octaves( numOctaves );
+#endif
+	for( int j = firstRow; j < lastRow; ++ j )
+	{
+		float* row = out.data() + static_cast<std::size_t>( j ) * width;
+		const float posY = origin.y + static_cast<float>( j ) * step.y;
+#if defined( ENGINE_SIMD_SSE )
+		const float totalAmplitude = SetupRowOctaves( octaves, posY, 0.f, false, scale, octavePersistence, octaveScale, seed );
+		FillRowLanes( row, width, origin.x, step.x, scale, octaveScale, renormalize, octaves, totalAmplitude, Compute2dPerlinOctaveLanes );
+#else
+		for( int i = 0; i < width; ++ i )
+		{
+			row[ i ] = Compute2dPerlinNoise( origin.x + static_cast<float>( i ) * step.x, posY, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+		}
+#endif
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Fill3dPerlinNoise( std::span<float> out, const Vector3& origin, const Vector3& step, int width, int height, int depth, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, int firstSlice, int sliceCount )
+{
+	const int lastSlice = GetLastGridRow( out.size(), width, width * height, depth, firstSlice, sliceCount );
+#if defined( ENGINE_SIMD_SSE )
+	std::vector<NoiseRowOctave> octaves( numOctaves );
+#endif
+	for( int k = firstSlice; k < lastSlice; ++ k )
+	{
+		const float posZ = origin.z + static_cast<float>( k ) * step.z;
+		for( int j = 0; j < height; ++ j )
+		{
+			float* row = out.data() + ( static_cast<std::size_t>( k ) * height + j ) * width;
+			const float posY = origin.y + static_cast<float>( j ) * step.y;
+#if defined( ENGINE_SIMD_SSE )
+			const float totalAmplitude = SetupRowOctaves( octaves, posY, posZ, true, scale, octavePersistence, octaveScale, seed );
+			FillRowLanes( row, width, origin.x, step.x, scale, octaveScale, renormalize, octaves, totalAmplitude, Compute3dPerlinOctaveLanes );
+#else
+			for( int i = 0; i < width; ++ i )
+			{
+				row[ i ] = Compute3dPerlinNoise( origin.x + static_cast<float>( i ) * step.x, posY, posZ, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+			}
+#endif
+		}
+	}
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Benchmark
+/////////////////////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+//-----------------------------------------------------------------------------------------------
+// Fills with each grid function and counts the samples that differ in any bit from the scalar function.
+//
+unsigned int CountGridMismatches( const Vector3& origin, const Vector3& step, int width, int height, int depth, float scale, unsigned int numOctaves, bool renormalize, unsigned int seed )
+{
+	const float persistence = 0.5f;
+	const float octaveScale = 2.f;
+	std::vector<float> grid2d( static_cast<std::size_t>( width ) * height );
+	std::vector<float> grid3d( static_cast<std::size_t>( width ) * height * depth );
+	unsigned int mismatches = 0;
+	auto compare = [&mismatches]( float actual, float expected ) {
+		mismatches += std::memcmp( &actual, &expected, sizeof( float ) ) != 0 ? 1u : 0u;
+	};
+
+	const Vector2 origin2d( origin.x, origin.y );
+	const Vector2 step2d( step.x, step.y );
+	Fill2dFractalNoise( grid2d, origin2d, step2d, width, height, scale, numOctaves, persistence, octaveScale, renormalize, seed );
+	for( int j = 0; j < height; ++ j )
+	{
+		for( int i = 0; i < width; ++ i )
+		{
+			compare( grid2d[ j * width + i ], Compute2dFractalNoise( origin.x + static_cast<float>( i ) * step.x, origin.y + static_cast<float>( j ) * step.y, scale, numOctaves, persistence, octaveScale, renormalize, seed ) );
+		}
+	}
+	Fill2dPerlinNoise( grid2d, origin2d, step2d, width, height, scale, numOctaves, persistence, octaveScale, renormalize, seed );
+	for( int j = 0; j < height; ++ j )
+	{
+		for( int i = 0; i < width; ++ i )
+		{
+			compare( grid2d[ j * width + i ], Compute2dPerlinNoise( origin.x + static_cast<float>( i ) * step.x, origin.y + static_cast<float>( j ) * step.y, scale, numOctaves, persistence, octaveScale, renormalize, seed ) );
+		}
+	}
+	Fill3dFractalNoise( grid3d, origin, step, width, height, depth, scale, numOctaves, persistence, octaveScale, renormalize, seed );
+	for( int k = 0; k < depth; ++ k )
+	{
+		for( int j = 0; j < height; ++ j )
+		{
+			for( int i = 0; i < width; ++ i )
+			{
+				compare( grid3d[ ( k * height + j ) * width + i ], Compute3dFractalNoise( origin.x + static_cast<float>( i ) * step.x, origin.y + static_cast<float>( j ) * step.y, origin.z + static_cast<float>( k ) * step.z, scale, numOctaves, persistence, octaveScale, renormalize, seed ) );
+			}
+		}
+	}
+	Fill3dPerlinNoise( grid3d, origin, step, width, height, depth, scale, numOctaves, persistence, octaveScale, renormalize, seed );
+	for( int k = 0; k < depth; ++ k )
+	{
+		for( int j = 0; j < height; ++ j )
+		{
+			for( int i = 0; i < width; ++ i )
+			{
+				compare( grid3d[ ( k * height + j ) * width + i ], Compute3dPerlinNoise( origin.x + static_cast<float>( i ) * step.x, origin.y + static_cast<float>( j ) * step.y, origin.z + static_cast<float>( k ) * step.z, scale, numOctaves, persistence, octaveScale, renormalize, seed ) );
+			}
+		}
+	}
+	return mismatches;
+}
 
+}
 
 
+//-----------------------------------------------------------------------------------------------
+void NoiseBenchmark( unsigned int iterations )
+{
+	// A terrain-like tile: four octaves with features about 64 samples across
+	const int WIDTH = 256;
+	const int HEIGHT = 256;
+	const int DEPTH = 16;
+	const float SCALE = 64.f;
+	const unsigned int OCTAVES = 4;
+	const Vector3 origin( -1024.f, 512.f, 8.f );
+	const Vector3 step( 1.f, 1.f, 1.f );
+	const Vector2 origin2d( origin.x, origin.y );
+	const Vector2 step2d( step.x, step.y );
+
+	std::vector<float> grid2d( static_cast<std::size_t>( WIDTH ) * HEIGHT );
+	std::vector<float> grid3d( static_cast<std::size_t>( WIDTH ) * HEIGHT * DEPTH );
+	float checksum = 0.f;
+	auto time_per_sample = [&]( std::size_t sampleCount, auto&& fill ) {
+		const unsigned int passes = (std::max)( 1u, static_cast<unsigned int>( iterations / sampleCount ) );
+		double start = GetCurrentTimeSeconds();
+		for( unsigned int pass = 0; pass < passes; ++ pass )
+		{
+			checksum += fill();
+		}
+		double seconds = GetCurrentTimeSeconds() - start;
+		return seconds * 1.0e9 / ( static_cast<double>( passes ) * sampleCount );
+	};
+	auto scalar2d = [&]( auto&& compute ) {
+		return [&, compute]() {
+			for( int j = 0; j < HEIGHT; ++ j )
+			{
+				for( int i = 0; i < WIDTH; ++ i )
+				{
+					grid2d[ j * WIDTH + i ] = compute( origin.x + static_cast<float>( i ) * step.x, origin.y + static_cast<float>( j ) * step.y );
+				}
+			}
+			return grid2d[ 0 ];
+		};
+	};
+	auto scalar3d = [&]( auto&& compute ) {
+		return [&, compute]() {
+			for( int k = 0; k < DEPTH; ++ k )
+			{
+				for( int j = 0; j < HEIGHT; ++ j )
+				{
+					for( int i = 0; i < WIDTH; ++ i )
+					{
+						grid3d[ ( k * HEIGHT + j ) * WIDTH + i ] = compute( origin.x + static_cast<float>( i ) * step.x, origin.y + static_cast<float>( j ) * step.y, origin.z + static_cast<float>( k ) * step.z );
+					}
+				}
+			}
+			return grid3d[ 0 ];
+		};
+	};
+
+	const std::size_t samples2d = grid2d.size();
+	const std::size_t samples3d = grid3d.size();
+	const double fractal2dScalarNs = time_per_sample( samples2d, scalar2d( [=]( float x, float y ) { return Compute2dFractalNoise( x, y, SCALE, OCTAVES ); } ) );
+	const double fractal2dGridNs = time_per_sample( samples2d, [&]() { Fill2dFractalNoise( grid2d, origin2d, step2d, WIDTH, HEIGHT, SCALE, OCTAVES ); return grid2d[ 0 ]; } );
+	const double perlin2dScalarNs = time_per_sample( samples2d, scalar2d( [=]( float x, float y ) { return Compute2dPerlinNoise( x, y, SCALE, OCTAVES ); } ) );
+	const double perlin2dGridNs = time_per_sample( samples2d, [&]() { Fill2dPerlinNoise( grid2d, origin2d, step2d, WIDTH, HEIGHT, SCALE, OCTAVES ); return grid2d[ 0 ]; } );
+	const double fractal3dScalarNs = time_per_sample( samples3d, scalar3d( [=]( float x, float y, float z ) { return Compute3dFractalNoise( x, y, z, SCALE, OCTAVES ); } ) );
+	const double fractal3dGridNs = time_per_sample( samples3d, [&]() { Fill3dFractalNoise( grid3d, origin, step, WIDTH, HEIGHT, DEPTH, SCALE, OCTAVES ); return grid3d[ 0 ]; } );
+	const double perlin3dScalarNs = time_per_sample( samples3d, scalar3d( [=]( float x, float y, float z ) { return Compute3dPerlinNoise( x, y, z, SCALE, OCTAVES ); } ) );
+	const double perlin3dGridNs = time_per_sample( samples3d, [&]() { Fill3dPerlinNoise( grid3d, origin, step, WIDTH, HEIGHT, DEPTH, SCALE, OCTAVES ); return grid3d[ 0 ]; } );
+
+	// One band of rows per job; the bands write disjoint rows of the same grid.
+	const int BAND_COUNT = 8;
+	const int bandRows = ( HEIGHT + BAND_COUNT - 1 ) / BAND_COUNT;
+	std::vector<float> banded( grid2d.size() );
+	auto fill_band = [&]( int band ) {
+		Fill2dPerlinNoise( banded, origin2d, step2d, WIDTH, HEIGHT, SCALE, OCTAVES, 0.5f, 2.f, true, 0, band * bandRows, bandRows );
+	};
+	const double perlin2dJobsNs = time_per_sample( samples2d, [&]() {
+		if( !g_theJobSystem )
+		{
+			for( int band = 0; band < BAND_COUNT; ++ band )
+			{
+				fill_band( band );
+			}
+			return banded[ 0 ];
+		}
+		std::vector<Job*> jobs;
+		for( int band = 0; band < BAND_COUNT; ++ band )
+		{
+			Job* job = JobSystem::Create( JobType::JOBTYPE_GENERIC, [&fill_band, band]( void* /*user_data*/ ) { fill_band( band ); }, nullptr );
+			JobSystem::Dispatch( job );
+			jobs.push_back( job );
+		}
+		for( Job* job : jobs )
+		{
+			JobSystem::WaitAndRelease( job );
+		}
+		return banded[ 0 ];
+	} );
+	Fill2dPerlinNoise( grid2d, origin2d, step2d, WIDTH, HEIGHT, SCALE, OCTAVES );
+	const unsigned int bandMismatches = grid2d == banded ? 0u : 1u;
+
+	// Odd widths exercise the partial last group; a small scale puts several cells between samples.
+	unsigned int mismatches = 0;
+	mismatches += CountGridMismatches( Vector3( -37.25f, 11.5f, -3.75f ), Vector3( 0.75f, 1.25f, 0.5f ), 67, 9, 5, 16.f, 5, true, 0 );
+	mismatches += CountGridMismatches( Vector3( 1000.5f, -2000.25f, 7.f ), Vector3( 3.5f, 2.f, 1.5f ), 33, 7, 3, 0.5f, 3, false, 17 );
+	mismatches += CountGridMismatches( Vector3( 0.f, 0.f, 0.f ), Vector3( -0.125f, 0.25f, -0.5f ), 5, 4, 4, 1.f, 1, true, 123456789 );
+
+	g_theFileLogger->LogTagf( "test", "Noise grid fills (%s), %u octaves, ns per sample, single-sample calls vs grid fill:\n", MathUtils::GetSimdInstructionSetName(), OCTAVES );
+	g_theFileLogger->LogTagf( "test", "  2D fractal %.1f vs %.1f, 2D Perlin %.1f vs %.1f (%d bands %s %.1f)\n", fractal2dScalarNs, fractal2dGridNs, perlin2dScalarNs, perlin2dGridNs, BAND_COUNT, g_theJobSystem ? "as jobs" : "in sequence", perlin2dJobsNs );
+	g_theFileLogger->LogTagf( "test", "  3D fractal %.1f vs %.1f, 3D Perlin %.1f vs %.1f\n", fractal3dScalarNs, fractal3dGridNs, perlin3dScalarNs, perlin3dGridNs );
+	g_theFileLogger->LogTagf( "test", "  Samples differing from the single-sample functions: %u. Banded grid differs: %u. (checksum %g)\n", mismatches, bandMismatches, checksum );
+	GUARANTEE_RECOVERABLE( mismatches == 0 && bandMismatches == 0, "Noise grid fills differ from the single-sample noise functions." );
+}
 
 
+//-----------------------------------------------------------------------------------------------
+void SimplexNoiseBenchmark( unsigned int iterations )
+{
+	// Same octave setup as NoiseBenchmark; positions walk diagonally so no two samples share a cell row
+	const float SCALE = 64.f;
+	const unsigned int OCTAVES = 4;
+	const Vector4 origin( -1024.f, 512.f, 8.f, 0.f );
+	const Vector4 step( 1.f, 0.61803398875f, 0.41421356237f, 0.0166666667f );
+	const unsigned int sampleCount = (std::max)( 1u, iterations );
+
+	struct NoiseStats
+	{
+		double nsPerSample = 0.0;
+		float minimum = 0.f;
+		float maximum = 0.f;
+	};
+	auto measure = [&]( auto&& compute ) {
+		NoiseStats stats;
+		stats.minimum = compute( origin.x, origin.y, origin.z, origin.w );
+		stats.maximum = stats.minimum;
+		double start = GetCurrentTimeSeconds();
+		for( unsigned int i = 0; i < sampleCount; ++ i )
+		{
+			float t = static_cast<float>( i );
+			float noise = compute( origin.x + t * step.x, origin.y + t * step.y, origin.z + t * step.z, origin.w + t * step.w );
+			stats.minimum = (std::min)( stats.minimum, noise );
+			stats.maximum = (std::max)( stats.maximum, noise );
+		}
+		double seconds = GetCurrentTimeSeconds() - start;
+		stats.nsPerSample = seconds * 1.0e9 / static_cast<double>( sampleCount );
+		return stats;
+	};
 
+	const NoiseStats fractal2d = measure( [=]( float x, float y, float, float ) { return Compute2dFractalNoise( x, y, SCALE, OCTAVES ); } );
+	const NoiseStats perlin2d = measure( [=]( float x, float y, float, float ) { return Compute2dPerlinNoise( x, y, SCALE, OCTAVES ); } );
+	const NoiseStats simplex2d = measure( [=]( float x, float y, float, float ) { return Compute2dSimplexNoise( x, y, SCALE, OCTAVES ); } );
+	const NoiseStats fractal3d = measure( [=]( float x, float y, float z, float ) { return Compute3dFractalNoise( x, y, z, SCALE, OCTAVES ); } );
+	const NoiseStats perlin3d = measure( [=]( float x, float y, float z, float ) { return Compute3dPerlinNoise( x, y, z, SCALE, OCTAVES ); } );
+	const NoiseStats simplex3d = measure( [=]( float x, float y, float z, float ) { return Compute3dSimplexNoise( x, y, z, SCALE, OCTAVES ); } );
+	const NoiseStats fractal4d = measure( [=]( float x, float y, float z, float t ) { return Compute4dFractalNoise( x, y, z, t, SCALE, OCTAVES ); } );
+	const NoiseStats perlin4d = measure( [=]( float x, float y, float z, float t ) { return Compute4dPerlinNoise( x, y, z, t, SCALE, OCTAVES ); } );
+	const NoiseStats simplex4d = measure( [=]( float x, float y, float z, float t ) { return Compute4dSimplexNoise( x, y, z, t, SCALE, OCTAVES ); } );
+
+	// One octave without renormalization shows the raw range each function was scaled to
+	const NoiseStats rawSimplex2d = measure( [=]( float x, float y, float, float ) { return Compute2dSimplexNoise( x, y, 1.f, 1, 0.5f, 2.f, false ); } );
+	const NoiseStats rawSimplex3d = measure( [=]( float x, float y, float z, float ) { return Compute3dSimplexNoise( x, y, z, 1.f, 1, 0.5f, 2.f, false ); } );
+	const NoiseStats rawSimplex4d = measure( [=]( float x, float y, float z, float t ) { return Compute4dSimplexNoise( x, y, z, t, 1.f, 1, 0.5f, 2.f, false ); } );
+
+	g_theFileLogger->LogTagf( "test", "Noise per dimension, %u octaves, %u samples each, ns per sample [min, max]:\n", OCTAVES, sampleCount );
+	const char* dimensionNames[ 3 ] = { "2D", "3D", "4D" };
+	const NoiseStats* results[ 3 ][ 3 ] = { { &fractal2d, &perlin2d, &simplex2d }, { &fractal3d, &perlin3d, &simplex3d }, { &fractal4d, &perlin4d, &simplex4d } };
+	for( int dimension = 0; dimension < 3; ++ dimension )
+	{
+		const NoiseStats& fractal = *results[ dimension ][ 0 ];
+		const NoiseStats& perlin = *results[ dimension ][ 1 ];
+		const NoiseStats& simplex = *results[ dimension ][ 2 ];
+		g_theFileLogger->LogTagf( "test", "  %s fractal %.1f [%.3f, %.3f], Perlin %.1f [%.3f, %.3f], simplex %.1f [%.3f, %.3f]\n", dimensionNames[ dimension ]
+			, fractal.nsPerSample, fractal.minimum, fractal.maximum
+			, perlin.nsPerSample, perlin.minimum, perlin.maximum
+			, simplex.nsPerSample, simplex.minimum, simplex.maximum );
+	}
+	g_theFileLogger->LogTagf( "test", "  Single-octave simplex without renormalization: 2D [%.3f, %.3f], 3D [%.3f, %.3f], 4D [%.3f, %.3f]\n"
+		, rawSimplex2d.minimum, rawSimplex2d.maximum, rawSimplex3d.minimum, rawSimplex3d.maximum, rawSimplex4d.minimum, rawSimplex4d.maximum );
+}
@@ -3,6 +3,11 @@
 //
 #pragma once
 
+#include <span>
+
+#include "Engine/Math/Vector2.hpp"
+#include "Engine/Math/Vector3.hpp"
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // Squirrel's Noise utilities (version 3)
 //
@@ -100,6 +105,28 @@ float Compute3dPerlinNoise( float posX, float posY, float posZ, float scale=1.f,
 float Compute4dPerlinNoise( float posX, float posY, float posZ, float posT, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
 
 
+//-----------------------------------------------------------------------------------------------
+// Grid fills of the fractal and Perlin noise above (random-access / deterministic)
+//
+// Fills a row-major grid, out[ i + width * ( j + height * k ) ], with the noise sampled at
+//	origin + ( i * step.x, j * step.y, k * step.z ).  Each sample matches the single-sample function
+//	called with the same position bit-for-bit, as long as positions stay within int range once scaled.
+//
+// Samples are evaluated four at a time along each row.  The octave setup and the Y/Z half of
+//	every lattice hash, weight and offset are computed once per row and shared by the whole row.
+//
+// <firstRow>/<rowCount>	Only fill these rows (2D) or slices (3D), so one grid can be split into
+//							jobs that write disjoint parts of <out>.  A negative count means "to the end".
+//
+void Fill2dFractalNoise( std::span<float> out, const Vector2& origin, const Vector2& step, int width, int height, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, int firstRow=0, int rowCount=-1 );
+void Fill3dFractalNoise( std::span<float> out, const Vector3& origin, const Vector3& step, int width, int height, int depth, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, int firstSlice=0, int sliceCount=-1 );
+void Fill2dPerlinNoise( std::span<float> out, const Vector2& origin, const Vector2& step, int width, int height, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, int firstRow=0, int rowCount=-1 );
+void Fill3dPerlinNoise( std::span<float> out, const Vector3& origin, const Vector3& step, int width, int height, int depth, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, int firstSlice=0, int sliceCount=-1 );
+
+// Times the grid fills against per-sample calls and warns if any sample differs; see the "noise_bench" console command.
+void NoiseBenchmark( unsigned int iterations );
+
+
 //-----------------------------------------------------------------------------------------------
 // Simplex noise functions (random-access / deterministic)
 //
@@ -108,10 +135,17 @@ float Compute4dPerlinNoise( float posX, float posY, float posZ, float posT, floa
 //	though, and examples of cross-sectional 4D simplex noise look worse to me than 4D Perlin.
 //
 // Simplex noise is based on a regular simplex (2D triangle, 3D tetrahedron, 4-simplex/5-cell)
-//	grid, which is a bit more fiddly, so I haven't written my own yet.
+//	grid, so each octave blends N+1 corners instead of Perlin's 2^N: 3 vs. 4 in 2D, 4 vs. 8 in 3D,
+//	and 5 vs. 16 in 4D, which makes it the cheap choice for animated (4D) noise.  It uses the same
+//	hashing and gradients as Perlin noise, and takes the same parameters.  There is no 1D version;
+//	1D simplex is just 1D Perlin.
 //
-// #TODO: Implement simplex noise in 2D, 3D, 4D (1D simplex is identical to 1D Perlin, I think?)
-// #TODO: Test actual simplex noise implementation in 2D/3D to compare speeds (branches vs. math!)
+float Compute2dSimplexNoise( float posX, float posY, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+float Compute3dSimplexNoise( float posX, float posY, float posZ, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+float Compute4dSimplexNoise( float posX, float posY, float posZ, float posT, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+
+// Times fractal vs. Perlin vs. simplex noise per dimension and logs each one's value range; see the "simplex_bench" console command.
+void SimplexNoiseBenchmark( unsigned int iterations );
 
 
 //-----------------------------------------------------------------------------------------------
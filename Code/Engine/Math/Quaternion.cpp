@@ -4,8 +4,24 @@
 #include "Engine/Math/MathUtils.hpp"
 
 #include "Engine/Math/Matrix4.hpp"
+#include "Engine/Math/Simd.hpp"
+#include "Engine/Math/Transform.hpp"
 
+#include "Engine/EngineConfig.hpp"
+
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#if defined(ENGINE_SIMD_SSE)
+//The SIMD paths load and store (w, x, y, z) as one register.
+static_assert(sizeof(Quaternion) == 4 * sizeof(float) && offsetof(Quaternion, axis) == sizeof(float), "Quaternion is not four packed floats.");
+#endif
 
 Quaternion::Quaternion()
     : w(1.0f)
@@ -16,85 +32,47 @@ Quaternion::Quaternion(const Matrix4& mat)
     : w(1.0f)
     , axis(Vector3::ZERO)
 {
-    //From http://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/
-
-    Vector4 diag = mat.GetDiagonal();
-    float trace = diag.x + diag.y + diag.z;
-
-    Vector3 row_zero =  Vector3(mat.GetIBasis());
-    Vector3 row_one =   Vector3(mat.GetJBasis());
-    Vector3 row_two =   Vector3(mat.GetKBasis());
-    Vector3 row_three = Vector3(mat.GetTBasis());
-
-    if (trace > 0.0f) {
-
-        float S = std::sqrt(1.0f + trace);
-
-        w = 0.5f * S;
-
-        float t = 0.5f / S;
-        axis.x = (row_two.y - row_one.z)  * t;
-        axis.y = (row_zero.z - row_two.x) * t;
-        axis.z = (row_one.x - row_zero.y) * t;
-
-    } else {
-
-        int i = 0;
-        if(row_one.y > row_zero.x) i = 1;
-        if(row_two.z > mat.GetIndex(i, i)) i = 2;
-
-        const int next[3] = { 1, 2, 0 };
-        int j = next[i];
-        int k = next[j];
-
-        float S = std::sqrt((mat.GetIndex(i, i) - (mat.GetIndex(j, j) + mat.GetIndex(k, k))) + 1.0f);
-
-        float* axisAsFloats = axis.GetAsFloatArray();
-
-        axisAsFloats[i] = S * 0.5f;
-        
-        float t = 0.0f;
-        if(!MathUtils::IsEquivalent(S, 0.0f)) {
-            t = 0.5f / S;
-        } else {
-            t = S;
-        }
-        w = (mat.GetIndex(k, j) - mat.GetIndex(j, k)) * t;
-        axisAsFloats[j] = (mat.GetIndex(j, i) + mat.GetIndex(i, j)) * t;
-        axisAsFloats[k] = (mat.GetIndex(k, i) + mat.GetIndex(i, k)) * t;
-        switch(i) {
-            case 0:
-                axis.x = axisAsFloats[i];
-                break;
-            case 1:
-                axis.y = axisAsFloats[i];
-                break;
-            case 2:
-                axis.z = axisAsFloats[i];
-                break;
-        }
-        switch(j) {
-            case 0:
-                axis.x = axisAsFloats[j];
-                break;
-            case 1:
-                axis.y = axisAsFloats[j];
-                break;
-            case 2:
-                axis.z = axisAsFloats[j];
-                break;
-        }
-        switch(k) {
-            case 0:
-                axis.x = axisAsFloats[k];
-                break;
-            case 1:
-                axis.y = axisAsFloats[k];
-                break;
-            case 2:
-                axis.z = axisAsFloats[k];
-                break;
-        }
+    //Shepperd's method: the diagonal gives 4q^2 for every component; the largest one is taken
+    //from its square root and the rest from off-diagonal sums divided by it, which keeps full
+    //precision for any rotation. The only branch is the choice of that component.
+    //The upper 3x3 must be a pure rotation; divide any scale out first.
+    const float* m = mat.m_indicies.data();
+    const float m00 = m[0];
+    const float m11 = m[5];
+    const float m22 = m[10];
+    const float four_w_sq = 1.0f + m00 + m11 + m22;
+    const float four_x_sq = 1.0f + m00 - m11 - m22;
+    const float four_y_sq = 1.0f - m00 + m11 - m22;
+    const float four_z_sq = 1.0f - m00 - m11 + m22;
+    int largest = 0;
+    float four_largest_sq = four_w_sq;
+    largest = four_x_sq > four_largest_sq ? 1 : largest;
+    four_largest_sq = (std::max)(four_largest_sq, four_x_sq);
+    largest = four_y_sq > four_largest_sq ? 2 : largest;
+    four_largest_sq = (std::max)(four_largest_sq, four_y_sq);
+    largest = four_z_sq > four_largest_sq ? 3 : largest;
+    four_largest_sq = (std::max)(four_largest_sq, four_z_sq);
+
+    const float root = std::sqrt(four_largest_sq);
+    const float half_root = 0.5f * root;
+    const float s = 0.5f / root;
+    switch(largest) {
+    case 0:
+        w = half_root;
+        axis = Vector3((m[9] - m[6]) * s, (m[2] - m[8]) * s, (m[4] - m[1]) * s);
+        break;
+    case 1:
+        w = (m[9] - m[6]) * s;
+        axis = Vector3(half_root, (m[1] + m[4]) * s, (m[2] + m[8]) * s);
+        break;
+    case 2:
+        w = (m[2] - m[8]) * s;
+        axis = Vector3((m[1] + m[4]) * s, half_root, (m[6] + m[9]) * s);
+        break;
+    default:
+        w = (m[4] - m[1]) * s;
+        axis = Vector3((m[2] + m[8]) * s, (m[6] + m[9]) * s, half_root);
+        break;
     }
     if(!MathUtils::IsEquivalent(CalcLengthSquared(), 1.0f)) {
         Normalize();
@@ -172,12 +150,25 @@ Quaternion& Quaternion::operator-=(const Quaternion& rhs) {
 }
 
 Quaternion Quaternion::operator*(const Quaternion& rhs) const {
+#if defined(ENGINE_SIMD_SSE)
+    //Lanes are (w, x, y, z). Each of this quaternion's components scales a permuted,
+    //sign-flipped copy of rhs; see the Hamilton product written out per component.
+    const __m128 a = _mm_loadu_ps(&this->w);
+    const __m128 b = _mm_loadu_ps(&rhs.w);
+    __m128 r = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b);
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f))));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f))));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(-0.0f, -0.0f, 0.0f, 0.0f))));
+    float q[4];
+    _mm_storeu_ps(q, r);
+    return Quaternion(q[0], q[1], q[2], q[3]);
+#else
     return Quaternion(this->w * rhs.w - MathUtils::DotProduct(this->axis, rhs.axis),
                       this->w * rhs.axis + rhs.w * this->axis + CrossProduct(this->axis, rhs.axis));
+#endif
 }
 Quaternion& Quaternion::operator*=(const Quaternion& rhs) {
-    this->w = this->w * rhs.w - MathUtils::DotProduct(this->axis, rhs.axis);
-    this->axis = this->w * rhs.axis + rhs.w * this->axis + CrossProduct(this->axis, rhs.axis);
+    *this = *this * rhs;
     return *this;
 }
 
@@ -186,7 +177,7 @@ Quaternion Quaternion::operator*(float scalar) const {
 }
 Quaternion& Quaternion::operator*=(float scalar) {
     this->w *= scalar;
-    this->axis *= axis;
+    this->axis *= scalar;
     return *this;
 }
 
@@ -367,6 +358,16 @@ void Quaternion::Inverse() {
     }
 }
 
+Vector3 Quaternion::Rotate(const Vector3& v) const {
+    //v + 2w(u x v) + 2u x (u x v), sharing the first cross product.
+    const float tx = 2.0f * (axis.y * v.z - axis.z * v.y);
+    const float ty = 2.0f * (axis.z * v.x - axis.x * v.z);
+    const float tz = 2.0f * (axis.x * v.y - axis.y * v.x);
+    return Vector3(v.x + w * tx + (axis.y * tz - axis.z * ty),
+                   v.y + w * ty + (axis.z * tx - axis.x * tz),
+                   v.z + w * tz + (axis.x * ty - axis.y * tx));
+}
+
 Quaternion Quaternion::CalcInverse() const {
     float lengthSq = CalcLengthSquared();
     Quaternion result;
@@ -500,28 +501,54 @@ Quaternion SLERP(const Quaternion& a, const Quaternion& b, float t) {
     end.Normalize();
 
     float dp = MathUtils::DotProduct(start, end);
+    const float sign = dp < 0.0f ? -1.0f : 1.0f;
+    dp = MathUtils::Clamp(dp * sign, 0.0f, 1.0f);
 
     //Really close together
     if(dp > 0.99995f) {
-        Quaternion result = MathUtils::Interpolate(start, end, t);
-        result.Normalize();
-        return result;
-    }
-
-    if(dp < 0.0f) {
-        end = -end;
-        dp = -dp;
+        return NLERP(start, end, t);
     }
 
-    dp = MathUtils::Clamp(dp, -1.0f, 1.0f);
-
-    float theta_0 = std::acos(dp);
-    float theta = theta_0 * t;
-
-    Quaternion result = end - start * dp;
-    result.Normalize();
+    //The weights are summed component-wise: the arithmetic operators renormalize their
+    //results, which would break the weighted sum.
+    const float theta_0 = std::acos(dp);
+    const float inv_sin_theta_0 = 1.0f / std::sin(theta_0);
+    const float wa = std::sin((1.0f - t) * theta_0) * inv_sin_theta_0;
+    const float wb = std::sin(t * theta_0) * inv_sin_theta_0 * sign;
+    return Quaternion(start.w * wa + end.w * wb,
+                      start.axis.x * wa + end.axis.x * wb,
+                      start.axis.y * wa + end.axis.y * wb,
+                      start.axis.z * wa + end.axis.z * wb);
+}
+
+Quaternion NLERP(const Quaternion& a, const Quaternion& b, float t) {
+    //q and -q are the same rotation; flipping b when the dot is negative takes the short way.
+    const float tb = std::copysign(t, a.w * b.w + a.axis.x * b.axis.x + a.axis.y * b.axis.y + a.axis.z * b.axis.z);
+    const float ta = 1.0f - t;
+    const float w = a.w * ta + b.w * tb;
+    const float x = a.axis.x * ta + b.axis.x * tb;
+    const float y = a.axis.y * ta + b.axis.y * tb;
+    const float z = a.axis.z * ta + b.axis.z * tb;
+    //Never zero: the blend of two unit quaternions on the same side has length >= sqrt(0.5).
+    const float inv_length = 1.0f / std::sqrt(w * w + x * x + y * y + z * z);
+    Quaternion result;
+    result.w = w * inv_length;
+    result.axis = Vector3(x * inv_length, y * inv_length, z * inv_length);
+    return result;
+}
 
-    return start * std::cos(theta) + result * std::sin(theta);
+/************************************************************************/
+/* https://zeux.io/2015/07/23/approximating-slerp/                      */
+/************************************************************************/
+Quaternion FastSLERP(const Quaternion& a, const Quaternion& b, float t) {
+    //NLERP moves fastest mid-way; the fitted correction depends on the angle between the
+    //inputs (through the dot product) and pulls t toward the ends to compensate.
+    const float d = std::fabs(a.w * b.w + a.axis.x * b.axis.x + a.axis.y * b.axis.y + a.axis.z * b.axis.z);
+    const float A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    const float B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    const float k = A * (t - 0.5f) * (t - 0.5f) + B;
+    const float corrected_t = t + t * (t - 0.5f) * (t - 1.0f) * k;
+    return NLERP(a, b, corrected_t);
 }
 
 Quaternion operator*(float scalar, const Quaternion& rhs) {
@@ -542,3 +569,116 @@ Quaternion& operator*=(const Vector3& lhs, Quaternion& rhs) {
     rhs = Quaternion(lhs) * rhs;
     return rhs;
 }
+
+/************************************************************************/
+/* BENCHMARK                                                            */
+/************************************************************************/
+namespace {
+
+//From the chord between the two (sign-matched) quaternions; acos of their dot product cannot
+//resolve angles below about 1e-3 radians in float.
+float CalcAngleBetween(const Quaternion& a, const Quaternion& b) {
+    const double sign = MathUtils::DotProduct(a, b) < 0.0f ? -1.0 : 1.0;
+    const double dw = a.w - sign * b.w;
+    const double dx = a.axis.x - sign * b.axis.x;
+    const double dy = a.axis.y - sign * b.axis.y;
+    const double dz = a.axis.z - sign * b.axis.z;
+    const double chord = std::sqrt(dw * dw + dx * dx + dy * dy + dz * dz);
+    return static_cast<float>(4.0 * std::asin((std::min)(1.0, 0.5 * chord)));
+}
+
+Quaternion CreateRandomRotation(std::mt19937& rng) {
+    //Normalized Gaussian 4-vectors are uniform over rotations.
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    return Quaternion(normal(rng), normal(rng), normal(rng), normal(rng)).GetNormalize();
+}
+
+}
+
+void QuaternionBenchmark(unsigned int iterations) {
+    constexpr std::size_t SAMPLE_COUNT = 1024;
+    std::mt19937 rng(1729);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> coord(-10.0f, 10.0f);
+
+    //Key pairs up to 180 degrees apart, as in sparse animation data, plus blend factors.
+    std::vector<Quaternion> starts(SAMPLE_COUNT);
+    std::vector<Quaternion> ends(SAMPLE_COUNT);
+    std::vector<float> ts(SAMPLE_COUNT);
+    std::vector<Vector3> vectors(SAMPLE_COUNT);
+    for(std::size_t i = 0; i < SAMPLE_COUNT; ++i) {
+        starts[i] = CreateRandomRotation(rng);
+        ends[i] = CreateRandomRotation(rng);
+        ts[i] = unit(rng);
+        vectors[i] = Vector3(coord(rng), coord(rng), coord(rng));
+    }
+
+    float max_nlerp_error = 0.0f;
+    float max_fast_slerp_error = 0.0f;
+    float max_conversion_error = 0.0f;
+    float max_rotate_error = 0.0f;
+    float max_multiply_error = 0.0f;
+    for(std::size_t i = 0; i < SAMPLE_COUNT; ++i) {
+        const Quaternion& a = starts[i];
+        const Quaternion& b = ends[i];
+        const Quaternion reference = SLERP(a, b, ts[i]);
+        max_nlerp_error = (std::max)(max_nlerp_error, CalcAngleBetween(reference, NLERP(a, b, ts[i])));
+        max_fast_slerp_error = (std::max)(max_fast_slerp_error, CalcAngleBetween(reference, FastSLERP(a, b, ts[i])));
+        max_conversion_error = (std::max)(max_conversion_error, CalcAngleBetween(a, Quaternion(Matrix4(a))));
+
+        const Vector3 rotated = a.Rotate(vectors[i]);
+        const Vector3 expected = Matrix4(a).TransformDirection(vectors[i]);
+        max_rotate_error = (std::max)(max_rotate_error, (rotated - expected).CalcLength() / vectors[i].CalcLength());
+
+        const Quaternion product = a * b;
+        const Quaternion expected_product(a.w * b.w - MathUtils::DotProduct(a.axis, b.axis), a.w * b.axis + b.w * a.axis + CrossProduct(a.axis, b.axis));
+        max_multiply_error = (std::max)(max_multiply_error, CalcAngleBetween(product, expected_product));
+    }
+
+    float checksum = 0.0f;
+    auto time_op = [&](auto&& op) {
+        double start = GetCurrentTimeSeconds();
+        for(unsigned int i = 0; i < iterations; ++i) {
+            checksum += op(i % SAMPLE_COUNT);
+        }
+        double seconds = GetCurrentTimeSeconds() - start;
+        return iterations ? seconds * 1.0e9 / iterations : 0.0;
+    };
+    const double slerp_ns = time_op([&](std::size_t i) { return SLERP(starts[i], ends[i], ts[i]).w; });
+    const double nlerp_ns = time_op([&](std::size_t i) { return NLERP(starts[i], ends[i], ts[i]).w; });
+    const double fast_slerp_ns = time_op([&](std::size_t i) { return FastSLERP(starts[i], ends[i], ts[i]).w; });
+    const double multiply_ns = time_op([&](std::size_t i) { return (starts[i] * ends[i]).w; });
+    const double rotate_ns = time_op([&](std::size_t i) { return starts[i].Rotate(vectors[i]).x; });
+    const double matrix_rotate_ns = time_op([&](std::size_t i) { return Matrix4(starts[i]).TransformDirection(vectors[i]).x; });
+    const double to_matrix_ns = time_op([&](std::size_t i) { return Matrix4(starts[i]).GetIBasis().x; });
+    const double from_matrix_ns = time_op([&](std::size_t i) { return Quaternion(Matrix4(starts[i])).w; }) - to_matrix_ns;
+
+    //One animated joint per iteration, the way MeshMotion::evaluate samples two keys.
+    std::vector<Matrix4> keys(SAMPLE_COUNT);
+    for(std::size_t i = 0; i < SAMPLE_COUNT; ++i) {
+        keys[i] = Transform(vectors[i], starts[i], Vector3(0.5f + unit(rng), 0.5f + unit(rng), 0.5f + unit(rng))).GetMatrix();
+    }
+    const double sample_ns = time_op([&](std::size_t i) {
+        const Transform start(keys[i]);
+        const Transform end(keys[(i + 1) % SAMPLE_COUNT]);
+        return Interpolate(start, end, ts[i]).GetMatrix().GetTranslation().x;
+    });
+    //The blend MeshMotion::evaluate used before: lerped basis matrices, which shear mid-way.
+    const double matrix_sample_ns = time_op([&](std::size_t i) {
+        const Matrix4& start = keys[i];
+        const Matrix4& end = keys[(i + 1) % SAMPLE_COUNT];
+        const Matrix4 start_rotation(start.GetIBasis(), start.GetJBasis(), start.GetKBasis(), Vector4::W_AXIS);
+        const Matrix4 end_rotation(end.GetIBasis(), end.GetJBasis(), end.GetKBasis(), Vector4::W_AXIS);
+        const Matrix4 T = Matrix4::CreateTranslationMatrix(Interpolate(start.GetTranslation(), end.GetTranslation(), ts[i]));
+        const Matrix4 R = MathUtils::Interpolate(start_rotation, end_rotation, ts[i]);
+        const Matrix4 S = Matrix4::CreateScaleMatrix(Interpolate(start.GetScale(), end.GetScale(), ts[i]));
+        return (T * R * S).GetTranslation().x;
+    });
+
+    const char* name = MathUtils::GetSimdInstructionSetName();
+    g_theFileLogger->LogTagf("test", "Quaternion %s paths, ns/call:\n", name);
+    g_theFileLogger->LogTagf("test", "  SLERP %.1f, NLERP %.1f, FastSLERP %.1f, multiply %.1f\n", slerp_ns, nlerp_ns, fast_slerp_ns, multiply_ns);
+    g_theFileLogger->LogTagf("test", "  rotate %.1f (through Matrix4 %.1f), to matrix %.1f, from matrix %.1f\n", rotate_ns, matrix_rotate_ns, to_matrix_ns, from_matrix_ns);
+    g_theFileLogger->LogTagf("test", "  animation sample (decompose two keys, blend, compose) %.1f per joint, previous matrix blend %.1f\n", sample_ns, matrix_sample_ns);
+    g_theFileLogger->LogTagf("test", "  Max error in radians against SLERP: NLERP %g, FastSLERP %g. Matrix round trip %g, multiply %g. Rotate relative error %g. (checksum %g)\n", max_nlerp_error, max_fast_slerp_error, max_conversion_error, max_multiply_error, max_rotate_error, checksum);
+}
@@ -67,6 +67,9 @@ public:
 
     void Inverse();
 
+    //v rotated by this quaternion without building a matrix. Assumes unit length.
+    Vector3 Rotate(const Vector3& v) const;
+
     friend Quaternion SLERP(const Quaternion& a, const Quaternion& b, float t);
 
 protected:
@@ -81,3 +84,14 @@ Quaternion& operator*=(const Vector3& lhs, Quaternion& rhs);
 
 Quaternion Conjugate(const Quaternion& q);
 Quaternion Inverse(const Quaternion& q);
+
+//Normalized linear interpolation along the shorter arc. Follows the same path as SLERP but
+//not at constant speed; the difference is negligible between nearby animation keys.
+Quaternion NLERP(const Quaternion& a, const Quaternion& b, float t);
+
+//NLERP with t corrected by a polynomial fit, which keeps it within about 1e-3 radians of
+//SLERP for any pair of rotations. No trigonometry, so it is several times cheaper.
+Quaternion FastSLERP(const Quaternion& a, const Quaternion& b, float t);
+
+//Times and checks the quaternion paths used for animation sampling. Results go to the log.
+void QuaternionBenchmark(unsigned int iterations);
@@ -0,0 +1,410 @@
+#include "Engine/Math/RandomEngine.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Engine/EngineConfig.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Simd.hpp"
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 is not three packed floats.");
+
+namespace {
+
+constexpr float TO_UNIT_FLOAT = 1.0f / 16777216.0f; //2^-24: the top 24 bits become [0, 1)
+constexpr float TO_SIGNED_UNIT_FLOAT = 1.0f / 8388608.0f; //2^-23: the top 24 bits become [0, 2)
+constexpr float MIN_NORMALIZE_LENGTH_SQUARED = 1.0e-4f;
+
+//SplitMix64: turns one 64-bit seed into well-mixed state words.
+std::uint64_t SplitMix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void SeedWords(std::uint64_t& mixer, std::uint32_t& s0, std::uint32_t& s1, std::uint32_t& s2, std::uint32_t& s3) {
+    const std::uint64_t low = SplitMix64(mixer);
+    const std::uint64_t high = SplitMix64(mixer);
+    s0 = static_cast<std::uint32_t>(low);
+    s1 = static_cast<std::uint32_t>(low >> 32);
+    s2 = static_cast<std::uint32_t>(high);
+    s3 = static_cast<std::uint32_t>(high >> 32);
+    //The all-zero state is the one fixed point of xoshiro.
+    if(!(s0 | s1 | s2 | s3)) {
+        s0 = 1u;
+    }
+}
+
+std::uint32_t Step(std::uint32_t& s0, std::uint32_t& s1, std::uint32_t& s2, std::uint32_t& s3) {
+    const std::uint32_t result = std::rotl(s1 * 5u, 7) * 9u;
+    const std::uint32_t t = s1 << 9;
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = std::rotl(s3, 11);
+    return result;
+}
+
+#if defined(ENGINE_SIMD_SSE)
+
+template<int K>
+__m128i RotateLeft(__m128i x) {
+    return _mm_or_si128(_mm_slli_epi32(x, K), _mm_srli_epi32(x, 32 - K));
+}
+
+//Step with SSE2 only: x * 5 and x * 9 are a shift and an add.
+__m128i StepLanes(__m128i (&s)[4]) {
+    const __m128i times_five = _mm_add_epi32(_mm_slli_epi32(s[1], 2), s[1]);
+    const __m128i rotated = RotateLeft<7>(times_five);
+    const __m128i result = _mm_add_epi32(_mm_slli_epi32(rotated, 3), rotated);
+    const __m128i t = _mm_slli_epi32(s[1], 9);
+    s[2] = _mm_xor_si128(s[2], s[0]);
+    s[3] = _mm_xor_si128(s[3], s[1]);
+    s[1] = _mm_xor_si128(s[1], s[2]);
+    s[0] = _mm_xor_si128(s[0], s[3]);
+    s[2] = _mm_xor_si128(s[2], t);
+    s[3] = RotateLeft<11>(s[3]);
+    return result;
+}
+
+//The top 24 bits as an exact float; below 2^31, so the signed conversion is fine.
+__m128 ToFloat24(__m128i bits) {
+    return _mm_cvtepi32_ps(_mm_srli_epi32(bits, 8));
+}
+
+void LoadLanes(const std::uint32_t (&lanes)[4][4], __m128i (&s)[4]) {
+    for(int word = 0; word < 4; ++word) {
+        s[word] = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes[word]));
+    }
+}
+
+void StoreLanes(const __m128i (&s)[4], std::uint32_t (&lanes)[4][4]) {
+    for(int word = 0; word < 4; ++word) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes[word]), s[word]);
+    }
+}
+
+#else
+
+void StepLanes(std::uint32_t (&lanes)[4][4], std::uint32_t (&out)[4]) {
+    for(int lane = 0; lane < 4; ++lane) {
+        out[lane] = Step(lanes[0][lane], lanes[1][lane], lanes[2][lane], lanes[3][lane]);
+    }
+}
+
+#endif
+
+}
+
+RandomEngine::RandomEngine(std::uint64_t seed, std::uint64_t stream /*= 0*/) {
+    Seed(seed, stream);
+}
+
+void RandomEngine::Seed(std::uint64_t seed, std::uint64_t stream /*= 0*/) {
+    //Mixing the stream in first keeps two streams from being shifted copies of each other.
+    std::uint64_t mixer = stream;
+    std::uint64_t mixer_state = seed ^ SplitMix64(mixer);
+    SeedWords(mixer_state, _state[0], _state[1], _state[2], _state[3]);
+    for(std::size_t lane = 0; lane < LANE_COUNT; ++lane) {
+        SeedWords(mixer_state, _lanes[0][lane], _lanes[1][lane], _lanes[2][lane], _lanes[3][lane]);
+    }
+}
+
+RandomEngine::result_type RandomEngine::operator()() {
+    return Step(_state[0], _state[1], _state[2], _state[3]);
+}
+
+std::uint32_t RandomEngine::NextBelow(std::uint32_t bound) {
+    ASSERT_OR_DIE(bound != 0u, "RandomEngine::NextBelow: bound is zero.");
+    //Lemire's multiply-shift. Rejecting the few low products below 2^32 mod bound removes the bias.
+    std::uint64_t product = std::uint64_t{(*this)()} * bound;
+    auto low = static_cast<std::uint32_t>(product);
+    if(low < bound) {
+        const std::uint32_t threshold = (0u - bound) % bound;
+        while(low < threshold) {
+            product = std::uint64_t{(*this)()} * bound;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+}
+
+float RandomEngine::NextFloat() {
+    return static_cast<float>((*this)() >> 8) * TO_UNIT_FLOAT;
+}
+
+double RandomEngine::NextDouble() {
+    const std::uint64_t high = (*this)() >> 5;
+    const std::uint64_t low = (*this)() >> 6;
+    return static_cast<double>((high << 26) | low) * (1.0 / 9007199254740992.0);
+}
+
+void RandomEngine::FillFloats(std::span<float> out, float minimumInclusive, float maximumExclusive) {
+    const float scale = (maximumExclusive - minimumInclusive) * TO_UNIT_FLOAT;
+    const std::size_t count = out.size();
+#if defined(ENGINE_SIMD_SSE)
+    __m128i s[4];
+    LoadLanes(_lanes, s);
+    const __m128 scale4 = _mm_set1_ps(scale);
+    const __m128 minimum4 = _mm_set1_ps(minimumInclusive);
+    std::size_t i = 0;
+    for(; i + LANE_COUNT <= count; i += LANE_COUNT) {
+        _mm_storeu_ps(out.data() + i, _mm_add_ps(_mm_mul_ps(ToFloat24(StepLanes(s)), scale4), minimum4));
+    }
+    if(i < count) {
+        alignas(16) float tail[LANE_COUNT];
+        _mm_store_ps(tail, _mm_add_ps(_mm_mul_ps(ToFloat24(StepLanes(s)), scale4), minimum4));
+        std::copy_n(tail, count - i, out.data() + i);
+    }
+    StoreLanes(s, _lanes);
+#else
+    for(std::size_t i = 0; i < count; i += LANE_COUNT) {
+        std::uint32_t bits[LANE_COUNT];
+        StepLanes(_lanes, bits);
+        for(std::size_t lane = 0; lane < LANE_COUNT && i + lane < count; ++lane) {
+            out[i + lane] = static_cast<float>(bits[lane] >> 8) * scale + minimumInclusive;
+        }
+    }
+#endif
+}
+
+void RandomEngine::FillPointsInCube(std::span<Vector3> out, float halfExtent) {
+    FillFloats(std::span<float>(reinterpret_cast<float*>(out.data()), out.size() * 3), -halfExtent, halfExtent);
+}
+
+void RandomEngine::FillPointsInSphere(std::span<Vector3> out, const Vector3& center, float radius) {
+    FillFromUnitBall(out, center, radius, false);
+}
+
+void RandomEngine::FillUnitVectors(std::span<Vector3> out) {
+    FillFromUnitBall(out, Vector3::ZERO, 1.0f, true);
+}
+
+void RandomEngine::FillFromUnitBall(std::span<Vector3> out, const Vector3& center, float radius, bool normalize) {
+    //Rejection sampling from the enclosing cube accepts about 52% of candidates, four at a
+    //time. Normalizing the accepted points is uniform over the sphere's surface.
+    const std::size_t count = out.size();
+    float* dest = reinterpret_cast<float*>(out.data());
+    std::size_t written = 0;
+#if defined(ENGINE_SIMD_SSE)
+    __m128i s[4];
+    LoadLanes(_lanes, s);
+    const __m128 to_signed = _mm_set1_ps(TO_SIGNED_UNIT_FLOAT);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 min_length_sq = _mm_set1_ps(MIN_NORMALIZE_LENGTH_SQUARED);
+    const __m128 radius4 = _mm_set1_ps(radius);
+    const __m128 cx = _mm_set1_ps(center.x);
+    const __m128 cy = _mm_set1_ps(center.y);
+    const __m128 cz = _mm_set1_ps(center.z);
+    while(written < count) {
+        const __m128 x = _mm_sub_ps(_mm_mul_ps(ToFloat24(StepLanes(s)), to_signed), one);
+        const __m128 y = _mm_sub_ps(_mm_mul_ps(ToFloat24(StepLanes(s)), to_signed), one);
+        const __m128 z = _mm_sub_ps(_mm_mul_ps(ToFloat24(StepLanes(s)), to_signed), one);
+        const __m128 length_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        int accepted = _mm_movemask_ps(_mm_cmple_ps(length_sq, one));
+        if(normalize) {
+            accepted &= _mm_movemask_ps(_mm_cmpgt_ps(length_sq, min_length_sq));
+        }
+        if(!accepted) {
+            continue;
+        }
+        const __m128 scale = normalize ? _mm_div_ps(one, _mm_sqrt_ps(length_sq)) : radius4;
+        alignas(16) float xs[LANE_COUNT];
+        alignas(16) float ys[LANE_COUNT];
+        alignas(16) float zs[LANE_COUNT];
+        _mm_store_ps(xs, _mm_add_ps(_mm_mul_ps(x, scale), cx));
+        _mm_store_ps(ys, _mm_add_ps(_mm_mul_ps(y, scale), cy));
+        _mm_store_ps(zs, _mm_add_ps(_mm_mul_ps(z, scale), cz));
+        if(written + LANE_COUNT <= count) {
+            //Branchless compaction: every lane is written, only accepted ones are kept.
+            for(std::size_t lane = 0; lane < LANE_COUNT; ++lane) {
+                dest[3 * written + 0] = xs[lane];
+                dest[3 * written + 1] = ys[lane];
+                dest[3 * written + 2] = zs[lane];
+                written += (accepted >> lane) & 1;
+            }
+            continue;
+        }
+        for(std::size_t lane = 0; lane < LANE_COUNT && written < count; ++lane) {
+            if(accepted & (1 << lane)) {
+                dest[3 * written + 0] = xs[lane];
+                dest[3 * written + 1] = ys[lane];
+                dest[3 * written + 2] = zs[lane];
+                ++written;
+            }
+        }
+    }
+    StoreLanes(s, _lanes);
+#else
+    while(written < count) {
+        std::uint32_t x_bits[LANE_COUNT];
+        std::uint32_t y_bits[LANE_COUNT];
+        std::uint32_t z_bits[LANE_COUNT];
+        StepLanes(_lanes, x_bits);
+        StepLanes(_lanes, y_bits);
+        StepLanes(_lanes, z_bits);
+        for(std::size_t lane = 0; lane < LANE_COUNT && written < count; ++lane) {
+            const float x = static_cast<float>(x_bits[lane] >> 8) * TO_SIGNED_UNIT_FLOAT - 1.0f;
+            const float y = static_cast<float>(y_bits[lane] >> 8) * TO_SIGNED_UNIT_FLOAT - 1.0f;
+            const float z = static_cast<float>(z_bits[lane] >> 8) * TO_SIGNED_UNIT_FLOAT - 1.0f;
+            const float length_sq = x * x + y * y + z * z;
+            if(!(length_sq <= 1.0f) || (normalize && !(length_sq > MIN_NORMALIZE_LENGTH_SQUARED))) {
+                continue;
+            }
+            const float scale = normalize ? 1.0f / std::sqrt(length_sq) : radius;
+            dest[3 * written + 0] = x * scale + center.x;
+            dest[3 * written + 1] = y * scale + center.y;
+            dest[3 * written + 2] = z * scale + center.z;
+            ++written;
+        }
+    }
+#endif
+}
+
+/************************************************************************/
+/* BENCHMARK                                                            */
+/************************************************************************/
+void RandomBenchmark(unsigned int iterations) {
+    constexpr std::size_t BATCH_SIZE = 1024;
+    const unsigned int batch_count = iterations / BATCH_SIZE + 1u;
+    RandomEngine engine(1729);
+
+    std::vector<float> floats(BATCH_SIZE);
+    std::vector<Vector3> vectors(BATCH_SIZE);
+    float checksum = 0.0f;
+    auto time_per_result = [&](std::size_t results, auto&& op) {
+        double start = GetCurrentTimeSeconds();
+        op();
+        double seconds = GetCurrentTimeSeconds() - start;
+        return results ? seconds * 1.0e9 / results : 0.0;
+    };
+
+    //What the MathUtils helpers did before: std::rand for floats, a shared minstd_rand behind
+    //std::uniform_real_distribution for doubles, and a scalar rejection loop for spheres.
+    const double rand_ns = time_per_result(iterations, [&]() {
+        for(unsigned int i = 0; i < iterations; ++i) {
+            checksum += static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+        }
+    });
+    std::minstd_rand minstd(1729);
+    const double minstd_ns = time_per_result(iterations, [&]() {
+        std::uniform_real_distribution<float> dist;
+        for(unsigned int i = 0; i < iterations; ++i) {
+            checksum += dist(minstd);
+        }
+    });
+    const double next_ns = time_per_result(iterations, [&]() {
+        for(unsigned int i = 0; i < iterations; ++i) {
+            checksum += engine.NextFloat();
+        }
+    });
+    const double thread_local_ns = time_per_result(iterations, [&]() {
+        for(unsigned int i = 0; i < iterations; ++i) {
+            checksum += MathUtils::GetRandomFloatZeroToOne();
+        }
+    });
+    const double fill_ns = time_per_result(batch_count * BATCH_SIZE, [&]() {
+        for(unsigned int i = 0; i < batch_count; ++i) {
+            engine.FillFloats(floats, 0.0f, 1.0f);
+            checksum += floats[i % BATCH_SIZE];
+        }
+    });
+    const double sphere_ns = time_per_result(iterations, [&]() {
+        for(unsigned int i = 0; i < iterations; ++i) {
+            checksum += MathUtils::GetRandomPointInSphere(Vector3::ZERO, 1.0f).x;
+        }
+    });
+    const double fill_sphere_ns = time_per_result(batch_count * BATCH_SIZE, [&]() {
+        for(unsigned int i = 0; i < batch_count; ++i) {
+            engine.FillPointsInSphere(vectors, Vector3::ZERO, 1.0f);
+            checksum += vectors[i % BATCH_SIZE].x;
+        }
+    });
+    const double fill_unit_ns = time_per_result(batch_count * BATCH_SIZE, [&]() {
+        for(unsigned int i = 0; i < batch_count; ++i) {
+            engine.FillUnitVectors(vectors);
+            checksum += vectors[i % BATCH_SIZE].x;
+        }
+    });
+
+    //Distribution checks. A uniform [0, 1) has mean 1/2 and variance 1/12; unit vectors
+    //uniform over the sphere average to zero.
+    constexpr std::size_t CHECK_COUNT = 1u << 20;
+    std::vector<float> check_floats(CHECK_COUNT);
+    engine.FillFloats(check_floats, 0.0f, 1.0f);
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    float min_float = 1.0f;
+    float max_float = 0.0f;
+    for(float f : check_floats) {
+        sum += f;
+        sum_sq += static_cast<double>(f) * f;
+        min_float = (std::min)(min_float, f);
+        max_float = (std::max)(max_float, f);
+    }
+    const double mean = sum / CHECK_COUNT;
+    const double variance = sum_sq / CHECK_COUNT - mean * mean;
+
+    std::vector<Vector3> check_vectors(CHECK_COUNT / 4);
+    engine.FillUnitVectors(check_vectors);
+    float max_unit_error = 0.0f;
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+    double mean_z = 0.0;
+    for(const Vector3& v : check_vectors) {
+        max_unit_error = (std::max)(max_unit_error, std::abs(v.CalcLength() - 1.0f));
+        mean_x += v.x;
+        mean_y += v.y;
+        mean_z += v.z;
+    }
+    const double unit_bias = std::sqrt(mean_x * mean_x + mean_y * mean_y + mean_z * mean_z) / check_vectors.size();
+
+    const Vector3 center(3.0f, -2.0f, 1.0f);
+    engine.FillPointsInSphere(check_vectors, center, 2.0f);
+    float max_sphere_distance = 0.0f;
+    for(const Vector3& v : check_vectors) {
+        max_sphere_distance = (std::max)(max_sphere_distance, (v - center).CalcLength());
+    }
+
+    //Same seed and stream replay exactly; another stream does not.
+    RandomEngine replay_a(42, 7);
+    RandomEngine replay_b(42, 7);
+    RandomEngine other_stream(42, 8);
+    unsigned int replay_mismatches = 0;
+    unsigned int stream_matches = 0;
+    for(int i = 0; i < 1000; ++i) {
+        const std::uint32_t a = replay_a();
+        replay_mismatches += a != replay_b() ? 1u : 0u;
+        stream_matches += a == other_stream() ? 1u : 0u;
+    }
+    std::vector<float> replay_floats(BATCH_SIZE);
+    replay_a.FillFloats(floats, -5.0f, 5.0f);
+    replay_b.FillFloats(replay_floats, -5.0f, 5.0f);
+    replay_mismatches += floats == replay_floats ? 0u : 1u;
+
+    const char* name = MathUtils::GetSimdInstructionSetName();
+    g_theFileLogger->LogTagf("test", "RandomEngine %s paths, ns per result:\n", name);
+    g_theFileLogger->LogTagf("test", "  float: std::rand %.2f, minstd_rand + distribution %.2f, NextFloat %.2f, thread-local GetRandomFloatZeroToOne %.2f, FillFloats %.2f\n", rand_ns, minstd_ns, next_ns, thread_local_ns, fill_ns);
+    g_theFileLogger->LogTagf("test", "  point in sphere: GetRandomPointInSphere %.2f, FillPointsInSphere %.2f, FillUnitVectors %.2f\n", sphere_ns, fill_sphere_ns, fill_unit_ns);
+    g_theFileLogger->LogTagf("test", "  FillFloats over %u: mean %.5f (0.5), variance %.5f (0.08333), range [%g, %g]\n", static_cast<unsigned int>(CHECK_COUNT), mean, variance, min_float, max_float);
+    g_theFileLogger->LogTagf("test", "  FillUnitVectors: max length error %g, mean vector length %g. FillPointsInSphere radius 2: max distance %g\n", max_unit_error, unit_bias, max_sphere_distance);
+    g_theFileLogger->LogTagf("test", "  Replay mismatches %u, matches across streams %u. (checksum %g)\n", replay_mismatches, stream_matches, checksum);
+    //Limits are several standard errors wide for these sample sizes.
+    GUARANTEE_RECOVERABLE(replay_mismatches == 0u && stream_matches < 4u, "RandomEngine seeds or streams do not replay as documented.");
+    GUARANTEE_RECOVERABLE(min_float >= 0.0f && max_float < 1.0f && std::abs(mean - 0.5) < 0.002 && std::abs(variance - 1.0 / 12.0) < 0.002, "RandomEngine::FillFloats is not uniform in [0, 1).");
+    GUARANTEE_RECOVERABLE(max_unit_error < 1.0e-4f && unit_bias < 0.01, "RandomEngine::FillUnitVectors is not uniform over the unit sphere.");
+    GUARANTEE_RECOVERABLE(max_sphere_distance <= 2.0f * (1.0f + 1.0e-5f), "RandomEngine::FillPointsInSphere returned a point outside the sphere.");
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "Engine/Math/Vector3.hpp"
+
+//xoshiro128** (Blackman and Vigna): 128 bits of state, period 2^128 - 1 and a handful of
+//shifts, rotates and adds per 32-bit result. Satisfies UniformRandomBitGenerator, so the
+//std distributions accept it.
+//An instance is not thread safe; MathUtils::GetRandomEngine hands out one per thread.
+//The same seed and stream always produce the same sequence, on every platform.
+class RandomEngine {
+public:
+    using result_type = std::uint32_t;
+
+    static constexpr result_type min() { return 0u; }
+    static constexpr result_type max() { return (std::numeric_limits<result_type>::max)(); }
+
+    //Streams with the same seed are independent sequences, e.g. one per job worker.
+    explicit RandomEngine(std::uint64_t seed, std::uint64_t stream = 0);
+    ~RandomEngine() = default;
+
+    void Seed(std::uint64_t seed, std::uint64_t stream = 0);
+
+    result_type operator()();
+
+    //Uniform in [0, bound) without modulo bias. bound must not be zero.
+    std::uint32_t NextBelow(std::uint32_t bound);
+    //Uniform in [0, 1) with 24 and 53 random bits respectively.
+    float NextFloat();
+    double NextDouble();
+
+    //The batch fills draw from four interleaved generators, stepped together in one SSE
+    //register, so they do not advance the scalar sequence above. Both builds produce the same
+    //values. Leftover results from the last group of four are discarded.
+    //Floats are uniform in [minimumInclusive, maximumExclusive), like NextFloat.
+    void FillFloats(std::span<float> out, float minimumInclusive, float maximumExclusive);
+    void FillPointsInCube(std::span<Vector3> out, float halfExtent);
+    void FillPointsInSphere(std::span<Vector3> out, const Vector3& center, float radius);
+    void FillUnitVectors(std::span<Vector3> out);
+
+protected:
+private:
+    static constexpr std::size_t LANE_COUNT = 4;
+
+    void FillFromUnitBall(std::span<Vector3> out, const Vector3& center, float radius, bool normalize);
+
+    std::uint32_t _state[4]{};
+    //Indexed [word][lane] so each word of all four lanes loads as one register.
+    alignas(16) std::uint32_t _lanes[4][LANE_COUNT]{};
+};
+
+void RandomBenchmark(unsigned int iterations);
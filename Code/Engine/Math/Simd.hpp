@@ -0,0 +1,31 @@
+#pragma once
+
+//Compile-time instruction set selection for the math kernels.
+//SSE2 is part of x64, so ENGINE_SIMD_SSE is on for every 64-bit build. ENGINE_SIMD_AVX
+//follows the compiler's target (/arch:AVX or higher). Define ENGINE_NO_SIMD to build the
+//scalar paths instead, e.g. to compare results.
+#if !defined(ENGINE_NO_SIMD) && (defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define ENGINE_SIMD_SSE
+#if defined(__AVX__)
+#define ENGINE_SIMD_AVX
+#endif
+#endif
+
+#if defined(ENGINE_SIMD_SSE)
+#include <immintrin.h>
+#endif
+
+namespace MathUtils {
+
+//Name of the kernels this build selected, for logs and benchmarks.
+constexpr const char* GetSimdInstructionSetName() {
+#if defined(ENGINE_SIMD_AVX)
+    return "AVX";
+#elif defined(ENGINE_SIMD_SSE)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+}
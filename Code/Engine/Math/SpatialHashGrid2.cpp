@@ -0,0 +1,535 @@
+#include "Engine/Math/SpatialHashGrid2.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#include "Engine/EngineConfig.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include "Engine/Math/Capsule2.hpp"
+#include "Engine/Math/Disc2.hpp"
+#include "Engine/Math/LineSegment2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomEngine.hpp"
+
+namespace {
+
+//Below these a job costs more than the work it takes off the calling thread.
+constexpr std::size_t MIN_ITEMS_PER_JOB = 4096;
+constexpr std::size_t MIN_BUCKETS_PER_JOB = 8192;
+constexpr std::size_t MIN_QUERIES_PER_JOB = 256;
+
+//Slab test along start + t * displacement for t in [0, 1]. Axes the segment does not move
+//along are tested directly, so no infinities meet a zero-width slab.
+bool DoesSegmentHitAABB2(const Vector2& start, const Vector2& displacement, const AABB2& box) {
+    float t_min = 0.0f;
+    float t_max = 1.0f;
+    const float starts[2] = {start.x, start.y};
+    const float displacements[2] = {displacement.x, displacement.y};
+    const float mins[2] = {box.mins.x, box.mins.y};
+    const float maxs[2] = {box.maxs.x, box.maxs.y};
+    for(std::size_t axis = 0; axis < 2; ++axis) {
+        if(displacements[axis] == 0.0f) {
+            if(starts[axis] < mins[axis] || maxs[axis] < starts[axis]) {
+                return false;
+            }
+            continue;
+        }
+        const float inv_displacement = 1.0f / displacements[axis];
+        const float t1 = (mins[axis] - starts[axis]) * inv_displacement;
+        const float t2 = (maxs[axis] - starts[axis]) * inv_displacement;
+        t_min = (std::max)(t_min, (std::min)(t1, t2));
+        t_max = (std::min)(t_max, (std::max)(t1, t2));
+    }
+    return t_min <= t_max;
+}
+
+} // namespace
+
+SpatialHashGrid2::SpatialHashGrid2(float cell_size /*= 1.0f*/) {
+    SetCellSize(cell_size);
+    Clear();
+}
+
+void SpatialHashGrid2::Build(std::span<const AABB2> bounds) {
+    _bounds.assign(bounds.begin(), bounds.end());
+    BuildFromBounds();
+}
+
+void SpatialHashGrid2::Build(std::span<const Disc2> discs) {
+    _bounds.resize(discs.size());
+    JobSystem::ForEachSlice(discs.size(), JobSystem::CalcSliceCount(discs.size(), MIN_ITEMS_PER_JOB), [this, discs](std::size_t begin, std::size_t end, std::size_t /*job*/) {
+        for(std::size_t i = begin; i < end; ++i) {
+            _bounds[i] = AABB2(discs[i].center, discs[i].radius, discs[i].radius);
+        }
+    });
+    BuildFromBounds();
+}
+
+void SpatialHashGrid2::Build(std::span<const Capsule2> capsules) {
+    _bounds.resize(capsules.size());
+    JobSystem::ForEachSlice(capsules.size(), JobSystem::CalcSliceCount(capsules.size(), MIN_ITEMS_PER_JOB), [this, capsules](std::size_t begin, std::size_t end, std::size_t /*job*/) {
+        for(std::size_t i = begin; i < end; ++i) {
+            const Capsule2& capsule = capsules[i];
+            const Vector2& a = capsule.line.start;
+            const Vector2& b = capsule.line.end;
+            _bounds[i] = AABB2((std::min)(a.x, b.x) - capsule.radius, (std::min)(a.y, b.y) - capsule.radius,
+                               (std::max)(a.x, b.x) + capsule.radius, (std::max)(a.y, b.y) + capsule.radius);
+        }
+    });
+    BuildFromBounds();
+}
+
+void SpatialHashGrid2::Clear() {
+    _bounds.clear();
+    _item_cells.clear();
+    _entries.clear();
+    _bucket_starts.assign(2, 0u);
+    _bucket_mask = 0;
+}
+
+void SpatialHashGrid2::SetCellSize(float cell_size) {
+    ASSERT_OR_DIE(cell_size > 0.0f, "SpatialHashGrid2 cell size must be positive.");
+    _cell_size = cell_size;
+    _inv_cell_size = 1.0f / cell_size;
+}
+
+float SpatialHashGrid2::GetCellSize() const {
+    return _cell_size;
+}
+
+std::size_t SpatialHashGrid2::GetItemCount() const {
+    return _bounds.size();
+}
+
+std::size_t SpatialHashGrid2::GetEntryCount() const {
+    return _entries.size();
+}
+
+const AABB2& SpatialHashGrid2::GetBounds(int item) const {
+    return _bounds[static_cast<std::size_t>(item)];
+}
+
+void SpatialHashGrid2::BuildFromBounds() {
+    const std::size_t item_count = _bounds.size();
+    _item_cells.resize(item_count);
+    const std::size_t item_jobs = JobSystem::CalcSliceCount(item_count, MIN_ITEMS_PER_JOB);
+
+    //Pass 1: the cells each item covers, and how many entries that makes.
+    std::vector<std::size_t> job_entry_counts(item_jobs, 0);
+    JobSystem::ForEachSlice(item_count, item_jobs, [this, &job_entry_counts](std::size_t begin, std::size_t end, std::size_t job) {
+        std::size_t entry_count = 0;
+        for(std::size_t i = begin; i < end; ++i) {
+            const CellRange range = CalcCellRange(_bounds[i]);
+            _item_cells[i] = range;
+            entry_count += static_cast<std::size_t>(range.max_x - range.min_x + 1) * static_cast<std::size_t>(range.max_y - range.min_y + 1);
+        }
+        job_entry_counts[job] = entry_count;
+    });
+    std::size_t entry_count = 0;
+    for(std::size_t count : job_entry_counts) {
+        entry_count += count;
+    }
+    ASSERT_OR_DIE(entry_count < (std::numeric_limits<std::uint32_t>::max)(), "SpatialHashGrid2 has too many entries; raise the cell size.");
+
+    //About two buckets per entry keeps unrelated cells from sharing one.
+    std::size_t bucket_count = 64;
+    while(bucket_count < 2 * entry_count) {
+        bucket_count *= 2;
+    }
+    _bucket_mask = static_cast<std::uint32_t>(bucket_count - 1);
+
+    //Pass 2: count the entries per bucket, one slot ahead so the prefix sum lands in place.
+    _bucket_starts.assign(bucket_count + 1, 0u);
+    JobSystem::ForEachSlice(item_count, item_jobs, [this, item_jobs](std::size_t begin, std::size_t end, std::size_t /*job*/) {
+        for(std::size_t i = begin; i < end; ++i) {
+            const CellRange& range = _item_cells[i];
+            for(int y = range.min_y; y <= range.max_y; ++y) {
+                for(int x = range.min_x; x <= range.max_x; ++x) {
+                    std::uint32_t& count = _bucket_starts[CalcBucket(x, y) + 1];
+                    if(item_jobs == 1) {
+                        ++count;
+                    } else {
+                        std::atomic_ref<std::uint32_t>(count).fetch_add(1u, std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+    });
+    for(std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+        _bucket_starts[bucket + 1] += _bucket_starts[bucket];
+    }
+
+    //Pass 3: scatter the entries into their buckets.
+    _entries.resize(entry_count);
+    _bucket_cursors.assign(_bucket_starts.begin(), _bucket_starts.end() - 1);
+    JobSystem::ForEachSlice(item_count, item_jobs, [this, item_jobs](std::size_t begin, std::size_t end, std::size_t /*job*/) {
+        for(std::size_t i = begin; i < end; ++i) {
+            const CellRange& range = _item_cells[i];
+            for(int y = range.min_y; y <= range.max_y; ++y) {
+                for(int x = range.min_x; x <= range.max_x; ++x) {
+                    std::uint32_t& cursor = _bucket_cursors[CalcBucket(x, y)];
+                    const std::uint32_t slot = item_jobs == 1 ? cursor++ : std::atomic_ref<std::uint32_t>(cursor).fetch_add(1u, std::memory_order_relaxed);
+                    _entries[slot] = Entry{static_cast<int>(i), x, y};
+                }
+            }
+        }
+    });
+
+    //Pass 4: order each bucket by cell and item, which groups cells that share a bucket and
+    //makes the result independent of how the scatter was split into jobs.
+    JobSystem::ForEachSlice(bucket_count, JobSystem::CalcSliceCount(bucket_count, MIN_BUCKETS_PER_JOB), [this](std::size_t begin, std::size_t end, std::size_t /*job*/) {
+        for(std::size_t bucket = begin; bucket < end; ++bucket) {
+            Entry* first = _entries.data() + _bucket_starts[bucket];
+            Entry* last = _entries.data() + _bucket_starts[bucket + 1];
+            std::sort(first, last);
+        }
+    });
+}
+
+SpatialHashGrid2::CellRange SpatialHashGrid2::CalcCellRange(const AABB2& bounds) const {
+    CellRange range{};
+    range.min_x = static_cast<int>(std::floor(bounds.mins.x * _inv_cell_size));
+    range.min_y = static_cast<int>(std::floor(bounds.mins.y * _inv_cell_size));
+    range.max_x = static_cast<int>(std::floor(bounds.maxs.x * _inv_cell_size));
+    range.max_y = static_cast<int>(std::floor(bounds.maxs.y * _inv_cell_size));
+    return range;
+}
+
+std::uint32_t SpatialHashGrid2::CalcBucket(int cell_x, int cell_y) const {
+    const std::uint32_t hash = static_cast<std::uint32_t>(cell_x) * 0x8da6b343u ^ static_cast<std::uint32_t>(cell_y) * 0xd8163841u;
+    return (hash ^ (hash >> 16)) & _bucket_mask;
+}
+
+std::span<const SpatialHashGrid2::Entry> SpatialHashGrid2::GetBucketEntries(int cell_x, int cell_y) const {
+    const std::uint32_t bucket = CalcBucket(cell_x, cell_y);
+    return std::span<const Entry>(_entries.data() + _bucket_starts[bucket], _entries.data() + _bucket_starts[bucket + 1]);
+}
+
+template<typename Overlaps>
+void SpatialHashGrid2::QueryCellRange(const CellRange& range, Overlaps&& overlaps, std::vector<int>& results) const {
+    //A query spanning more cells than there are items is cheaper as a plain scan.
+    const std::int64_t cell_count = (static_cast<std::int64_t>(range.max_x) - range.min_x + 1) * (static_cast<std::int64_t>(range.max_y) - range.min_y + 1);
+    if(static_cast<std::int64_t>(_bounds.size()) < cell_count) {
+        for(std::size_t i = 0; i < _bounds.size(); ++i) {
+            if(overlaps(_bounds[i])) {
+                results.push_back(static_cast<int>(i));
+            }
+        }
+        return;
+    }
+    for(int y = range.min_y; y <= range.max_y; ++y) {
+        for(int x = range.min_x; x <= range.max_x; ++x) {
+            for(const Entry& entry : GetBucketEntries(x, y)) {
+                if(entry.cell_x != x || entry.cell_y != y) {
+                    continue;
+                }
+                //Report each item only from the first cell it shares with the query.
+                const CellRange& item_range = _item_cells[entry.item];
+                if(x != (std::max)(item_range.min_x, range.min_x) || y != (std::max)(item_range.min_y, range.min_y)) {
+                    continue;
+                }
+                if(overlaps(_bounds[entry.item])) {
+                    results.push_back(entry.item);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHashGrid2::QueryOverlaps(const AABB2& bounds, std::vector<int>& results) const {
+    QueryCellRange(CalcCellRange(bounds), [&bounds](const AABB2& box) { return MathUtils::DoAABBsOverlap(bounds, box); }, results);
+}
+
+void SpatialHashGrid2::QueryRadius(const Vector2& center, float radius, std::vector<int>& results) const {
+    const float radius_squared = radius * radius;
+    QueryCellRange(CalcCellRange(AABB2(center, radius, radius)), [&center, radius_squared](const AABB2& box) {
+        return CalcDistanceSquared(center, CalcClosestPoint(center, box)) <= radius_squared;
+    }, results);
+}
+
+void SpatialHashGrid2::QuerySegment(const LineSegment2& segment, std::vector<int>& results) const {
+    QuerySweep(segment.start, segment.end, 0.0f, results);
+}
+
+void SpatialHashGrid2::QueryCapsule(const Capsule2& capsule, std::vector<int>& results) const {
+    QuerySweep(capsule.line.start, capsule.line.end, capsule.radius, results);
+}
+
+//Walks the rows of cells the swept disc crosses, visiting in each row only the cells between
+//where the sweep enters and leaves that row's band, widened by the radius. Boxes are tested
+//against the segment after padding them by the radius, which is slightly generous at corners.
+void SpatialHashGrid2::QuerySweep(const Vector2& start, const Vector2& end, float radius, std::vector<int>& results) const {
+    const Vector2 displacement = end - start;
+    //Covers rounding between the band edges below and the cells items were entered in.
+    const float reach = radius + _cell_size * 0.001f;
+    auto hits = [&start, &displacement, radius](const AABB2& box) {
+        const AABB2 padded(box.mins.x - radius, box.mins.y - radius, box.maxs.x + radius, box.maxs.y + radius);
+        return DoesSegmentHitAABB2(start, displacement, padded);
+    };
+    const CellRange bounding_range = CalcCellRange(AABB2((std::min)(start.x, end.x) - reach, (std::min)(start.y, end.y) - reach,
+                                                         (std::max)(start.x, end.x) + reach, (std::max)(start.y, end.y) + reach));
+    const std::int64_t row_count = static_cast<std::int64_t>(bounding_range.max_y) - bounding_range.min_y + 1;
+    if(static_cast<std::int64_t>(_bounds.size()) < row_count) {
+        QueryCellRange(bounding_range, hits, results);
+        return;
+    }
+
+    //The columns visited in each row; rows the sweep misses get an empty span.
+    struct RowSpan {
+        int min_x = 0;
+        int max_x = -1;
+    };
+    std::vector<RowSpan> spans(static_cast<std::size_t>(row_count));
+    for(std::size_t row = 0; row < spans.size(); ++row) {
+        const float band_min = static_cast<float>(bounding_range.min_y + static_cast<int>(row)) * _cell_size - reach;
+        const float band_max = band_min + _cell_size + 2.0f * reach;
+        float t_min = 0.0f;
+        float t_max = 1.0f;
+        if(displacement.y != 0.0f) {
+            const float t1 = (band_min - start.y) / displacement.y;
+            const float t2 = (band_max - start.y) / displacement.y;
+            t_min = (std::max)(t_min, (std::min)(t1, t2));
+            t_max = (std::min)(t_max, (std::max)(t1, t2));
+        }
+        if(t_max < t_min) {
+            continue;
+        }
+        const float x1 = start.x + displacement.x * t_min;
+        const float x2 = start.x + displacement.x * t_max;
+        spans[row].min_x = (std::max)(bounding_range.min_x, static_cast<int>(std::floor(((std::min)(x1, x2) - reach) * _inv_cell_size)));
+        spans[row].max_x = (std::min)(bounding_range.max_x, static_cast<int>(std::floor(((std::max)(x1, x2) + reach) * _inv_cell_size)));
+    }
+
+    for(std::size_t row = 0; row < spans.size(); ++row) {
+        const int y = bounding_range.min_y + static_cast<int>(row);
+        for(int x = spans[row].min_x; x <= spans[row].max_x; ++x) {
+            for(const Entry& entry : GetBucketEntries(x, y)) {
+                if(entry.cell_x != x || entry.cell_y != y) {
+                    continue;
+                }
+                //Report each item only from the first visited cell it covers: skip it if an
+                //earlier row's span reached its columns, or an earlier cell in this row did.
+                const CellRange& item_range = _item_cells[entry.item];
+                if(x != (std::max)(item_range.min_x, spans[row].min_x)) {
+                    continue;
+                }
+                bool seen = false;
+                for(int earlier_y = (std::max)(item_range.min_y, bounding_range.min_y); earlier_y < y && !seen; ++earlier_y) {
+                    const RowSpan& earlier = spans[static_cast<std::size_t>(earlier_y - bounding_range.min_y)];
+                    seen = earlier.min_x <= item_range.max_x && item_range.min_x <= earlier.max_x;
+                }
+                if(!seen && hits(_bounds[entry.item])) {
+                    results.push_back(entry.item);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHashGrid2::QueryRadii(std::span<const Vector2> centers, float radius, std::vector<int>& results, std::vector<std::size_t>& offsets) const {
+    const std::size_t query_count = centers.size();
+    const std::size_t job_count = JobSystem::CalcSliceCount(query_count, MIN_QUERIES_PER_JOB);
+    offsets.resize(query_count + 1);
+    results.clear();
+    if(job_count == 1) {
+        for(std::size_t i = 0; i < query_count; ++i) {
+            offsets[i] = results.size();
+            QueryRadius(centers[i], radius, results);
+        }
+        offsets[query_count] = results.size();
+        return;
+    }
+    //Each job fills its own list with offsets relative to it; the lists are joined in order.
+    std::vector<std::vector<int>> job_results(job_count);
+    JobSystem::ForEachSlice(query_count, job_count, [this, centers, radius, &job_results, &offsets](std::size_t begin, std::size_t end, std::size_t job) {
+        std::vector<int>& local = job_results[job];
+        for(std::size_t i = begin; i < end; ++i) {
+            offsets[i] = local.size();
+            QueryRadius(centers[i], radius, local);
+        }
+    });
+    for(std::size_t job = 0; job < job_count; ++job) {
+        const std::size_t base = results.size();
+        for(std::size_t i = JobSystem::CalcSliceBegin(query_count, job_count, job); i < JobSystem::CalcSliceBegin(query_count, job_count, job + 1); ++i) {
+            offsets[i] += base;
+        }
+        results.insert(results.end(), job_results[job].begin(), job_results[job].end());
+    }
+    offsets[query_count] = results.size();
+}
+
+void SpatialHashGrid2::FindAllPairs(std::vector<std::pair<int, int>>& pairs) const {
+    pairs.clear();
+    const std::size_t bucket_count = _bucket_starts.size() - 1;
+    const std::size_t job_count = JobSystem::CalcSliceCount(bucket_count, MIN_BUCKETS_PER_JOB);
+    std::vector<std::vector<std::pair<int, int>>> job_pairs(job_count > 1 ? job_count : 0);
+    JobSystem::ForEachSlice(bucket_count, job_count, [this, job_count, &pairs, &job_pairs](std::size_t begin, std::size_t end, std::size_t job) {
+        std::vector<std::pair<int, int>>& local = job_count > 1 ? job_pairs[job] : pairs;
+        for(std::size_t bucket = begin; bucket < end; ++bucket) {
+            const Entry* first = _entries.data() + _bucket_starts[bucket];
+            const Entry* last = _entries.data() + _bucket_starts[bucket + 1];
+            //Entries are grouped by cell, and by item within a cell.
+            for(const Entry* a = first; a < last; ++a) {
+                const CellRange& a_range = _item_cells[a->item];
+                for(const Entry* b = a + 1; b < last && b->cell_x == a->cell_x && b->cell_y == a->cell_y; ++b) {
+                    //Items sharing several cells pair up only in the first of them.
+                    const CellRange& b_range = _item_cells[b->item];
+                    if(a->cell_x != (std::max)(a_range.min_x, b_range.min_x) || a->cell_y != (std::max)(a_range.min_y, b_range.min_y)) {
+                        continue;
+                    }
+                    if(MathUtils::DoAABBsOverlap(_bounds[a->item], _bounds[b->item])) {
+                        local.emplace_back(a->item, b->item);
+                    }
+                }
+            }
+        }
+    });
+    for(const auto& local : job_pairs) {
+        pairs.insert(pairs.end(), local.begin(), local.end());
+    }
+}
+
+void SpatialHashGrid2Benchmark(unsigned int frames) {
+    frames = (std::max)(frames, 1u);
+    g_theFileLogger->LogTagf("test", "SpatialHashGrid2, %u frames of motion, %s:\n", frames, g_theJobSystem ? "as jobs" : "in sequence");
+
+    const std::size_t disc_counts[] = {10000, 100000};
+    for(std::size_t disc_count : disc_counts) {
+        //Unit discs at a density of about two overlaps each, drifting and bouncing off the walls.
+        const float radius = 0.5f;
+        const float world_size = std::sqrt(MathUtils::M_PI * 0.5f * static_cast<float>(disc_count));
+        const float max_speed = 0.05f;
+        RandomEngine rng(12345u);
+        std::vector<Disc2> discs(disc_count);
+        std::vector<Vector2> velocities(disc_count);
+        for(std::size_t i = 0; i < disc_count; ++i) {
+            discs[i] = Disc2(rng.NextFloat() * world_size, rng.NextFloat() * world_size, radius);
+            velocities[i] = Vector2(rng.NextFloat() * 2.0f - 1.0f, rng.NextFloat() * 2.0f - 1.0f) * max_speed;
+        }
+
+        SpatialHashGrid2 grid(4.0f * radius);
+        std::vector<std::pair<int, int>> pairs{};
+        std::size_t touching = 0;
+        double build_seconds = 0.0;
+        double pair_seconds = 0.0;
+        for(unsigned int frame = 0; frame < frames; ++frame) {
+            for(std::size_t i = 0; i < disc_count; ++i) {
+                Vector2& p = discs[i].center;
+                Vector2& v = velocities[i];
+                p += v;
+                if(p.x < 0.0f || world_size < p.x) { v.x = -v.x; }
+                if(p.y < 0.0f || world_size < p.y) { v.y = -v.y; }
+            }
+            double start = GetCurrentTimeSeconds();
+            grid.Build(std::span<const Disc2>(discs));
+            build_seconds += GetCurrentTimeSeconds() - start;
+            start = GetCurrentTimeSeconds();
+            grid.FindAllPairs(pairs);
+            pair_seconds += GetCurrentTimeSeconds() - start;
+            for(const auto& pair : pairs) {
+                touching += MathUtils::DoDiscsOverlap(discs[pair.first], discs[pair.second]) ? 1 : 0;
+            }
+        }
+
+        //Every disc looking for neighbours within twice its radius.
+        std::vector<Vector2> centers(disc_count);
+        for(std::size_t i = 0; i < disc_count; ++i) {
+            centers[i] = discs[i].center;
+        }
+        std::vector<int> neighbours{};
+        std::vector<std::size_t> offsets{};
+        double start = GetCurrentTimeSeconds();
+        grid.QueryRadii(centers, 2.0f * radius, neighbours, offsets);
+        const double radii_ms = (GetCurrentTimeSeconds() - start) * 1000.0;
+
+        const unsigned int sweep_count = 1000;
+        const float sweep_length = 20.0f;
+        std::vector<Capsule2> sweeps(sweep_count);
+        for(auto& sweep : sweeps) {
+            const Vector2 from(rng.NextFloat() * world_size, rng.NextFloat() * world_size);
+            sweep = Capsule2(from, rng.NextFloat() * 360.0f, sweep_length, radius);
+        }
+        std::vector<int> segment_hits{};
+        std::vector<int> sweep_hits{};
+        start = GetCurrentTimeSeconds();
+        for(const auto& sweep : sweeps) {
+            grid.QuerySegment(sweep.line, segment_hits);
+        }
+        const double segment_us = (GetCurrentTimeSeconds() - start) * 1.0e6 / sweep_count;
+        start = GetCurrentTimeSeconds();
+        for(const auto& sweep : sweeps) {
+            grid.QueryCapsule(sweep, sweep_hits);
+        }
+        const double sweep_us = (GetCurrentTimeSeconds() - start) * 1.0e6 / sweep_count;
+
+        g_theFileLogger->LogTagf("test", "  %u discs, %u entries: per frame: build %.3f ms, pairs %.3f ms (%u pairs, %.0f touching)\n",
+                                 static_cast<unsigned int>(disc_count), static_cast<unsigned int>(grid.GetEntryCount()), build_seconds * 1000.0 / frames,
+                                 pair_seconds * 1000.0 / frames, static_cast<unsigned int>(pairs.size()), static_cast<double>(touching) / frames);
+        g_theFileLogger->LogTagf("test", "    radius queries %.2f ms (%u found), segment %u hits %.2f us each, swept disc %u hits %.2f us each\n",
+                                 radii_ms, static_cast<unsigned int>(neighbours.size()), static_cast<unsigned int>(segment_hits.size()), segment_us,
+                                 static_cast<unsigned int>(sweep_hits.size()), sweep_us);
+
+        //The grid must find exactly what testing every box would; n^2 is only affordable for the smaller set.
+        if(disc_count > 10000) {
+            continue;
+        }
+        std::vector<std::pair<int, int>> brute_pairs{};
+        std::vector<int> brute_neighbours{};
+        std::vector<int> brute_segment_hits{};
+        std::vector<int> brute_sweep_hits{};
+        start = GetCurrentTimeSeconds();
+        for(std::size_t i = 0; i < disc_count; ++i) {
+            const AABB2& a = grid.GetBounds(static_cast<int>(i));
+            for(std::size_t j = i + 1; j < disc_count; ++j) {
+                if(MathUtils::DoAABBsOverlap(a, grid.GetBounds(static_cast<int>(j)))) {
+                    brute_pairs.emplace_back(static_cast<int>(i), static_cast<int>(j));
+                }
+            }
+        }
+        const double brute_pairs_ms = (GetCurrentTimeSeconds() - start) * 1000.0;
+        const float query_radius_squared = 4.0f * radius * radius;
+        for(const auto& center : centers) {
+            for(std::size_t i = 0; i < disc_count; ++i) {
+                const AABB2& box = grid.GetBounds(static_cast<int>(i));
+                if(CalcDistanceSquared(center, CalcClosestPoint(center, box)) <= query_radius_squared) {
+                    brute_neighbours.push_back(static_cast<int>(i));
+                }
+            }
+        }
+        for(const auto& sweep : sweeps) {
+            const Vector2 displacement = sweep.CalcDisplacement();
+            for(std::size_t i = 0; i < disc_count; ++i) {
+                const AABB2& box = grid.GetBounds(static_cast<int>(i));
+                if(DoesSegmentHitAABB2(sweep.line.start, displacement, box)) {
+                    brute_segment_hits.push_back(static_cast<int>(i));
+                }
+                const AABB2 padded(box.mins.x - radius, box.mins.y - radius, box.maxs.x + radius, box.maxs.y + radius);
+                if(DoesSegmentHitAABB2(sweep.line.start, displacement, padded)) {
+                    brute_sweep_hits.push_back(static_cast<int>(i));
+                }
+            }
+        }
+        //Compare the sets, not just their sizes. Neighbours are compared per center.
+        std::sort(pairs.begin(), pairs.end());
+        for(std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+            std::sort(neighbours.begin() + offsets[i], neighbours.begin() + offsets[i + 1]);
+        }
+        std::sort(segment_hits.begin(), segment_hits.end());
+        std::sort(brute_segment_hits.begin(), brute_segment_hits.end());
+        std::sort(sweep_hits.begin(), sweep_hits.end());
+        std::sort(brute_sweep_hits.begin(), brute_sweep_hits.end());
+        const bool results_match = brute_pairs == pairs && brute_neighbours == neighbours && brute_segment_hits == segment_hits && brute_sweep_hits == sweep_hits;
+        g_theFileLogger->LogTagf("test", "    brute force: %u pairs %.2f ms, %u found, %u segment hits, %u swept disc hits. %s\n",
+                                 static_cast<unsigned int>(brute_pairs.size()), brute_pairs_ms, static_cast<unsigned int>(brute_neighbours.size()),
+                                 static_cast<unsigned int>(brute_segment_hits.size()), static_cast<unsigned int>(brute_sweep_hits.size()),
+                                 results_match ? "Results match." : "RESULTS DIFFER.");
+        GUARANTEE_RECOVERABLE(results_match, "SpatialHashGrid2 queries differ from brute force.");
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vector2.hpp"
+
+class Capsule2;
+class Disc2;
+class LineSegment2;
+
+//Uniform grid over the plane for broad-phase queries on many moving 2D primitives, meant to be
+//rebuilt from scratch every frame. Cells are hashed into a power-of-two bucket table, so the
+//world needs no bounds. Build counting-sorts every (cell, item) entry into one flat array,
+//with no per-cell containers, so a rebuild allocates nothing once capacity has grown.
+//An item is entered in every cell its bounds touch. A cell about twice the typical item width
+//works well: most items then touch one to four cells, and a cell holds only a few items.
+//Item ids are indices into the span given to Build. Every query tests the item bounds, so
+//results are candidates for an exact test. Queries append to their output, report each item
+//once, and are safe to call from several threads at a time between builds.
+//Build, FindAllPairs and QueryRadii split their work into JobSystem jobs when it is running.
+class SpatialHashGrid2 {
+public:
+    explicit SpatialHashGrid2(float cell_size = 1.0f);
+    ~SpatialHashGrid2() = default;
+
+    void Build(std::span<const AABB2> bounds);
+    void Build(std::span<const Disc2> discs);
+    void Build(std::span<const Capsule2> capsules);
+    void Clear();
+
+    //Takes effect at the next Build.
+    void SetCellSize(float cell_size);
+    float GetCellSize() const;
+    std::size_t GetItemCount() const;
+    std::size_t GetEntryCount() const;
+    const AABB2& GetBounds(int item) const;
+
+    void QueryOverlaps(const AABB2& bounds, std::vector<int>& results) const;
+    void QueryRadius(const Vector2& center, float radius, std::vector<int>& results) const;
+    //Items hit by the segment.
+    void QuerySegment(const LineSegment2& segment, std::vector<int>& results) const;
+    //Items touched by the capsule, i.e. by its disc swept from start to end.
+    void QueryCapsule(const Capsule2& capsule, std::vector<int>& results) const;
+
+    //One QueryRadius per center, run in parallel. The results for centers[i] are
+    //results[offsets[i]] up to results[offsets[i + 1]]; both outputs are overwritten.
+    void QueryRadii(std::span<const Vector2> centers, float radius, std::vector<int>& results, std::vector<std::size_t>& offsets) const;
+
+    //Every pair with overlapping bounds once, as (lower id, higher id). Overwrites pairs.
+    void FindAllPairs(std::vector<std::pair<int, int>>& pairs) const;
+
+protected:
+private:
+    //Inclusive cell coordinates covered by an item.
+    struct CellRange {
+        int min_x = 0;
+        int min_y = 0;
+        int max_x = -1;
+        int max_y = -1;
+    };
+    struct Entry {
+        int item = 0;
+        int cell_x = 0;
+        int cell_y = 0;
+        //By row, then column, then item.
+        bool operator<(const Entry& rhs) const {
+            if(cell_y != rhs.cell_y) {
+                return cell_y < rhs.cell_y;
+            }
+            if(cell_x != rhs.cell_x) {
+                return cell_x < rhs.cell_x;
+            }
+            return item < rhs.item;
+        }
+    };
+
+    void BuildFromBounds();
+    CellRange CalcCellRange(const AABB2& bounds) const;
+    std::uint32_t CalcBucket(int cell_x, int cell_y) const;
+    std::span<const Entry> GetBucketEntries(int cell_x, int cell_y) const;
+    template<typename Overlaps>
+    void QueryCellRange(const CellRange& range, Overlaps&& overlaps, std::vector<int>& results) const;
+    void QuerySweep(const Vector2& start, const Vector2& end, float radius, std::vector<int>& results) const;
+
+    std::vector<AABB2> _bounds{};
+    std::vector<CellRange> _item_cells{};
+    std::vector<Entry> _entries{};
+    //Bucket b holds _entries[_bucket_starts[b]] up to _entries[_bucket_starts[b + 1]],
+    //sorted by cell and then by item.
+    std::vector<std::uint32_t> _bucket_starts{};
+    //Scatter cursors for Build, kept to avoid an allocation per rebuild.
+    std::vector<std::uint32_t> _bucket_cursors{};
+    float _cell_size = 1.0f;
+    float _inv_cell_size = 1.0f;
+    std::uint32_t _bucket_mask = 0;
+};
+
+void SpatialHashGrid2Benchmark(unsigned int frames);
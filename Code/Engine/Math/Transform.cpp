@@ -1,2 +1,162 @@
-//#include "Engine/Math/Transform.hpp"
-//
\ No newline at end of file
+#include "Engine/Math/Transform.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include "Engine/Math/MathUtils.hpp"
+
+Transform::Transform(const Vector3& position, const Quaternion& rotation /*= Quaternion::GetIdentity()*/, const Vector3& scale /*= Vector3::ONE*/)
+    : position(position)
+    , rotation(rotation)
+    , scale(scale)
+{
+    /* DO NOTHING */
+}
+
+Transform::Transform(const Matrix4& mat)
+    : position()
+    , rotation()
+    , scale()
+{
+    //The scale is the length of each basis and the rotation what remains once it is divided out.
+    //A reflection (negative determinant) goes into the x scale so the rest is a proper rotation.
+    const float* m = *mat;
+    position = Vector3(m[3], m[7], m[11]);
+    scale = Vector3(std::sqrt(m[0] * m[0] + m[4] * m[4] + m[8] * m[8]),
+                    std::sqrt(m[1] * m[1] + m[5] * m[5] + m[9] * m[9]),
+                    std::sqrt(m[2] * m[2] + m[6] * m[6] + m[10] * m[10]));
+    if(MathUtils::CalculateMatrix3Determinant(m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10]) < 0.0f) {
+        scale.x = -scale.x;
+    }
+    const float inv_x = scale.x != 0.0f ? 1.0f / scale.x : 0.0f;
+    const float inv_y = scale.y > 0.0f ? 1.0f / scale.y : 0.0f;
+    const float inv_z = scale.z > 0.0f ? 1.0f / scale.z : 0.0f;
+    const float rotation_only[16] = {m[0] * inv_x, m[1] * inv_y, m[2] * inv_z, 0.0f,
+                                     m[4] * inv_x, m[5] * inv_y, m[6] * inv_z, 0.0f,
+                                     m[8] * inv_x, m[9] * inv_y, m[10] * inv_z, 0.0f,
+                                     0.0f, 0.0f, 0.0f, 1.0f};
+    rotation = Quaternion(Matrix4(rotation_only));
+}
+
+Matrix4 Transform::GetMatrix() const {
+    //Same as T * R * S without the two full multiplies.
+    Matrix4 result(rotation);
+    float* m = *result;
+    m[0] *= scale.x; m[1] *= scale.y; m[2]  *= scale.z; m[3]  = position.x;
+    m[4] *= scale.x; m[5] *= scale.y; m[6]  *= scale.z; m[7]  = position.y;
+    m[8] *= scale.x; m[9] *= scale.y; m[10] *= scale.z; m[11] = position.z;
+    return result;
+}
+
+void TransformHierarchy::CalculateWorldMatrices(std::span<const std::size_t> parents, std::span<const Matrix4> locals, std::span<Matrix4> worlds) {
+    ASSERT_OR_DIE(parents.size() == locals.size() && parents.size() == worlds.size(), "TransformHierarchy::CalculateWorldMatrices: span sizes differ.");
+    const std::size_t count = parents.size();
+    for(std::size_t i = 0; i < count; ++i) {
+        const std::size_t parent = parents[i];
+        if(parent == NO_PARENT) {
+            worlds[i] = locals[i];
+            continue;
+        }
+        ASSERT_OR_DIE(parent < i, "TransformHierarchy::CalculateWorldMatrices: parent stored after child.");
+        worlds[i] = worlds[parent] * locals[i];
+    }
+}
+
+std::size_t TransformHierarchy::AddNode(const Transform& local /*= Transform{}*/, std::size_t parent /*= NO_PARENT*/) {
+    const std::size_t node = _locals.size();
+    ASSERT_OR_DIE(parent == NO_PARENT || parent < node, "TransformHierarchy::AddNode: parent does not exist.");
+    _locals.push_back(local);
+    _parents.push_back(parent);
+    _worlds.emplace_back();
+    _dirty.push_back(1);
+    _first_dirty = (std::min)(_first_dirty, node);
+    return node;
+}
+
+void TransformHierarchy::Reserve(std::size_t node_count) {
+    _locals.reserve(node_count);
+    _parents.reserve(node_count);
+    _worlds.reserve(node_count);
+    _dirty.reserve(node_count);
+}
+
+void TransformHierarchy::Clear() {
+    _locals.clear();
+    _parents.clear();
+    _worlds.clear();
+    _dirty.clear();
+    _first_dirty = 0;
+}
+
+std::size_t TransformHierarchy::GetNodeCount() const {
+    return _locals.size();
+}
+
+std::size_t TransformHierarchy::GetParent(std::size_t node) const {
+    return _parents[node];
+}
+
+const Transform& TransformHierarchy::GetLocalTransform(std::size_t node) const {
+    return _locals[node];
+}
+
+void TransformHierarchy::SetLocalTransform(std::size_t node, const Transform& local) {
+    _locals[node] = local;
+    MarkDirty(node);
+}
+
+void TransformHierarchy::SetLocalPosition(std::size_t node, const Vector3& position) {
+    _locals[node].position = position;
+    MarkDirty(node);
+}
+
+void TransformHierarchy::SetLocalRotation(std::size_t node, const Quaternion& rotation) {
+    _locals[node].rotation = rotation;
+    MarkDirty(node);
+}
+
+void TransformHierarchy::SetLocalScale(std::size_t node, const Vector3& scale) {
+    _locals[node].scale = scale;
+    MarkDirty(node);
+}
+
+const Matrix4& TransformHierarchy::GetWorldMatrix(std::size_t node) const {
+    if(node >= _first_dirty) {
+        UpdateWorldMatrices();
+    }
+    return _worlds[node];
+}
+
+const std::vector<Matrix4>& TransformHierarchy::GetWorldMatrices() const {
+    UpdateWorldMatrices();
+    return _worlds;
+}
+
+void TransformHierarchy::UpdateWorldMatrices() const {
+    //Everything before _first_dirty is clean. From there a node is recomputed when it or its
+    //parent was flagged; parents come first, so their flag is final by the time it is read.
+    const std::size_t count = _locals.size();
+    for(std::size_t i = _first_dirty; i < count; ++i) {
+        const std::size_t parent = _parents[i];
+        const bool parent_dirty = parent != NO_PARENT && _dirty[parent];
+        if(!_dirty[i] && !parent_dirty) {
+            continue;
+        }
+        _dirty[i] = 1;
+        const Matrix4 local = _locals[i].GetMatrix();
+        _worlds[i] = parent == NO_PARENT ? local : _worlds[parent] * local;
+    }
+    std::fill(_dirty.begin() + (std::min)(_first_dirty, count), _dirty.end(), static_cast<unsigned char>(0));
+    _first_dirty = count;
+}
+
+void TransformHierarchy::MarkDirty(std::size_t node) {
+    _dirty[node] = 1;
+    _first_dirty = (std::min)(_first_dirty, node);
+}
+
+Transform Interpolate(const Transform& a, const Transform& b, float t) {
+    return Transform(Interpolate(a.position, b.position, t), FastSLERP(a.rotation, b.rotation, t), Interpolate(a.scale, b.scale, t));
+}
@@ -1,14 +1,79 @@
-//#pragma once
-//
-//#include "Engine/Math/Matrix4.hpp"
-//
-//class Matrix4;
-//
-//class Transform {
-//public:
-//	Transform();
-//	~Transform();
-//protected:
-//private:
-//    Matrix4* parent;
-//};
\ No newline at end of file
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Engine/Math/Matrix4.hpp"
+#include "Engine/Math/Quaternion.hpp"
+#include "Engine/Math/Vector3.hpp"
+
+//Translation, rotation and scale. As a matrix the scale applies first, then the rotation,
+//then the translation.
+class Transform {
+public:
+    Vector3 position = Vector3::ZERO;
+    Quaternion rotation = Quaternion::GetIdentity();
+    Vector3 scale = Vector3::ONE;
+
+    Transform() = default;
+    explicit Transform(const Vector3& position, const Quaternion& rotation = Quaternion::GetIdentity(), const Vector3& scale = Vector3::ONE);
+    //Decomposes a translate-rotate-scale matrix. Shear is lost; a reflection comes back as a
+    //negative x scale.
+    explicit Transform(const Matrix4& mat);
+
+    Matrix4 GetMatrix() const;
+
+protected:
+private:
+};
+
+//Lerps position and scale and FastSLERPs rotation, for sampling animation keys.
+Transform Interpolate(const Transform& a, const Transform& b, float t);
+
+//A tree of transforms in flat arrays. Nodes are stored parent-first, so one forward pass
+//computes every world matrix. World matrices are cached: only nodes whose local transform
+//changed since the last update, and their descendants, are recomputed.
+//Nodes are identified by index and never move.
+class TransformHierarchy {
+public:
+    static constexpr std::size_t NO_PARENT = static_cast<std::size_t>(-1);
+
+    //world[i] = world[parents[i]] * local[i] for a whole hierarchy in one pass.
+    //parents[i] must be NO_PARENT or less than i. worlds may alias locals.
+    static void CalculateWorldMatrices(std::span<const std::size_t> parents, std::span<const Matrix4> locals, std::span<Matrix4> worlds);
+
+    TransformHierarchy() = default;
+    ~TransformHierarchy() = default;
+
+    //Returns the new node's index. parent must already exist.
+    std::size_t AddNode(const Transform& local = Transform{}, std::size_t parent = NO_PARENT);
+    void Reserve(std::size_t node_count);
+    void Clear();
+
+    std::size_t GetNodeCount() const;
+    std::size_t GetParent(std::size_t node) const;
+
+    const Transform& GetLocalTransform(std::size_t node) const;
+    void SetLocalTransform(std::size_t node, const Transform& local);
+    void SetLocalPosition(std::size_t node, const Vector3& position);
+    void SetLocalRotation(std::size_t node, const Quaternion& rotation);
+    void SetLocalScale(std::size_t node, const Vector3& scale);
+
+    //Both bring the cache up to date first.
+    const Matrix4& GetWorldMatrix(std::size_t node) const;
+    const std::vector<Matrix4>& GetWorldMatrices() const;
+
+    //Recomputes the dirty part of the tree. Safe to call when nothing changed.
+    void UpdateWorldMatrices() const;
+
+protected:
+private:
+    void MarkDirty(std::size_t node);
+
+    std::vector<Transform> _locals{};
+    std::vector<std::size_t> _parents{};
+    mutable std::vector<Matrix4> _worlds{};
+    mutable std::vector<unsigned char> _dirty{};
+    mutable std::size_t _first_dirty = 0;
+};
@@ -1,29 +1,36 @@
 #pragma once
 
+#include <cstdint>
+
+#include "Engine/Core/Clock.hpp"
 #include "Engine/Core/Time.hpp"
 
+//Times are integer nanoseconds so intervals stay exact however long the process runs.
+//Uses real time unless given a parent clock, whose pause and scale it then follows.
 class Interval
 {
 public:
-    //void set_parent_clock(Clock *clock);
+    void set_parent_clock(Clock *clock) {
+        parent_clock = clock;
+        reset();
+    }
 
     void set_seconds(float seconds) {
-        interval_time = seconds;
-        target_time = static_cast<float>(GetCurrentTimeSeconds()) + seconds;
+        interval_ticks = Clock::SecondsToTicks(seconds);
+        target_ticks = get_current_ticks() + interval_ticks;
     }
 
     void set_frequency(float hz) { set_seconds(1.0f / hz); }
 
     bool check()
     {
-        float current_time = static_cast<float>(GetCurrentTimeSeconds());
-        return (current_time >= target_time);
+        return (get_current_ticks() >= target_ticks);
     }
 
     bool check_and_decrement()
     {
         if(check()) {
-            target_time += interval_time;
+            target_ticks += interval_ticks;
             return true;
         } else {
             return false;
@@ -52,11 +59,17 @@ public:
 
     void reset()
     {
-        target_time = static_cast<float>(GetCurrentTimeSeconds()) + interval_time;
+        target_ticks = get_current_ticks() + interval_ticks;
+    }
+
+    int64_t get_current_ticks() const
+    {
+        return parent_clock ? parent_clock->GetTotalTicks() : GetCurrentTimeNanoseconds();
     }
 
 public:
-    float interval_time;
-    float target_time;
+    int64_t interval_ticks = 0;
+    int64_t target_ticks = 0;
+    Clock* parent_clock = nullptr;
 
-};
\ No newline at end of file
+};
@@ -56,7 +56,7 @@ void RPCSystem::OnCallRPC(Net::Message* msg) {
             std::string id;
             msg->readString(id);
 
-            auto entry_iter = _rpcs.find(id);
+            auto entry_iter = FindStringId(_rpcs, id);
             if(entry_iter == _rpcs.end()) {
                 return;
             }
@@ -68,7 +68,7 @@ void RPCSystem::OnCallRPC(Net::Message* msg) {
         std::string id;
         msg->readString(id);
 
-        auto entry_iter = _rpcs.find(id);
+        auto entry_iter = FindStringId(_rpcs, id);
         if(entry_iter == _rpcs.end()) {
             return;
         }
@@ -6,8 +6,11 @@
 #include <future>
 #include <map>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 
+#include "Engine/Core/StringId.hpp"
+
 #include "Engine/Networking/TCPSession.hpp"
 #include "Engine/Networking/Connection.hpp"
 #include "Engine/Networking/Message.hpp"
@@ -157,7 +160,7 @@ private:
     template<typename Ret, typename... Args>
     void UnCallRPC(Net::Message& msg, RpcEntry& entry, Args... args);
 
-    std::map<std::string, Net::RpcEntry> _rpcs = std::map<std::string, Net::RpcEntry>{};
+    std::unordered_map<StringId, Net::RpcEntry> _rpcs = std::unordered_map<StringId, Net::RpcEntry>{};
 
 };
 
@@ -172,7 +175,7 @@ void RPCSystem::Register(const std::string& id, Ret(*function)(Args...)) {
     rpc_entry.func_ptr = function;
     rpc_entry.serialize_ptr = RpcSerializeFunc<Ret, Args...>;
     rpc_entry.deserialize_ptr = RpcDeserializeFunc<Ret, Args...>;
-    _rpcs.insert_or_assign(id, rpc_entry);
+    _rpcs.insert_or_assign(StringId(id), rpc_entry);
 }
 
 template<typename Ret, typename... Args>
@@ -182,7 +185,7 @@ void RPCSystem::Register(const char* id, Ret(*function)(Args...)) {
 
 template<typename Ret, typename... Args>
 void RPCSystem::CallRPC(uint8_t source_id, uint8_t target_id, const std::string& id, Args... args) {
-    auto rpc_iter = _rpcs.find(id);
+    auto rpc_iter = FindStringId(_rpcs, id);
     if(rpc_iter == _rpcs.end()) {
         return;
     }
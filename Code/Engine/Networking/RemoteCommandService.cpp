@@ -178,6 +178,7 @@ void RemoteCommandService::Render() const {
 
     auto font = g_theConsole->GetFont();
     auto dims = _renderer->_rhi_output->GetDimensions();
+    _renderer->BeginTextBatch();
     float i = 1.0f;
 
     bool is_running = s_instance->session.IsRunning();
@@ -201,14 +202,14 @@ void RemoteCommandService::Render() const {
     ss.str("");
     for(auto& conn : s_instance->session.connections) {
         if(conn == nullptr) {
-            return;
+            break;
         }
         ss << (conn->address == s_instance->session.host_connection->address ? " *" : " -") << " [" << conn->connection_index << "] " << Net::NetAddressToString(conn->address) << " [" << conn->owner->state << "] ";
         text_width = font->CalculateTextWidth(ss.str());
         _renderer->DrawTextLine(g_theConsole->GetFont(), ss.str(), Rgba::WHITE, dims.x - text_width, font->GetLineHeight() * i++);
         ss.str("");
     }
-
+    _renderer->EndTextBatch();
 }
 
 }
\ No newline at end of file
@@ -44,7 +44,7 @@ void ParticleEffect::EndFrame() {
 void ParticleEffect::LoadFromXml(const XMLElement& element) {
     
     _definition = new ParticleEffectDefinition;
-    _definition->_name = DataUtils::ParseXmlAttribute(element, std::string("name"), std::string("UNNAMED_PARTICLE_EFFECT"));
+    _definition->_name = DataUtils::ParseXmlAttribute(element, "name", std::string("UNNAMED_PARTICLE_EFFECT"));
 
     for(auto emitterXml = element.FirstChildElement("ParticleEmitter");
         emitterXml != nullptr;
@@ -93,7 +93,7 @@ ComputeShader* RHIDevice::CreateComputeShaderFromHlslFile(const std::string& fil
 
         _dx_device->CreateComputeShader(cs_byte_code->GetBufferPointer(), cs_byte_code->GetBufferSize(), nullptr, &cs);
 
-        namespace FS = std::experimental::filesystem::v1;
+        namespace FS = std::filesystem;
         FS::path p(filename);
         ID3D11InputLayout* il = CreateInputLayout(cs_byte_code);
         ComputeShader* compute_shader = new ComputeShader(p.filename().string(), this, cs, cs_byte_code, il);
@@ -179,7 +179,7 @@ ShaderProgram* RHIDevice::CreateShaderFromHlslFile(const std::string& filename)
         _dx_device->CreateVertexShader(vs_byte_code->GetBufferPointer(), vs_byte_code->GetBufferSize(), nullptr, &vs);
         _dx_device->CreatePixelShader(fs_byte_code->GetBufferPointer(), fs_byte_code->GetBufferSize(), nullptr, &fs);
 
-        namespace FS = std::experimental::filesystem::v1;
+        namespace FS = std::filesystem;
         FS::path p(filename);
         ID3D11InputLayout* il = CreateInputLayout(vs_byte_code);
         ShaderProgram* program = new ShaderProgram(p.string(), this, vs, fs, vs_byte_code, fs_byte_code, il);
@@ -168,51 +168,48 @@ Camera3D::CameraFrustum Camera3D::CalcFrustum(const Vector3& worldUp /*= Vector3
     float nearWidth = nearHeight * m_aspectRatio;
     Vector2 nearHalfExtents(nearWidth * 0.5f, nearHeight * 0.5f);
 
-    float farHeight = 2.0f * tanFovHalf * m_farDistance;
-    float farWidth = farHeight * m_aspectRatio;
-    Vector2 farHalfExtents(farWidth * 0.5f, farHeight * 0.5f);
-
     Vector3 forward = GetForwardXYZ();
-    Vector3 backward = -forward;
     Vector3 up = GetUpFromLeftXYZ(worldUp);
     Vector3 down = -up;
     Vector3 left = GetLeftXYZ(worldUp);
     Vector3 right = -left;
-    float cam_distance_from_origin = m_position.CalcLength();
+    float cam_distance_along_forward = MathUtils::DotProduct(m_position, forward);
 
+    //Every normal faces into the frustum, so a point is inside when it is in front of all six
+    //planes. The side planes pass through the camera position.
     CameraFrustum frustum;
 
     std::size_t currentPlane = static_cast<std::size_t>(FrustumPlanes::NEARPLANE);
-    frustum[currentPlane].dist = m_nearDistance;
     frustum[currentPlane].normal = forward;
+    frustum[currentPlane].dist = cam_distance_along_forward + m_nearDistance;
 
     currentPlane = static_cast<std::size_t>(FrustumPlanes::FARPLANE);
-    frustum[currentPlane].dist = m_farDistance;
-    frustum[currentPlane].normal = backward;
+    frustum[currentPlane].normal = -forward;
+    frustum[currentPlane].dist = -(cam_distance_along_forward + m_farDistance);
 
     currentPlane = static_cast<std::size_t>(FrustumPlanes::RIGHT);
-    frustum[currentPlane].dist = cam_distance_from_origin;
-    Vector3 rightEdge(((m_position + forward * m_nearDistance) + right * nearHalfExtents.x) - m_position);
+    Vector3 rightEdge(forward * m_nearDistance + right * nearHalfExtents.x);
     rightEdge.Normalize();
-    frustum[currentPlane].normal = CrossProduct(up, rightEdge);
+    frustum[currentPlane].normal = CrossProduct(rightEdge, up);
+    frustum[currentPlane].dist = MathUtils::DotProduct(frustum[currentPlane].normal, m_position);
 
     currentPlane = static_cast<std::size_t>(FrustumPlanes::LEFT);
-    frustum[currentPlane].dist = cam_distance_from_origin;
-    Vector3 leftEdge(((m_position + forward * m_nearDistance) + left * nearHalfExtents.x) - m_position);
+    Vector3 leftEdge(forward * m_nearDistance + left * nearHalfExtents.x);
     leftEdge.Normalize();
-    frustum[currentPlane].normal = CrossProduct(down, leftEdge);
+    frustum[currentPlane].normal = CrossProduct(up, leftEdge);
+    frustum[currentPlane].dist = MathUtils::DotProduct(frustum[currentPlane].normal, m_position);
 
     currentPlane = static_cast<std::size_t>(FrustumPlanes::TOP);
-    frustum[currentPlane].dist = cam_distance_from_origin;
-    Vector3 topEdge(((m_position + forward * m_nearDistance) + up * nearHalfExtents.y) - m_position);
+    Vector3 topEdge(forward * m_nearDistance + up * nearHalfExtents.y);
     topEdge.Normalize();
-    frustum[currentPlane].normal = CrossProduct(down, topEdge);
+    frustum[currentPlane].normal = CrossProduct(right, topEdge);
+    frustum[currentPlane].dist = MathUtils::DotProduct(frustum[currentPlane].normal, m_position);
 
     currentPlane = static_cast<std::size_t>(FrustumPlanes::BOTTOM);
-    frustum[currentPlane].dist = cam_distance_from_origin;
-    Vector3 bottomEdge(((m_position + forward * m_nearDistance) + down * nearHalfExtents.y) - m_position);
+    Vector3 bottomEdge(forward * m_nearDistance + down * nearHalfExtents.y);
     bottomEdge.Normalize();
-    frustum[currentPlane].normal = CrossProduct(up, bottomEdge);
+    frustum[currentPlane].normal = CrossProduct(left, bottomEdge);
+    frustum[currentPlane].dist = MathUtils::DotProduct(frustum[currentPlane].normal, m_position);
 
     return std::move(frustum);
 }
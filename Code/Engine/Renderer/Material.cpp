@@ -84,7 +84,7 @@ void Material::SetShader(Shader* shader) {
 }
 
 bool Material::LoadFromXml(const XMLElement& element) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
 
     DataUtils::ValidateXmlElement(element, "material", "", "name", "shader,textures");
 
@@ -103,7 +103,7 @@ bool Material::LoadFromXml(const XMLElement& element) {
     }
 
     auto xml_textures = element.FirstChildElement("textures");
-    auto loaded_textures = _renderer->GetLoadedTextures();
+    const auto& loaded_textures = _renderer->GetLoadedTextures();
     auto invalid_tex = _renderer->GetTexture("__invalid");
     if(xml_textures != nullptr) {
 
@@ -113,7 +113,7 @@ bool Material::LoadFromXml(const XMLElement& element) {
             FS::path p(file);
             const auto& p_str = p.string();
             bool empty_path = p.empty();
-            bool texture_not_exist = !empty_path && loaded_textures.find(p_str) == loaded_textures.end();
+            bool texture_not_exist = !empty_path && FindStringId(loaded_textures, p_str) == loaded_textures.end();
             bool invalid_src = empty_path || texture_not_exist;
             auto tex = invalid_src ? invalid_tex : (_renderer->GetTexture(p_str));
             _textures[0] = tex;
@@ -125,7 +125,7 @@ bool Material::LoadFromXml(const XMLElement& element) {
             FS::path p(file);
             const auto& p_str = p.string();
             bool empty_path = p.empty();
-            bool texture_not_exist = !empty_path && loaded_textures.find(p_str) == loaded_textures.end();
+            bool texture_not_exist = !empty_path && FindStringId(loaded_textures, p_str) == loaded_textures.end();
             bool invalid_src = empty_path || texture_not_exist;
             auto tex = invalid_src ? invalid_tex : (_renderer->GetTexture(p_str));
             _textures[1] = tex;
@@ -137,7 +137,7 @@ bool Material::LoadFromXml(const XMLElement& element) {
             FS::path p(file);
             const auto& p_str = p.string();
             bool empty_path = p.empty();
-            bool texture_not_exist = !empty_path && loaded_textures.find(p_str) == loaded_textures.end();
+            bool texture_not_exist = !empty_path && FindStringId(loaded_textures, p_str) == loaded_textures.end();
             bool invalid_src = empty_path || texture_not_exist;
             auto tex = invalid_src ? invalid_tex : (_renderer->GetTexture(p_str));
             _textures[2] = tex;
@@ -149,7 +149,7 @@ bool Material::LoadFromXml(const XMLElement& element) {
             FS::path p(file);
             const auto& p_str = p.string();
             bool empty_path = p.empty();
-            bool texture_not_exist = !empty_path && loaded_textures.find(p_str) == loaded_textures.end();
+            bool texture_not_exist = !empty_path && FindStringId(loaded_textures, p_str) == loaded_textures.end();
             bool invalid_src = empty_path || texture_not_exist;
             auto tex = invalid_src ? invalid_tex : (_renderer->GetTexture(p_str));
             _textures[3] = tex;
@@ -161,7 +161,7 @@ bool Material::LoadFromXml(const XMLElement& element) {
             FS::path p(file);
             const auto& p_str = p.string();
             bool empty_path = p.empty();
-            bool texture_not_exist = !empty_path && loaded_textures.find(p_str) == loaded_textures.end();
+            bool texture_not_exist = !empty_path && FindStringId(loaded_textures, p_str) == loaded_textures.end();
             bool invalid_src = empty_path || texture_not_exist;
             auto tex = invalid_src ? invalid_tex : (_renderer->GetTexture(p_str));
             _textures[4] = tex;
@@ -173,7 +173,7 @@ bool Material::LoadFromXml(const XMLElement& element) {
             FS::path p(file);
             const auto& p_str = p.string();
             bool empty_path = p.empty();
-            bool texture_not_exist = !empty_path && loaded_textures.find(p_str) == loaded_textures.end();
+            bool texture_not_exist = !empty_path && FindStringId(loaded_textures, p_str) == loaded_textures.end();
             bool invalid_src = empty_path || texture_not_exist;
             auto tex = invalid_src ? invalid_tex : (_renderer->GetTexture(p_str));
             _textures[5] = tex;
@@ -189,7 +189,7 @@ bool Material::LoadFromXml(const XMLElement& element) {
             xml_texture = xml_texture->NextSiblingElement("texture"))
         {
             DataUtils::ValidateXmlElement(*xml_texture, "texture", "", "index,src");
-            std::size_t index = CUSTOM_TEXTURE_INDEX_OFFSET + DataUtils::ParseXmlAttribute(*xml_texture, std::string("index"), 0u);
+            std::size_t index = CUSTOM_TEXTURE_INDEX_OFFSET + DataUtils::ParseXmlAttribute(*xml_texture, "index", 0u);
             if(index >= MAX_CUSTOM_TEXTURE_COUNT) {
                 continue;
             }
@@ -197,7 +197,7 @@ bool Material::LoadFromXml(const XMLElement& element) {
             FS::path p(file);
             const auto& p_str = p.string();
             bool empty_path = p.empty();
-            bool texture_not_exist = !empty_path && loaded_textures.find(p_str) == loaded_textures.end();
+            bool texture_not_exist = !empty_path && FindStringId(loaded_textures, p_str) == loaded_textures.end();
             bool invalid_src = empty_path || texture_not_exist;
             auto tex = invalid_src ? invalid_tex : (_renderer->GetTexture(p_str));
             _textures[index] = tex;
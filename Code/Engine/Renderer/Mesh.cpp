@@ -159,7 +159,7 @@ MeshBuilder* Mesh::GetBuilder() const {
 
 bool Mesh::ParseObj(const std::string& filepath) {
 
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
 
     FS::path path = filepath;
     if (FS::exists(path) == false) {
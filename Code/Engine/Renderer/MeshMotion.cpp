@@ -4,6 +4,7 @@
 #include <cmath>
 
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Transform.hpp"
 
 #include "Engine/Renderer/MeshSkeleton.hpp"
 
@@ -48,37 +49,19 @@ void MeshMotion::evaluate(MeshPose& out, float time) const {
     float firstKeyFrame_idx = std::floor(calculatedFrame);
     float secondKeyFrame_idx = std::ceil(calculatedFrame);
 
-    MeshPose firstKeyFrame = poses[(unsigned int)firstKeyFrame_idx];
-    MeshPose secondKeyFrame = poses[(unsigned int)secondKeyFrame_idx];
-    //out = firstKeyFrame;
-    //return;
+    const MeshPose& firstKeyFrame = poses[(unsigned int)firstKeyFrame_idx];
+    const MeshPose& secondKeyFrame = poses[(unsigned int)secondKeyFrame_idx];
 
-    MeshPose result;
+    //Keys are decomposed to translation, rotation and scale and the rotations are blended as
+    //quaternions, so the result stays a rigid rotation with the keys' scale.
+    const float t = calculatedFrame - firstKeyFrame_idx;
     std::size_t s = (std::min)(firstKeyFrame.local_transforms.size(), secondKeyFrame.local_transforms.size());
-    for(unsigned int pose_idx = 0; pose_idx < s; ++pose_idx) {
-        const auto& first_transform = firstKeyFrame.local_transforms[pose_idx];
-        const auto& second_transform = secondKeyFrame.local_transforms[pose_idx];
-
-        Vector3 startTranslation = first_transform.GetTranslation();
-        Vector3 endTranslation = second_transform.GetTranslation();
-
-        //Quaternion startRot = Quaternion(first_transform);
-        //Quaternion endRot = Quaternion(second_transform);
-
-        Matrix4 startRot = Matrix4(first_transform.GetIBasis(), first_transform.GetJBasis(), first_transform.GetKBasis(), Vector4::W_AXIS);
-        Matrix4 endRot = Matrix4(second_transform.GetIBasis(), second_transform.GetJBasis(), second_transform.GetKBasis(), Vector4::W_AXIS);
-
-        Vector3 startScale = first_transform.GetScale();
-        Vector3 endScale = second_transform.GetScale();
-
-        float t = calculatedFrame - firstKeyFrame_idx;
-        Matrix4 T = Matrix4::CreateTranslationMatrix(Interpolate(startTranslation, endTranslation, t));
-        Matrix4 Q = Matrix4(MathUtils::Interpolate(startRot, endRot, t));
-        Matrix4 S = Matrix4::CreateScaleMatrix(Interpolate(startScale, endScale, t));
-        auto result_mat = T * Q * S;
-        result.local_transforms.push_back(result_mat);
+    out.local_transforms.resize(s);
+    for(std::size_t pose_idx = 0; pose_idx < s; ++pose_idx) {
+        const Transform start(firstKeyFrame.local_transforms[pose_idx]);
+        const Transform end(secondKeyFrame.local_transforms[pose_idx]);
+        out.local_transforms[pose_idx] = Interpolate(start, end, t).GetMatrix();
     }
-    out = result;
 }
 
 bool MeshMotion::write(FileUtils::BinaryStream& stream) const {
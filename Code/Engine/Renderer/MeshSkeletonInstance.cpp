@@ -1,6 +1,9 @@
 #include "Engine/Renderer/MeshSkeletonInstance.hpp"
 
+#include <algorithm>
+
 #include "Engine/Math/Matrix4.hpp"
+#include "Engine/Math/Transform.hpp"
 
 #include "Engine/Renderer/MeshMotion.hpp"
 #include "Engine/Renderer/SimpleRenderer.hpp"
@@ -26,24 +29,19 @@ MeshSkeletonInstance::~MeshSkeletonInstance() {
 }
 
 Matrix4 MeshSkeletonInstance::get_joint_global_transform(std::size_t joint_idx) const {
+    const std::size_t joint_count = get_joint_count();
+    if(joint_idx >= joint_count || current_pose.local_transforms.size() < joint_count) {
+        return Matrix4::GetIdentity();
+    }
+    UpdateJointParents();
     Matrix4 result = current_pose.local_transforms[joint_idx];
-    for(MeshSkeleton::Joint* cur_joint_parent = get_joint_parent(joint_idx);
-        cur_joint_parent != nullptr;
-        cur_joint_parent = cur_joint_parent->parent) {
-        result = current_pose.local_transforms[skeleton->get_joint_index(cur_joint_parent->name)] * result;
-        auto t = result.GetTranslation();
+    for(std::size_t parent = _jointParents[joint_idx]; parent != TransformHierarchy::NO_PARENT; parent = _jointParents[parent]) {
+        result = current_pose.local_transforms[parent] * result;
     }
     return result;
 }
 Matrix4 MeshSkeletonInstance::get_joint_global_transform(const std::string& joint_name) const {
-    Matrix4 result = current_pose.local_transforms[skeleton->get_joint_index(joint_name)];
-    for(MeshSkeleton::Joint* cur_joint_parent = get_joint_parent(joint_name);
-        cur_joint_parent != nullptr;
-        cur_joint_parent = cur_joint_parent->parent) {
-        result = current_pose.local_transforms[skeleton->get_joint_index(cur_joint_parent->name)] * result;
-        auto t = result.GetTranslation();
-    }
-    return result;
+    return get_joint_global_transform(skeleton->get_joint_index(joint_name));
 }
 MeshSkeleton::Joint* MeshSkeletonInstance::get_joint_parent(std::size_t joint_idx) const {
     return (skeleton->get_joint_parent(joint_idx));
@@ -71,10 +69,11 @@ void MeshSkeletonInstance::SetLocalTransform(const Matrix4& transform) {
 void MeshSkeletonInstance::Update(float /*deltaSeconds*/) {
     if(_currentMotion && skeleton && _skinTransforms) {
         _currentMotion->evaluate(current_pose, _currentMotionTime);
-        auto joint_count = get_joint_count();
+        UpdateJointGlobalTransforms();
+        auto joint_count = _jointGlobalTransforms.size();
         for(std::size_t i = 0; i < joint_count; ++i) {
             auto A = skeleton->get_joint_transform(i);
-            auto C = get_joint_global_transform(i);
+            auto C = _jointGlobalTransforms[i];
             auto A_inv = Matrix4::CalculateInverse(A);
             auto S = C * A_inv;
             _skinTransforms_data[i] = S;
@@ -87,11 +86,12 @@ void MeshSkeletonInstance::Render() const {
     _renderer->SetModelMatrix(Matrix4::GetIdentity());
     _renderer->SetMaterial(_renderer->GetMaterial("__unlit"));
     _renderer->DisableDepthStencil();
-    for(unsigned int i = 0; i < get_joint_count(); ++i) {
-        auto p = get_joint_parent(i);
-        if(p) {
-            auto p1 = _localTransform * get_joint_global_transform(p->name);
-            auto p2 = _localTransform * get_joint_global_transform(i);
+    UpdateJointGlobalTransforms();
+    for(std::size_t i = 0; i < _jointGlobalTransforms.size(); ++i) {
+        auto p = _jointParents[i];
+        if(p != TransformHierarchy::NO_PARENT) {
+            auto p1 = _localTransform * _jointGlobalTransforms[p];
+            auto p2 = _localTransform * _jointGlobalTransforms[i];
             _renderer->DrawLine(Vertex3D(p1.GetTranslation(), Rgba::GREEN), Vertex3D(p2.GetTranslation(), Rgba::RED));
         }
     }
@@ -105,4 +105,29 @@ void MeshSkeletonInstance::InitializeSkinTransforms() {
     }
     _skinTransforms = _renderer->_rhi_device->CreateStructuredBuffer(_skinTransforms_data.data(), sizeof(Matrix4), static_cast<unsigned int>(size), BufferUsage::DYNAMIC, BufferBindUsage::SHADER_RESOURCE);
     _renderer->_rhi_context->SetStructuredBuffer(0, _skinTransforms);
-}
\ No newline at end of file
+}
+
+void MeshSkeletonInstance::UpdateJointParents() const {
+    const std::size_t joint_count = get_joint_count();
+    if(_jointParentsSkeleton == skeleton && _jointParents.size() == joint_count) {
+        return;
+    }
+    _jointParentsSkeleton = skeleton;
+    _jointParents.resize(joint_count);
+    for(std::size_t i = 0; i < joint_count; ++i) {
+        const MeshSkeleton::Joint* parent = get_joint_parent(i);
+        _jointParents[i] = parent ? skeleton->get_joint_index(parent->name) : TransformHierarchy::NO_PARENT;
+    }
+}
+
+void MeshSkeletonInstance::UpdateJointGlobalTransforms() const {
+    const std::size_t joint_count = is_loaded() ? (std::min)(get_joint_count(), current_pose.local_transforms.size()) : 0;
+    if(joint_count == 0) {
+        _jointGlobalTransforms.clear();
+        return;
+    }
+    UpdateJointParents();
+    _jointGlobalTransforms.resize(joint_count);
+    //Joints are added parent-first, so every global transform is one multiply.
+    TransformHierarchy::CalculateWorldMatrices(std::span<const std::size_t>(_jointParents.data(), joint_count), std::span<const Matrix4>(current_pose.local_transforms.data(), joint_count), _jointGlobalTransforms);
+}
@@ -36,10 +36,19 @@ public:
 
 protected:
 private:
+    //Parent index of each joint, TransformHierarchy::NO_PARENT for roots. Rebuilt when the
+    //skeleton or its joint count changes.
+    void UpdateJointParents() const;
+    //Global transform of every joint in current_pose, computed in one parent-first pass.
+    void UpdateJointGlobalTransforms() const;
+
     SimpleRenderer* _renderer;
     StructuredBuffer* _skinTransforms;
     MeshMotion* _currentMotion;
     float _currentMotionTime;
     Matrix4 _localTransform;
     std::vector<Matrix4> _skinTransforms_data;
+    mutable const MeshSkeleton* _jointParentsSkeleton = nullptr;
+    mutable std::vector<std::size_t> _jointParents;
+    mutable std::vector<Matrix4> _jointGlobalTransforms;
 };
\ No newline at end of file
@@ -164,7 +164,7 @@ void Renderer::DrawLines(const Vertex2D* vertexes, int numVertexes) {
 }
 
 SpriteSheet* Renderer::CreateSpriteSheet(const std::string& filepath, int tileWidth, int tileHeight) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     Texture* t = nullptr;
     FS::path p(filepath);
     if(FS::exists(p) == false) {
@@ -106,11 +106,11 @@ RasterState* Shader::GetRasterState() const {
 }
 
 bool Shader::LoadFromXML(const XMLElement& element) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
 
     DataUtils::ValidateXmlElement(element, "shader", "shaderprogram", "name", "depth,stencil,blends,raster,sampler");
 
-    _name = DataUtils::ParseXmlAttribute(element, std::string("name"), "UNNAMED_SHADER");
+    _name = DataUtils::ParseXmlAttribute(element, "name", "UNNAMED_SHADER");
 
     auto xml_SP = element.FirstChildElement("shaderprogram");
     DataUtils::ValidateXmlElement(*xml_SP, "shaderprogram", "", "src");
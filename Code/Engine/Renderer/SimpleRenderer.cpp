@@ -5,11 +5,13 @@
 #include "Engine/Window.hpp"
 
 #include "Engine/Core/BitmapFont.hpp"
+#include "Engine/Core/DataUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/FileUtils.hpp"
 #include "Engine/Core/KerningFont.hpp"
 #include "Engine/Core/Image.hpp"
 #include "Engine/Core/Rgba.hpp"
+#include "Engine/Core/TextLayout.hpp"
 
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/MathUtils.hpp"
@@ -76,6 +78,11 @@ SimpleRenderer::SimpleRenderer(unsigned int width, unsigned int height)
     , _current_blend_state(nullptr)
     , _depthstencil_state{}
     , _current_depthstencil_state(nullptr)
+    , _font_materials{}
+    , _text_batches{}
+    , _text_vbo{}
+    , _text_ibo{}
+    , _text_batch_depth(0)
     , m_windowWidth(width)
     , m_windowHeight(height)
 {
@@ -480,11 +487,11 @@ bool SimpleRenderer::RegisterShader(const std::string& name, Shader* shader) {
 }
 
 bool SimpleRenderer::RegisterShaderFromFile(const std::string& filepath) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(filepath);
 
     tinyxml2::XMLDocument doc;
-    auto load_result = doc.LoadFile(p.string().c_str());
+    auto load_result = DataUtils::LoadXmlDocument(doc, p.string());
     bool success = load_result == tinyxml2::XML_SUCCESS;
     if(success) {
         Shader* shader = new Shader(this, *doc.RootElement());
@@ -495,7 +502,7 @@ bool SimpleRenderer::RegisterShaderFromFile(const std::string& filepath) {
 }
 
 bool SimpleRenderer::RegisterShadersFromFolder(const std::string& folderpath, bool recursive /*= false*/) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(folderpath);
     { //Avoid pollution by error code.
         std::error_code ec;
@@ -1404,7 +1411,7 @@ Sampler* SimpleRenderer::CreateDefaultSampler() {
 }
 
 Material* SimpleRenderer::CreateOrGetMaterial(const std::string& material_str) {
-    auto material_iter = _materials.find(material_str);
+    auto material_iter = FindStringId(_materials, material_str);
     auto material_exists = material_iter != _materials.end();
     if(material_exists) {
         return GetMaterial(material_str);
@@ -1414,13 +1421,13 @@ Material* SimpleRenderer::CreateOrGetMaterial(const std::string& material_str) {
 }
 
 Material* SimpleRenderer::CreateMaterial(const std::string& filepath) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(filepath);
     if(p.extension() != ".material") {
         return nullptr;
     }
     tinyxml2::XMLDocument doc;
-    auto load_result = doc.LoadFile(p.string().c_str());
+    auto load_result = DataUtils::LoadXmlDocument(doc, p.string());
     if(load_result == tinyxml2::XML_SUCCESS) {
         return new Material(this, *doc.RootElement());
     } else {
@@ -1429,9 +1436,8 @@ Material* SimpleRenderer::CreateMaterial(const std::string& filepath) {
 }
 
 Material* SimpleRenderer::GetMaterial(const std::string& name) {
-    namespace FS = std::experimental::filesystem;
-    FS::path p(name);
-    return _materials[p.string()];
+    auto material_iter = FindStringId(_materials, name);
+    return material_iter != _materials.end() ? material_iter->second : nullptr;
 }
 
 void SimpleRenderer::SetMaterial(Material* mat /*= nullptr*/) {
@@ -1522,7 +1528,7 @@ void SimpleRenderer::SetShader(Shader* shader /*= nullptr*/) {
 }
 
 Shader* SimpleRenderer::GetShader(const std::string& name) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(name);
     return _shaders[p.string()];
 }
@@ -1976,34 +1982,20 @@ void SimpleRenderer::UpdateIbo(const std::vector<unsigned int>& new_ibo) {
 }
 
 bool SimpleRenderer::RegisterFontsFromFolder(const std::string& folderpath, bool recursive /*= false*/) {
-    namespace FS = std::experimental::filesystem;
-    FS::path p(folderpath);
-    { //Avoid pollution by error code.
-        std::error_code ec;
-        if(!FS::exists(folderpath) || !FS::is_directory(p, ec)) {
-            std::ostringstream ss;
-            ss << "SimpleRenderer::RegisterFontsFromFolder: \"" << folderpath << "\" does not exist or is not a directory. Filesystem reported the following error: " << ec.message() << "\n";
-            g_theFileLogger->LogErrorf(ss.str().c_str());
-            g_theFileLogger->LogFlush();
-            ERROR_AND_DIE(ss.str().c_str());
-        }
+    namespace FS = std::filesystem;
+    if(!FileUtils::FolderExists(folderpath)) {
+        std::ostringstream ss;
+        ss << "SimpleRenderer::RegisterFontsFromFolder: \"" << folderpath << "\" does not exist or is not a directory.\n";
+        g_theFileLogger->LogErrorf(ss.str().c_str());
+        g_theFileLogger->LogFlush();
+        ERROR_AND_DIE(ss.str().c_str());
     }
-    if(!recursive) {
-        for(FS::directory_iterator dir_iter(p); dir_iter != FS::directory_iterator{} /* defaults to end iter */; ++dir_iter) {
-            FS::path current_path = dir_iter->path();
-            if(FS::is_directory(current_path)) continue;
-            if(current_path.extension() != ".fnt") continue;
-            CreateOrGetFont(current_path.stem().string());
-        }
-        return true;
-    } else {
-        for(FS::recursive_directory_iterator dir_iter(p); dir_iter != FS::recursive_directory_iterator{} /* defaults to end iter */; ++dir_iter) {
-            FS::path current_path = dir_iter->path();
-            if(current_path.extension() != ".fnt") continue;
-            CreateOrGetFont(current_path.stem().string());
-        }
-        return true;
+    for(auto& filepath : FileUtils::EnumerateFiles(folderpath, recursive)) {
+        FS::path current_path(filepath);
+        if(current_path.extension() != ".fnt") continue;
+        CreateOrGetFont(current_path.stem().string());
     }
+    return true;
 }
 
 bool SimpleRenderer::RegisterMotion(const std::string& fbx_path, MeshMotion* motion) {
@@ -2325,7 +2317,7 @@ void SimpleRenderer::DrawDebugX2D(const Vector2& center, float radius, float thi
 
 ComputeShader* SimpleRenderer::CreateComputeShader(const std::string& filepath) {
 
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
 
     FS::path p = filepath;
     if(FS::exists(p) == false) {
@@ -2373,7 +2365,7 @@ RasterState* SimpleRenderer::GetRasterState(const std::string& name) {
 void SimpleRenderer::ReloadTextures() {
     std::vector<std::string> texture_paths;
     for(auto& t : _textures) {
-        texture_paths.push_back(t.first);
+        texture_paths.emplace_back(t.first.GetString());
         delete t.second;
     }
     for(auto& p : texture_paths) {
@@ -2381,7 +2373,7 @@ void SimpleRenderer::ReloadTextures() {
     }
 }
 
-const std::map<std::string, Texture2D*>& SimpleRenderer::GetLoadedTextures() const {
+const std::unordered_map<StringId, Texture2D*>& SimpleRenderer::GetLoadedTextures() const {
     return _textures;
 }
 
@@ -2538,7 +2530,7 @@ SpriteSheet* SimpleRenderer::CreateSpriteSheet(const XMLElement& elem) {
 }
 
 SpriteSheet* SimpleRenderer::CreateSpriteSheet(const std::string& filepath, int tileWidth, int tileHeight) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     Texture2D* t = nullptr;
     FS::path p(filepath);
     if(FS::exists(p) == false) {
@@ -2584,7 +2576,7 @@ MeshMotion* SimpleRenderer::GetMotion(const std::string& fbx_path) {
 }
 
 MeshMotion* SimpleRenderer::CreateMotion(const std::string& fbx_path, MeshSkeleton& meshSkeleton, MeshSkeletonInstance& meshSkeletonInstance, const Matrix4& initialTransform /*= Matrix4::GetIdentity()*/) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
 
     FS::path file_path_load(fbx_path);
     std::string folder_path_load = file_path_load.parent_path().string() + "/";
@@ -2652,7 +2644,7 @@ MeshSkeleton* SimpleRenderer::GetSkeleton(const std::string& fbx_path) {
 }
 
 MeshSkeleton* SimpleRenderer::CreateSkeleton(const std::string& fbx_path, const Matrix4& initialTransform) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
 
     FS::path file_path_load(fbx_path);
     std::string folder_path_load = file_path_load.parent_path().string() + "\\";
@@ -2718,7 +2710,7 @@ Mesh* SimpleRenderer::GetMesh(const std::string& fbx_path) {
 }
 
 Mesh* SimpleRenderer::CreateMesh(const Model::Type& type, const std::string& fbx_path, const Matrix4& initialTransform /*= Matrix4::GetIdentity()*/, MeshSkeleton* skeleton /*= nullptr*/) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
 
     FS::path file_path_load(fbx_path);
     std::string folder_path_load = file_path_load.parent_path().string() + "\\";
@@ -2800,13 +2792,13 @@ Model* SimpleRenderer::CreateOrGetModel(const Model::Type& type, const std::stri
 }
 
 Model* SimpleRenderer::GetModel(const std::string& folderpath) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(folderpath);
     return _models[p.string()];
 }
 
 Model* SimpleRenderer::CreateModel(const Model::Type& type, const std::string& folderpath, const Matrix4& initialTransform /*= Matrix4::GetIdentity()*/) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(folderpath);
     Model* model = new Model(type, this, p.string(), initialTransform);
     RegisterModel(p.string(), model);
@@ -2821,7 +2813,7 @@ void SimpleRenderer::ExportFBXToEngineAsset(const std::string& fbx_path, const M
 
 void SimpleRenderer::ExportFBXMotionToEngineAsset(const std::string& fbx_path, const MeshMotion& motion) {
 
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
 
     FS::path file_path(fbx_path);
     std::string folder_path = file_path.parent_path().string() + "/";
@@ -2838,7 +2830,7 @@ void SimpleRenderer::ExportFBXMotionToEngineAsset(const std::string& fbx_path, c
 
 void SimpleRenderer::ExportFBXSkeletonToEngineAsset(const std::string& fbx_path, const MeshSkeleton& skeleton) {
 
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
 
     FS::path file_path(fbx_path);
     std::string folder_path = file_path.parent_path().string() + "/";
@@ -2854,7 +2846,7 @@ void SimpleRenderer::ExportFBXSkeletonToEngineAsset(const std::string& fbx_path,
 
 void SimpleRenderer::ExportFBXMeshToEngineAsset(const std::string& fbx_path, const Mesh& model) {
 
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
 
     FS::path file_path(fbx_path);
     std::string folder_path = file_path.parent_path().string() + "/";
@@ -3027,35 +3019,20 @@ bool SimpleRenderer::RegisterShaderProgramFromFile(RHIDevice* device, const std:
 }
 
 bool SimpleRenderer::RegisterTexturesFromFolder(const std::string& folderpath, bool recursive /*= false*/) {
-    namespace FS = std::experimental::filesystem;
-    FS::path p(folderpath);
-    { //Avoid pollution by error code.
-        std::error_code ec;
-        if (!FS::exists(folderpath) || !FS::is_directory(p, ec)) {
-            std::ostringstream ss;
-            ss << "SimpleRenderer::RegisterTexturesFromFolder: \"" << folderpath << "\" does not exist or is not a directory. Filesystem reported the following error: " << ec.message() << "\n";
-            g_theFileLogger->LogErrorf(ss.str().c_str());
-            g_theFileLogger->LogFlush();
-            ERROR_AND_DIE(ss.str().c_str());
-        }
-    }
-    if (!recursive) {
-        for (FS::directory_iterator dir_iter(p); dir_iter != FS::directory_iterator{} /* defaults to end iter */; ++dir_iter) {
-            FS::path current_path = dir_iter->path();
-            if(FS::is_directory(current_path)) continue;
-            if(!IsSupportedImageType(current_path.extension().string())) continue;
-            CreateOrGetTexture(current_path.string());
-        }
-        return true;
+    namespace FS = std::filesystem;
+    if(!FileUtils::FolderExists(folderpath)) {
+        std::ostringstream ss;
+        ss << "SimpleRenderer::RegisterTexturesFromFolder: \"" << folderpath << "\" does not exist or is not a directory.\n";
+        g_theFileLogger->LogErrorf(ss.str().c_str());
+        g_theFileLogger->LogFlush();
+        ERROR_AND_DIE(ss.str().c_str());
     }
-    else {
-        for (FS::recursive_directory_iterator dir_iter(p); dir_iter != FS::recursive_directory_iterator{} /* defaults to end iter */; ++dir_iter) {
-            FS::path current_path = dir_iter->path();
-            if(!IsSupportedImageType(current_path.extension().string())) continue;
-            CreateOrGetTexture(current_path.string());
-        }
-        return true;
+    for(auto& filepath : FileUtils::EnumerateFiles(folderpath, recursive)) {
+        FS::path current_path(filepath);
+        if(!IsSupportedImageType(current_path.extension().string())) continue;
+        CreateOrGetTexture(current_path.string());
     }
+    return true;
 }
 
 bool SimpleRenderer::RegisterComputeShaderFromFile(RHIDevice* device, const std::string& filepath, ComputeShader*& output_program) {
@@ -3064,7 +3041,7 @@ bool SimpleRenderer::RegisterComputeShaderFromFile(RHIDevice* device, const std:
 }
 
 bool SimpleRenderer::RegisterComputeShadersFromFolder(RHIDevice* device, const std::string& folderpath, bool recursive /*= false*/) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(folderpath);
     { //Avoid pollution by error code.
         std::error_code ec;
@@ -3102,24 +3079,26 @@ bool SimpleRenderer::RegisterComputeShadersFromFolder(RHIDevice* device, const s
 }
 
 bool SimpleRenderer::RegisterMaterial(const std::string& name, Material* mat) {
-    auto material_iter = _materials.find(name);
+    auto material_iter = FindStringId(_materials, name);
     bool material_exists = material_iter != _materials.end();
     if(material_exists) {
         delete material_iter->second;
         material_iter->second = nullptr;
         if(mat == nullptr) {
+            _font_materials.clear();
             return false;
         }
     }
-    _materials.insert_or_assign(name, mat);
+    _font_materials.clear();
+    _materials.insert_or_assign(StringId(name), mat);
     return true;
 }
 
 bool SimpleRenderer::RegisterMaterialFromFile(const std::string& filepath) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(filepath);
     tinyxml2::XMLDocument doc;
-    auto load_result = doc.LoadFile(p.string().c_str());
+    auto load_result = DataUtils::LoadXmlDocument(doc, p.string());
     bool success = load_result == tinyxml2::XML_SUCCESS;
     if(success) {
         Material* mat = new Material(this, *doc.RootElement());
@@ -3130,76 +3109,43 @@ bool SimpleRenderer::RegisterMaterialFromFile(const std::string& filepath) {
 }
 
 bool SimpleRenderer::RegisterMaterialsFromFolder(const std::string& folderpath, bool recursive /*= false*/) {
-    namespace FS = std::experimental::filesystem;
-    FS::path p(folderpath);
-    { //Avoid pollution by error code.
-        std::error_code ec;
-        if(!FS::exists(folderpath) || !FS::is_directory(p, ec)) {
-            std::ostringstream ss;
-            ss << "Material::RegisterMaterialsFromFolder: \"" << folderpath << "\" does not exist or is not a directory. Filesystem reported the following error: " << ec.message() << "\n";
-            g_theFileLogger->LogErrorf(ss.str().c_str());
-            g_theFileLogger->LogFlush();
-            ERROR_AND_DIE(ss.str().c_str());
-        }
+    namespace FS = std::filesystem;
+    if(!FileUtils::FolderExists(folderpath)) {
+        std::ostringstream ss;
+        ss << "Material::RegisterMaterialsFromFolder: \"" << folderpath << "\" does not exist or is not a directory.\n";
+        g_theFileLogger->LogErrorf(ss.str().c_str());
+        g_theFileLogger->LogFlush();
+        ERROR_AND_DIE(ss.str().c_str());
     }
-    if(!recursive) {
-        for(FS::directory_iterator dir_iter(p); dir_iter != FS::directory_iterator{} /* defaults to end iter */; ++dir_iter) {
-            FS::path current_path = dir_iter->path();
-            if(FS::is_directory(current_path)) continue;
-            if(current_path.extension() != ".material") continue;
-            if(!RegisterMaterialFromFile(current_path.string())) {
-                return false;
-            }
-        }
-        return true;
-    } else {
-        for(FS::recursive_directory_iterator dir_iter(p); dir_iter != FS::recursive_directory_iterator{} /* defaults to end iter */; ++dir_iter) {
-            FS::path current_path = dir_iter->path();
-            if(current_path.extension() != ".material") continue;
-            if(!RegisterMaterialFromFile(current_path.string())) {
-                return false;
-            }
+    for(auto& filepath : FileUtils::EnumerateFiles(folderpath, recursive)) {
+        FS::path current_path(filepath);
+        if(current_path.extension() != ".material") continue;
+        if(!RegisterMaterialFromFile(current_path.string())) {
+            return false;
         }
-        return true;
     }
+    return true;
 }
 
 bool SimpleRenderer::RegisterShaderProgramsFromFolder(RHIDevice* device, const std::string& folderpath, bool recursive /*= false*/) {
-    namespace FS = std::experimental::filesystem;
-    FS::path p(folderpath);
-    { //Avoid pollution by error code.
-        std::error_code ec;
-        if(!FS::exists(folderpath) || !FS::is_directory(p, ec)) {
-            std::ostringstream ss;
-            ss << "ShaderProgram::RegisterShadersFromFolder: \"" << folderpath << "\" does not exist or is not a directory. Filesystem reported the following error: " << ec.message() << "\n";
-            g_theFileLogger->LogErrorf(ss.str().c_str());
-            g_theFileLogger->LogFlush();
-            ERROR_AND_DIE(ss.str().c_str());
-        }
+    namespace FS = std::filesystem;
+    if(!FileUtils::FolderExists(folderpath)) {
+        std::ostringstream ss;
+        ss << "ShaderProgram::RegisterShadersFromFolder: \"" << folderpath << "\" does not exist or is not a directory.\n";
+        g_theFileLogger->LogErrorf(ss.str().c_str());
+        g_theFileLogger->LogFlush();
+        ERROR_AND_DIE(ss.str().c_str());
     }
-    if(!recursive) {
-        for(FS::directory_iterator dir_iter(p); dir_iter != FS::directory_iterator{} /* defaults to end iter */; ++dir_iter) {
-            FS::path current_path = dir_iter->path();
-            if(current_path.extension() != ".hlsl") continue;
-            ShaderProgram* current_program = nullptr;
-            if(!RegisterShaderProgramFromFile(device, current_path.string(), current_program)) {
-                return false;
-            }
-            _shaderPrograms.insert_or_assign(current_path.string(), current_program);
-        }
-        return true;
-    } else {
-        for(FS::recursive_directory_iterator dir_iter(p); dir_iter != FS::recursive_directory_iterator{} /* defaults to end iter */; ++dir_iter) {
-            FS::path current_path = dir_iter->path();
-            if(current_path.extension() != ".hlsl") continue;
-            ShaderProgram* current_program = nullptr;
-            if(!RegisterShaderProgramFromFile(device, current_path.string(), current_program)) {
-                return false;
-            }
-            _shaderPrograms.insert_or_assign(current_path.string(), current_program);
+    for(auto& filepath : FileUtils::EnumerateFiles(folderpath, recursive)) {
+        FS::path current_path(filepath);
+        if(current_path.extension() != ".hlsl") continue;
+        ShaderProgram* current_program = nullptr;
+        if(!RegisterShaderProgramFromFile(device, current_path.string(), current_program)) {
+            return false;
         }
-        return true;
+        _shaderPrograms.insert_or_assign(current_path.string(), current_program);
     }
+    return true;
 }
 
 void SimpleRenderer::DrawTextLine(KerningFont* f, const std::string& text, const Vector2& bottomLeftStartPos /*= Vector2::ZERO*/, const Rgba& color /*= Rgba::WHITE*/, float scale /*= 1.0f*/) {
@@ -3207,36 +3153,34 @@ void SimpleRenderer::DrawTextLine(KerningFont* f, const std::string& text, const
 }
 
 void SimpleRenderer::DrawTextLine(KerningFont* f, const std::string& text, const Rgba& color /*= Rgba::WHITE*/, float sx /*= 0.0f*/, float sy /*= 0.0f*/, float /*scale*/ /*= 1.0f*/) {
-    if(f == nullptr) {
+    if(f == nullptr || text.empty()) {
+        return;
+    }
+    Material* material = GetFontMaterial(f);
+    if(_text_batch_depth) {
+        AppendTextLine(f, text, color, sx, sy, GetTextBatchVbo(material));
         return;
     }
+    _text_vbo.clear();
+    AppendTextLine(f, text, color, sx, sy, _text_vbo);
+    DrawTextVbo(material, _text_vbo);
+}
 
-    namespace FS = std::experimental::filesystem;
+void SimpleRenderer::AppendTextLine(KerningFont* f, std::string_view text, const Rgba& color, float sx, float sy, std::vector<Vertex3D>& vbo) const {
+    if(f == nullptr || text.empty()) {
+        return;
+    }
 
-    float lineHeight = static_cast<float>(f->GetLineHeight());
-    //float inv_lineHeight = 1.0f / lineHeight;
     float cursor_x = sx;
-    float cursor_y = sy;
-    float line_top = cursor_y - f->_common.base;
-    float line_bottom = line_top + lineHeight;
-    line_bottom; //UNUSED
+    float line_top = sy - f->_common.base;
     float texture_w = static_cast<float>(f->_common.scaleW);
     float texture_h = static_cast<float>(f->_common.scaleH);
 
-    std::vector<Vertex3D> font_vbo;
-    font_vbo.reserve(text.size() * 4);
-    std::vector<unsigned int> font_ibo;
-    font_ibo.reserve(text.size() * 6);
-
-    Texture2D* texture = nullptr;
+    vbo.reserve(vbo.size() + text.size() * 4);
+    int page = f->GetGlyph(text.front()).page;
     for(auto char_iter = text.begin(); char_iter != text.end(); /* DO NOTHING */) {
-        KerningFont::CharDef current_charDef = f->GetCharDef(*char_iter);
-        if(!texture) {
-            texture = GetTexture(f->_image_paths[current_charDef.page]);
-        } else {
-            Texture2D* texture2 = GetTexture(f->_image_paths[current_charDef.page]);
-            ASSERT_OR_DIE(texture == texture2, "Font characters not on single page!");
-        }
+        const KerningFont::CharDef& current_charDef = f->GetGlyph(*char_iter);
+        ASSERT_OR_DIE(current_charDef.page == page, "Font characters not on single page!");
 
         //Get Font Texture UVs
         float char_uvl = current_charDef.x / texture_w;
@@ -3250,41 +3194,116 @@ void SimpleRenderer::DrawTextLine(KerningFont* f, const std::string& text, const
         float quad_left = cursor_x + static_cast<float>(current_charDef.xoffset);
         float quad_right = quad_left + current_charDef.width;
 
-        font_vbo.emplace_back(Vector3(quad_left, quad_bottom, 0.0), color, Vector2(char_uvl, char_uvb), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
-        font_vbo.emplace_back(Vector3(quad_left, quad_top, 0.0), color, Vector2(char_uvl, char_uvt), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
-        font_vbo.emplace_back(Vector3(quad_right, quad_top, 0.0), color, Vector2(char_uvr, char_uvt), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
-        font_vbo.emplace_back(Vector3(quad_right, quad_bottom, 0.0), color, Vector2(char_uvr, char_uvb), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
-
-        unsigned int s = static_cast<unsigned int>(font_vbo.size());
-        font_ibo.push_back(s - 4);
-        font_ibo.push_back(s - 3);
-        font_ibo.push_back(s - 2);
-        font_ibo.push_back(s - 4);
-        font_ibo.push_back(s - 2);
-        font_ibo.push_back(s - 1);
+        vbo.emplace_back(Vector3(quad_left, quad_bottom, 0.0), color, Vector2(char_uvl, char_uvb), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
+        vbo.emplace_back(Vector3(quad_left, quad_top, 0.0), color, Vector2(char_uvl, char_uvt), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
+        vbo.emplace_back(Vector3(quad_right, quad_top, 0.0), color, Vector2(char_uvr, char_uvt), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
+        vbo.emplace_back(Vector3(quad_right, quad_bottom, 0.0), color, Vector2(char_uvr, char_uvb), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
 
         auto previous_char = char_iter;
         ++char_iter;
         if(char_iter != text.end()) {
-            auto kern_iter = f->_kernmap.find(std::make_pair(*previous_char, *char_iter));
-            float kern_value = 0.0f;
-            if(kern_iter != f->_kernmap.end()) {
-                kern_value = static_cast<float>(kern_iter->second);
-            }
+            float kern_value = static_cast<float>(f->GetKerning(static_cast<unsigned char>(*previous_char), static_cast<unsigned char>(*char_iter)));
             cursor_x += (current_charDef.xadvance + kern_value);
         }
     }
-    if(texture) {
-        std::ostringstream ss;
-        FS::path p(f->_filepath);
-        p.replace_extension(".material");
-        ss << p.string();
-        SetMaterial(GetMaterial(ss.str()));
-        UpdateVbo(font_vbo);
-        UpdateIbo(font_ibo);
-        DrawIndexed(PrimitiveType::TRIANGLES, _temp_vbo, _temp_ibo, font_ibo.size());
+}
+
+void SimpleRenderer::AppendTextLayout(const TextLayout& layout, const Rgba& color, float sx, float sy, std::vector<Vertex3D>& vbo) const {
+    const auto& glyphs = layout.GetGlyphs();
+    vbo.reserve(vbo.size() + glyphs.size() * 4);
+    for(const auto& glyph : glyphs) {
+        float quad_left = sx + glyph.left;
+        float quad_right = sx + glyph.right;
+        float quad_top = sy + glyph.top;
+        float quad_bottom = sy + glyph.bottom;
+        vbo.emplace_back(Vector3(quad_left, quad_bottom, 0.0), color, Vector2(glyph.uv_left, glyph.uv_bottom), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
+        vbo.emplace_back(Vector3(quad_left, quad_top, 0.0), color, Vector2(glyph.uv_left, glyph.uv_top), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
+        vbo.emplace_back(Vector3(quad_right, quad_top, 0.0), color, Vector2(glyph.uv_right, glyph.uv_top), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
+        vbo.emplace_back(Vector3(quad_right, quad_bottom, 0.0), color, Vector2(glyph.uv_right, glyph.uv_bottom), -Vector3::Z_AXIS, Vector3::X_AXIS, Vector3::Vector3::Y_AXIS);
+    }
+}
+
+void SimpleRenderer::DrawTextLayout(const TextLayout& layout, const Rgba& color /*= Rgba::WHITE*/, float sx /*= 0.0f*/, float sy /*= 0.0f*/) {
+    KerningFont* f = const_cast<KerningFont*>(layout.GetFont());
+    if(f == nullptr || layout.GetGlyphs().empty()) {
+        return;
     }
+    Material* material = GetFontMaterial(f);
+    if(_text_batch_depth) {
+        AppendTextLayout(layout, color, sx, sy, GetTextBatchVbo(material));
+        return;
+    }
+    _text_vbo.clear();
+    AppendTextLayout(layout, color, sx, sy, _text_vbo);
+    DrawTextVbo(material, _text_vbo);
+}
 
+void SimpleRenderer::BeginTextBatch() {
+    ++_text_batch_depth;
+}
+
+void SimpleRenderer::EndTextBatch() {
+    GUARANTEE_OR_DIE(_text_batch_depth, "SimpleRenderer::EndTextBatch called without BeginTextBatch.");
+    if(--_text_batch_depth) {
+        return;
+    }
+    for(auto& batch : _text_batches) {
+        DrawTextVbo(batch.material, batch.vbo);
+        batch.vbo.clear();
+    }
+}
+
+std::vector<Vertex3D>& SimpleRenderer::GetTextBatchVbo(Material* material) {
+    auto found = std::find_if(_text_batches.begin(), _text_batches.end(), [material](const text_batch_t& batch) { return batch.material == material; });
+    if(found != _text_batches.end()) {
+        return found->vbo;
+    }
+    _text_batches.push_back(text_batch_t{ material, {} });
+    return _text_batches.back().vbo;
+}
+
+void SimpleRenderer::DrawTextVbo(Material* material, const std::vector<Vertex3D>& vbo) {
+    if(vbo.empty()) {
+        return;
+    }
+    _text_ibo.clear();
+    AppendQuadIndices(0, vbo.size() / 4, _text_ibo);
+
+    SetMaterial(material);
+    UpdateVbo(vbo);
+    UpdateIbo(_text_ibo);
+    DrawIndexed(PrimitiveType::TRIANGLES, _temp_vbo, _temp_ibo, _text_ibo.size());
+}
+
+void SimpleRenderer::AppendQuadIndices(std::size_t first_vertex, std::size_t quad_count, std::vector<unsigned int>& ibo) {
+    ibo.reserve(ibo.size() + quad_count * 6);
+    for(std::size_t i = 0; i < quad_count; ++i) {
+        unsigned int s = static_cast<unsigned int>(first_vertex + i * 4);
+        ibo.push_back(s + 0);
+        ibo.push_back(s + 1);
+        ibo.push_back(s + 2);
+        ibo.push_back(s + 0);
+        ibo.push_back(s + 2);
+        ibo.push_back(s + 3);
+    }
+}
+
+Material* SimpleRenderer::GetFontMaterial(const KerningFont* f) {
+    if(f == nullptr) {
+        return nullptr;
+    }
+    auto found = _font_materials.find(f);
+    if(found != _font_materials.end()) {
+        return found->second;
+    }
+    namespace FS = std::filesystem;
+    FS::path p(f->_filepath);
+    p.replace_extension(".material");
+    Material* material = GetMaterial(p.string());
+    if(material) {
+        _font_materials.insert_or_assign(f, material);
+    }
+    return material;
 }
 
 void SimpleRenderer::DrawTextLine(const BitmapFont& font, const std::string& text, const Vector2& bottomLeftStartPos, float fontHeight, float fontAspect, const Rgba& tint /*= Rgba::WHITE*/, const FontJustification& justification /*= FontJustification::LEFT*/) {
@@ -3365,11 +3384,11 @@ KerningFont* SimpleRenderer::GetFont(const std::string& name) {
 }
 
 KerningFont* SimpleRenderer::CreateFontFromXML(const std::string& name) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path font_path("Data/Fonts/");
     font_path.append(name);
     font_path.replace_extension(".fnt");
-    if(FS::exists(font_path)) {
+    if(FileUtils::FileExists(font_path.string())) {
         auto* f = new KerningFont();
         if(f->LoadFromFile(font_path.string())) {
             CreateMaterialFromFont(name, f);
@@ -3382,7 +3401,7 @@ KerningFont* SimpleRenderer::CreateFontFromXML(const std::string& name) {
     return nullptr;
 }
 void SimpleRenderer::CreateMaterialFromFont(const std::string& name, KerningFont* f) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path material_path = std::string("Data/Fonts/");
     material_path.append(name);
     material_path.replace_extension(".material");
@@ -3409,19 +3428,16 @@ void SimpleRenderer::CreateMaterialFromFont(const std::string& name, KerningFont
     }
 }
 Texture2D* SimpleRenderer::CreateOrGetTexture(const std::string& filepath) {
-    namespace FS = std::experimental::filesystem;
-    FS::path p(filepath);
-    auto texture_iter = _textures.find(p.string());
+    auto texture_iter = FindStringId(_textures, filepath);
     if(texture_iter == _textures.end()) {
         return CreateTexture(filepath);
     } else {
-        return GetTexture(filepath);
+        return texture_iter->second;
     }
 }
 Texture2D* SimpleRenderer::GetTexture(const std::string& filepath) {
-    namespace FS = std::experimental::filesystem;
-    FS::path p(filepath);
-    return _textures[p.string()];
+    auto texture_iter = FindStringId(_textures, filepath);
+    return texture_iter != _textures.end() ? texture_iter->second : nullptr;
 }
 
 Texture2D* SimpleRenderer::CreateTexture2DFromImage(const Image* image,
@@ -3544,9 +3560,9 @@ Texture2D* SimpleRenderer::CreateTexture(const std::string& filepath,
                                          const BufferBindUsage& bindUsage /*= BufferBindUsage::SHADER_RESOURCE*/,
                                          const ImageFormat& imageFormat /*= ImageFormat::R8G8B8A8_UNORM*/) {
 
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(filepath);
-    if(!FS::exists(p)) {
+    if(!FileUtils::FileExists(p.string())) {
         return GetTexture("__invalid");
     }
     Image img = Image(p.string());
@@ -3601,10 +3617,10 @@ Texture2D* SimpleRenderer::CreateTexture(const std::string& filepath,
 
 ShaderProgram* SimpleRenderer::CreateShaderProgram(const std::string& filepath) {
 
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     
     FS::path p = filepath;
-    if(FS::exists(p) == false) {
+    if(FileUtils::FileExists(p.string()) == false) {
         return nullptr;
     }
     ShaderProgram* prog = _rhi_device->CreateShaderFromHlslFile(p.string());
@@ -3612,9 +3628,9 @@ ShaderProgram* SimpleRenderer::CreateShaderProgram(const std::string& filepath)
 }
 
 bool SimpleRenderer::RegisterTexture(const std::string& name, Texture2D *texture) {
-    auto found_texture = _textures.find(name);
+    auto found_texture = FindStringId(_textures, name);
     if(found_texture == _textures.end()) {
-        _textures.insert_or_assign(name, texture);
+        _textures.insert_or_assign(StringId(name), texture);
         return true;
     } else {
         return false;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Core/EngineSubsystem.hpp"
+#include "Engine/Core/StringId.hpp"
 
 #include "Engine/RHI/RHI.hpp"
 #include "Engine/RHI/RHITypes.hpp"
@@ -11,8 +12,12 @@
 #include "Engine/Renderer/BlendState.hpp"
 
 #include "Engine/Renderer/Model.hpp"
+#include "Engine/Renderer/Vertex3D.hpp"
 
 #include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 class AABB2;
 
@@ -95,6 +100,7 @@ class Material;
 class Shader;
 class ShaderProgram;
 class SpriteSheet;
+class TextLayout;
 class VertexBuffer;
 
 enum class FontJustification {
@@ -178,6 +184,19 @@ public:
     void DrawIcoSphere(const Vector3& position, const Rgba& color, float radius, unsigned int iterations);
     void DrawTextLine(KerningFont* f, const std::string& text, const Rgba& color = Rgba::WHITE, float sx = 0.0f, float sy = 0.0f, float scale = 1.0f);
     void DrawTextLine(KerningFont* f, const std::string& text, const Vector2& bottomLeftStartPos = Vector2::ZERO, const Rgba& color = Rgba::WHITE, float scale = 1.0f);
+    //Appends the glyph quads for text to vbo without drawing, four vertices per character.
+    void AppendTextLine(KerningFont* f, std::string_view text, const Rgba& color, float sx, float sy, std::vector<Vertex3D>& vbo) const;
+    //As AppendTextLine, but from quads the layout already computed.
+    void AppendTextLayout(const TextLayout& layout, const Rgba& color, float sx, float sy, std::vector<Vertex3D>& vbo) const;
+    void DrawTextLayout(const TextLayout& layout, const Rgba& color = Rgba::WHITE, float sx = 0.0f, float sy = 0.0f);
+    //KerningFont text drawn between these is collected per font material and drawn at the
+    //outermost EndTextBatch, one draw call per material, with the model matrix current then.
+    void BeginTextBatch();
+    void EndTextBatch();
+    //Appends two triangles per quad for quad_count quads starting at first_vertex.
+    static void AppendQuadIndices(std::size_t first_vertex, std::size_t quad_count, std::vector<unsigned int>& ibo);
+    //Cached until the next RegisterMaterial, so look it up again rather than keeping it.
+    Material* GetFontMaterial(const KerningFont* f);
 
     void DrawTextLine(const BitmapFont& font, const std::string& text,
                                 const Vector2& bottomLeftStartPos, float fontHeight,
@@ -188,7 +207,7 @@ public:
     void DrawMultilineText(KerningFont* font, const std::string& text, const Vector2& bottomLeftStartPos, float fontHeight, float fontAspect = 1.0f, const Rgba& tint = Rgba::WHITE, const FontJustification& justification = FontJustification::LEFT);
 
     void ReloadTextures();
-    const std::map<std::string, Texture2D*>& GetLoadedTextures() const;
+    const std::unordered_map<StringId, Texture2D*>& GetLoadedTextures() const;
 
     const Matrix4& GetProjectionMatrix() const;
     void SetProjectionMatrix(const Matrix4& matrix);
@@ -326,13 +345,13 @@ public:
     Texture2D* _current_depthstencil;
     Texture2D* _default_depthstencil;
     std::map<std::string, RasterState*> _rasters;
-    std::map<std::string, Texture2D*> _textures;
+    std::unordered_map<StringId, Texture2D*> _textures;
     std::map<std::string, Sampler*> _samplers;
     std::map<std::string, KerningFont*> _fonts;
     std::map<std::string, ShaderProgram*> _shaderPrograms;
     std::map<std::string, Shader*> _shaders;
     std::map<std::string, ComputeShader*> _compute_shaders;
-    std::map<std::string, Material*> _materials;
+    std::unordered_map<StringId, Material*> _materials;
     std::map<std::string, Mesh*> _meshes;
     std::map<std::string, MeshMotion*> _motions;
     std::map<std::string, MeshSkeleton*> _skeletons;
@@ -355,6 +374,18 @@ public:
     ConstantBuffer* _lighting_cb;
     lighting_buffer_t _lighting_data;
 
+    struct text_batch_t {
+        Material* material = nullptr;
+        std::vector<Vertex3D> vbo{};
+    };
+    //Cleared whenever a material is registered, since that may replace one of these.
+    std::unordered_map<const KerningFont*, Material*> _font_materials;
+    //Kept between frames so batching reuses capacity.
+    std::vector<text_batch_t> _text_batches;
+    std::vector<Vertex3D> _text_vbo;
+    std::vector<unsigned int> _text_ibo;
+    unsigned int _text_batch_depth;
+
 private:
     KerningFont* GetFont(const std::string& name);
     KerningFont* CreateFontFromXML(const std::string& filepath);
@@ -430,6 +461,9 @@ private:
 
     void CalculateUvSphereBuffers(const Vector3& position, const Rgba& color, float radius, unsigned int slices, unsigned int stacks, std::vector<Vertex3D>& vbo, std::vector<unsigned int>& ibo);
 
+    std::vector<Vertex3D>& GetTextBatchVbo(Material* material);
+    void DrawTextVbo(Material* material, const std::vector<Vertex3D>& vbo);
+
     void UpdateVbo(const std::vector<Vertex3D>& new_vbo);
     void UpdateIbo(const std::vector<unsigned int>& new_ibo);
 
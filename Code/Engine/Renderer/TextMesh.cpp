@@ -0,0 +1,67 @@
+#include "Engine/Renderer/TextMesh.hpp"
+
+#include <vector>
+
+#include "Engine/RHI/RHIDevice.hpp"
+
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/SimpleRenderer.hpp"
+#include "Engine/Renderer/Vertex3D.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+
+TextMesh::~TextMesh() {
+    delete _vbo;
+    _vbo = nullptr;
+
+    delete _ibo;
+    _ibo = nullptr;
+}
+
+void TextMesh::Set(SimpleRenderer& renderer, KerningFont* f, std::string_view text, const Rgba& color /*= Rgba::WHITE*/, float sx /*= 0.0f*/, float sy /*= 0.0f*/) {
+    bool layout_changed = _layout.SetText(f, text);
+    if(!layout_changed && _color == color && _sx == sx && _sy == sy) {
+        return;
+    }
+    _color = color;
+    _sx = sx;
+    _sy = sy;
+    UpdateBuffers(renderer);
+}
+
+void TextMesh::Render(SimpleRenderer& renderer) const {
+    if(_index_count == 0) {
+        return;
+    }
+    renderer.SetMaterial(renderer.GetFontMaterial(_layout.GetFont()));
+    renderer.DrawIndexed(PrimitiveType::TRIANGLES, _vbo, _ibo, _index_count);
+}
+
+const TextLayout& TextMesh::GetLayout() const {
+    return _layout;
+}
+
+void TextMesh::UpdateBuffers(SimpleRenderer& renderer) {
+    std::vector<Vertex3D> vbo;
+    renderer.AppendTextLayout(_layout, _color, _sx, _sy, vbo);
+    std::vector<unsigned int> ibo;
+    SimpleRenderer::AppendQuadIndices(0, vbo.size() / 4, ibo);
+
+    _index_count = ibo.size();
+    if(_index_count == 0) {
+        return;
+    }
+    if(_vbo_capacity < vbo.size()) {
+        delete _vbo;
+        _vbo = renderer._rhi_device->CreateVertexBuffer(vbo, BufferUsage::DYNAMIC, BufferBindUsage::VERTEX_BUFFER);
+        _vbo_capacity = vbo.size();
+    } else {
+        _vbo->Update(renderer._rhi_context, vbo);
+    }
+    if(_ibo_capacity < ibo.size()) {
+        delete _ibo;
+        _ibo = renderer._rhi_device->CreateIndexBuffer(ibo, BufferUsage::DYNAMIC, BufferBindUsage::INDEX_BUFFER);
+        _ibo_capacity = ibo.size();
+    } else {
+        _ibo->Update(renderer._rhi_context, ibo);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "Engine/Core/Rgba.hpp"
+#include "Engine/Core/TextLayout.hpp"
+
+class IndexBuffer;
+class KerningFont;
+class SimpleRenderer;
+class VertexBuffer;
+
+//Text whose glyph quads live in their own GPU buffers across frames. For labels that
+//rarely change: Set every frame is cheap, since the buffers are rewritten only when the
+//text, font, color or position actually changes. The font's material is looked up on
+//each Render, so the mesh survives material reloads.
+class TextMesh {
+public:
+    TextMesh() = default;
+    TextMesh(const TextMesh& other) = delete;
+    TextMesh& operator=(const TextMesh& other) = delete;
+    ~TextMesh();
+
+    void Set(SimpleRenderer& renderer, KerningFont* f, std::string_view text, const Rgba& color = Rgba::WHITE, float sx = 0.0f, float sy = 0.0f);
+    void Render(SimpleRenderer& renderer) const;
+
+    const TextLayout& GetLayout() const;
+
+protected:
+private:
+    void UpdateBuffers(SimpleRenderer& renderer);
+
+    TextLayout _layout{};
+    Rgba _color = Rgba::WHITE;
+    float _sx = 0.0f;
+    float _sy = 0.0f;
+    VertexBuffer* _vbo = nullptr;
+    IndexBuffer* _ibo = nullptr;
+    std::size_t _vbo_capacity = 0;
+    std::size_t _ibo_capacity = 0;
+    std::size_t _index_count = 0;
+};
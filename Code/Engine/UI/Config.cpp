@@ -233,7 +233,7 @@ void Config::SetValue(const std::string& key, const char* value) {
     SetValue(key, std::string(value));
 }
 bool Config::LoadFromFile(const std::string& filepath) {
-    namespace FS = std::experimental::filesystem;
+    namespace FS = std::filesystem;
     FS::path p(filepath);
     if(p.has_extension() == false) {
         std::ostringstream ss;
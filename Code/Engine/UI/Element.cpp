@@ -180,6 +180,7 @@ void Element::RemoveSelf() {
     if(_parent) {
         _parent->RemoveChild(this);
         _parent = nullptr;
+        DirtyWorldTransform();
     }
 }
 
@@ -236,7 +237,20 @@ void Element::CalcBounds() {
         default:
             ERROR_AND_DIE("Element::CalcBounds: Unhandled positioning mode.");
     }
+    DirtyWorldTransform();
+}
 
+void Element::DirtyWorldTransform() {
+    //A dirty element's descendants are already dirty: cleaning one cleans its ancestors first.
+    if(_dirtyWorldTransform) {
+        return;
+    }
+    _dirtyWorldTransform = true;
+    for(auto& c : _children) {
+        if(c) {
+            c->DirtyWorldTransform();
+        }
+    }
 }
 
 AABB2 Element::CalcBoundsRelativeToParent() const {
@@ -319,7 +333,11 @@ Matrix4 Element::GetLocalTransform() const {
 }
 
 Matrix4 Element::GetWorldTransform() const {
-    return GetParentWorldTransform() * GetLocalTransform();
+    if(_dirtyWorldTransform) {
+        _worldTransform = GetParentWorldTransform() * GetLocalTransform();
+        _dirtyWorldTransform = false;
+    }
+    return _worldTransform;
 }
 
 void Element::Update(float /*deltaSeconds*/, const Vector2& canvas_position) {
@@ -127,6 +127,7 @@ protected:
     void DestroyChild(UI::Element*& child);
     void DestroyAllChildren();
     void CalcBounds();
+    void DirtyWorldTransform();
     AABB2 CalcBoundsRelativeToParent() const;
 
     AABB2 CalcRelativeBounds();
@@ -148,6 +149,8 @@ protected:
     Rgba _debugFill = Rgba::NOALPHA;
     Rgba _debugEdge = Rgba::WHITE;
     bool _dirtyBounds = false;
+    mutable Matrix4 _worldTransform{};
+    mutable bool _dirtyWorldTransform = true;
     KerningFont* _font = nullptr;
     Vector2 _last_canvas_position = Vector2(0.0f, 0.0f);
     Vector2 _current_canvas_position = Vector2(0.0f, 0.0f);
@@ -12,6 +12,7 @@ Text::Text(KerningFont* f)
     : UI::Element()
 {
     _font = f;
+    _layout.SetText(_font, std::string_view{});
 }
 
 Text::Text(UI::Canvas* parentCanvas)
@@ -22,13 +23,15 @@ Text::Text(UI::Canvas* parentCanvas)
 
 void Text::DebugRender(SimpleRenderer* renderer) const {
     renderer->SetModelMatrix(GetWorldTransform());
-    renderer->DrawTextLine(_font, _text, _bounds.GetBottomLeft(), _color, _scale);
+    const auto bottom_left = _bounds.GetBottomLeft();
+    renderer->DrawTextLayout(_layout, _color, bottom_left.x, bottom_left.y);
     UI::Element::DebugRender(renderer);
 }
 
 void Text::Render(SimpleRenderer* renderer) const {
     renderer->SetModelMatrix(GetWorldTransform());
-    renderer->DrawTextLine(_font, _text, _bounds.GetBottomLeft(), _color, _scale);
+    const auto bottom_left = _bounds.GetBottomLeft();
+    renderer->DrawTextLayout(_layout, _color, bottom_left.x, bottom_left.y);
 }
 
 void Text::Update(float deltaSeconds, const Vector2& mouse_position) {
@@ -50,12 +53,12 @@ float Text::GetScale() const {
 
 void Text::SetText(const std::string& text) {
     _dirtyBounds = true;
-    _text = text;
+    _layout.SetText(_font, text);
     CalcBoundsFromFont(_font);
 }
 
 const std::string& Text::GetText() const {
-    return _text;
+    return _layout.GetText();
 }
 
 void Text::SetTextColor(const Rgba& textColor) {
@@ -70,8 +73,9 @@ void Text::CalcBoundsFromFont(KerningFont* f) {
     if(f == nullptr) {
         return;
     }
-    float width = f->CalculateTextWidth(_text, _scale);
-    float height = f->CalculateTextHeight(_text, _scale);
+    _layout.SetText(f, _layout.GetText());
+    float width = _layout.GetWidth(_scale);
+    float height = _layout.GetHeight(_scale);
     auto old_size = GetSize();
     float old_width = old_size.x;
     float old_height = old_size.y;
@@ -3,6 +3,7 @@
 #include <string>
 
 #include "Engine/Core/Rgba.hpp"
+#include "Engine/Core/TextLayout.hpp"
 
 #include "Engine/UI/Element.hpp"
 
@@ -43,7 +44,8 @@ protected:
 private:
     float _scale = 1.0f;
     Rgba _color = Rgba::BLACK;
-    std::string _text = std::string{};
+    //Holds the text; rebuilt when the text or font changes, not every frame.
+    TextLayout _layout{};
 };
 
 } //End UI
\ No newline at end of file